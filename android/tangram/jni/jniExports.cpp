@@ -203,12 +203,8 @@ extern "C" {
         map->handleShoveGesture(distance);
     }
 
-    JNIEXPORT void JNICALL Java_com_mapzen_tangram_MapController_nativeOnUrlSuccess(JNIEnv* jniEnv, jobject obj, jbyteArray fetchedBytes, jlong callbackPtr) {
-        onUrlSuccess(jniEnv, fetchedBytes, callbackPtr);
-    }
-
-    JNIEXPORT void JNICALL Java_com_mapzen_tangram_MapController_nativeOnUrlFailure(JNIEnv* jniEnv, jobject obj, jlong callbackPtr) {
-        onUrlFailure(jniEnv, callbackPtr);
+    JNIEXPORT void JNICALL Java_com_mapzen_tangram_MapController_nativeOnUrlResponses(JNIEnv* jniEnv, jobject obj, jobjectArray fetchedBytes, jlongArray callbackPtrs) {
+        onUrlResponses(jniEnv, fetchedBytes, callbackPtrs);
     }
 
     JNIEXPORT void JNICALL Java_com_mapzen_tangram_MapController_nativePickFeature(JNIEnv* jniEnv, jobject obj, jlong mapPtr, jfloat posX, jfloat posY, jobject listener) {
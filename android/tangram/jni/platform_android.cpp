@@ -56,6 +56,8 @@ static AAssetManager* assetManager = nullptr;
 static bool s_isContinuousRendering = false;
 
 PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT = 0;
+PFNGLMAPBUFFERRANGEEXTPROC glMapBufferRangeEXT = 0;
+PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT = 0;
 PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT = 0;
 PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT = 0;
 
@@ -260,6 +262,12 @@ unsigned char* bytesFromFile(const char* _path, size_t& _size) {
     return nullptr;
 }
 
+// Relative paths name entries inside the AAssetManager, which have no
+// filesystem location - leave them untouched
+std::string resolveAssetPath(const char* _path) {
+    return std::string(_path);
+}
+
 bool startUrlRequest(const std::string& _url, UrlCallback _callback) {
 
     jstring jUrl = jniRenderThreadEnv->NewStringUTF(_url.c_str());
@@ -282,25 +290,34 @@ void cancelUrlRequest(const std::string& _url) {
     jniRenderThreadEnv->CallVoidMethod(tangramInstance, cancelUrlRequestMID, jUrl);
 }
 
-void onUrlSuccess(JNIEnv* _jniEnv, jbyteArray _jBytes, jlong _jCallbackPtr) {
+// Completed downloads are queued on the Java side and delivered here
+// in one batch per frame, so a burst of tile responses costs a single
+// JNI transition instead of one per response. A null entry in the
+// byte array stands for a failed request.
+void onUrlResponses(JNIEnv* _jniEnv, jobjectArray _jBytesArray, jlongArray _jCallbackPtrs) {
 
-    size_t length = _jniEnv->GetArrayLength(_jBytes);
-    std::vector<char> content;
-    content.resize(length);
+    jsize count = _jniEnv->GetArrayLength(_jCallbackPtrs);
 
-    _jniEnv->GetByteArrayRegion(_jBytes, 0, length, reinterpret_cast<jbyte*>(content.data()));
+    jlong* callbackPtrs = _jniEnv->GetLongArrayElements(_jCallbackPtrs, nullptr);
 
-    UrlCallback* callback = reinterpret_cast<UrlCallback*>(_jCallbackPtr);
-    (*callback)(std::move(content));
-    delete callback;
-}
+    for (jsize i = 0; i < count; i++) {
 
-void onUrlFailure(JNIEnv* _jniEnv, jlong _jCallbackPtr) {
-    std::vector<char> empty;
+        std::vector<char> content;
 
-    UrlCallback* callback = reinterpret_cast<UrlCallback*>(_jCallbackPtr);
-    (*callback)(std::move(empty));
-    delete callback;
+        jbyteArray jBytes = (jbyteArray) _jniEnv->GetObjectArrayElement(_jBytesArray, i);
+        if (jBytes) {
+            size_t length = _jniEnv->GetArrayLength(jBytes);
+            content.resize(length);
+            _jniEnv->GetByteArrayRegion(jBytes, 0, length, reinterpret_cast<jbyte*>(content.data()));
+            _jniEnv->DeleteLocalRef(jBytes);
+        }
+
+        UrlCallback* callback = reinterpret_cast<UrlCallback*>(callbackPtrs[i]);
+        (*callback)(std::move(content));
+        delete callback;
+    }
+
+    _jniEnv->ReleaseLongArrayElements(_jCallbackPtrs, callbackPtrs, JNI_ABORT);
 }
 
 void setCurrentThreadPriority(int priority) {
@@ -317,7 +334,7 @@ void featurePickCallback(JNIEnv* jniEnv, jobject listener, const std::vector<Tan
     jobject hashmap = jniEnv->NewObject(hashmapClass, hashmapInitMID);
 
     for (const auto& item : properties->items()) {
-        jstring jkey = jniEnv->NewStringUTF(item.key.c_str());
+        jstring jkey = jniEnv->NewStringUTF(item.key().c_str());
         jstring jvalue = jniEnv->NewStringUTF(properties->asString(item.value).c_str());
         jniEnv->CallObjectMethod(hashmap, hashmapPutMID, jkey, jvalue);
     }
@@ -331,6 +348,18 @@ void initGLExtensions() {
     glBindVertexArrayOESEXT = (PFNGLBINDVERTEXARRAYOESPROC) dlsym(libhandle, "glBindVertexArrayOES");
     glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSOESPROC) dlsym(libhandle, "glDeleteVertexArraysOES");
     glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSOESPROC) dlsym(libhandle, "glGenVertexArraysOES");
+
+    // Core entry point on ES3 devices, EXT_map_buffer_range elsewhere
+    glMapBufferRangeEXT = (PFNGLMAPBUFFERRANGEEXTPROC) dlsym(libhandle, "glMapBufferRange");
+    if (!glMapBufferRangeEXT) {
+        glMapBufferRangeEXT = (PFNGLMAPBUFFERRANGEEXTPROC) dlsym(libhandle, "glMapBufferRangeEXT");
+    }
+
+    // Core entry point on ES3 devices, EXT_discard_framebuffer elsewhere
+    glDiscardFramebufferEXT = (PFNGLDISCARDFRAMEBUFFEREXTPROC) dlsym(libhandle, "glInvalidateFramebuffer");
+    if (!glDiscardFramebufferEXT) {
+        glDiscardFramebufferEXT = (PFNGLDISCARDFRAMEBUFFEREXTPROC) dlsym(libhandle, "glDiscardFramebufferEXT");
+    }
 }
 
 std::string stringFromJString(JNIEnv* jniEnv, jstring string) {
@@ -7,8 +7,7 @@
 
 void bindJniEnvToThread(JNIEnv* jniEnv);
 void setupJniEnv(JNIEnv* _jniEnv, jobject _tangramInstance, jobject _assetManager);
-void onUrlSuccess(JNIEnv* jniEnv, jbyteArray jFetchedBytes, jlong jCallbackPtr);
-void onUrlFailure(JNIEnv* jniEnv, jlong jCallbackPtr);
+void onUrlResponses(JNIEnv* jniEnv, jobjectArray jBytesArray, jlongArray jCallbackPtrs);
 
 namespace Tangram {
 struct TouchItem;
@@ -15,6 +15,7 @@ import com.squareup.okhttp.Response;
 
 import java.io.IOException;
 import java.nio.IntBuffer;
+import java.util.ArrayList;
 import java.util.HashMap;
 import java.util.Iterator;
 import java.util.Map;
@@ -781,8 +782,7 @@ public class MapController implements Renderer {
     private synchronized native void nativeUseCachedGlState(long mapPtr, boolean use);
     private synchronized native void nativeCaptureSnapshot(long mapPtr, int[] buffer);
 
-    private native void nativeOnUrlSuccess(byte[] rawDataBytes, long callbackPtr);
-    private native void nativeOnUrlFailure(long callbackPtr);
+    private native void nativeOnUrlResponses(byte[][] rawDataBytes, long[] callbackPtrs);
 
     synchronized native long nativeAddDataSource(long mapPtr, String name);
     synchronized native void nativeRemoveDataSource(long mapPtr, long sourcePtr);
@@ -810,6 +810,12 @@ public class MapController implements Renderer {
     private boolean frameCaptureAwaitCompleteView;
     private Map<String, MapData> clientDataSources = new HashMap<>();
 
+    // Completed url requests queued for batched delivery to native code;
+    // a null data entry marks a failed request.
+    private final Object urlResponseLock = new Object();
+    private ArrayList<byte[]> urlResponseData = new ArrayList<>();
+    private ArrayList<Long> urlResponseCallbacks = new ArrayList<>();
+
     // GLSurfaceView.Renderer methods
     // ==============================
 
@@ -825,6 +831,8 @@ public class MapController implements Renderer {
             return;
         }
 
+        flushUrlResponses();
+
         boolean viewComplete = nativeUpdate(mapPointer, delta);
         nativeRender(mapPointer);
 
@@ -867,23 +875,52 @@ public class MapController implements Renderer {
         httpHandler.onRequest(url, new Callback() {
             @Override
             public void onFailure(Request request, IOException e) {
-                nativeOnUrlFailure(callbackPtr);
+                queueUrlResponse(null, callbackPtr);
             }
 
             @Override
             public void onResponse(Response response) throws IOException {
                 if (!response.isSuccessful()) {
-                    nativeOnUrlFailure(callbackPtr);
+                    queueUrlResponse(null, callbackPtr);
                     throw new IOException("Unexpected response code: " + response);
                 }
                 BufferedSource source = response.body().source();
                 byte[] bytes = source.readByteArray();
-                nativeOnUrlSuccess(bytes, callbackPtr);
+                queueUrlResponse(bytes, callbackPtr);
             }
         });
         return true;
     }
 
+    void queueUrlResponse(byte[] data, long callbackPtr) {
+        synchronized (urlResponseLock) {
+            urlResponseData.add(data);
+            urlResponseCallbacks.add(callbackPtr);
+        }
+        requestRender();
+    }
+
+    // Deliver all completed url requests to native code in one JNI call;
+    // tile bursts otherwise pay one native transition per response.
+    void flushUrlResponses() {
+        byte[][] data;
+        long[] callbacks;
+        synchronized (urlResponseLock) {
+            int count = urlResponseData.size();
+            if (count == 0) {
+                return;
+            }
+            data = urlResponseData.toArray(new byte[count][]);
+            callbacks = new long[count];
+            for (int i = 0; i < count; i++) {
+                callbacks[i] = urlResponseCallbacks.get(i);
+            }
+            urlResponseData.clear();
+            urlResponseCallbacks.clear();
+        }
+        nativeOnUrlResponses(data, callbacks);
+    }
+
     // Font Fetching
     // =============
     String getFontFilePath(String key) {
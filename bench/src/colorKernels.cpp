@@ -0,0 +1,58 @@
+#include "gl/texture.h"
+#include "util/color.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Pseudo-random pixels, deterministic across runs
+static std::vector<GLuint> makePixels(int _count) {
+    std::vector<GLuint> pixels;
+    pixels.reserve(_count);
+    unsigned int seed = 12345;
+    for (int i = 0; i < _count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        pixels.push_back(seed);
+    }
+    return pixels;
+}
+
+// Color stop mixing as run per feature at fractional zooms
+static void BM_Tangram_ColorMix(benchmark::State& state) {
+    auto pixels = makePixels(state.range_x());
+
+    while (state.KeepRunning()) {
+        uint32_t sum = 0;
+        float a = 0.f;
+        for (size_t i = 1; i < pixels.size(); i++) {
+            sum += Color::mix(Color(pixels[i - 1]), Color(pixels[i]), a).abgr;
+            a += 1.f / pixels.size();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Tangram_ColorMix)->Arg(256)->Arg(4096)->Arg(65536);
+
+// Worker-side mip generation as run when a raster tile is decoded;
+// the argument is the square tile edge in pixels
+static void BM_Tangram_GenerateMipmaps(benchmark::State& state) {
+    int edge = state.range_x();
+    auto pixels = makePixels(edge * edge);
+
+    TextureOptions options = {GL_RGBA, GL_RGBA,
+                              {GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR},
+                              {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE}};
+
+    while (state.KeepRunning()) {
+        Texture texture(edge, edge, options, true);
+        texture.setData(pixels.data(), pixels.size());
+        benchmark::DoNotOptimize(texture);
+    }
+}
+BENCHMARK(BM_Tangram_GenerateMipmaps)->Arg(256)->Arg(512)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,56 @@
+#include "util/fastmap.h"
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Key sets modeled on the real users: style names for tile building,
+// attribute names for draw-time location lookups.
+static std::vector<std::string> makeKeys(int _count) {
+    static const char* names[] = {
+        "polygons", "lines", "points", "text", "buildings", "roads",
+        "water", "earth", "landuse", "boundaries", "places", "pois",
+        "a_position", "a_normal", "a_color", "a_texcoord",
+    };
+    std::vector<std::string> keys;
+    for (int i = 0; i < _count; i++) {
+        keys.push_back(std::string(names[i % 16]) + std::to_string(i / 16));
+    }
+    return keys;
+}
+
+static void BM_Tangram_FastmapFind(benchmark::State& state) {
+    auto keys = makeKeys(state.range_x());
+    fastmap<std::string, int> map;
+    for (size_t i = 0; i < keys.size(); i++) { map[keys[i]] = i; }
+
+    while (state.KeepRunning()) {
+        int sum = 0;
+        for (auto& key : keys) {
+            sum += map.find(key)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Tangram_FastmapFind)->Arg(8)->Arg(16)->Arg(64)->Arg(256);
+
+static void BM_Tangram_HashmapFind(benchmark::State& state) {
+    auto keys = makeKeys(state.range_x());
+    hashmap<int> map;
+    for (size_t i = 0; i < keys.size(); i++) { map[keys[i]] = i; }
+
+    while (state.KeepRunning()) {
+        int sum = 0;
+        for (auto& key : keys) {
+            sum += map.find(key)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Tangram_HashmapFind)->Arg(8)->Arg(16)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
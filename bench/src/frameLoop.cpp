@@ -0,0 +1,161 @@
+#include "tangram.h"
+#include "gl.h"
+#include "platform.h"
+#include "data/mvtSource.h"
+#include "tile/tileTask.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Serves the same fixture tile bytes for every requested tile id,
+// synchronously, so frame timings measure the engine and not the
+// network. Parsing and styling go through the regular MVT path.
+class FixtureSource : public MVTSource {
+public:
+    FixtureSource(const std::string& _name, std::shared_ptr<std::vector<char>> _fixture)
+        : MVTSource(_name, "", 16),
+          m_fixture(_fixture) {}
+
+    bool loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) override {
+        auto& task = static_cast<DownloadTileTask&>(*_task);
+        task.rawTileData = m_fixture;
+        _cb.func(std::move(_task));
+        return true;
+    }
+
+    void cancelLoadingTile(const TileID& _tile) override {}
+
+private:
+    std::shared_ptr<std::vector<char>> m_fixture;
+};
+
+// One leg of a recorded camera trace; values are interpolated
+// linearly over the duration of the leg at a fixed 60hz timestep.
+struct CameraKeyframe {
+    float duration;
+    double lon, lat;
+    float zoom;
+    float rotation;
+    float tilt;
+};
+
+// Pan, zoom out, rotate while tilting, then zoom back in - the moves
+// our interactive traces consist of.
+static const CameraKeyframe s_cameraPath[] = {
+    { 0.f, -74.00976, 40.70532, 16.f, 0.f,   0.f },
+    { 2.f, -74.00076, 40.70532, 16.f, 0.f,   0.f },
+    { 2.f, -74.00076, 40.70982, 12.f, 0.f,   0.f },
+    { 2.f, -74.00526, 40.70982, 12.f, 1.57f, 1.05f },
+    { 2.f, -74.00976, 40.70532, 15.f, 0.f,   0.f },
+};
+
+static const float s_frameTime = 1.f / 60.f;
+
+class FrameLoopFixture : public benchmark::Fixture {
+public:
+    std::unique_ptr<Map> map;
+
+    FrameStats sum;
+    std::map<std::string, float> styleSum;
+    int frames = 0;
+
+    void SetUp() override {
+        map = std::make_unique<Map>();
+        map->loadScene("scene.yaml");
+
+        auto fixture = std::make_shared<std::vector<char>>();
+        std::ifstream resource("tile.mvt", std::ifstream::ate | std::ifstream::binary);
+        if (resource.is_open()) {
+            fixture->resize(resource.tellg());
+            resource.seekg(std::ifstream::beg);
+            resource.read(fixture->data(), fixture->size());
+        } else {
+            LOGE("Failed to read fixture tile.mvt");
+        }
+
+        // Named like the scene source so its tiles pick up the same
+        // layers and styles
+        map->addDataSource(std::make_shared<FixtureSource>("osm", fixture));
+
+        map->setupGL();
+        map->resize(1280, 720);
+
+        // Build the tiles at the path start so the measured replay
+        // exercises steady-state updates, not the first-frame builds
+        applyKeyframe(s_cameraPath[0]);
+        for (int i = 0; i < 1000; i++) {
+            if (map->update(s_frameTime)) { break; }
+            map->render();
+        }
+    }
+
+    void TearDown() override {
+        if (frames > 0) {
+            LOG("avg/frame ms - update %.3f tileUpdate %.3f labelUpdate %.3f render %.3f",
+                sum.update / frames, sum.tileUpdate / frames,
+                sum.labelUpdate / frames, sum.render / frames);
+            for (auto& pass : styleSum) {
+                LOG("  style '%s' %.3f", pass.first.c_str(), pass.second / frames);
+            }
+        }
+        map.reset();
+    }
+
+    void applyKeyframe(const CameraKeyframe& _key) {
+        map->setPosition(_key.lon, _key.lat);
+        map->setZoom(_key.zoom);
+        map->setRotation(_key.rotation);
+        map->setTilt(_key.tilt);
+    }
+
+    void replayPath() {
+        size_t count = sizeof(s_cameraPath) / sizeof(s_cameraPath[0]);
+
+        for (size_t i = 1; i < count; i++) {
+            const auto& a = s_cameraPath[i-1];
+            const auto& b = s_cameraPath[i];
+
+            int steps = int(b.duration / s_frameTime);
+            for (int s = 0; s < steps; s++) {
+                float t = float(s) / steps;
+
+                map->setPosition(a.lon + (b.lon - a.lon) * t,
+                                 a.lat + (b.lat - a.lat) * t);
+                map->setZoom(a.zoom + (b.zoom - a.zoom) * t);
+                map->setRotation(a.rotation + (b.rotation - a.rotation) * t);
+                map->setTilt(a.tilt + (b.tilt - a.tilt) * t);
+
+                map->update(s_frameTime);
+                map->render();
+
+                auto stats = map->getFrameStats();
+                sum.update += stats.update;
+                sum.tileUpdate += stats.tileUpdate;
+                sum.labelUpdate += stats.labelUpdate;
+                sum.render += stats.render;
+                for (auto& pass : stats.stylePasses) {
+                    styleSum[pass.first] += pass.second;
+                }
+                frames++;
+            }
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(FrameLoopFixture, CameraPathReplay)(benchmark::State& st) {
+
+    while (st.KeepRunning()) {
+        replayPath();
+    }
+}
+
+BENCHMARK_REGISTER_F(FrameLoopFixture, CameraPathReplay);
+
+BENCHMARK_MAIN();
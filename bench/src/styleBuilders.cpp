@@ -0,0 +1,201 @@
+#include "tangram.h"
+#include "gl.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/drawRule.h"
+#include "scene/scene.h"
+#include "scene/sceneLayer.h"
+#include "scene/sceneLoader.h"
+#include "scene/styleContext.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "util/mapProjection.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Count heap allocations made on this thread so each benchmark can
+// report allocations per iteration next to its timing.
+static std::atomic<size_t> s_allocCount(0);
+
+void* operator new(size_t _size) {
+    s_allocCount++;
+    void* ptr = malloc(_size);
+    if (!ptr) { throw std::bad_alloc(); }
+    return ptr;
+}
+
+void operator delete(void* _ptr) noexcept {
+    free(_ptr);
+}
+
+struct BuilderContext {
+
+    MercatorProjection projection;
+
+    std::shared_ptr<Scene> scene;
+    StyleContext styleContext;
+    std::shared_ptr<DataSource> source;
+    std::vector<char> rawTileData;
+
+    void loadScene(const char* _sceneFile) {
+        scene = std::make_shared<Scene>(_sceneFile);
+        auto sceneString = stringFromFile(_sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, scene);
+
+        styleContext.initFunctions(*scene);
+        styleContext.setKeywordZoom(0);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* _path) {
+        std::ifstream resource(_path, std::ifstream::ate | std::ifstream::binary);
+        if (!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", _path);
+            return;
+        }
+
+        size_t size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        rawTileData.resize(size);
+        resource.read(&rawTileData[0], size);
+        resource.close();
+    }
+
+    std::shared_ptr<TileData> parseTile(TileID _tileId) {
+        auto task = source->createTask(_tileId);
+        auto& t = static_cast<DownloadTileTask&>(*task);
+        t.rawTileData = std::make_shared<std::vector<char>>(rawTileData);
+
+        return source->parse(*task, projection);
+    }
+};
+
+static BuilderContext& context() {
+    static BuilderContext ctx;
+    static bool loaded = false;
+    if (!loaded) {
+        loaded = true;
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+    }
+    return ctx;
+}
+
+// Full build pipeline - rule matching plus every style builder - over
+// the fixture tile; the benchmark argument selects the tile zoom, so
+// overzoomed and underzoomed scale factors are covered.
+static void BM_Tangram_TileBuild(benchmark::State& state) {
+    auto& ctx = context();
+    TileID tileId(0, 0, state.range_x(), state.range_x(), 0);
+    auto tileData = ctx.parseTile(tileId);
+    TileBuilder builder(ctx.scene);
+
+    size_t allocsBefore = s_allocCount;
+    size_t iterations = 0;
+
+    while (state.KeepRunning()) {
+        auto tile = builder.build(tileId, *tileData, *ctx.source);
+        benchmark::DoNotOptimize(tile);
+        iterations++;
+    }
+
+    if (iterations > 0) {
+        LOG("z%d build: %zu allocations/iteration",
+            state.range_x(), (s_allocCount - allocsBefore) / iterations);
+    }
+}
+BENCHMARK(BM_Tangram_TileBuild)->Arg(10)->Arg(12)->Arg(14)->Arg(16);
+
+// Runs a single named style's builder over every feature of the
+// fixture tile with a fixed literal draw rule, isolating that
+// builder's cost from rule evaluation and the other styles.
+static void benchStyleBuilder(benchmark::State& state, const char* _styleName,
+                              std::vector<StyleParam> _params) {
+    auto& ctx = context();
+
+    std::shared_ptr<Style> style;
+    for (auto& s : ctx.scene->styles()) {
+        if (s->getName() == _styleName) { style = s; break; }
+    }
+    if (!style) {
+        LOGE("Style %s not found in scene", _styleName);
+        return;
+    }
+
+    TileID tileId(0, 0, 14, 14, 0);
+    auto tileData = ctx.parseTile(tileId);
+    Tile tile(tileId, ctx.projection);
+
+    DrawRuleData ruleData(_styleName, 0, std::move(_params));
+    SceneLayer layer("layer", Filter(), { ruleData }, {});
+    DrawRule rule(ruleData, layer);
+
+    size_t allocsBefore = s_allocCount;
+    size_t iterations = 0;
+
+    while (state.KeepRunning()) {
+        auto builder = style->createBuilder();
+        builder->setup(tile);
+
+        for (const auto& datalayer : tileData->layers) {
+            for (const auto& feature : datalayer.features) {
+                builder->addFeature(feature, rule);
+            }
+        }
+        auto mesh = builder->build();
+        benchmark::DoNotOptimize(mesh);
+        iterations++;
+    }
+
+    if (iterations > 0) {
+        LOG("%s: %zu allocations/iteration",
+            _styleName, (s_allocCount - allocsBefore) / iterations);
+    }
+}
+
+static void BM_Tangram_PolygonStyleBuilder(benchmark::State& state) {
+    benchStyleBuilder(state, "polygons",
+                      {{ "order", "0" }, { "color", "#ffffff" }});
+}
+BENCHMARK(BM_Tangram_PolygonStyleBuilder);
+
+static void BM_Tangram_PolylineStyleBuilder(benchmark::State& state) {
+    benchStyleBuilder(state, "lines",
+                      {{ "order", "0" }, { "color", "#ffffff" }, { "width", "10px" }});
+}
+BENCHMARK(BM_Tangram_PolylineStyleBuilder);
+
+static void BM_Tangram_PointStyleBuilder(benchmark::State& state) {
+    benchStyleBuilder(state, "points",
+                      {{ "order", "0" }, { "color", "#ffffff" }, { "size", "16px" }});
+}
+BENCHMARK(BM_Tangram_PointStyleBuilder);
+
+static void BM_Tangram_TextStyleBuilder(benchmark::State& state) {
+    benchStyleBuilder(state, "text",
+                      {{ "order", "0" }, { "font:size", "12px" }});
+}
+BENCHMARK(BM_Tangram_TextStyleBuilder);
+
+BENCHMARK_MAIN();
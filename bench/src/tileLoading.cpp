@@ -117,6 +117,38 @@ BENCHMARK_DEFINE_F(TileLoadingFixture, BuildTest)(benchmark::State& st) {
 
 BENCHMARK_REGISTER_F(TileLoadingFixture, BuildTest);
 
+// Combined content hash of the built meshes, per style in style order
+static size_t buildHash(const Tile& _tile, const Scene& _scene) {
+    size_t hash = 0;
+    for (const auto& style : _scene.styles()) {
+        if (const auto& mesh = _tile.getMesh(*style)) {
+            hash = hash * 31 + mesh->contentHash();
+        }
+    }
+    return hash;
+}
+
+// Golden-output check: rebuilding the same tile must produce
+// byte-identical mesh buffers, so performance changes to the build
+// pipeline can be validated as output-neutral.
+BENCHMARK_DEFINE_F(TileLoadingFixture, BuildDeterminismTest)(benchmark::State& st) {
+
+    size_t golden = 0;
+
+    while (st.KeepRunning()) {
+        ctx.parseTile();
+        result = ctx.tileBuilder->build({0,0,10,10,0}, *ctx.tileData, *ctx.source);
+
+        size_t hash = buildHash(*result, *ctx.scene);
+        if (golden == 0) {
+            golden = hash;
+            LOG("golden build hash %zx", golden);
+        } else if (hash != golden) {
+            LOGE("Build diverged: %zx != %zx", hash, golden);
+        }
+    }
+}
 
+BENCHMARK_REGISTER_F(TileLoadingFixture, BuildDeterminismTest);
 
 BENCHMARK_MAIN();
@@ -26,9 +26,10 @@ uniform LOWP int u_pass;
 
 attribute vec2 a_uv;
 attribute vec2 a_position;
-attribute LOWP float a_alpha;
 attribute LOWP vec4 a_color;
+attribute vec4 a_fade;
 #ifdef TANGRAM_TEXT
+attribute LOWP float a_alpha;
 attribute LOWP vec4 a_stroke;
 attribute float a_scale;
 #endif
@@ -47,14 +48,39 @@ varying float v_alpha;
 #define UNPACK_EXTRUDE(x) (x / 256.0)
 #define UNPACK_TEXTURE(x) (x * u_uv_scale_factor)
 
+#define TANGRAM_HALF_PI 1.5707963
+
+// Fade transitions evaluated against u_time, so a fading label needs
+// no per-frame vertex updates. a_fade holds the start time split into
+// two 16-bit milliseconds words, the duration in milliseconds and the
+// packed ease/direction selector; a zero duration means no fade.
+float fade_factor() {
+    if (a_fade.z <= 0.0) { return 1.0; }
+
+    float start = (a_fade.y * 65536.0 + a_fade.x) / 1000.0;
+    float st = clamp((u_time - start) / (a_fade.z / 1000.0), 0.0, 1.0);
+
+    float fade_in = mod(a_fade.w, 2.0);
+    float ease = floor(a_fade.w / 2.0);
+
+    if (ease == 0.0) { // linear
+        return fade_in > 0.0 ? st : 1.0 - st;
+    }
+    if (ease == 1.0) { // pow
+        return fade_in > 0.0 ? st * st : 1.0 - st * st;
+    }
+    // sine
+    return fade_in > 0.0 ? sin(st * TANGRAM_HALF_PI) : cos(st * TANGRAM_HALF_PI);
+}
+
 void main() {
 
-    v_alpha = a_alpha;
     v_color = a_color;
 
     vec2 vertex_pos = UNPACK_POSITION(a_position);
 
 #ifdef TANGRAM_TEXT
+    v_alpha = a_alpha * fade_factor();
     v_texcoords = UNPACK_TEXTURE(a_uv);
     v_sdf_scale = a_scale / 64.0;
 
@@ -83,6 +109,9 @@ void main() {
         v_alpha = 0.0;
     }
 #else
+    // The base alpha is pre-modulated into a_color.a for sprites
+    v_alpha = a_color.a * fade_factor();
+    v_color.a = 1.0;
     v_texcoords = a_uv;
 #endif
 
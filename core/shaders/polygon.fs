@@ -18,6 +18,11 @@ uniform float u_meters_per_pixel;
 uniform float u_device_pixel_ratio;
 uniform mat3 u_inverse_normal_matrix;
 
+#ifdef TANGRAM_FOG
+    uniform vec3 u_fog_color;
+    uniform vec2 u_fog_distance;
+#endif
+
 #pragma tangram: uniforms
 
 varying vec4 v_world_position;
@@ -87,6 +92,13 @@ void main(void) {
     // Modify color after lighting (filter-like effects that don't require a additional render passes)
     #pragma tangram: filter
 
+    #ifdef TANGRAM_FOG
+        // Fade distant fragments into the horizon color, hiding the far
+        // edge of the visible-tile set
+        color.rgb = mix(color.rgb, u_fog_color,
+                        smoothstep(u_fog_distance.x, u_fog_distance.y, length(v_position.xyz)));
+    #endif
+
     //color.rgb = pow(color.rgb, vec3(1.0/2.2)); // gamma correction
     gl_FragColor = color;
 }
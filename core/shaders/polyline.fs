@@ -20,6 +20,11 @@ uniform float u_device_pixel_ratio;
 uniform float u_texture_ratio;
 uniform sampler2D u_texture;
 
+#ifdef TANGRAM_FOG
+    uniform vec3 u_fog_color;
+    uniform vec2 u_fog_distance;
+#endif
+
 #pragma tangram: uniforms
 
 varying vec4 v_world_position;
@@ -106,5 +111,19 @@ void main(void) {
     // Modify color after lighting (filter-like effects that don't require a additional render passes)
     #pragma tangram: filter
 
+    #if defined(TANGRAM_LINE_SMOOTH_EDGES) && defined(TANGRAM_EXTENSION_OES_standard_derivatives)
+        // Analytic edge antialiasing: v_texcoord.x runs 0 to 1 across
+        // the line, fade out over one fragment's footprint at each edge
+        float edge_dist = (0.5 - abs(v_texcoord.x - 0.5)) / fwidth(v_texcoord.x);
+        color.a *= clamp(edge_dist, 0.0, 1.0);
+    #endif
+
+    #ifdef TANGRAM_FOG
+        // Fade distant fragments into the horizon color, hiding the far
+        // edge of the visible-tile set
+        color.rgb = mix(color.rgb, u_fog_color,
+                        smoothstep(u_fog_distance.x, u_fog_distance.y, length(v_position.xyz)));
+    #endif
+
     gl_FragColor = color;
 }
@@ -0,0 +1,53 @@
+#include "bundleSource.h"
+
+#include "tile/tileTask.h"
+#include "platform.h"
+
+// A bundle is a fixed asset, never evict from it
+#define BUNDLE_MAX_USAGE (size_t(1) << 40)
+
+namespace Tangram {
+
+BundleSource::BundleSource(const std::string& _name, const std::string& _bundlePath,
+                           const std::string& _urlTemplate, int32_t _maxZoom)
+    : MVTSource(_name, _urlTemplate, _maxZoom),
+      m_offlineOnly(_urlTemplate.empty()) {
+
+    setDiskCache(_bundlePath, BUNDLE_MAX_USAGE);
+}
+
+bool BundleSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
+
+    auto& task = static_cast<DownloadTileTask&>(*_task);
+
+    // createTask probed the caches when the task was made; repeat the
+    // probe only for tasks that were created some other way
+    if (!task.hasData()) { cacheGet(task); }
+
+    if (task.hasData()) {
+        // rawTileData is a view of the memory-mapped bundle file
+        _cb.func(std::move(_task));
+        return true;
+    }
+
+    if (m_offlineOnly) {
+        LOGD("Tile %s not in bundle '%s'",
+             _task->tileId().toString().c_str(), m_name.c_str());
+        return false;
+    }
+
+    // Fall back to the network; the response lands in the bundle
+    // through cachePut, filling it in place
+    return DataSource::loadTileData(std::move(_task), _cb);
+}
+
+void BundleSource::cancelLoadingTile(const TileID& _tile) {
+
+    // Bundle reads complete synchronously, only a network fallback
+    // can still be in flight
+    if (!m_offlineOnly) {
+        DataSource::cancelLoadingTile(_tile);
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "mvtSource.h"
+
+namespace Tangram {
+
+/* Offline tile source backed by a local bundle directory.
+ *
+ * A bundle is a directory in the disk cache layout, as written by the
+ * tile transcoder tool or by a previous run of the engine. Tiles are
+ * served through read-only memory-mapped files and handed zero-copy
+ * into the TileTask, so an offline session costs no network stack and
+ * no buffer copies. When a URL template is given, tiles missing from
+ * the bundle are fetched from it and stored, growing the bundle in
+ * place; without one the source is strictly offline.
+ */
+class BundleSource : public MVTSource {
+
+public:
+
+    BundleSource(const std::string& _name, const std::string& _bundlePath,
+                 const std::string& _urlTemplate, int32_t _maxZoom);
+
+    virtual bool loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) override;
+
+    virtual void cancelLoadingTile(const TileID& _tile) override;
+
+private:
+
+    // No URL template was given; tiles not in the bundle stay empty
+    bool m_offlineOnly;
+
+};
+
+}
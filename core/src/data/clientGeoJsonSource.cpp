@@ -6,6 +6,7 @@
 #include "platform.h"
 #include "tangram.h"
 #include "tile/tileTask.h"
+#include "util/asyncWorker.h"
 #include "util/geom.h"
 #include "data/propertyItem.h"
 #include "data/tileData.h"
@@ -38,6 +39,7 @@ ClientGeoJsonSource::ClientGeoJsonSource(const std::string& _name, const std::st
     // TODO: handle network url for client datasource data
     // TODO: generic uri handling
     m_generateGeometry = true;
+    m_worker = std::make_unique<AsyncWorker>();
 
     if (!_url.empty()) {
         std::regex r("^(http|https):/");
@@ -57,19 +59,67 @@ ClientGeoJsonSource::ClientGeoJsonSource(const std::string& _name, const std::st
     }
 }
 
-ClientGeoJsonSource::~ClientGeoJsonSource() {}
+ClientGeoJsonSource::~ClientGeoJsonSource() {
+    // Join the build thread before the feature store goes away
+    m_worker.reset();
+}
+
+void ClientGeoJsonSource::requestBuild() {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutexFeatures);
+        if (m_buildRunning) {
+            // The running rebuild picks the new features up on its next pass
+            m_buildQueued = true;
+            return;
+        }
+        m_buildRunning = true;
+    }
+
+    m_worker->enqueue([this]() {
+
+        while (true) {
+
+            std::vector<geojsonvt::ProjectedFeature> features;
+            {
+                std::lock_guard<std::mutex> lock(m_mutexFeatures);
+                features = m_features;
+                m_buildQueued = false;
+            }
+
+            auto store = std::make_unique<GeoJSONVT>(features, m_maxZoom, m_maxZoom,
+                                                     indexMaxPoints, tolerance);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutexStore);
+                m_store = std::move(store);
+                m_generation++;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutexFeatures);
+            if (!m_buildQueued) {
+                m_buildRunning = false;
+                break;
+            }
+        }
+
+        // Trigger an update so tiles reload against the new generation
+        requestRender(RenderDirty::full);
+    });
+}
 
 void ClientGeoJsonSource::addData(const std::string& _data) {
 
     auto features = geojsonvt::GeoJSONVT::convertFeatures(_data);
 
-    for (auto& f : features) {
-        m_features.push_back(std::move(f));
+    {
+        std::lock_guard<std::mutex> lock(m_mutexFeatures);
+        for (auto& f : features) {
+            m_features.push_back(std::move(f));
+        }
     }
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
+    requestBuild();
 
 }
 
@@ -86,7 +136,15 @@ bool ClientGeoJsonSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTa
 
 void ClientGeoJsonSource::clearData() {
 
-    m_features.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutexFeatures);
+        m_features.clear();
+        if (m_buildRunning) {
+            // Make a running rebuild take another pass over the now
+            // empty feature list instead of swapping in a stale store
+            m_buildQueued = true;
+        }
+    }
 
     std::lock_guard<std::mutex> lock(m_mutexStore);
     m_store.reset();
@@ -103,11 +161,12 @@ void ClientGeoJsonSource::addPoint(const Properties& _tags, LngLat _point) {
                                               geojsonvt::ProjectedFeatureType::Point,
                                               container.members);
 
-    m_features.push_back(std::move(feature));
+    {
+        std::lock_guard<std::mutex> lock(m_mutexFeatures);
+        m_features.push_back(std::move(feature));
+    }
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
+    requestBuild();
 }
 
 void ClientGeoJsonSource::addLine(const Properties& _tags, const Coordinates& _line) {
@@ -119,11 +178,12 @@ void ClientGeoJsonSource::addLine(const Properties& _tags, const Coordinates& _l
                                               geojsonvt::ProjectedFeatureType::LineString,
                                               geometry);
 
-    m_features.push_back(std::move(feature));
+    {
+        std::lock_guard<std::mutex> lock(m_mutexFeatures);
+        m_features.push_back(std::move(feature));
+    }
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
+    requestBuild();
 }
 
 void ClientGeoJsonSource::addPoly(const Properties& _tags, const std::vector<Coordinates>& _poly) {
@@ -138,11 +198,12 @@ void ClientGeoJsonSource::addPoly(const Properties& _tags, const std::vector<Coo
                                               geojsonvt::ProjectedFeatureType::Polygon,
                                               geometry);
 
-    m_features.push_back(std::move(feature));
+    {
+        std::lock_guard<std::mutex> lock(m_mutexFeatures);
+        m_features.push_back(std::move(feature));
+    }
 
-    std::lock_guard<std::mutex> lock(m_mutexStore);
-    m_store = std::make_unique<GeoJSONVT>(m_features, m_maxZoom, m_maxZoom, indexMaxPoints, tolerance);
-    m_generation++;
+    requestBuild();
 }
 
 std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
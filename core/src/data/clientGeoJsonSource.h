@@ -17,6 +17,7 @@ namespace Tangram {
 
 using GeoJSONVT = mapbox::util::geojsonvt::GeoJSONVT;
 
+class AsyncWorker;
 struct Properties;
 
 class ClientGeoJsonSource : public DataSource {
@@ -43,9 +44,19 @@ protected:
     virtual std::shared_ptr<TileData> parse(const TileTask& _task,
                                             const MapProjection& _projection) const override;
 
+    // Snapshots m_features and rebuilds the tile store on m_worker.
+    // Bursts of updates are coalesced into one rebuild; the source
+    // generation is bumped when the new store is swapped in, so tiles
+    // built from the old store get reloaded.
+    void requestBuild();
+
     std::unique_ptr<GeoJSONVT> m_store;
     mutable std::mutex m_mutexStore;
     std::vector<mapbox::util::geojsonvt::ProjectedFeature> m_features;
+    std::mutex m_mutexFeatures;
+    std::unique_ptr<AsyncWorker> m_worker;
+    bool m_buildRunning = false;
+    bool m_buildQueued = false;
     bool m_hasPendingData = false;
 
 };
@@ -1,5 +1,7 @@
 #include "dataSource.h"
+#include "data/diskCache.h"
 #include "util/geoJson.h"
+#include "util/tileDataSerializer.h"
 #include "platform.h"
 #include "tileData.h"
 #include "tile/tileID.h"
@@ -8,7 +10,9 @@
 #include "tile/tileManager.h"
 #include "tile/tileTask.h"
 #include "gl/texture.h"
+#include "util/memoryBudget.h"
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <list>
@@ -17,21 +21,65 @@
 
 namespace Tangram {
 
+// Downloads in flight across all sources, keyed by resolved URL. Raster
+// and vector sources layered over the same tile server request identical
+// URLs; concurrent requests for one URL then share a single transfer.
+namespace {
+
+struct InflightDownloads {
+
+    struct Subscriber {
+        DataSource* source;
+        std::shared_ptr<TileTask> task;
+        TileTaskCb cb;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<Subscriber>> downloads;
+};
+
+InflightDownloads& inflight() {
+    static InflightDownloads d;
+    return d;
+}
+
+}
+
 struct RawCache {
 
     // Used to ensure safe access from async loading threads
     std::mutex m_mutex;
 
     // LRU in-memory cache for raw tile data
-    using CacheEntry = std::pair<TileID, std::shared_ptr<std::vector<char>>>;
+    struct CacheEntry {
+        TileID id;
+        std::shared_ptr<std::vector<char>> data;
+        size_t charged;    // 0 for entries sharing a deduped buffer
+        uint64_t contentHash;
+    };
     using CacheList = std::list<CacheEntry>;
     using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
 
     CacheMap m_cacheMap;
     CacheList m_cacheList;
+
+    // Canonical buffer per content hash. Vast ocean and rural areas
+    // produce byte-identical tiles (empty or water-only); those share
+    // one allocation and are charged against the budget only once.
+    std::unordered_map<uint64_t, std::weak_ptr<std::vector<char>>> m_contentMap;
+
     int m_usage = 0;
     int m_maxUsage = 0;
 
+    static uint64_t contentHash(const std::vector<char>& _data) {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325;
+        for (char c : _data) {
+            hash = (hash ^ uint8_t(c)) * 0x100000001b3;
+        }
+        return hash;
+    }
+
     bool get(DownloadTileTask& _task) {
 
         if (m_maxUsage <= 0) { return false; }
@@ -43,29 +91,65 @@ struct RawCache {
         if (it != m_cacheMap.end()) {
             // Move cached entry to start of list
             m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
-            _task.rawTileData = m_cacheList.front().second;
+            _task.rawTileData = m_cacheList.front().data;
 
             return true;
         }
 
         return false;
     }
-    void put(const TileID& tileID, std::shared_ptr<std::vector<char>> rawDataRef) {
 
-        if (m_maxUsage <= 0) { return; }
+    // Returns the stored buffer: when a byte-identical buffer is already
+    // cached under another TileID, that canonical buffer instead of the
+    // given one. Callers hand the result to their task, so downstream
+    // stages can dedup by pointer identity.
+    std::shared_ptr<std::vector<char>> put(const TileID& tileID,
+                                           std::shared_ptr<std::vector<char>> rawDataRef) {
+
+        if (m_maxUsage <= 0) { return rawDataRef; }
 
         std::lock_guard<std::mutex> lock(m_mutex);
         TileID id(tileID.x, tileID.y, tileID.z);
 
-        m_cacheList.push_front({id, rawDataRef});
+        uint64_t hash = contentHash(*rawDataRef);
+        size_t charged = rawDataRef->size();
+
+        auto canonical = m_contentMap.find(hash);
+        if (canonical != m_contentMap.end()) {
+            if (auto shared = canonical->second.lock()) {
+                if (*shared == *rawDataRef) {
+                    rawDataRef = shared;
+                    charged = 0;
+                }
+                // On a hash collision keep the new buffer uncharged-for
+            } else {
+                canonical->second = rawDataRef;
+            }
+        } else {
+            m_contentMap.emplace(hash, rawDataRef);
+        }
+
+        m_cacheList.push_front({id, rawDataRef, charged, hash});
         m_cacheMap[id] = m_cacheList.begin();
 
-        m_usage += rawDataRef->size();
+        m_usage += charged;
+        MemoryBudget::add(MemoryBudget::rawTiles, charged);
+
+        trim(m_maxUsage);
+
+        return rawDataRef;
+    }
 
-        while (m_usage > m_maxUsage) {
+    // Evict LRU entries until usage is at most _maxBytes.
+    // The cache mutex must be held.
+    void trim(int _maxBytes) {
+        while (m_usage > _maxBytes ||
+               MemoryBudget::overBudget(MemoryBudget::rawTiles) > 0) {
             if (m_cacheList.empty()) {
-                LOGE("Error: invalid cache state!");
-                m_usage = 0;
+                if (m_usage > _maxBytes) {
+                    LOGE("Error: invalid cache state!");
+                    m_usage = 0;
+                }
                 break;
             }
 
@@ -73,10 +157,34 @@ struct RawCache {
             //        double(m_cacheUsage) / (1024*1024));
 
             auto& entry = m_cacheList.back();
-            m_usage -= entry.second->size();
 
-            m_cacheMap.erase(entry.first);
+            size_t charged = entry.charged;
+            if (charged > 0) {
+                // Other entries may share this buffer through content
+                // dedup; pass the byte accounting on to one of them,
+                // the bytes stay alive with it
+                for (auto& other : m_cacheList) {
+                    if (&other != &entry && other.charged == 0 &&
+                        other.data == entry.data) {
+                        other.charged = charged;
+                        charged = 0;
+                        break;
+                    }
+                }
+            }
+            m_usage -= charged;
+            MemoryBudget::remove(MemoryBudget::rawTiles, charged);
+
+            uint64_t hash = entry.contentHash;
+            m_cacheMap.erase(entry.id);
             m_cacheList.pop_back();
+
+            // Drop the canonical-buffer entry once nothing keeps the
+            // buffer alive
+            auto canonical = m_contentMap.find(hash);
+            if (canonical != m_contentMap.end() && canonical->second.expired()) {
+                m_contentMap.erase(canonical);
+            }
         }
     }
 
@@ -84,6 +192,8 @@ struct RawCache {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_cacheMap.clear();
         m_cacheList.clear();
+        m_contentMap.clear();
+        MemoryBudget::remove(MemoryBudget::rawTiles, m_usage);
         m_usage = 0;
     }
 };
@@ -113,16 +223,76 @@ void DataSource::setCacheSize(size_t _cacheSize) {
     m_cache->m_maxUsage = _cacheSize;
 }
 
+size_t DataSource::rawCacheUsage() const {
+    return m_cache->m_usage > 0 ? size_t(m_cache->m_usage) : 0;
+}
+
+void DataSource::trimRawCacheTo(size_t _maxBytes) {
+    std::lock_guard<std::mutex> lock(m_cache->m_mutex);
+    m_cache->trim(int(_maxBytes));
+}
+
+void DataSource::setDiskCache(const std::string& _path, size_t _maxUsage) {
+    m_diskCache = std::make_unique<DiskCache>(_path, _maxUsage);
+
+    // Raster tiles are decoded straight into textures; caching a
+    // parsed stage only pays off for vector sources.
+    if (!isRaster()) {
+        m_parsedCache = std::make_unique<DiskCache>(_path + "/parsed", _maxUsage);
+    }
+}
+
+std::shared_ptr<TileData> DataSource::parseCached(const TileTask& _task, const MapProjection& _projection) {
+
+    if (m_parsedCache) {
+        if (auto blob = m_parsedCache->get(_task.tileId())) {
+            if (auto tileData = TileDataSerializer::deserialize(blob.data(), blob.size())) {
+                return tileData;
+            }
+        }
+    }
+
+    auto tileData = parse(_task, _projection);
+
+    if (tileData && m_parsedCache) {
+        m_parsedCache->put(_task.tileId(), TileDataSerializer::serialize(*tileData));
+    }
+
+    return tileData;
+}
+
 bool DataSource::cacheGet(DownloadTileTask& _task) {
-    return m_cache->get(_task);
+    if (m_cache->get(_task)) { return true; }
+
+    if (m_diskCache) {
+        if (auto rawData = m_diskCache->get(_task.tileId())) {
+            _task.rawTileData = rawData;
+            return true;
+        }
+    }
+
+    return false;
 }
 
-void DataSource::cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef) {
-    m_cache->put(_tileID, _rawDataRef);
+std::shared_ptr<std::vector<char>> DataSource::cachePut(const TileID& _tileID,
+                                                        std::shared_ptr<std::vector<char>> _rawDataRef) {
+    auto ref = m_cache->put(_tileID, std::move(_rawDataRef));
+
+    if (m_diskCache) {
+        m_diskCache->put(_tileID, *ref);
+    }
+
+    return ref;
 }
 
 void DataSource::clearData() {
     m_cache->clear();
+    if (m_diskCache) {
+        m_diskCache->clear();
+    }
+    if (m_parsedCache) {
+        m_parsedCache->clear();
+    }
     m_generation++;
 }
 
@@ -153,30 +323,102 @@ void DataSource::onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<Tile
         std::swap(*rawDataRef, _rawData);
 
         auto& task = static_cast<DownloadTileTask&>(*_task);
-        task.rawTileData = rawDataRef;
+        // Cache before dispatch: byte-identical tiles come back as one
+        // shared buffer, and the pointer identity lets the parse stage
+        // reuse parsed data across tile IDs (see MVTSource::parse)
+        task.rawTileData = cachePut(tileID, rawDataRef);
 
         _cb.func(std::move(_task));
+    } else {
+        // Deliver failures too, so waiters can account for the tile;
+        // hasData() stays false and the receiver cancels or retries
+        _cb.func(std::move(_task));
+    }
+}
+
+bool DataSource::urlRequestShared(std::string _url, std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
+
+    auto& shared = inflight();
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+
+        auto it = shared.downloads.find(_url);
+        if (it != shared.downloads.end()) {
+            // An identical transfer is running - subscribe to its result
+            it->second.push_back({this, std::move(_task), _cb});
+            return true;
+        }
+        shared.downloads[_url].push_back({this, std::move(_task), _cb});
+    }
+
+    bool started = startUrlRequest(_url, [url = _url](std::vector<char>&& rawData) {
+
+            std::vector<InflightDownloads::Subscriber> subscribers;
+            {
+                auto& shared = inflight();
+                std::lock_guard<std::mutex> lock(shared.mutex);
+
+                auto it = shared.downloads.find(url);
+                if (it != shared.downloads.end()) {
+                    subscribers = std::move(it->second);
+                    shared.downloads.erase(it);
+                }
+            }
+
+            for (auto& entry : subscribers) {
+                // The last subscriber takes the buffer, the others copy it
+                auto data = (&entry == &subscribers.back())
+                    ? std::move(rawData)
+                    : rawData;
+                entry.source->onTileLoaded(std::move(data), std::move(entry.task), entry.cb);
+            }
+    });
 
-        cachePut(tileID, rawDataRef);
+    if (!started) {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.downloads.erase(_url);
     }
+
+    return started;
 }
 
 bool DataSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
 
     std::string url(constructURL(_task->tileId()));
 
-    // lambda captured parameters are const by default, we want "task" (moved) to be non-const,
-    // hence "mutable"
-    // Refer: http://en.cppreference.com/w/cpp/language/lambda
-    return startUrlRequest(url,
-            [this, _cb, task = std::move(_task)](std::vector<char>&& rawData) mutable {
-                this->onTileLoaded(std::move(rawData), std::move(task), _cb);
-            });
-
+    return urlRequestShared(std::move(url), std::move(_task), _cb);
 }
 
 void DataSource::cancelLoadingTile(const TileID& _tileID) {
-    cancelUrlRequest(constructURL(_tileID));
+
+    std::string url(constructURL(_tileID));
+
+    auto& shared = inflight();
+    bool cancelTransfer = false;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+
+        auto it = shared.downloads.find(url);
+        if (it != shared.downloads.end()) {
+            auto& subscribers = it->second;
+            subscribers.erase(
+                std::remove_if(subscribers.begin(), subscribers.end(),
+                               [&](const auto& entry) { return entry.source == this; }),
+                subscribers.end());
+
+            // Only stop the transfer when no other source waits for it
+            if (subscribers.empty()) {
+                shared.downloads.erase(it);
+                cancelTransfer = true;
+            }
+        } else {
+            // Not tracked here, forward the cancel to the platform
+            cancelTransfer = true;
+        }
+    }
+
+    if (cancelTransfer) { cancelUrlRequest(url); }
+
     for (auto& raster : m_rasterSources) {
         TileID rasterID = _tileID.withMaxSourceZoom(raster->maxZoom());
         raster->cancelLoadingTile(rasterID);
@@ -196,4 +438,10 @@ void DataSource::clearRaster(const TileID& id) {
     }
 }
 
+void DataSource::clearDecodedPixels() {
+    for (auto& raster : m_rasterSources) {
+        raster->clearDecodedPixels();
+    }
+}
+
 }
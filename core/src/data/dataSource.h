@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <vector>
@@ -16,6 +17,7 @@ struct Raster;
 class Tile;
 class TileManager;
 struct RawCache;
+class DiskCache;
 class Texture;
 
 class DataSource : public std::enable_shared_from_this<DataSource> {
@@ -46,6 +48,12 @@ public:
     /* Parse a <TileTask> with data into a <TileData>, returning an empty TileData on failure */
     virtual std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const = 0;
 
+    /* Like parse, but served from the binary parsed-tile cache when possible.
+     * On a hit the stored TileData is deserialized directly, skipping pbf/JSON
+     * decoding; on a miss the result of parse is stored for next time.
+     */
+    std::shared_ptr<TileData> parseCached(const TileTask& _task, const MapProjection& _projection);
+
     /* Clears all data associated with this DataSource */
     virtual void clearData();
 
@@ -54,6 +62,10 @@ public:
     virtual void clearRasters();
     virtual void clearRaster(const TileID& id);
 
+    /* Drops cached decoded raster pixels while keeping raw data and
+     * textures; evicted entries are decoded again on the next use. */
+    virtual void clearDecodedPixels();
+
     virtual bool equals(const DataSource& _other) const {
         return m_name == _other.m_name &&
                m_urlTemplate == _other.m_urlTemplate;
@@ -66,6 +78,21 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* Bytes currently held by the in-memory raw tile cache */
+    size_t rawCacheUsage() const;
+
+    /* Evicts least recently used raw tile data until at most @_maxBytes
+     * are held, without changing the configured cache size.
+     */
+    void trimRawCacheTo(size_t _maxBytes);
+
+    /* @_path: Root directory for a persistent tile cache, created if needed.
+     * @_maxUsage: Size budget for the cache on disk in bytes.
+     * Cached tiles are served across app runs through memory-mapped reads;
+     * least recently used tiles are evicted once the budget is exceeded.
+     */
+    void setDiskCache(const std::string& _path, size_t _maxUsage);
+
     /* ID of this DataSource instance */
     int32_t id() const { return m_id; }
 
@@ -89,6 +116,13 @@ protected:
     virtual void onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<TileTask>&& _task,
                               TileTaskCb _cb);
 
+    /* Starts the download of @_url, or joins an identical transfer that is
+     * already in flight from any source - sources layered over the same tile
+     * server then share one transfer per tile. The fetched bytes reach every
+     * subscribed source through its onTileLoaded.
+     */
+    bool urlRequestShared(std::string _url, std::shared_ptr<TileTask>&& _task, TileTaskCb _cb);
+
     /* Constructs the URL of a tile using <m_urlTemplate> */
     virtual void constructURL(const TileID& _tileCoord, std::string& _url) const;
 
@@ -100,7 +134,12 @@ protected:
 
     bool cacheGet(DownloadTileTask& _task);
 
-    void cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef);
+    /* Stores raw tile bytes in the memory (and disk) cache. Byte-identical
+     * tiles are deduped against a canonical buffer; the returned reference
+     * is the stored buffer, which tasks should carry so downstream stages
+     * can dedup by pointer identity. */
+    std::shared_ptr<std::vector<char>> cachePut(const TileID& _tileID,
+                                                std::shared_ptr<std::vector<char>> _rawDataRef);
 
     // This datasource is used to generate actual tile geometry
     bool m_generateGeometry = false;
@@ -114,14 +153,20 @@ protected:
     // Unique id for DataSource
     int32_t m_id;
 
-    // Generation of dynamic DataSource state (incremented for each update)
-    int64_t m_generation = 1;
+    // Generation of dynamic DataSource state (incremented for each update,
+    // possibly from a worker thread)
+    std::atomic<int64_t> m_generation { 1 };
 
     // URL template for requesting tiles from a network or filesystem
     std::string m_urlTemplate;
 
     std::unique_ptr<RawCache> m_cache;
 
+    std::unique_ptr<DiskCache> m_diskCache;
+
+    // Disk cache for the parsed, binary-serialized stage of a tile
+    std::unique_ptr<DiskCache> m_parsedCache;
+
     /* vector of raster sources (as raster samplers) referenced by this datasource */
     std::vector<std::shared_ptr<DataSource>> m_rasterSources;
 };
@@ -0,0 +1,193 @@
+#include "diskCache.h"
+
+#include "platform.h"
+#include "tile/tileHash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace Tangram {
+
+DiskCache::DiskCache(const std::string& _root, size_t _maxUsage)
+    : m_root(_root), m_maxUsage(_maxUsage) {
+
+    mkdir(m_root.c_str(), S_IRWXU);
+
+    scanEntries();
+}
+
+std::string DiskCache::entryPath(const TileID& _tileID) const {
+    return m_root + "/" + std::to_string(_tileID.z) +
+        "-" + std::to_string(_tileID.x) +
+        "-" + std::to_string(_tileID.y) + ".tile";
+}
+
+void DiskCache::scanEntries() {
+
+    DIR* dir = opendir(m_root.c_str());
+    if (!dir) { return; }
+
+    struct FoundEntry {
+        Entry entry;
+        time_t lastUsed;
+    };
+    std::vector<FoundEntry> found;
+
+    while (struct dirent* item = readdir(dir)) {
+        int x = 0, y = 0, z = 0, consumed = 0;
+        // The pattern must cover the whole name: an unanchored match
+        // would also register temp files left by a crash between
+        // write and rename, whose partial contents could then be
+        // served via the mmap path. Those strays are deleted instead.
+        if (sscanf(item->d_name, "%d-%d-%d.tile%n", &z, &x, &y, &consumed) != 3 ||
+            item->d_name[consumed] != '\0') {
+            size_t length = strlen(item->d_name);
+            if (length > 4 && strcmp(item->d_name + length - 4, ".tmp") == 0) {
+                unlink((m_root + "/" + item->d_name).c_str());
+            }
+            continue;
+        }
+
+        struct stat st;
+        std::string path = m_root + "/" + item->d_name;
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+
+        found.push_back({{TileID(x, y, z), size_t(st.st_size)}, st.st_mtime});
+    }
+    closedir(dir);
+
+    // Oldest entries go to the back of the LRU list
+    std::sort(found.begin(), found.end(),
+              [](const auto& a, const auto& b) { return a.lastUsed > b.lastUsed; });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& item : found) {
+        m_entries.push_back(item.entry);
+        m_entryMap[item.entry.id] = std::prev(m_entries.end());
+        m_usage += item.entry.size;
+    }
+
+    evictOverBudget();
+}
+
+RawData DiskCache::get(const TileID& _tileID) {
+
+    TileID id(_tileID.x, _tileID.y, _tileID.z);
+    std::string path;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_entryMap.find(id);
+        if (it == m_entryMap.end()) { return {}; }
+
+        // Move entry to start of list
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        path = entryPath(id);
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return {}; }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return {};
+    }
+
+    size_t size = st.st_size;
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapped == MAP_FAILED) {
+        LOGE("Failed to map cached tile %s", path.c_str());
+        return {};
+    }
+
+    // Refresh mtime so LRU ordering survives restarts
+    utimes(path.c_str(), nullptr);
+
+    std::shared_ptr<const void> owner(mapped, [size](const void* _ptr) {
+            munmap(const_cast<void*>(_ptr), size);
+        });
+
+    return RawData(std::move(owner), static_cast<const char*>(mapped), size);
+}
+
+void DiskCache::put(const TileID& _tileID, const std::vector<char>& _rawData) {
+
+    if (_rawData.empty()) { return; }
+
+    TileID id(_tileID.x, _tileID.y, _tileID.z);
+    std::string path = entryPath(id);
+    std::string tmpPath = path + ".tmp";
+
+    // Write to a temporary file first so readers never see a
+    // partially written tile.
+    FILE* file = fopen(tmpPath.c_str(), "wb");
+    if (!file) {
+        LOGE("Failed to open cache file %s", tmpPath.c_str());
+        return;
+    }
+
+    size_t written = fwrite(_rawData.data(), 1, _rawData.size(), file);
+    fclose(file);
+
+    if (written != _rawData.size() || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entryMap.find(id);
+    if (it != m_entryMap.end()) {
+        m_usage -= it->second->size;
+        m_entries.erase(it->second);
+    }
+
+    m_entries.push_front({id, _rawData.size()});
+    m_entryMap[id] = m_entries.begin();
+    m_usage += _rawData.size();
+
+    evictOverBudget();
+}
+
+void DiskCache::evictOverBudget() {
+
+    while (m_usage > m_maxUsage && !m_entries.empty()) {
+        auto& entry = m_entries.back();
+
+        unlink(entryPath(entry.id).c_str());
+
+        m_usage -= entry.size;
+        m_entryMap.erase(entry.id);
+        m_entries.pop_back();
+    }
+}
+
+void DiskCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& entry : m_entries) {
+        unlink(entryPath(entry.id).c_str());
+    }
+
+    m_entryMap.clear();
+    m_entries.clear();
+    m_usage = 0;
+}
+
+}
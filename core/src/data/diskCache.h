@@ -0,0 +1,71 @@
+#pragma once
+
+#include "tile/tileID.h"
+#include "tile/tileTask.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* Persistent on-disk cache for raw tile data, sharded by TileID.
+ *
+ * Tiles are stored as one file per TileID under a root directory
+ * supplied by the embedder. Reads are served through mmap as
+ * zero-copy <RawData> views; the mapping is released when the last
+ * view goes away. The cache is trimmed to a byte budget, least
+ * recently used entries first, and survives app restarts: the LRU
+ * state is rebuilt from file modification times on startup.
+ */
+class DiskCache {
+
+public:
+
+    DiskCache(const std::string& _root, size_t _maxUsage);
+
+    /* Looks up raw data for _tileID, returning a view of the
+     * memory-mapped cache file or an empty view on miss. */
+    RawData get(const TileID& _tileID);
+
+    /* Writes raw data for _tileID, evicting least recently used
+     * entries when the cache exceeds its byte budget. */
+    void put(const TileID& _tileID, const std::vector<char>& _rawData);
+
+    /* Removes all entries from disk. */
+    void clear();
+
+private:
+
+    struct Entry {
+        TileID id;
+        size_t size;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    std::string entryPath(const TileID& _tileID) const;
+
+    // Rebuild LRU state from the files present under m_root.
+    void scanEntries();
+
+    // Drop least recently used entries until usage fits the budget.
+    // Must be called with m_mutex held.
+    void evictOverBudget();
+
+    // Used to ensure safe access from loading threads
+    std::mutex m_mutex;
+
+    std::string m_root;
+
+    size_t m_maxUsage;
+    size_t m_usage = 0;
+
+    // Most recently used entries at the front
+    EntryList m_entries;
+    std::unordered_map<TileID, EntryList::iterator> m_entryMap;
+};
+
+}
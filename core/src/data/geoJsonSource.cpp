@@ -21,44 +21,21 @@ std::shared_ptr<TileData> GeoJsonSource::parse(const TileTask& _task,
 
     std::shared_ptr<TileData> tileData = std::make_shared<TileData>();
 
-    // Parse data into a JSON document
+    // Batch projection with the per-tile constants hoisted out of the
+    // per-point loop
+    TileID tileId = task.tileId();
+    const auto projFn = [&](const glm::dvec2* _lonLat, Point* _out, size_t _count){
+        _projection.LonLatToTilePoints(tileId, _lonLat, _out, _count);
+    };
+
+    // Parse JSON data directly into TileData, without building a DOM
     const char* error;
     size_t offset;
-    auto document = JsonParseBytes(task.rawTileData->data(), task.rawTileData->size(), &error, &offset);
-
-    if (error) {
+    if (!GeoJson::parseStreaming(task.rawTileData.data(), task.rawTileData.size(),
+                                 projFn, m_id, *tileData, &error, &offset)) {
         LOGE("Json parsing failed on tile [%s]: %s (%u)", task.tileId().toString().c_str(), error, offset);
-        return tileData;
-    }
-
-    BoundingBox tileBounds(_projection.TileBounds(task.tileId()));
-    glm::dvec2 tileOrigin = {tileBounds.min.x, tileBounds.max.y*-1.0};
-    double tileInverseScale = 1.0 / tileBounds.width();
-
-    const auto projFn = [&](glm::dvec2 _lonLat){
-        glm::dvec2 tmp = _projection.LonLatToMeters(_lonLat);
-        return Point {
-            (tmp.x - tileOrigin.x) * tileInverseScale,
-            (tmp.y - tileOrigin.y) * tileInverseScale,
-             0
-        };
-    };
-
-    // Transform JSON data into TileData using GeoJson functions
-    if (GeoJson::isFeatureCollection(document)) {
-        tileData->layers.push_back(GeoJson::getLayer(document, projFn, m_id));
-    } else {
-        for (auto layer = document.MemberBegin(); layer != document.MemberEnd(); ++layer) {
-            if (GeoJson::isFeatureCollection(layer->value)) {
-                tileData->layers.push_back(GeoJson::getLayer(layer->value, projFn, m_id));
-                tileData->layers.back().name = layer->name.GetString();
-            }
-        }
     }
 
-
-    // Discard original JSON object and return TileData
-
     return tileData;
 
 }
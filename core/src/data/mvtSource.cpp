@@ -16,11 +16,25 @@ MVTSource::MVTSource(const std::string& _name, const std::string& _urlTemplate,
 
 std::shared_ptr<TileData> MVTSource::parse(const TileTask& _task, const MapProjection& _projection) const {
 
-    auto tileData = std::make_shared<TileData>();
-
     auto& task = static_cast<const DownloadTileTask&>(_task);
 
-    protobuf::message item(task.rawTileData->data(), task.rawTileData->size());
+    {
+        std::lock_guard<std::mutex> lock(m_parsedMutex);
+
+        auto it = m_parsedData.find(task.rawTileData.data());
+        if (it != m_parsedData.end() &&
+            it->second.raw.size() == task.rawTileData.size() &&
+            it->second.z == task.tileId().z) {
+
+            if (auto tileData = it->second.parsed.lock()) {
+                return tileData;
+            }
+        }
+    }
+
+    auto tileData = std::make_shared<TileData>();
+
+    protobuf::message item(task.rawTileData.data(), task.rawTileData.size());
     PbfParser::ParserContext ctx(m_id);
 
     while(item.next()) {
@@ -30,6 +44,22 @@ std::shared_ptr<TileData> MVTSource::parse(const TileTask& _task, const MapProje
             item.skip();
         }
     }
+
+    {
+        std::lock_guard<std::mutex> lock(m_parsedMutex);
+
+        // Drop memo entries whose parsed data is gone before adding
+        for (auto it = m_parsedData.begin(); it != m_parsedData.end();) {
+            if (it->second.parsed.expired()) {
+                it = m_parsedData.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_parsedData[task.rawTileData.data()] =
+            { task.rawTileData, task.tileId().z, tileData };
+    }
+
     return tileData;
 }
 
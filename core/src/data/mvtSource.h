@@ -1,6 +1,10 @@
 #pragma once
 
 #include "dataSource.h"
+#include "tile/tileTask.h"
+
+#include <mutex>
+#include <unordered_map>
 
 namespace Tangram {
 
@@ -15,6 +19,24 @@ public:
 
     MVTSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom);
 
+private:
+
+    /* Memo of recently parsed tiles keyed by raw-buffer identity. The raw
+     * cache dedups byte-identical downloads into one buffer, and MVT
+     * geometry is tile-local, so tiles sharing their bytes at the same
+     * data zoom share the parsed TileData instead of decoding the pbf
+     * again - common over ocean and rural areas. Entries pin their raw
+     * buffer so a pointer cannot be reused with different content, and
+     * are swept once the parsed data expires. */
+    struct ParsedEntry {
+        RawData raw;
+        int8_t z = 0;
+        std::weak_ptr<TileData> parsed;
+    };
+
+    mutable std::mutex m_parsedMutex;
+    mutable std::unordered_map<const char*, ParsedEntry> m_parsedData;
+
 };
 
 }
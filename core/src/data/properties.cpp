@@ -21,22 +21,26 @@ void Properties::setSorted(std::vector<Item>&& _items) {
 const Value& Properties::get(const std::string& key) const {
     const static Value NOT_FOUND(none_type{});
 
+    // A key that was never interned cannot be set on any feature
+    uint32_t keyId = PropertyKey::find(key);
+    if (keyId == PropertyKey::invalid) {
+        return NOT_FOUND;
+    }
+
+    return get(keyId);
+}
+
+const Value& Properties::get(uint32_t keyId) const {
+    const static Value NOT_FOUND(none_type{});
+
     const auto it = std::find_if(props.begin(), props.end(),
                                  [&](const auto& item) {
-                                     return item.key == key;
+                                     return item.keyId == keyId;
                                  });
     if (it == props.end()) {
         return NOT_FOUND;
     }
 
-    // auto it = std::lower_bound(props.begin(), props.end(), key,
-    //                            [](auto& item, auto& key) {
-    //                                return keyComparator(item.key, key);
-    //                            });
-    // if (it == props.end() || it->key != key) {
-    //     return NOT_FOUND;
-    // }
-
     return it->value;
 }
 
@@ -46,6 +50,10 @@ bool Properties::contains(const std::string& key) const {
     return !get(key).is<none_type>();
 }
 
+bool Properties::contains(uint32_t keyId) const {
+    return !get(keyId).is<none_type>();
+}
+
 bool Properties::getNumber(const std::string& key, double& value) const {
     auto& it = get(key);
     if (it.is<double>()) {
@@ -117,13 +125,15 @@ void Properties::sort() {
 
 void Properties::set(std::string key, std::string value) {
 
-    auto it = std::lower_bound(props.begin(), props.end(), key,
-                               [](auto& item, auto& key) {
-                                   return keyComparator(item.key, key);
+    uint32_t keyId = PropertyKey::intern(key);
+
+    auto it = std::lower_bound(props.begin(), props.end(), keyId,
+                               [](auto& item, auto& id) {
+                                   return item.keyId < id;
                                });
 
-    if (it == props.end() || it->key != key) {
-        props.emplace(it, std::move(key), std::move(value));
+    if (it == props.end() || it->keyId != keyId) {
+        props.emplace(it, keyId, Value(std::move(value)));
     } else {
         it->value = std::move(value);
     }
@@ -131,13 +141,15 @@ void Properties::set(std::string key, std::string value) {
 
 void Properties::set(std::string key, double value) {
 
-    auto it = std::lower_bound(props.begin(), props.end(), key,
-                               [](auto& item, auto& key) {
-                                   return keyComparator(item.key, key);
+    uint32_t keyId = PropertyKey::intern(key);
+
+    auto it = std::lower_bound(props.begin(), props.end(), keyId,
+                               [](auto& item, auto& id) {
+                                   return item.keyId < id;
                                });
 
-    if (it == props.end() || it->key != key) {
-        props.emplace(it, std::move(key), value);
+    if (it == props.end() || it->keyId != keyId) {
+        props.emplace(it, keyId, Value(value));
     } else {
         it->value = value;
     }
@@ -149,7 +161,7 @@ std::string Properties::toJson() const {
 
     for (const auto& item : props) {
         bool last = (&item == &props.back());
-        json += "\"" + item.key + "\": \"" + asString(item.value) + (last ? "\"" : "\",");
+        json += "\"" + item.key() + "\": \"" + asString(item.value) + (last ? "\"" : "\",");
     }
 
     json += " }";
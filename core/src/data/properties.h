@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -22,12 +23,18 @@ struct Properties {
 
     const Value& get(const std::string& key) const;
 
+    // Lookup by interned key id (see PropertyKey); the hot path for
+    // filter and draw rule evaluation, a linear integer-compare scan.
+    const Value& get(uint32_t keyId) const;
+
     void sort();
 
     void clear();
 
     bool contains(const std::string& key) const;
 
+    bool contains(uint32_t keyId) const;
+
     bool getNumber(const std::string& key, double& value) const;
 
     double getNumber(const std::string& key) const;
@@ -58,13 +65,6 @@ struct Properties {
 
     int32_t sourceId;
 
-    static bool keyComparator(const std::string& a, const std::string& b) {
-        if (a.size() == b.size()) {
-            return a < b;
-        } else {
-            return a.size() < b.size();
-        }
-    }
 private:
     std::vector<Item> props;
 };
@@ -0,0 +1,55 @@
+#include "data/propertyKey.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace Tangram {
+namespace PropertyKey {
+
+namespace {
+
+struct Table {
+    std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> ids;
+    // deque: growing never invalidates references handed out by string()
+    std::deque<std::string> keys;
+};
+
+Table& table() {
+    static Table t;
+    return t;
+}
+
+}
+
+uint32_t intern(const std::string& _key) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    auto it = t.ids.find(_key);
+    if (it != t.ids.end()) { return it->second; }
+
+    uint32_t id = static_cast<uint32_t>(t.keys.size());
+    t.keys.push_back(_key);
+    t.ids.emplace(_key, id);
+    return id;
+}
+
+uint32_t find(const std::string& _key) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    auto it = t.ids.find(_key);
+    return (it == t.ids.end()) ? invalid : it->second;
+}
+
+const std::string& string(uint32_t _id) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    return t.keys[_id];
+}
+
+}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Tangram {
+
+// Global interning table for feature property keys. The same few keys
+// ("name", "kind", "height", ...) repeat in every feature of every
+// tile, so each PropertyItem stores a 32-bit id into this table and
+// key comparisons in the styling hot path are integer compares.
+// Interned keys are kept for the lifetime of the process; the set of
+// distinct keys across tile sources is small and bounded.
+namespace PropertyKey {
+
+// Id returned by find() for keys that were never interned
+constexpr uint32_t invalid = UINT32_MAX;
+
+// Returns the id for @_key, adding it to the table when new
+uint32_t intern(const std::string& _key);
+
+// Returns the id for @_key without adding it, or `invalid`
+uint32_t find(const std::string& _key);
+
+// Returns the key string for an id returned by intern()
+const std::string& string(uint32_t _id);
+
+}
+}
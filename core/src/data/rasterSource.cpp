@@ -6,17 +6,127 @@
 #include "tile/tile.h"
 #include "tile/tileTask.h"
 #include "util/geoJson.h"
+#include "util/memoryBudget.h"
 #include "platform.h"
 
+#include <atomic>
+#include <list>
+
 namespace Tangram {
 
+namespace {
+
+// Byte budget for decoded pixels kept per RasterSource; a handful of
+// 256px RGBA tiles per source is enough to cover zoom bounce.
+constexpr size_t DECODED_CACHE_SIZE = 16 * (1024 * 1024);
+
+std::atomic<size_t> s_decodedCacheHits(0);
+std::atomic<size_t> s_decodedCacheMisses(0);
+
+}
+
+struct DecodedPixelCache {
+
+    // Used to ensure safe access from tile worker threads
+    std::mutex m_mutex;
+
+    struct Pixels {
+        std::shared_ptr<std::vector<GLuint>> data;
+        unsigned int width = 0;
+        unsigned int height = 0;
+
+        size_t bytes() const { return data ? data->size() * sizeof(GLuint) : 0; }
+    };
+
+    // LRU in-memory cache for decoded tile pixels
+    using CacheEntry = std::pair<TileID, Pixels>;
+    using CacheList = std::list<CacheEntry>;
+    using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
+
+    CacheMap m_cacheMap;
+    CacheList m_cacheList;
+    size_t m_usage = 0;
+    size_t m_maxUsage = DECODED_CACHE_SIZE;
+
+    bool get(const TileID& _tileId, Pixels& _pixels) {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_cacheMap.find(_tileId);
+        if (it != m_cacheMap.end()) {
+            // Move cached entry to start of list
+            m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+            _pixels = m_cacheList.front().second;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void put(const TileID& _tileId, Pixels _pixels) {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_cacheMap.find(_tileId) != m_cacheMap.end()) { return; }
+
+        size_t bytes = _pixels.bytes();
+
+        m_cacheList.push_front({_tileId, std::move(_pixels)});
+        m_cacheMap[_tileId] = m_cacheList.begin();
+
+        m_usage += bytes;
+        MemoryBudget::add(MemoryBudget::decodedPixels, bytes);
+
+        trim(m_maxUsage);
+    }
+
+    // Evict LRU entries until usage is at most _maxBytes.
+    // The cache mutex must be held.
+    void trim(size_t _maxBytes) {
+        while (m_usage > _maxBytes ||
+               MemoryBudget::overBudget(MemoryBudget::decodedPixels) > 0) {
+            if (m_cacheList.empty()) {
+                if (m_usage > _maxBytes) {
+                    LOGE("Error: invalid cache state!");
+                    m_usage = 0;
+                }
+                break;
+            }
+
+            auto& entry = m_cacheList.back();
+            size_t bytes = entry.second.bytes();
+            m_usage -= bytes;
+            MemoryBudget::remove(MemoryBudget::decodedPixels, bytes);
+
+            m_cacheMap.erase(entry.first);
+            m_cacheList.pop_back();
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MemoryBudget::remove(MemoryBudget::decodedPixels, m_usage);
+        m_cacheMap.clear();
+        m_cacheList.clear();
+        m_usage = 0;
+    }
+};
+
 class RasterTileTask : public DownloadTileTask {
 public:
     RasterTileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _subTask)
-        : DownloadTileTask(_tileId, _source, _subTask) {}
+        : DownloadTileTask(_tileId, _source, _subTask),
+          m_rasterId(_tileId.x, _tileId.y, _tileId.z) {}
 
     std::shared_ptr<Texture> m_texture;
 
+    // The tile actually covered by m_texture. Usually this task's own
+    // data coordinates, but an ancestor tile when an overzoomed task
+    // references a resident parent texture; the style then samples the
+    // matching sub-rectangle.
+    TileID m_rasterId;
+
     bool hasData() const override {
         return bool(rawTileData) || bool(m_texture);
     }
@@ -35,7 +145,7 @@ public:
 
         if (!m_texture) {
             // Decode texture data
-            m_texture = source->createTexture(*rawTileData);
+            m_texture = source->createTexture(tileId(), rawTileData);
         }
 
         // Create tile geometries
@@ -50,6 +160,8 @@ public:
         auto raster = source->getRaster(*this);
         assert(raster.isValid());
 
+        m_tile->setLoadStamps(m_timing.start, m_timing.data, m_timing.built);
+
         m_tile->rasters().push_back(std::move(raster));
 
         for (auto& subTask : m_subTasks) {
@@ -71,12 +183,15 @@ public:
 
 RasterSource::RasterSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom,
                            TextureOptions _options, bool _genMipmap)
-    : DataSource(_name, _urlTemplate, _maxZoom), m_texOptions(_options), m_genMipmap(_genMipmap) {
+    : DataSource(_name, _urlTemplate, _maxZoom), m_texOptions(_options), m_genMipmap(_genMipmap),
+      m_decodedCache(std::make_unique<DecodedPixelCache>()) {
 
     m_emptyTexture = std::make_shared<Texture>(nullptr, 0, m_texOptions, m_genMipmap, true);
 }
 
-std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _rawTileData) {
+RasterSource::~RasterSource() {}
+
+std::shared_ptr<Texture> RasterSource::createTexture(const TileID& _tileId, const RawData& _rawTileData) {
     auto udata = reinterpret_cast<const unsigned char*>(_rawTileData.data());
     size_t dataSize = _rawTileData.size();
 
@@ -84,11 +199,48 @@ std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _r
         return m_emptyTexture;
     }
 
+    TileID id(_tileId.x, _tileId.y, _tileId.z);
+
+    // When the Texture was evicted but the decoded pixels are still
+    // cached, skip the image decode and rebuild the Texture directly
+    DecodedPixelCache::Pixels decoded;
+    if (m_decodedCache->get(id, decoded)) {
+        s_decodedCacheHits++;
+
+        auto texture = std::make_shared<Texture>(decoded.width, decoded.height,
+                                                 m_texOptions, m_genMipmap);
+        texture->setData(decoded.data->data(), decoded.data->size());
+
+        return texture;
+    }
+    s_decodedCacheMisses++;
+
     auto texture = std::make_shared<Texture>(udata, dataSize, m_texOptions, m_genMipmap, true);
 
+    // Keep a copy of the freshly decoded pixels for the next rebuild.
+    // On decode failure the Texture holds a 1x1 placeholder that does
+    // not match its (zero) dimensions - nothing worth caching then.
+    auto& pixels = texture->getData();
+    if (!pixels.empty() &&
+        pixels.size() == size_t(texture->getWidth()) * texture->getHeight()) {
+        decoded.data = std::make_shared<std::vector<GLuint>>(pixels);
+        decoded.width = texture->getWidth();
+        decoded.height = texture->getHeight();
+
+        m_decodedCache->put(id, std::move(decoded));
+    }
+
     return texture;
 }
 
+size_t RasterSource::decodedCacheHits() {
+    return s_decodedCacheHits;
+}
+
+size_t RasterSource::decodedCacheMisses() {
+    return s_decodedCacheMisses;
+}
+
 std::shared_ptr<TileData> RasterSource::parse(const TileTask& _task, const MapProjection& _projection) const {
 
     std::shared_ptr<TileData> tileData = std::make_shared<TileData>();
@@ -126,6 +278,26 @@ std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId, int _subTask)
 
     // Try raw data cache
     cacheGet(*task);
+    if (task->hasData()) { return task; }
+
+    // An overzoomed tile is fully covered by any resident ancestor
+    // texture. Reference that texture with the ancestor's ID - the
+    // style computes the sub-rectangle from the zoom difference - so
+    // no new download or texture upload is needed.
+    if (_tileId.s > _tileId.z) {
+        TileID ancestor(_tileId.x, _tileId.y, _tileId.z);
+        while (ancestor.z > 0) {
+            ancestor = TileID(ancestor.x >> 1, ancestor.y >> 1, ancestor.z - 1);
+
+            auto texIt = m_textures.find(ancestor);
+            if (texIt == m_textures.end()) { continue; }
+            if (texIt->second == m_emptyTexture) { continue; }
+
+            task->m_texture = texIt->second;
+            task->m_rasterId = ancestor;
+            break;
+        }
+    }
 
     return task;
 }
@@ -141,11 +313,11 @@ void RasterSource::onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<Ti
     std::swap(*rawDataRef, _rawData);
 
     auto& task = static_cast<DownloadTileTask&>(*_task);
-    task.rawTileData = rawDataRef;
+    // Deduped against the cache first, so byte-identical raster tiles
+    // share one buffer
+    task.rawTileData = cachePut(tileID, rawDataRef);
 
     _cb.func(std::move(_task));
-
-    cachePut(tileID, rawDataRef);
 }
 
 bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
@@ -154,13 +326,7 @@ bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _c
 
     auto copyTask = _task;
 
-    // lambda captured parameters are const by default, we want "task" (moved) to be non-const,
-    // hence "mutable"
-    // Refer: http://en.cppreference.com/w/cpp/language/lambda
-    bool status = startUrlRequest(url,
-            [this, _cb, task = std::move(_task)](std::vector<char>&& rawData) mutable {
-                this->onTileLoaded(std::move(rawData), std::move(task), _cb);
-            });
+    bool status = urlRequestShared(std::move(url), std::move(_task), _cb);
 
     // For "dependent" raster datasources if this returns false make sure to create a black texture
     // for tileID in this task, and consider dependent raster ready
@@ -173,14 +339,17 @@ bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _c
 }
 
 Raster RasterSource::getRaster(const TileTask& _task) {
-    TileID id(_task.tileId().x, _task.tileId().y, _task.tileId().z);
+    auto& task = static_cast<const RasterTileTask&>(_task);
+
+    // m_rasterId names the tile the texture covers; for tasks that
+    // reference an ancestor texture this differs from the task's ID.
+    const TileID& id = task.m_rasterId;
 
     auto texIt = m_textures.find(id);
     if (texIt != m_textures.end()) {
         return { id, texIt->second };
     }
 
-    auto& task = static_cast<const RasterTileTask&>(_task);
     m_textures.emplace(id, task.m_texture);
 
     return { id, task.m_texture };
@@ -192,6 +361,15 @@ void RasterSource::clearRasters() {
     }
 
     m_textures.clear();
+    m_decodedCache->clear();
+}
+
+void RasterSource::clearDecodedPixels() {
+    for (auto& raster: m_rasterSources) {
+        raster->clearDecodedPixels();
+    }
+
+    m_decodedCache->clear();
 }
 
 void RasterSource::clearRaster(const TileID &tileID) {
@@ -13,6 +13,7 @@
 namespace Tangram {
 
 class RasterTileTask;
+struct DecodedPixelCache;
 
 class RasterSource : public DataSource {
 
@@ -22,6 +23,12 @@ class RasterSource : public DataSource {
 
     std::shared_ptr<Texture> m_emptyTexture;
 
+    // LRU cache of decoded pixel buffers, sitting between the raw data
+    // cache and Texture creation: when a Texture was evicted but the raw
+    // bytes are still cached, createTexture would otherwise pay the image
+    // decode a second time.
+    std::unique_ptr<DecodedPixelCache> m_decodedCache;
+
 protected:
 
     virtual std::shared_ptr<TileData> parse(const TileTask& _task,
@@ -35,6 +42,8 @@ public:
     RasterSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom,
                  TextureOptions _options, bool genMipmap = false);
 
+    ~RasterSource() override;
+
     virtual std::shared_ptr<TileTask> createTask(TileID _tile, int _subTask) override;
 
     virtual bool loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) override;
@@ -43,12 +52,19 @@ public:
 
     virtual void clearRasters() override;
     virtual void clearRaster(const TileID& id) override;
+    virtual void clearDecodedPixels() override;
     virtual bool isRaster() const override { return true; }
 
-    std::shared_ptr<Texture> createTexture(const std::vector<char>& _rawTileData);
+    std::shared_ptr<Texture> createTexture(const TileID& _tileId, const RawData& _rawTileData);
 
     Raster getRaster(const TileTask& _task);
 
+    /* Decode-avoidance telemetry, summed over all RasterSources: a hit is
+     * a createTexture call served from the decoded-pixel cache, a miss is
+     * one that had to run the image decoder. */
+    static size_t decodedCacheHits();
+    static size_t decodedCacheMisses();
+
 };
 
 }
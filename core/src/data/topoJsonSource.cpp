@@ -24,7 +24,7 @@ std::shared_ptr<TileData> TopoJsonSource::parse(const TileTask& _task,
     // Parse data into a JSON document
     const char* error;
     size_t offset;
-    auto document = JsonParseBytes(task.rawTileData->data(), task.rawTileData->size(), &error, &offset);
+    auto document = JsonParseBytes(task.rawTileData.data(), task.rawTileData.size(), &error, &offset);
 
     if (error) {
         LOGE("Json parsing failed on tile [%s]: %s (%u)", task.tileId().toString().c_str(), error, offset);
@@ -0,0 +1,169 @@
+#ifdef TANGRAM_BUILD_TELEMETRY
+
+#include "buildTelemetry.h"
+
+#include "platform.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace Tangram {
+namespace BuildTelemetry {
+
+namespace {
+
+// Counters of the task running on this thread; counting is active
+// only between beginTask and endTask, so allocations made by other
+// threads or outside tile builds are not attributed.
+struct TaskCounters {
+    bool active = false;
+    size_t allocations = 0;
+    size_t allocatedBytes = 0;
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+    size_t shapingUs = 0;
+    std::chrono::steady_clock::time_point shapingStart;
+};
+
+thread_local TaskCounters t_counters;
+
+// Aggregated results of finished tasks
+std::mutex s_mutex;
+size_t s_tasks = 0;
+size_t s_sumAllocations = 0;
+size_t s_sumAllocatedBytes = 0;
+size_t s_sumPeakBytes = 0;
+size_t s_sumShapingUs = 0;
+std::string s_lastTask;
+
+// Allocation header holding the block size, so frees can be
+// subtracted from the live count. Sized to preserve the strictest
+// fundamental alignment for the returned pointer.
+constexpr size_t header_size = alignof(max_align_t);
+
+}
+
+void beginTask() {
+    t_counters = TaskCounters();
+    t_counters.active = true;
+}
+
+void endTask(const TileID& _tileId) {
+
+    auto& c = t_counters;
+    c.active = false;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_tasks++;
+    s_sumAllocations += c.allocations;
+    s_sumAllocatedBytes += c.allocatedBytes;
+    s_sumPeakBytes += c.peakBytes;
+    s_sumShapingUs += c.shapingUs;
+
+    s_lastTask = _tileId.toString()
+        + " " + std::to_string(c.allocations) + " allocs "
+        + std::to_string(c.allocatedBytes / 1024) + "kb peak "
+        + std::to_string(c.peakBytes / 1024) + "kb shaping "
+        + std::to_string(c.shapingUs / 1000) + "ms";
+
+    LOGD("build %s", s_lastTask.c_str());
+}
+
+std::string summary() {
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_tasks == 0) { return "build telemetry: no tasks"; }
+
+    return "build " + s_lastTask
+        + " | avg " + std::to_string(s_sumAllocations / s_tasks) + " allocs "
+        + std::to_string(s_sumAllocatedBytes / s_tasks / 1024) + "kb peak "
+        + std::to_string(s_sumPeakBytes / s_tasks / 1024) + "kb shaping "
+        + std::to_string(s_sumShapingUs / s_tasks / 1000) + "ms";
+}
+
+void beginFrameGuard() {
+    t_counters = TaskCounters();
+    t_counters.active = true;
+}
+
+void endFrameGuard() {
+
+    auto& c = t_counters;
+    c.active = false;
+
+    if (c.allocations == 0) { return; }
+
+#ifdef TANGRAM_FRAME_ALLOC_ASSERT
+    assert(false && "heap allocation on the frame path");
+#else
+    // Log at most once per second; a warm frame path that still
+    // allocates does so every frame
+    static std::chrono::steady_clock::time_point s_lastLog;
+    auto now = std::chrono::steady_clock::now();
+    if (now - s_lastLog > std::chrono::seconds(1)) {
+        s_lastLog = now;
+        LOGD("frame path made %d allocations (%dkb)",
+             int(c.allocations), int(c.allocatedBytes / 1024));
+    }
+#endif
+}
+
+void beginShaping() {
+    auto& c = t_counters;
+    if (c.active) {
+        c.shapingStart = std::chrono::steady_clock::now();
+    }
+}
+
+void endShaping() {
+    auto& c = t_counters;
+    if (c.active) {
+        c.shapingUs += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - c.shapingStart).count();
+    }
+}
+
+}
+}
+
+// Program-wide allocation hooks; near-zero cost on threads that are
+// not inside a tile build. Every block carries a small header with
+// its size, so deletes can maintain the live-byte high-water mark.
+void* operator new(size_t _size) {
+
+    char* block = static_cast<char*>(
+        malloc(_size + Tangram::BuildTelemetry::header_size));
+    if (!block) { throw std::bad_alloc(); }
+
+    *reinterpret_cast<size_t*>(block) = _size;
+
+    auto& c = Tangram::BuildTelemetry::t_counters;
+    if (c.active) {
+        c.allocations++;
+        c.allocatedBytes += _size;
+        c.liveBytes += _size;
+        if (c.liveBytes > c.peakBytes) { c.peakBytes = c.liveBytes; }
+    }
+
+    return block + Tangram::BuildTelemetry::header_size;
+}
+
+void operator delete(void* _ptr) noexcept {
+
+    if (!_ptr) { return; }
+
+    char* block = static_cast<char*>(_ptr) - Tangram::BuildTelemetry::header_size;
+    size_t size = *reinterpret_cast<size_t*>(block);
+
+    auto& c = Tangram::BuildTelemetry::t_counters;
+    if (c.active && c.liveBytes >= size) {
+        c.liveBytes -= size;
+    }
+
+    free(block);
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "tile/tileID.h"
+
+#include <string>
+
+namespace Tangram {
+
+/* Per-tile build telemetry, compiled in with TANGRAM_BUILD_TELEMETRY
+ * (cmake option of the same name). Between beginTask and endTask the
+ * worker thread's heap allocations are counted - covering parsing,
+ * rule evaluation and the style builders - along with the peak of
+ * transient live bytes. Results aggregate into a summary line shown
+ * on the DebugFlags::tangram_infos HUD. Without the flag every call
+ * compiles to nothing. */
+namespace BuildTelemetry {
+
+#ifdef TANGRAM_BUILD_TELEMETRY
+
+/* Starts counting allocations on the calling thread */
+void beginTask();
+
+/* Stops counting and folds the task's numbers into the summary */
+void endTask(const TileID& _tileId);
+
+/* Brackets the text shaping and layout work of the running task;
+ * the accumulated time is reported next to the allocation counts -
+ * text-heavy tiles spend more time here than tessellating */
+void beginShaping();
+void endShaping();
+
+/* One line for the debug HUD: last task and rolling averages */
+std::string summary();
+
+/* Brackets the per-frame render path on the calling thread. Any heap
+ * allocation inside the scope is counted and logged once per second -
+ * the frame path is meant to run on capacity-retaining buffers once
+ * warm. Define TANGRAM_FRAME_ALLOC_ASSERT to turn the log into an
+ * assertion for pinpointing regressions in a debugger. */
+void beginFrameGuard();
+void endFrameGuard();
+
+#else
+
+inline void beginTask() {}
+inline void endTask(const TileID& _tileId) {}
+inline void beginShaping() {}
+inline void endShaping() {}
+inline std::string summary() { return std::string(); }
+inline void beginFrameGuard() {}
+inline void endFrameGuard() {}
+
+#endif
+
+}
+
+}
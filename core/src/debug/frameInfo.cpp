@@ -9,6 +9,10 @@
 #include "view/view.h"
 #include "gl.h"
 #include "gl/error.h"
+#include "util/memoryBudget.h"
+#include "data/rasterSource.h"
+#include "debug/buildTelemetry.h"
+#include "debug/trace.h"
 
 #include <deque>
 #include <ctime>
@@ -26,6 +30,63 @@ static clock_t s_startFrameTime = 0,
     s_startUpdateTime = 0,
     s_endUpdateTime = 0;
 
+// Frame-stats collection; all scopes run on the render thread.
+static clock_t s_scopeStart[5] = { 0 };
+static clock_t s_stylePassStart = 0;
+static std::string s_stylePassName;
+static FrameStats s_buildingStats;
+static FrameStats s_lastStats;
+
+// Scope names for the trace recorder, indexed like s_scopeStart
+static const char* s_scopeNames[5] = {
+    "update", "tileUpdate", "labelUpdate", "tileUpload", "render",
+};
+
+void FrameInfo::beginScope(Scope _scope) {
+    s_scopeStart[int(_scope)] = clock();
+    Trace::begin(s_scopeNames[int(_scope)]);
+}
+
+void FrameInfo::endScope(Scope _scope) {
+    Trace::end(s_scopeNames[int(_scope)]);
+    float time = TIME_TO_MS(s_scopeStart[int(_scope)], clock());
+
+    switch (_scope) {
+        case Scope::update:
+            s_buildingStats.update = time;
+            break;
+        case Scope::tileUpdate:
+            s_buildingStats.tileUpdate = time;
+            break;
+        case Scope::labelUpdate:
+            s_buildingStats.labelUpdate = time;
+            break;
+        case Scope::tileUpload:
+            s_buildingStats.tileUpload = time;
+            break;
+        case Scope::render:
+            // The render scope closes the frame
+            s_buildingStats.render = time;
+            s_lastStats = std::move(s_buildingStats);
+            s_buildingStats = FrameStats();
+            break;
+    }
+}
+
+void FrameInfo::beginStylePass(const std::string& _name) {
+    s_stylePassName = _name;
+    s_stylePassStart = clock();
+}
+
+void FrameInfo::endStylePass() {
+    float time = TIME_TO_MS(s_stylePassStart, clock());
+    s_buildingStats.stylePasses.emplace_back(s_stylePassName, time);
+}
+
+FrameStats FrameInfo::stats() {
+    return s_lastStats;
+}
+
 void FrameInfo::beginUpdate() {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
@@ -113,6 +174,19 @@ void FrameInfo::draw(const View& _view, TileManager& _tileManager) {
             debuginfos.push_back("tile cache size:"
                                  + std::to_string(_tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
             debuginfos.push_back("tile size:" + std::to_string(memused / 1024) + "kb");
+            debuginfos.push_back("memory " + MemoryBudget::toString());
+
+            size_t decodeHits = RasterSource::decodedCacheHits();
+            size_t decodeTotal = decodeHits + RasterSource::decodedCacheMisses();
+            if (decodeTotal > 0) {
+                debuginfos.push_back("raster decode hits:" + std::to_string(decodeHits)
+                                     + "/" + std::to_string(decodeTotal) + " ("
+                                     + to_string_with_precision(100.0 * decodeHits / decodeTotal, 1)
+                                     + "%)");
+            }
+#ifdef TANGRAM_BUILD_TELEMETRY
+            debuginfos.push_back(BuildTelemetry::summary());
+#endif
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "tangram.h"
+
+#include <string>
+
 namespace Tangram {
 
 class TileManager;
@@ -7,6 +11,25 @@ class View;
 
 struct FrameInfo {
 
+    // Per-stage CPU scopes, accumulated into the FrameStats of the
+    // frame being built; Scope::render closes the frame.
+    enum class Scope {
+        update,
+        tileUpdate,
+        labelUpdate,
+        tileUpload,
+        render,
+    };
+
+    static void beginScope(Scope _scope);
+    static void endScope(Scope _scope);
+
+    static void beginStylePass(const std::string& _name);
+    static void endStylePass();
+
+    // Timings of the last completed frame, see Map::getFrameStats()
+    static FrameStats stats();
+
     static void beginUpdate();
     static void beginFrame();
 
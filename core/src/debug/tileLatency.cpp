@@ -0,0 +1,109 @@
+#include "debug/tileLatency.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace Tangram {
+namespace TileLatency {
+
+namespace {
+
+// Quarter-power-of-two buckets are ~19% wide, so reported
+// percentiles are exact to about one fifth; 64 buckets reach ~65s
+constexpr int NUM_BUCKETS = 64;
+
+struct Histogram {
+    std::atomic<uint32_t> buckets[NUM_BUCKETS] = {};
+};
+
+Histogram s_fetch;
+Histogram s_build;
+Histogram s_upload;
+Histogram s_total;
+
+int bucketIndex(float _ms) {
+    if (_ms <= 0.f) { return 0; }
+    int i = int(std::log2(_ms + 1.f) * 4.f);
+    return i >= NUM_BUCKETS ? NUM_BUCKETS - 1 : i;
+}
+
+// Lower edge of the bucket, so percentiles never overstate
+float bucketValue(int _index) {
+    return std::exp2(_index / 4.f) - 1.f;
+}
+
+void add(Histogram& _histogram, Clock::time_point _from, Clock::time_point _to) {
+    float ms = std::chrono::duration<float, std::milli>(_to - _from).count();
+    _histogram.buckets[bucketIndex(ms)]++;
+}
+
+TileLatencyStats::Stage percentiles(const Histogram& _histogram) {
+    uint32_t counts[NUM_BUCKETS];
+    uint64_t total = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        counts[i] = _histogram.buckets[i].load();
+        total += counts[i];
+    }
+
+    TileLatencyStats::Stage stage;
+    if (total == 0) { return stage; }
+
+    auto valueAt = [&](double _fraction) {
+        uint64_t target = uint64_t(_fraction * (total - 1));
+        uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            seen += counts[i];
+            if (seen > target) { return bucketValue(i); }
+        }
+        return bucketValue(NUM_BUCKETS - 1);
+    };
+
+    stage.p50 = valueAt(0.50);
+    stage.p90 = valueAt(0.90);
+    stage.p99 = valueAt(0.99);
+    return stage;
+}
+
+}
+
+void record(Clock::time_point _start, Clock::time_point _data,
+            Clock::time_point _built, Clock::time_point _staged) {
+
+    // Incomplete traces carry default stamps; tiles revived from the
+    // cache or published by the partial build phase are not re-counted
+    if (_start == Clock::time_point() || _data == Clock::time_point() ||
+        _built == Clock::time_point()) {
+        return;
+    }
+
+    add(s_fetch, _start, _data);
+    add(s_build, _data, _built);
+    add(s_upload, _built, _staged);
+    add(s_total, _start, _staged);
+}
+
+TileLatencyStats stats() {
+    TileLatencyStats stats;
+    stats.fetch = percentiles(s_fetch);
+    stats.build = percentiles(s_build);
+    stats.upload = percentiles(s_upload);
+    stats.total = percentiles(s_total);
+
+    uint64_t samples = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        samples += s_total.buckets[i].load();
+    }
+    stats.samples = uint32_t(samples);
+    return stats;
+}
+
+void clear() {
+    for (auto* histogram : { &s_fetch, &s_build, &s_upload, &s_total }) {
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            histogram->buckets[i] = 0;
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "tangram.h"
+
+#include <chrono>
+
+namespace Tangram {
+
+/* End-to-end tile latency tracing. Tile tasks stamp the pipeline
+ * stages they pass - load issued, raw bytes available, worker build
+ * finished - and the stamps travel with the built Tile until its
+ * meshes are first staged for drawing, where the stage durations fold
+ * into histograms. Percentiles are queryable at any time through
+ * Map::getTileLatencyStats(), attributing slow tiles to network,
+ * build or upload. Bucket counters are atomic; stamping and recording
+ * need no locks. */
+namespace TileLatency {
+
+using Clock = std::chrono::steady_clock;
+
+/* Folds one tile's stage stamps into the histograms; called on the GL
+ * thread when the tile's meshes are first staged. Traces with unset
+ * stamps (e.g. client-generated tiles) are skipped. */
+void record(Clock::time_point _start, Clock::time_point _data,
+            Clock::time_point _built, Clock::time_point _staged);
+
+/* Percentiles over everything recorded so far */
+TileLatencyStats stats();
+
+/* Drops all recorded samples */
+void clear();
+
+}
+}
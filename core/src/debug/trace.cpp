@@ -0,0 +1,102 @@
+#include "debug/trace.h"
+
+#include "platform.h"
+#include "tangram.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+namespace Tangram {
+namespace Trace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    int64_t timeUs;
+    uint32_t tid;
+    char phase; // 'B' or 'E'
+};
+
+// 16k events - with begin/end pairs around tile stages and frame
+// passes this covers well over a minute of heavy tile traffic
+const size_t RING_SIZE = 1 << 14;
+
+Event s_ring[RING_SIZE];
+
+// Total number of events ever written; the slot of event n is
+// n % RING_SIZE. fetch_add hands each writer a unique slot, so
+// recording needs no lock.
+std::atomic<uint64_t> s_cursor{0};
+
+int64_t timeNowUs() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+uint32_t threadId() {
+    static thread_local const uint32_t id =
+        uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    return id;
+}
+
+void record(const char* _name, char _phase) {
+    uint64_t slot = s_cursor.fetch_add(1);
+    s_ring[slot % RING_SIZE] = { _name, timeNowUs(), threadId(), _phase };
+}
+
+} // namespace
+
+void begin(const char* _name) {
+    if (!getDebugFlag(DebugFlags::tracing)) { return; }
+    record(_name, 'B');
+}
+
+void end(const char* _name) {
+    if (!getDebugFlag(DebugFlags::tracing)) { return; }
+    record(_name, 'E');
+}
+
+void clear() {
+    s_cursor = 0;
+}
+
+bool dump(const std::string& _path) {
+
+    FILE* file = fopen(_path.c_str(), "w");
+    if (!file) {
+        LOGE("Could not open trace file %s", _path.c_str());
+        return false;
+    }
+
+    // Writers may still append while dumping; the cursor is read once
+    // and the ring may lose its oldest events to them. For a debug
+    // capture that is acceptable - viewers skip unmatched pairs.
+    uint64_t last = s_cursor.load();
+    uint64_t first = last > RING_SIZE ? last - RING_SIZE : 0;
+
+    fputs("{\"traceEvents\":[", file);
+
+    for (uint64_t n = first; n < last; n++) {
+        const Event& event = s_ring[n % RING_SIZE];
+
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lld,"
+                "\"pid\":1,\"tid\":%u}",
+                n == first ? "" : ",",
+                event.name, event.phase,
+                (long long)event.timeUs, event.tid);
+    }
+
+    fputs("]}\n", file);
+    fclose(file);
+
+    LOG("Wrote %d trace events to %s", int(last - first), _path.c_str());
+    return true;
+}
+
+}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+namespace Tangram {
+
+/* Chrome-tracing event recorder, toggled at runtime with
+ * DebugFlags::tracing. Begin/end pairs from any thread land in a
+ * fixed-size in-memory ring that overwrites its oldest entries, so
+ * recording is cheap enough to stay compiled in and enabled in the
+ * field; while the flag is off every call is a flag test. dump()
+ * writes the ring as chrome://tracing JSON ('Trace Event Format')
+ * loadable in chrome://tracing or Perfetto. */
+namespace Trace {
+
+/* Record the start of a named scope on the calling thread.
+ * _name must outlive the recording - pass a string literal. */
+void begin(const char* _name);
+
+/* Record the end of the matching begin() on the calling thread */
+void end(const char* _name);
+
+/* Write all recorded events to _path as chrome://tracing JSON;
+ * returns false when the file cannot be written */
+bool dump(const std::string& _path);
+
+/* Drop all recorded events */
+void clear();
+
+/* Scoped begin/end pair */
+struct Scope {
+    explicit Scope(const char* _name) : name(_name) { begin(name); }
+    ~Scope() { end(name); }
+    const char* name;
+};
+
+}
+}
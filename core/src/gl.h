@@ -270,6 +270,21 @@ typedef char            GLchar;
 #define GL_MAX_TEXTURE_SIZE             0x0D33
 #define GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS 0x8B4D
 
+/* Buffer mapping access bits */
+#define GL_MAP_WRITE_BIT                0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT     0x0004
+#define GL_MAP_INVALIDATE_BUFFER_BIT    0x0008
+#define GL_MAP_UNSYNCHRONIZED_BIT       0x0020
+
+/* Framebuffers */
+#define GL_FRAMEBUFFER                  0x8D40
+#define GL_RENDERBUFFER                 0x8D41
+#define GL_COLOR_ATTACHMENT0            0x8CE0
+#define GL_DEPTH_ATTACHMENT             0x8D00
+#define GL_DEPTH_COMPONENT16            0x81A5
+#define GL_FRAMEBUFFER_COMPLETE         0x8CD5
+#define GL_FRAMEBUFFER_BINDING          0x8CA6
+
 #ifdef PLATFORM_ANDROID
 #define GL_APICALL  __attribute__((visibility("default")))
 #define GL_APIENTRY
@@ -356,6 +371,12 @@ extern "C" {
                           GLenum format, GLenum type,
                           const GLvoid *pixels);
 
+    GL_APICALL void GL_APIENTRY glCompressedTexImage2D(GLenum target, GLint level,
+                          GLenum internalformat,
+                          GLsizei width, GLsizei height,
+                          GLint border, GLsizei imageSize,
+                          const GLvoid *data);
+
     GL_APICALL void GL_APIENTRY glGenerateMipmap(GLenum target);
 
 
@@ -395,11 +416,55 @@ extern "C" {
     GL_APICALL void *GL_APIENTRY glMapBuffer(GLenum target, GLenum access);
     GL_APICALL GLboolean GL_APIENTRY glUnmapBuffer(GLenum target);
 
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_RPI)
+    // Resolved at runtime where the ES2 libraries may not export it,
+    // see initGLExtensions() in the platform implementations
+    typedef void* (GL_APIENTRY *PFNGLMAPBUFFERRANGEEXTPROC) (GLenum target, GLintptr offset,
+                            GLsizeiptr length, GLbitfield access);
+    extern PFNGLMAPBUFFERRANGEEXTPROC glMapBufferRangeEXT;
+    #define glMapBufferRange glMapBufferRangeEXT
+#elif defined(PLATFORM_IOS)
+    // The OpenGLES framework exports the EXT entry point directly
+    GL_APICALL void *GL_APIENTRY glMapBufferRangeEXT(GLenum target, GLintptr offset,
+                            GLsizeiptr length, GLbitfield access);
+    #define glMapBufferRange glMapBufferRangeEXT
+#else
+    GL_APICALL void *GL_APIENTRY glMapBufferRange(GLenum target, GLintptr offset,
+                            GLsizeiptr length, GLbitfield access);
+#endif
+
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_RPI)
+    // EXT_discard_framebuffer, or glInvalidateFramebuffer on ES3;
+    // resolved at runtime like glMapBufferRange above
+    typedef void (GL_APIENTRY *PFNGLDISCARDFRAMEBUFFEREXTPROC) (GLenum target,
+                            GLsizei numAttachments, const GLenum *attachments);
+    extern PFNGLDISCARDFRAMEBUFFEREXTPROC glDiscardFramebufferEXT;
+#elif defined(PLATFORM_IOS)
+    // The OpenGLES framework exports the EXT entry point directly
+    GL_APICALL void GL_APIENTRY glDiscardFramebufferEXT(GLenum target,
+                            GLsizei numAttachments, const GLenum *attachments);
+#endif
+
     GL_APICALL void GL_APIENTRY glFinish(void);
 
     GL_APICALL void GL_APIENTRY glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height,
                             GLenum format, GLenum type, GLvoid* pixels);
 
+    // Framebuffers
+    GL_APICALL void GL_APIENTRY glGenFramebuffers(GLsizei n, GLuint *framebuffers);
+    GL_APICALL void GL_APIENTRY glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers);
+    GL_APICALL void GL_APIENTRY glBindFramebuffer(GLenum target, GLuint framebuffer);
+    GL_APICALL void GL_APIENTRY glFramebufferTexture2D(GLenum target, GLenum attachment,
+                            GLenum textarget, GLuint texture, GLint level);
+    GL_APICALL void GL_APIENTRY glFramebufferRenderbuffer(GLenum target, GLenum attachment,
+                            GLenum renderbuffertarget, GLuint renderbuffer);
+    GL_APICALL GLenum GL_APIENTRY glCheckFramebufferStatus(GLenum target);
+    GL_APICALL void GL_APIENTRY glGenRenderbuffers(GLsizei n, GLuint *renderbuffers);
+    GL_APICALL void GL_APIENTRY glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers);
+    GL_APICALL void GL_APIENTRY glBindRenderbuffer(GLenum target, GLuint renderbuffer);
+    GL_APICALL void GL_APIENTRY glRenderbufferStorage(GLenum target, GLenum internalformat,
+                            GLsizei width, GLsizei height);
+
     // VAO
 #ifdef PLATFORM_ANDROID
     typedef void (GL_APIENTRYP PFNGLBINDVERTEXARRAYOESPROC) (GLuint array);
@@ -4,6 +4,7 @@
 #include "gl/renderState.h"
 #include "gl/shaderProgram.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <atomic>
@@ -39,6 +40,12 @@ public:
 
     ~DynamicQuadMesh() override {
         QuadIndices::unref();
+
+        // The base destructor returns the buffer to the pool sized by
+        // the vertex count; report the actual grown store size instead.
+        if (m_glCapacityBytes > 0) {
+            m_nVertices = m_glCapacityBytes / m_vertexLayout->getStride();
+        }
     }
 
     bool draw(ShaderProgram& _shader) override;
@@ -71,6 +78,14 @@ public:
 private:
 
     std::vector<T> m_vertices;
+
+    // Mirror of the vertex data held by the GL store, for diffing
+    // against the re-pushed quads of the next frame
+    std::vector<T> m_lastVertices;
+
+    // Allocated size of the GL data store; grows by doubling and is
+    // never shrunk while the mesh lives
+    size_t m_glCapacityBytes = 0;
 };
 
 template<class T>
@@ -80,12 +95,55 @@ void DynamicQuadMesh<T>::upload() {
 
     MeshBase::checkValidity();
 
-    // Generate vertex buffer, if needed
+    size_t stride = m_vertexLayout->getStride();
+    size_t bytes = m_nVertices * stride;
+
     if (m_glVertexBuffer == 0) {
-        GL_CHECK(glGenBuffers(1, &m_glVertexBuffer));
+        m_glVertexBuffer = RenderState::acquireBuffer(bytes);
+        m_glCapacityBytes = 0;
     }
 
-    MeshBase::subDataUpload(reinterpret_cast<GLbyte*>(m_vertices.data()));
+    RenderState::vertexBuffer(m_glVertexBuffer);
+
+    auto* data = reinterpret_cast<const GLbyte*>(m_vertices.data());
+
+    if (bytes > m_glCapacityBytes) {
+        // Grow the data store by doubling, so a mesh gaining a few
+        // quads per frame re-specifies its buffer O(log n) times
+        // instead of every frame
+        size_t capacity = m_glCapacityBytes > 0 ? m_glCapacityBytes : bytes;
+        while (capacity < bytes) { capacity *= 2; }
+
+        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, capacity, NULL, m_hint));
+        GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data));
+
+        m_glCapacityBytes = capacity;
+        m_lastVertices = m_vertices;
+
+    } else {
+        // The store already fits; upload only the byte range that
+        // changed since the last frame. Styles clear and re-push all
+        // quads each frame, so when one label moves or fades most of
+        // the buffer is identical to what the driver already holds.
+        auto* last = reinterpret_cast<const GLbyte*>(m_lastVertices.data());
+        size_t common = std::min(bytes, m_lastVertices.size() * stride);
+
+        size_t first = 0;
+        while (first < common && data[first] == last[first]) { first++; }
+
+        if (first < bytes) {
+            size_t end = bytes;
+            // The tail can only be trimmed where the mirror has data
+            // to compare against
+            if (bytes == common) {
+                while (end > first && data[end - 1] == last[end - 1]) { end--; }
+            }
+
+            GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, GLintptr(first),
+                                     GLsizei(end - first), data + first));
+            m_lastVertices = m_vertices;
+        }
+    }
 
     m_isUploaded = true;
 }
@@ -1,7 +1,49 @@
 #include "error.h"
 
+#include <array>
+#include <cstdio>
+#include <mutex>
+
 namespace Tangram {
 
+namespace {
+
+#ifndef GL_DEBUG_OUTPUT
+#define GL_DEBUG_OUTPUT 0x92E0
+#endif
+
+// Ring buffer for messages reported by the KHR_debug callback. The
+// callback may run on a driver thread, so access is serialized; the
+// GL pipeline itself is never queried.
+constexpr size_t captureRingSize = 64;
+
+std::mutex s_captureMutex;
+std::array<std::string, captureRingSize> s_captureRing;
+size_t s_captureNext = 0;
+size_t s_captureCount = 0;
+
+using DebugCallbackFn = void (*)(GLenum _source, GLenum _type, GLuint _id,
+                                 GLenum _severity, GLsizei _length,
+                                 const GLchar* _message, const void* _userParam);
+
+using DebugMessageCallbackFn = void (*)(DebugCallbackFn _callback, const void* _userParam);
+
+void debugMessageCallback(GLenum _source, GLenum _type, GLuint _id, GLenum _severity,
+                          GLsizei _length, const GLchar* _message, const void* _userParam) {
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "source 0x%x type 0x%x id %u severity 0x%x: %.*s",
+             _source, _type, _id, _severity,
+             _length < 0 ? int(sizeof(buffer)) : int(_length), _message);
+
+    std::lock_guard<std::mutex> lock(s_captureMutex);
+    s_captureRing[s_captureNext] = buffer;
+    s_captureNext = (s_captureNext + 1) % captureRingSize;
+    if (s_captureCount < captureRingSize) { s_captureCount++; }
+}
+
+}
+
 std::unordered_map<GLenum, std::string> Error::s_GlErrorCodesToStrings = {
         {GL_NO_ERROR, "GL_NO_ERROR"},
         {GL_INVALID_ENUM, "GL_INVALID_ENUM"},
@@ -13,6 +55,7 @@ std::unordered_map<GLenum, std::string> Error::s_GlErrorCodesToStrings = {
 
 bool Error::hadGlError(const std::string& _locationTag) {
 
+#if defined(DEBUG) || defined(TANGRAM_GL_CHECKS)
     GLenum error = glGetError();
 
     if (error != GL_NO_ERROR) {
@@ -23,6 +66,7 @@ bool Error::hadGlError(const std::string& _locationTag) {
 
         return true;
     }
+#endif
 
     return false;
 }
@@ -41,4 +85,31 @@ void Error::glError(const char* stmt, const char* fname, int line) {
     }
 }
 
+void Error::initDebugCapture(void* _glDebugMessageCallback) {
+
+    if (!_glDebugMessageCallback) { return; }
+
+    auto install = reinterpret_cast<DebugMessageCallbackFn>(_glDebugMessageCallback);
+    install(&debugMessageCallback, nullptr);
+
+    // In debug contexts output is already on; enabling is harmless and
+    // covers contexts that expose the extension without it
+    glEnable(GL_DEBUG_OUTPUT);
+}
+
+std::vector<std::string> Error::capturedMessages() {
+
+    std::lock_guard<std::mutex> lock(s_captureMutex);
+
+    std::vector<std::string> messages;
+    messages.reserve(s_captureCount);
+
+    size_t start = (s_captureNext + captureRingSize - s_captureCount) % captureRingSize;
+    for (size_t i = 0; i < s_captureCount; i++) {
+        messages.push_back(s_captureRing[(start + i) % captureRingSize]);
+    }
+
+    return messages;
+}
+
 }
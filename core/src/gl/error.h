@@ -3,6 +3,7 @@
 #include "platform.h"
 #include "gl.h"
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 namespace Tangram {
@@ -14,19 +15,37 @@ public:
     /*
      * hadGlError - checks OpenGL for any recorded errors. If no errors are found, it returns false.
      * If an error is found, it prints the GL error enum combined with the location tag passed in,
-     * then returns true. This is intended to be used infrequently, in places where errors are likely or known.
+     * then returns true. This is intended to be used infrequently, in places where errors are likely
+     * or known. Compiled to a no-op when GL checking is disabled.
      */
     static bool hadGlError(const std::string& _locationTag);
 
     static void glError(const char* stmt, const char* fname, int line);
 
+    /* Installs a KHR_debug message callback through @_glDebugMessageCallback,
+     * the platform-resolved glDebugMessageCallbackKHR (or equivalent) entry
+     * point - core cannot link the extension portably. Driver-reported
+     * errors are then recorded into a small ring buffer as they happen,
+     * with no glGetError round-trip on any call. Passing null is a no-op,
+     * so platforms simply forward whatever the proc lookup returned. */
+    static void initDebugCapture(void* _glDebugMessageCallback);
+
+    /* Messages recorded by the debug callback, oldest first. The ring
+     * keeps the most recent messages; older ones are overwritten. */
+    static std::vector<std::string> capturedMessages();
+
 private:
 
     static std::unordered_map<GLenum, std::string> s_GlErrorCodesToStrings;
 
 };
 
-#ifdef DEBUG
+/* Per-call GL error checking is compiled in for debug builds, or
+ * explicitly with the TANGRAM_GL_CHECKS cmake option. glGetError forces
+ * pipeline synchronization on some drivers, so other builds compile the
+ * check out entirely; use the KHR_debug capture path above when errors
+ * must be diagnosed in release builds. */
+#if defined(DEBUG) || defined(TANGRAM_GL_CHECKS)
 #define GL_CHECK(STMT) do { STMT; Tangram::Error::glError(#STMT, __FILE__, __LINE__); } while (0)
 #else
 #define GL_CHECK(STMT) STMT;
@@ -0,0 +1,85 @@
+#include "frameBuffer.h"
+
+#include "gl/error.h"
+#include "platform.h"
+
+namespace Tangram {
+
+FrameBuffer::FrameBuffer(int _width, int _height)
+    : m_width(_width),
+      m_height(_height) {}
+
+FrameBuffer::~FrameBuffer() {
+
+    // FrameBuffers are owned and destroyed on the render thread, so the
+    // GL objects are deleted directly instead of through a deletion queue
+    if (m_glFrameBufferHandle) {
+        GL_CHECK(glDeleteFramebuffers(1, &m_glFrameBufferHandle));
+    }
+    if (m_glColorTextureHandle) {
+        GL_CHECK(glDeleteTextures(1, &m_glColorTextureHandle));
+    }
+    if (m_glDepthRenderBufferHandle) {
+        GL_CHECK(glDeleteRenderbuffers(1, &m_glDepthRenderBufferHandle));
+    }
+}
+
+void FrameBuffer::init() {
+
+    m_initialized = true;
+
+    GL_CHECK(glGenTextures(1, &m_glColorTextureHandle));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_glColorTextureHandle));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0,
+                          GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+    GL_CHECK(glGenRenderbuffers(1, &m_glDepthRenderBufferHandle));
+    GL_CHECK(glBindRenderbuffer(GL_RENDERBUFFER, m_glDepthRenderBufferHandle));
+    GL_CHECK(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16,
+                                   m_width, m_height));
+
+    GL_CHECK(glGenFramebuffers(1, &m_glFrameBufferHandle));
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_glFrameBufferHandle));
+    GL_CHECK(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                    GL_TEXTURE_2D, m_glColorTextureHandle, 0));
+    GL_CHECK(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                                       GL_RENDERBUFFER, m_glDepthRenderBufferHandle));
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    m_valid = (status == GL_FRAMEBUFFER_COMPLETE);
+
+    if (!m_valid) {
+        LOGE("Framebuffer incomplete: %x", status);
+    }
+}
+
+bool FrameBuffer::bind() {
+
+    GL_CHECK(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_previousFrameBuffer));
+
+    if (!m_initialized) {
+        init();
+    }
+
+    if (!m_valid) { return false; }
+
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_glFrameBufferHandle));
+    GL_CHECK(glViewport(0, 0, m_width, m_height));
+
+    return true;
+}
+
+void FrameBuffer::unbind() {
+
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_previousFrameBuffer));
+}
+
+void FrameBuffer::readPixels(unsigned int* _data) const {
+
+    GL_CHECK(glReadPixels(0, 0, m_width, m_height, GL_RGBA,
+                          GL_UNSIGNED_BYTE, (GLvoid*)_data));
+}
+
+}
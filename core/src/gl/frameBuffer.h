@@ -0,0 +1,57 @@
+#pragma once
+
+#include "gl.h"
+
+namespace Tangram {
+
+/* Offscreen render target backed by a framebuffer object
+ *
+ * Color is rendered into an RGBA texture and depth into a renderbuffer.
+ * GL resources are created lazily on the first bind(), so instances may
+ * be constructed before a context exists. This is the render target for
+ * headless use, where no window-owned default framebuffer is available.
+ */
+class FrameBuffer {
+
+public:
+
+    FrameBuffer(int _width, int _height);
+    ~FrameBuffer();
+
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    /* Bind as the current render target and set the viewport; the
+     * framebuffer bound before is remembered for unbind(). Returns
+     * false when the target could not be completed */
+    bool bind();
+
+    /* Restore the render target that was bound before bind() */
+    void unbind();
+
+    /* Read the color attachment back as 32-bit RGBA pixels into _data,
+     * which must hold width * height entries; the target must be bound */
+    void readPixels(unsigned int* _data) const;
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+
+    void init();
+
+    GLuint m_glFrameBufferHandle = 0;
+    GLuint m_glColorTextureHandle = 0;
+    GLuint m_glDepthRenderBufferHandle = 0;
+
+    GLint m_previousFrameBuffer = 0;
+
+    int m_width;
+    int m_height;
+
+    bool m_initialized = false;
+    bool m_valid = false;
+
+};
+
+}
@@ -12,8 +12,14 @@ namespace Tangram {
 namespace Hardware {
 
 bool supportsMapBuffer = false;
+bool supportsMapBufferRange = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
+bool supportsDiscardFramebuffer = false;
+bool prefersBufferRotation = false;
+bool supportsGlyphGpuSdf = false;
+bool supportsTextureETC2 = false;
+bool supportsTextureASTC = false;
 
 uint32_t maxTextureSize = 0;
 uint32_t maxCombinedTextureUnits = 0;
@@ -51,14 +57,38 @@ void loadExtensions() {
     }
 
     supportsMapBuffer = DESKTOP_GL || isAvailable("mapbuffer");
-    supportsVAOs = isAvailable("vertex_array_object");
+    supportsVAOs = DESKTOP_GL || isAvailable("vertex_array_object");
     supportsTextureNPOT = isAvailable("texture_non_power_of_two");
 
-    LOG("Driver supports map buffer: %d", supportsMapBuffer);
-    LOG("Driver supports vaos: %d", supportsVAOs);
+    // ETC2 is mandatory in ES3 and in desktop GL with ES3 compatibility;
+    // ASTC is extension-only everywhere
+    const char* version = (const char*)glGetString(GL_VERSION);
+    bool es3 = version && strstr(version, "OpenGL ES 3") != nullptr;
+    supportsTextureETC2 = es3 ||
+                          isAvailable("compressed_ETC2") ||
+                          isAvailable("ES3_compatibility");
+    supportsTextureASTC = isAvailable("texture_compression_astc");
 
     // find extension symbols if needed
     initGLExtensions();
+
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_RPI)
+    // The entry point is resolved at runtime and missing on ES2-only drivers
+    supportsMapBufferRange = (glMapBufferRange != nullptr);
+    supportsDiscardFramebuffer = (glDiscardFramebufferEXT != nullptr);
+#elif defined(PLATFORM_IOS)
+    supportsMapBufferRange = isAvailable("map_buffer_range");
+    supportsDiscardFramebuffer = isAvailable("discard_framebuffer");
+#else
+    supportsMapBufferRange = DESKTOP_GL;
+#endif
+
+    LOG("Driver supports map buffer: %d", supportsMapBuffer);
+    LOG("Driver supports map buffer range: %d", supportsMapBufferRange);
+    LOG("Driver supports vaos: %d", supportsVAOs);
+    LOG("Driver supports discard framebuffer: %d", supportsDiscardFramebuffer);
+    LOG("Driver supports ETC2 textures: %d", supportsTextureETC2);
+    LOG("Driver supports ASTC textures: %d", supportsTextureASTC);
 }
 
 void loadCapabilities() {
@@ -69,8 +99,31 @@ void loadCapabilities() {
     GL_CHECK(glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &val));
     maxCombinedTextureUnits = val;
 
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    if (renderer) {
+        // All of these GPU families are tile based renderers
+        static const char* tilers[] = { "Mali", "Adreno", "PowerVR", "Vivante", "VideoCore", "Apple" };
+        for (auto* name : tilers) {
+            if (strstr(renderer, name)) {
+                prefersBufferRotation = true;
+                break;
+            }
+        }
+    }
+
+    // The pass itself only needs ES2-level framebuffer objects, but
+    // older ES2 drivers are where RGBA FBO rendering and readback are
+    // least dependable, so the GPU glyph path is gated to ES3-class
+    // and desktop contexts and everything else keeps the CPU transform
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (version) {
+        supportsGlyphGpuSdf = strstr(version, "OpenGL ES") == nullptr ||
+                              strstr(version, "OpenGL ES 3") != nullptr;
+    }
+
     LOG("Hardware max texture size %d", maxTextureSize);
     LOG("Hardware max combined texture units %d", maxCombinedTextureUnits);
+    LOG("Hardware prefers buffer rotation: %d", prefersBufferRotation);
 }
 
 }
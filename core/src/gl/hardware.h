@@ -6,8 +6,29 @@ namespace Tangram {
 namespace Hardware {
 
 extern bool supportsMapBuffer;
+// glMapBufferRange with invalidate/unsynchronized access bits; lets
+// uploads write straight into driver memory without an extra copy
+extern bool supportsMapBufferRange;
 extern bool supportsVAOs;
 extern bool supportsTextureNPOT;
+// glDiscardFramebufferEXT/glInvalidateFramebuffer; lets tiling GPUs
+// drop the depth store at the end of the frame instead of resolving
+// it to memory
+extern bool supportsDiscardFramebuffer;
+// True on tiling GPUs, where re-specifying a buffer the previous frame
+// still references makes the driver ghost the store or stall; dynamic
+// meshes then rotate between buffer objects instead of orphaning
+extern bool prefersBufferRotation;
+// Whether glyph distance fields are generated with a render-to-texture
+// jump-flood pass instead of the CPU transform; enabled on ES3-class
+// and desktop contexts, where the passes and the region readback are
+// reliably cheap. See GlyphSdfPass.
+extern bool supportsGlyphGpuSdf;
+// Compressed texture formats the driver samples directly; raster
+// sources delivering pre-compressed tile payloads upload them with
+// glCompressedTexImage2D and skip the CPU image decode entirely
+extern bool supportsTextureETC2;
+extern bool supportsTextureASTC;
 extern uint32_t maxTextureSize;
 extern uint32_t maxCombinedTextureUnits;
 
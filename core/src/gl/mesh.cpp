@@ -4,6 +4,8 @@
 #include "hardware.h"
 #include "platform.h"
 
+#include <utility>
+
 namespace Tangram {
 
 
@@ -42,19 +44,27 @@ MeshBase::~MeshBase() {
             if (RenderState::vertexBuffer.compare(m_glVertexBuffer)) {
                 RenderState::vertexBuffer.init(0, false);
             }
-            GL_CHECK(glDeleteBuffers(1, &m_glVertexBuffer));
+            size_t vertexBytes = m_nVertices * (m_vertexLayout ? m_vertexLayout->getStride() : 0);
+            RenderState::releaseBuffer(m_glVertexBuffer, vertexBytes);
+        }
+        if (m_glAltVertexBuffer) {
+            if (RenderState::vertexBuffer.compare(m_glAltVertexBuffer)) {
+                RenderState::vertexBuffer.init(0, false);
+            }
+            size_t vertexBytes = m_nVertices * (m_vertexLayout ? m_vertexLayout->getStride() : 0);
+            RenderState::releaseBuffer(m_glAltVertexBuffer, vertexBytes);
         }
         if (m_glIndexBuffer) {
             if (RenderState::indexBuffer.compare(m_glIndexBuffer)) {
                 RenderState::indexBuffer.init(0, false);
             }
-            GL_CHECK(glDeleteBuffers(1, &m_glIndexBuffer));
+            RenderState::releaseBuffer(m_glIndexBuffer, m_nIndices * sizeof(GLushort));
         }
     } else {
         if (m_vaos) { m_vaos->discard(); }
     }
 
-    if (m_glVertexData) {
+    if (m_glVertexData && m_ownsVertexData) {
         delete[] m_glVertexData;
     }
 
@@ -99,47 +109,103 @@ void MeshBase::subDataUpload(GLbyte* _data) {
 
     long vertexBytes = m_nVertices * m_vertexLayout->getStride();
 
-    // invalidate/orphane the data store on the driver
-    GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertexBytes, NULL, m_hint));
+    // When only a small range of the buffer changed, upload just that
+    // range without orphaning - re-specifying the whole store for a
+    // few dirty vertices is what makes many small label updates
+    // expensive on mobile drivers. Full refreshes (explicit _data) or
+    // large dirty ranges keep the orphaning path so the driver never
+    // has to stall on a buffer still in use by the previous frame.
+    if (_data == nullptr && m_dirtySize > 0 && m_dirtySize < vertexBytes / 2) {
 
-    if (Hardware::supportsMapBuffer) {
-        GLvoid* dataStore = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        GL_CHECK();
+        if (Hardware::supportsMapBufferRange) {
+            // Invalidating the range lets the driver hand out fresh
+            // memory instead of synchronizing with in-flight draws
+            GLvoid* dataStore = glMapBufferRange(GL_ARRAY_BUFFER, m_dirtyOffset, m_dirtySize,
+                                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+            GL_CHECK();
 
-        // write memory client side
-        std::memcpy(dataStore, data, vertexBytes);
+            std::memcpy(dataStore, m_glVertexData + m_dirtyOffset, m_dirtySize);
 
-        GL_CHECK(glUnmapBuffer(GL_ARRAY_BUFFER));
+            GL_CHECK(glUnmapBuffer(GL_ARRAY_BUFFER));
+        } else {
+            GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, m_dirtyOffset, m_dirtySize,
+                                     m_glVertexData + m_dirtyOffset));
+        }
     } else {
 
-        // if this buffer is still used by gpu on current frame this call will not wait
-        // for the frame to finish using the vbo but "directly" send command to upload the data
-        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertexBytes, data, m_hint));
+        if (Hardware::prefersBufferRotation) {
+            // Tiler GPUs ghost or stall when a store still referenced
+            // by the previous frame is re-specified; rotate between two
+            // buffer objects so the one written is no longer in flight
+            std::swap(m_glVertexBuffer, m_glAltVertexBuffer);
+            if (m_glVertexBuffer == 0) {
+                m_glVertexBuffer = RenderState::acquireBuffer(vertexBytes);
+            }
+            RenderState::vertexBuffer(m_glVertexBuffer);
+
+            if (m_vaos) {
+                // The vao captured the other buffer binding
+                m_vaos->discard();
+                m_vaos.reset();
+            }
+        }
+
+        // invalidate/orphane the data store on the driver
+        GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertexBytes, NULL, m_hint));
+
+        if (Hardware::supportsMapBufferRange) {
+            // The store was just re-specified, so writing unsynchronized
+            // is safe and skips any driver-side locking
+            GLvoid* dataStore = glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexBytes,
+                                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT |
+                                                 GL_MAP_UNSYNCHRONIZED_BIT);
+            GL_CHECK();
+
+            // write memory client side
+            std::memcpy(dataStore, data, vertexBytes);
+
+            GL_CHECK(glUnmapBuffer(GL_ARRAY_BUFFER));
+        } else if (Hardware::supportsMapBuffer) {
+            GLvoid* dataStore = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+            GL_CHECK();
+
+            // write memory client side
+            std::memcpy(dataStore, data, vertexBytes);
+
+            GL_CHECK(glUnmapBuffer(GL_ARRAY_BUFFER));
+        } else {
+
+            // if this buffer is still used by gpu on current frame this call will not wait
+            // for the frame to finish using the vbo but "directly" send command to upload the data
+            GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertexBytes, data, m_hint));
+        }
     }
 
     m_dirty = false;
+    m_dirtySize = 0;
+    m_dirtyOffset = 0;
 }
 
 void MeshBase::upload() {
 
-    // Generate vertex buffer, if needed
-    if (m_glVertexBuffer == 0) {
-        GL_CHECK(glGenBuffers(1, &m_glVertexBuffer));
-    }
-
     // Buffer vertex data
     int vertexBytes = m_nVertices * m_vertexLayout->getStride();
 
+    // Get a vertex buffer, if needed
+    if (m_glVertexBuffer == 0) {
+        m_glVertexBuffer = RenderState::acquireBuffer(vertexBytes);
+    }
+
     RenderState::vertexBuffer(m_glVertexBuffer);
     GL_CHECK(glBufferData(GL_ARRAY_BUFFER, vertexBytes, m_glVertexData, m_hint));
 
-    delete[] m_glVertexData;
+    if (m_ownsVertexData) { delete[] m_glVertexData; }
     m_glVertexData = nullptr;
 
     if (m_glIndexData) {
 
         if (m_glIndexBuffer == 0) {
-            GL_CHECK(glGenBuffers(1, &m_glIndexBuffer));
+            m_glIndexBuffer = RenderState::acquireBuffer(m_nIndices * sizeof(GLushort));
         }
 
         // Buffer element index data
@@ -231,6 +297,7 @@ bool MeshBase::checkValidity() {
     if (!RenderState::isValidGeneration(m_generation)) {
         m_isUploaded = false;
         m_glVertexBuffer = 0;
+        m_glAltVertexBuffer = 0;
         m_glIndexBuffer = 0;
         m_vaos.reset();
 
@@ -246,6 +313,26 @@ size_t MeshBase::bufferSize() const {
     return m_nVertices * m_vertexLayout->getStride() + m_nIndices * sizeof(GLushort);
 }
 
+size_t MeshBase::contentHash() const {
+
+    // FNV-1a over the compiled buffer bytes
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&](const GLbyte* _bytes, size_t _size) {
+        for (size_t i = 0; i < _size; i++) {
+            hash = (hash ^ uint8_t(_bytes[i])) * 1099511628211ULL;
+        }
+    };
+
+    if (m_glVertexData) {
+        mix(m_glVertexData, m_nVertices * m_vertexLayout->getStride());
+    }
+    if (m_glIndexData) {
+        mix(reinterpret_cast<const GLbyte*>(m_glIndexData), m_nIndices * sizeof(GLushort));
+    }
+
+    return size_t(hash);
+}
+
 // Add indices by collecting them into batches to draw as much as
 // possible in one draw call.  The indices must be shifted by the
 // number of vertices that are present in the current batch.
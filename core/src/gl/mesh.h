@@ -12,6 +12,7 @@
 #include <memory>
 #include <cstring> // for memcpy
 #include <cassert>
+#include <unordered_map>
 
 #define MAX_INDEX_VALUE 65535 // Maximum value of GLushort
 
@@ -66,6 +67,12 @@ public:
 
     size_t bufferSize() const;
 
+    /* FNV-1a hash over the compiled vertex and index buffers. Only
+     * meaningful between compile() and upload(), which releases the
+     * CPU-side copies; used by tests and benchmarks to check that
+     * pipeline changes are output-neutral. */
+    size_t contentHash() const;
+
 protected:
 
     int m_generation; // Generation in which this mesh's GL handles were created
@@ -79,11 +86,20 @@ protected:
     size_t m_nVertices;
     GLuint m_glVertexBuffer;
 
+    // Second vertex buffer for dynamic meshes on GPUs with
+    // Hardware::prefersBufferRotation; full refreshes alternate between
+    // the two so the CPU never writes a store the GPU is still reading
+    GLuint m_glAltVertexBuffer = 0;
+
     std::unique_ptr<Vao> m_vaos;
 
     // Compiled vertices for upload
     GLbyte* m_glVertexData = nullptr;
 
+    // False when m_glVertexData aliases storage owned by a subclass,
+    // see Mesh<T>::compile(MeshData<T>&&)
+    bool m_ownsVertexData = true;
+
     size_t m_nIndices;
     GLuint m_glIndexBuffer;
     // Compiled  indices for upload
@@ -107,6 +123,28 @@ protected:
     void setDirty(GLintptr _byteOffset, GLsizei _byteSize);
 };
 
+// Hash and equality on the raw bytes of a vertex. Valid because style
+// vertices are quantized PODs whose padding bytes are zero-initialized.
+template<class T>
+struct VertexBytesHash {
+    size_t operator()(const T& _v) const {
+        // FNV-1a over the vertex bytes
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&_v);
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+        return size_t(hash);
+    }
+};
+
+template<class T>
+struct VertexBytesEqual {
+    bool operator()(const T& _a, const T& _b) const {
+        return std::memcmp(&_a, &_b, sizeof(T)) == 0;
+    }
+};
+
 template<class T>
 struct MeshData {
 
@@ -126,6 +164,70 @@ struct MeshData {
         indices.clear();
         vertices.clear();
     }
+
+    /* Welds vertices that compare byte-equal and drops degenerate
+     * triangles, shrinking the buffers uploaded by compile(). Indices
+     * are relative to their geometry batch, so each batch is welded
+     * within its own vertex window. Assumes GL_TRIANGLES geometry; only
+     * for meshes that are not updated in place afterwards.
+     */
+    void weld() {
+
+        if (indices.empty()) { return; }
+
+        std::vector<T> weldedVertices;
+        weldedVertices.reserve(vertices.size());
+        std::vector<uint16_t> weldedIndices;
+        weldedIndices.reserve(indices.size());
+
+        std::unordered_map<T, uint16_t, VertexBytesHash<T>, VertexBytesEqual<T>> welded;
+
+        size_t srcIndex = 0;
+        size_t srcVertex = 0;
+
+        for (auto& batch : offsets) {
+            size_t nIndices = batch.first;
+            size_t nVertices = batch.second;
+
+            size_t vertexBase = weldedVertices.size();
+            size_t indexBase = weldedIndices.size();
+            welded.clear();
+
+            auto weldOne = [&](uint16_t _index) {
+                const T& vertex = vertices[srcVertex + _index];
+                auto it = welded.find(vertex);
+                if (it != welded.end()) { return it->second; }
+                uint16_t id = uint16_t(weldedVertices.size() - vertexBase);
+                welded.emplace(vertex, id);
+                weldedVertices.push_back(vertex);
+                return id;
+            };
+
+            size_t i = 0;
+            for (; i + 3 <= nIndices; i += 3) {
+                uint16_t a = weldOne(indices[srcIndex + i]);
+                uint16_t b = weldOne(indices[srcIndex + i + 1]);
+                uint16_t c = weldOne(indices[srcIndex + i + 2]);
+                if (a == b || b == c || a == c) { continue; }
+                weldedIndices.push_back(a);
+                weldedIndices.push_back(b);
+                weldedIndices.push_back(c);
+            }
+            // Leftover indices of non-triangle geometry pass through
+            for (; i < nIndices; i++) {
+                weldedIndices.push_back(weldOne(indices[srcIndex + i]));
+            }
+
+            batch.first = uint32_t(weldedIndices.size() - indexBase);
+            batch.second = uint32_t(weldedVertices.size() - vertexBase);
+
+            srcIndex += nIndices;
+            srcVertex += nVertices;
+        }
+
+        indices = std::move(weldedIndices);
+        vertices = std::move(weldedVertices);
+    }
 };
 
 template<class T>
@@ -142,6 +244,10 @@ public:
         return MeshBase::bufferSize();
     }
 
+    size_t contentHash() const override {
+        return MeshBase::contentHash();
+    }
+
     bool draw(ShaderProgram& _shader) override {
         return MeshBase::draw(_shader);
     }
@@ -150,6 +256,19 @@ public:
 
     void compile(const MeshData<T>& _mesh);
 
+    /*
+     * Takes ownership of the vertex storage instead of copying it into
+     * a staging buffer; the upload reads straight from the moved
+     * vector. Indices are still rebased into 16-bit windows.
+     */
+    void compile(MeshData<T>&& _mesh);
+
+    void upload() override {
+        MeshBase::upload();
+        // Release adopted vertex storage once the data is on the GPU
+        m_vertexStore = std::vector<T>();
+    }
+
     /*
      * Update _nVerts vertices in the mesh with the new T value _newVertexValue
      * starting after _byteOffset in the mesh vertex data memory
@@ -164,6 +283,11 @@ public:
     template<class A>
     void updateAttribute(Range _vertexRange, const A& _newAttributeValue,
                          size_t _attribOffset = 0);
+
+private:
+
+    // Vertex storage adopted by compile(MeshData<T>&&)
+    std::vector<T> m_vertexStore;
 };
 
 
@@ -227,6 +351,28 @@ void Mesh<T>::compile(const MeshData<T>& _mesh) {
     m_isCompiled = true;
 }
 
+template<class T>
+void Mesh<T>::compile(MeshData<T>&& _mesh) {
+
+    m_nVertices = _mesh.vertices.size();
+    m_nIndices = _mesh.indices.size();
+
+    assert(size_t(m_vertexLayout->getStride()) == sizeof(T));
+
+    if (m_nIndices > 0) {
+        m_glIndexData = new GLushort[m_nIndices];
+        compileIndices(_mesh.offsets, _mesh.indices, 0);
+    }
+
+    // Adopt the builder's vertex vector; the upload reads from it
+    // directly, skipping the staging copy of the const overload.
+    m_vertexStore = std::move(_mesh.vertices);
+    m_glVertexData = reinterpret_cast<GLbyte*>(m_vertexStore.data());
+    m_ownsVertexData = false;
+
+    m_isCompiled = true;
+}
+
 template<class T>
 template<class A>
 void Mesh<T>::updateAttribute(Range _vertexRange, const A& _newAttributeValue,
@@ -4,6 +4,10 @@
 #include "vertexLayout.h"
 #include "gl/hardware.h"
 
+#include <ctime>
+#include <mutex>
+#include <vector>
+
 namespace Tangram {
 
  // Incremented when the GL context is invalidated
@@ -17,6 +21,7 @@ namespace RenderState {
     StencilTest stencilTest;
     Culling culling;
     DepthWrite depthWrite;
+    DepthFunc depthFunc;
     BlendingFunc blendingFunc;
     StencilWrite stencilWrite;
     StencilFunc stencilFunc;
@@ -49,6 +54,122 @@ namespace RenderState {
         GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id));
     }
 
+    struct PooledBuffer {
+        GLuint id;
+        size_t size;
+    };
+
+    // Released buffer objects waiting for reuse, with the byte size of
+    // their last data store
+    static std::vector<PooledBuffer> s_bufferPool;
+
+    // Enough to absorb the buffers of a screenful of retiring tiles;
+    // beyond this, released buffers go back to the driver
+    static const size_t MAX_POOLED_BUFFERS = 32;
+
+    GLuint acquireBuffer(size_t _size) {
+
+        if (!s_bufferPool.empty()) {
+            // Prefer the smallest pooled buffer whose store already fits
+            // the request, otherwise take the largest one available
+            size_t best = 0;
+            bool fits = s_bufferPool[0].size >= _size;
+            for (size_t i = 1; i < s_bufferPool.size(); i++) {
+                size_t size = s_bufferPool[i].size;
+                if (size >= _size) {
+                    if (!fits || size < s_bufferPool[best].size) {
+                        best = i;
+                        fits = true;
+                    }
+                } else if (!fits && size > s_bufferPool[best].size) {
+                    best = i;
+                }
+            }
+            GLuint id = s_bufferPool[best].id;
+            s_bufferPool.erase(s_bufferPool.begin() + best);
+            return id;
+        }
+
+        GLuint id = 0;
+        GL_CHECK(glGenBuffers(1, &id));
+        return id;
+    }
+
+    void releaseBuffer(GLuint _id, size_t _size) {
+
+        if (s_bufferPool.size() >= MAX_POOLED_BUFFERS) {
+            GL_CHECK(glDeleteBuffers(1, &_id));
+            return;
+        }
+        s_bufferPool.push_back({ _id, _size });
+    }
+
+    struct PendingTexture {
+        GLenum target;
+        GLuint id;
+        int generation;
+    };
+
+    // Textures queued for deletion from any thread; a cache eviction
+    // can retire hundreds at once, so they are freed over several
+    // frames instead of in one burst of driver calls.
+    static std::vector<PendingTexture> s_pendingTextureDeletions;
+    static std::mutex s_deletionMutex;
+
+    // Handles deleted per glDeleteTextures call between budget checks
+    static const size_t DELETION_BATCH_SIZE = 16;
+
+    void queueTextureDeletion(GLenum _target, GLuint _id, int _generation) {
+        std::lock_guard<std::mutex> lock(s_deletionMutex);
+        s_pendingTextureDeletions.push_back({ _target, _id, _generation });
+    }
+
+    void flushResourceDeletions(float _maxTimeMs) {
+
+        std::vector<PendingTexture> pending;
+        {
+            std::lock_guard<std::mutex> lock(s_deletionMutex);
+            if (s_pendingTextureDeletions.empty()) { return; }
+            std::swap(pending, s_pendingTextureDeletions);
+        }
+
+        clock_t start = clock();
+        size_t done = 0;
+
+        while (done < pending.size()) {
+
+            GLuint batch[DELETION_BATCH_SIZE];
+            size_t count = 0;
+
+            for (; done < pending.size() && count < DELETION_BATCH_SIZE; done++) {
+                auto& t = pending[done];
+                // Handles from a lost context are already invalid
+                if (!isValidGeneration(t.generation)) { continue; }
+
+                // Deleting a bound texture resets the binding to 0 per
+                // the GL spec; mirror that in the cached state.
+                if (texture.compare(t.target, t.id)) {
+                    texture.init(t.target, 0, false);
+                }
+                batch[count++] = t.id;
+            }
+
+            if (count > 0) {
+                GL_CHECK(glDeleteTextures(GLsizei(count), batch));
+            }
+
+            float elapsed = float(clock() - start) / CLOCKS_PER_SEC * 1000.f;
+            if (elapsed > _maxTimeMs) { break; }
+        }
+
+        if (done < pending.size()) {
+            // Out of budget - requeue the remainder for the next frame
+            std::lock_guard<std::mutex> lock(s_deletionMutex);
+            s_pendingTextureDeletions.insert(s_pendingTextureDeletions.end(),
+                                             pending.begin() + done, pending.end());
+        }
+    }
+
     void activeTextureUnit(GLuint _unit) {
         // current texture unit is changing, invalidate current texture binding:
         texture.init(GL_TEXTURE_2D, max, false);
@@ -72,7 +193,7 @@ namespace RenderState {
         depthWrite.init(GL_TRUE);
 
         GL_CHECK(glDisable(GL_STENCIL_TEST));
-        GL_CHECK(glDepthFunc(GL_LESS));
+        depthFunc.init(GL_LESS);
         GL_CHECK(glClearDepthf(1.0));
         GL_CHECK(glDepthRangef(0.0, 1.0));
 
@@ -88,6 +209,8 @@ namespace RenderState {
 
     void increaseGeneration() {
         s_validGeneration++;
+        // Pooled buffer ids belong to the lost context
+        s_bufferPool.clear();
     }
 
     bool isValidGeneration(int _generation) {
@@ -19,6 +19,21 @@ namespace RenderState {
     void bindVertexBuffer(GLuint _id);
     /* Bind an index buffer */
     void bindIndexBuffer(GLuint _id);
+    /* Get a buffer object for a data store of _size bytes, reusing a
+     * pooled buffer of a similar size when one is available */
+    GLuint acquireBuffer(size_t _size);
+    /* Return a buffer object whose data store holds _size bytes to the
+     * pool instead of deleting it, so meshes cycling with tiles reuse
+     * buffers rather than churning driver allocations */
+    void releaseBuffer(GLuint _id, size_t _size);
+    /* Queue a texture object for deletion. Deletions are collected
+     * from any thread and run batched on the GL thread with a time
+     * budget, see flushResourceDeletions() */
+    void queueTextureDeletion(GLenum _target, GLuint _id, int _generation);
+    /* Delete queued GL resources in batches until roughly _maxTimeMs
+     * is spent; the rest carries over to the next frame. Called once
+     * per frame on the GL thread. */
+    void flushResourceDeletions(float _maxTimeMs = 2.f);
     /* Sets the currently active texture unit */
     void activeTextureUnit(GLuint _unit);
     /* Bind a texture for the specified target */
@@ -115,6 +130,9 @@ namespace RenderState {
     using DepthWrite = StateWrap<FUN(glDepthMask),
                                  GLboolean>; // enabled
 
+    using DepthFunc = StateWrap<FUN(glDepthFunc),
+                                GLenum>; // func
+
     using BlendingFunc = StateWrap<FUN(glBlendFunc),
                                    GLenum,  // sfactor
                                    GLenum>; // dfactor
@@ -162,6 +180,7 @@ namespace RenderState {
 
     extern DepthTest depthTest;
     extern DepthWrite depthWrite;
+    extern DepthFunc depthFunc;
     extern Blending blending;
     extern BlendingFunc blendingFunc;
     extern StencilTest stencilTest;
@@ -5,8 +5,8 @@
 #include "gl/renderState.h"
 #include "glm/gtc/type_ptr.hpp"
 
+#include <cctype>
 #include <sstream>
-#include <regex>
 #include <set>
 
 namespace Tangram {
@@ -51,6 +51,8 @@ ShaderProgram::~ShaderProgram() {
 void ShaderProgram::setSourceStrings(const std::string& _fragSrc, const std::string& _vertSrc){
     m_fragmentShaderSource = std::string(_fragSrc);
     m_vertexShaderSource = std::string(_vertSrc);
+    m_assembledVertexSource.clear();
+    m_assembledFragmentSource.clear();
     m_needsBuild = true;
 }
 
@@ -65,6 +67,8 @@ void ShaderProgram::addSourceBlock(const std::string& _tagName, const std::strin
     }
 
     m_sourceBlocks[_tagName].push_back(_glslSource);
+    m_assembledVertexSource.clear();
+    m_assembledFragmentSource.clear();
     m_needsBuild = true;
 
     //  TODO:
@@ -125,12 +129,19 @@ bool ShaderProgram::build() {
 
     if (m_invalidShaderSource) { return false; }
 
-    // Inject source blocks
+    // Inject source blocks. The assembled sources are kept so that
+    // rebuilding the same program (e.g. recreating GL objects after a
+    // context loss) skips re-running the assembly.
 
-    Light::assembleLights(m_sourceBlocks);
+    if (m_assembledVertexSource.empty()) {
+        Light::assembleLights(m_sourceBlocks);
 
-    auto vertSrc = applySourceBlocks(m_vertexShaderSource, false);
-    auto fragSrc = applySourceBlocks(m_fragmentShaderSource, true);
+        m_assembledVertexSource = applySourceBlocks(m_vertexShaderSource, false);
+        m_assembledFragmentSource = applySourceBlocks(m_fragmentShaderSource, true);
+    }
+
+    const auto& vertSrc = m_assembledVertexSource;
+    const auto& fragSrc = m_assembledFragmentSource;
 
     // Try to compile vertex and fragment shaders, releasing resources and quiting on failure
 
@@ -167,9 +178,11 @@ bool ShaderProgram::build() {
     m_glVertexShader = vertexShader;
     m_glProgram = program;
 
-    // Clear any cached shader locations
+    // Clear any cached shader locations and uniform values; both are
+    // keyed by locations of the previous program
 
     m_attribMap.clear();
+    m_uniformCache.clear();
 
     return true;
 }
@@ -238,13 +251,33 @@ GLuint ShaderProgram::makeCompiledShader(const std::string& _src, GLenum _type)
 }
 
 
-std::string ShaderProgram::applySourceBlocks(const std::string& source, bool fragShader) {
+// Matches '\s*#pragma tangram:\s+(\w+)' and extracts the tag name
+static bool matchPragmaLine(const char* _begin, const char* _end, std::string& _name) {
+
+    const char* p = _begin;
+    while (p != _end && (*p == ' ' || *p == '\t')) { p++; }
+
+    static const char prefix[] = "#pragma tangram:";
+    for (const char* c = prefix; *c != '\0'; c++, p++) {
+        if (p == _end || *p != *c) { return false; }
+    }
+
+    while (p != _end && (*p == ' ' || *p == '\t')) { p++; }
+
+    const char* nameStart = p;
+    while (p != _end && (isalnum(*p) || *p == '_')) { p++; }
+
+    if (p == nameStart) { return false; }
 
-    static const std::regex pragmaLine("^\\s*#pragma tangram:\\s+(\\w+).*$");
+    _name.assign(nameStart, p);
+    return true;
+}
+
+std::string ShaderProgram::applySourceBlocks(const std::string& source, bool fragShader) {
 
     std::stringstream sourceOut;
     std::set<std::string> pragmas;
-    std::smatch sm;
+    std::string pragmaName;
 
     sourceOut << "#define TANGRAM_EPSILON 0.00001\n";
     sourceOut << "#define TANGRAM_WORLD_POSITION_WRAP 100000.\n";
@@ -272,17 +305,15 @@ std::string ShaderProgram::applySourceBlocks(const std::string& source, bool fra
         auto matchEnd = source.begin() + lineEnd;
         lineStart = lineEnd + 1;
 
-        if (std::regex_match(matchPos, matchEnd, sm, pragmaLine)) {
-
-            std::string pragmaName = sm[1];
+        if (matchPragmaLine(&*matchPos, &*matchPos + (matchEnd - matchPos), pragmaName)) {
 
             bool unique;
-            std::tie(std::ignore, unique) = pragmas.emplace(std::move(pragmaName));
+            std::tie(std::ignore, unique) = pragmas.emplace(pragmaName);
 
             // ignore duplicates
             if (!unique) { continue; }
 
-            auto block = m_sourceBlocks.find(sm[1]);
+            auto block = m_sourceBlocks.find(pragmaName);
             if (block == m_sourceBlocks.end()) { continue; }
 
             // write from last source position to end of pragma
@@ -313,9 +344,26 @@ std::string ShaderProgram::applySourceBlocks(const std::string& source, bool fra
     // This also makes sure if any "\"s are present in the shaders coming from style sheet will be
     // taken care of.
     auto str = sourceOut.str();
-    std::regex backslashMatch("\\\\\\s*\\n");
 
-    return std::regex_replace(str, backslashMatch, " ");
+    std::string out;
+    out.reserve(str.size());
+
+    for (size_t i = 0; i < str.size(); i++) {
+        if (str[i] == '\\') {
+            // Replace a backslash followed by (whitespace and) a
+            // newline with a single space
+            size_t j = i + 1;
+            while (j < str.size() && (str[j] == ' ' || str[j] == '\t' || str[j] == '\r')) { j++; }
+            if (j < str.size() && str[j] == '\n') {
+                out += ' ';
+                i = j;
+                continue;
+            }
+        }
+        out += str[i];
+    }
+
+    return out;
 }
 
 void ShaderProgram::checkValidity() {
@@ -426,8 +474,10 @@ void ShaderProgram::setUniformMatrix2f(const UniformLocation& _loc, const glm::m
     if (!use()) { return; }
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
-        bool cached = !_transpose && getFromCache(location, _value);
-        if (!cached) { GL_CHECK(glUniformMatrix2fv(location, 1, _transpose, glm::value_ptr(_value))); }
+        // Cache the effective value, so transposed sets dedup too
+        glm::mat2 value = _transpose ? glm::transpose(_value) : _value;
+        bool cached = getFromCache(location, value);
+        if (!cached) { GL_CHECK(glUniformMatrix2fv(location, 1, false, glm::value_ptr(value))); }
     }
 }
 
@@ -435,8 +485,9 @@ void ShaderProgram::setUniformMatrix3f(const UniformLocation& _loc, const glm::m
     if (!use()) { return; }
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
-        bool cached = !_transpose && getFromCache(location, _value);
-        if (!cached) { GL_CHECK(glUniformMatrix3fv(location, 1, _transpose, glm::value_ptr(_value))); }
+        glm::mat3 value = _transpose ? glm::transpose(_value) : _value;
+        bool cached = getFromCache(location, value);
+        if (!cached) { GL_CHECK(glUniformMatrix3fv(location, 1, false, glm::value_ptr(value))); }
     }
 }
 
@@ -444,8 +495,9 @@ void ShaderProgram::setUniformMatrix4f(const UniformLocation& _loc, const glm::m
     if (!use()) { return; }
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
-        bool cached = !_transpose && getFromCache(location, _value);
-        if (!cached) { GL_CHECK(glUniformMatrix4fv(location, 1, _transpose, glm::value_ptr(_value))); }
+        glm::mat4 value = _transpose ? glm::transpose(_value) : _value;
+        bool cached = getFromCache(location, value);
+        if (!cached) { GL_CHECK(glUniformMatrix4fv(location, 1, false, glm::value_ptr(value))); }
     }
 }
 
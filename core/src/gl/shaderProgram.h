@@ -56,6 +56,11 @@ public:
      */
     bool isValid() const { return m_glProgram != 0; };
 
+    /*
+     * Returns true if the program sources still have to be compiled and linked
+     */
+    bool needsBuild() const { return m_needsBuild; }
+
     /*
      * Binds the program in openGL if it is not already bound; If the shader sources
      * have been modified since the last time build() was called, also calls build().
@@ -134,9 +139,14 @@ private:
 
     static int s_validGeneration; // Incremented when GL context is invalidated
 
-    // Get a uniform value from the cache, and returns false when it's a cache miss
+    // Get a uniform value from the cache, and returns false when it's a cache miss.
+    // The cache is a flat vector indexed by uniform location, so each
+    // setUniform call costs one array access instead of a map lookup.
     template <class T>
     inline bool getFromCache(GLint _location, T _value) {
+        if (size_t(_location) >= m_uniformCache.size()) {
+            m_uniformCache.resize(_location + 1);
+        }
         auto& v = m_uniformCache[_location];
         if (v.is<T>()) {
             T& value = v.get<T>();
@@ -153,12 +163,19 @@ private:
     GLuint m_glFragmentShader;
     GLuint m_glVertexShader;
 
-    fastmap<std::string, ShaderLocation> m_attribMap;
-    fastmap<GLint, UniformValue> m_uniformCache;
+    hashmap<ShaderLocation> m_attribMap;
+
+    // Last-sent uniform values indexed by uniform location
+    std::vector<UniformValue> m_uniformCache;
 
     std::string m_fragmentShaderSource;
     std::string m_vertexShaderSource;
 
+    // Sources with all blocks applied, kept for rebuilds; cleared
+    // when the sources or source blocks change
+    std::string m_assembledFragmentSource;
+    std::string m_assembledVertexSource;
+
     // An optionnal shader description printed on compile failure
     std::string m_description;
 
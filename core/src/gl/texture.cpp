@@ -5,14 +5,53 @@
 #include "gl/renderState.h"
 #include "gl/hardware.h"
 #include "tangram.h"
+#include "util/memoryBudget.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 #include <cstring> // for memset
 
+// Compressed internal formats; not among the repo's gl.h constants
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_12x12_KHR
+#define GL_COMPRESSED_RGBA_ASTC_12x12_KHR 0x93BD
+#endif
+
 namespace Tangram {
 
+namespace {
+
+// Whether the driver can sample _format directly
+bool isSupportedCompressedFormat(GLenum _format) {
+    switch (_format) {
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            return Hardware::supportsTextureETC2;
+        default:
+            break;
+    }
+    if (_format >= GL_COMPRESSED_RGBA_ASTC_4x4_KHR &&
+        _format <= GL_COMPRESSED_RGBA_ASTC_12x12_KHR) {
+        return Hardware::supportsTextureASTC;
+    }
+    return false;
+}
+
+uint32_t readU32le(const unsigned char* _p) {
+    return uint32_t(_p[0]) | uint32_t(_p[1]) << 8 | uint32_t(_p[2]) << 16 | uint32_t(_p[3]) << 24;
+}
+
+}
+
 Texture::Texture(unsigned int _width, unsigned int _height, TextureOptions _options, bool _generateMipmaps)
     : m_options(_options), m_generateMipmaps(_generateMipmaps) {
 
@@ -33,6 +72,12 @@ bool Texture::loadImageFromMemory(const unsigned char* blob, unsigned int size,
     unsigned char* pixels = nullptr;
     int width, height, comp;
 
+    // Pre-compressed payloads go straight to the GPU; only blobs that
+    // are no known compressed container are decoded with stb_image
+    if (blob != nullptr && size != 0 && loadCompressedImage(blob, size)) {
+        return true;
+    }
+
     // stbi_load_from_memory loads the image as a serie of scanline starting from
     // the top-left corner of the image. When shouldFlip is set to true, the image
     // would be flipped vertically.
@@ -71,6 +116,14 @@ Texture& Texture::operator=(Texture&& _other) {
 
     m_options = _other.m_options;
     m_data = std::move(_other.m_data);
+    m_mipmaps = std::move(_other.m_mipmaps);
+    m_compressedData = std::move(_other.m_compressedData);
+    m_compressedFormat = _other.m_compressedFormat;
+
+    // Hand over the accounted pixel buffer bytes
+    MemoryBudget::remove(MemoryBudget::textures, m_accountedBytes);
+    m_accountedBytes = _other.m_accountedBytes;
+    _other.m_accountedBytes = 0;
     m_dirtyRanges = std::move(_other.m_dirtyRanges);
     m_shouldResize = _other.m_shouldResize;
     m_width = _other.m_width;
@@ -84,20 +137,26 @@ Texture& Texture::operator=(Texture&& _other) {
 
 Texture::~Texture() {
     if (m_glHandle) {
+        // Deletions are batched and run with a per-frame time budget
+        // on the GL thread, so evicting many textures at once does not
+        // stall a single frame.
+        RenderState::queueTextureDeletion(m_target, m_glHandle, m_generation);
+    }
 
-        m_mainThreadJobQueue.add([id = m_glHandle, t = m_target, g = m_generation]() {
-            if (RenderState::isValidGeneration(g)) {
-                // If the texture is bound, and deleted, the binding defaults to 0
-                // according to the OpenGL spec. In this case we need to force the
-                // currently bound texture to 0 in the render state.
-                if (RenderState::texture.compare(t, id)) {
-                    RenderState::texture.init(t, 0, false);
-                }
+    MemoryBudget::remove(MemoryBudget::textures, m_accountedBytes);
+}
 
-                GL_CHECK(glDeleteTextures(1, &id));
-            }
-        });
+void Texture::accountPixelBuffers() {
+    size_t bytes = m_data.size() * sizeof(GLuint);
+    for (auto& mip : m_mipmaps) {
+        bytes += mip.size() * sizeof(GLuint);
+    }
+    bytes += m_compressedData.size();
 
+    if (bytes != m_accountedBytes) {
+        MemoryBudget::remove(MemoryBudget::textures, m_accountedBytes);
+        MemoryBudget::add(MemoryBudget::textures, bytes);
+        m_accountedBytes = bytes;
     }
 }
 
@@ -107,9 +166,68 @@ void Texture::setData(const GLuint* _data, unsigned int _dataSize) {
 
     m_data.insert(m_data.begin(), _data, _data + _dataSize);
 
+    if (m_generateMipmaps) {
+        // Run on the calling thread - for raster tiles this is a tile
+        // worker, keeping the mip filtering off the GL thread
+        generateMipmapsCpu();
+    }
+
+    accountPixelBuffers();
+
     setDirty(0, m_height);
 }
 
+void Texture::generateMipmapsCpu() {
+
+    m_mipmaps.clear();
+
+    if (m_data.empty() || bytesPerPixel() != 4 ||
+        !isPowerOfTwo(m_width) || !isPowerOfTwo(m_height)) {
+        return;
+    }
+
+    const GLuint* src = m_data.data();
+    unsigned int w = m_width;
+    unsigned int h = m_height;
+
+    while (w > 1 || h > 1) {
+        unsigned int mw = std::max(w / 2, 1u);
+        unsigned int mh = std::max(h / 2, 1u);
+
+        std::vector<GLuint> level(mw * mh);
+        GLuint* dst = level.data();
+
+        for (unsigned int y = 0; y < mh; y++) {
+            for (unsigned int x = 0; x < mw; x++) {
+                // 2x2 box filter; clamp for degenerate 1xN / Nx1 levels
+                unsigned int x1 = std::min(2 * x + 1, w - 1);
+                unsigned int y1 = std::min(2 * y + 1, h - 1);
+
+                GLuint a = src[2 * y * w + 2 * x];
+                GLuint b = src[2 * y * w + x1];
+                GLuint c = src[y1 * w + 2 * x];
+                GLuint d = src[y1 * w + x1];
+
+                // Channels averaged pairwise in integer registers: the
+                // four byte sums stay below the 16 bits of lane headroom,
+                // so two adds and a shift per word replace the per-byte
+                // loop, and the compiler can vectorize across pixels
+                GLuint rb = (((a & 0x00FF00FF) + (b & 0x00FF00FF) +
+                              (c & 0x00FF00FF) + (d & 0x00FF00FF)) >> 2) & 0x00FF00FF;
+                GLuint ag = ((((a >> 8) & 0x00FF00FF) + ((b >> 8) & 0x00FF00FF) +
+                              ((c >> 8) & 0x00FF00FF) + ((d >> 8) & 0x00FF00FF)) >> 2) & 0x00FF00FF;
+
+                dst[y * mw + x] = rb | (ag << 8);
+            }
+        }
+
+        m_mipmaps.push_back(std::move(level));
+        src = m_mipmaps.back().data();
+        w = mw;
+        h = mh;
+    }
+}
+
 void Texture::setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
                          uint16_t _width, uint16_t _height, uint16_t _stride) {
 
@@ -119,6 +237,7 @@ void Texture::setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
     // Init m_data if update() was not called after resize()
     if (m_data.size() != (m_width * m_height) / divisor) {
         m_data.resize((m_width * m_height) / divisor);
+        accountPixelBuffers();
     }
 
     // update m_data with subdata
@@ -132,6 +251,104 @@ void Texture::setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
     setDirty(_yoff, _height);
 }
 
+void Texture::setCompressedData(GLenum _internalFormat, unsigned int _width, unsigned int _height,
+                                const unsigned char* _data, size_t _size) {
+
+    m_compressedFormat = _internalFormat;
+    m_compressedData.assign(_data, _data + _size);
+
+    m_data.clear();
+    m_data.shrink_to_fit();
+
+    // The payload carries no mip chain and the block data cannot be
+    // filtered on the CPU, so sample level 0 only
+    m_generateMipmaps = false;
+    m_mipmaps.clear();
+    if (m_options.filtering.min == GL_LINEAR_MIPMAP_LINEAR ||
+        m_options.filtering.min == GL_LINEAR_MIPMAP_NEAREST ||
+        m_options.filtering.min == GL_NEAREST_MIPMAP_LINEAR ||
+        m_options.filtering.min == GL_NEAREST_MIPMAP_NEAREST) {
+        m_options.filtering.min = GL_LINEAR;
+    }
+
+    resize(_width, _height);
+    accountPixelBuffers();
+}
+
+bool Texture::loadCompressedImage(const unsigned char* blob, unsigned int size) {
+
+    // KTX v1 container, the common wrapper for ETC2 and ASTC payloads
+    static const unsigned char ktxMagic[12] =
+        { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    if (size > 64 && std::memcmp(blob, ktxMagic, sizeof(ktxMagic)) == 0) {
+        // Header fields are u32, little-endian when the endianness
+        // marker matches; big-endian files are not produced by the
+        // usual encoders and are simply rejected
+        if (readU32le(blob + 12) != 0x04030201) { return false; }
+
+        uint32_t glType = readU32le(blob + 16);
+        uint32_t glInternalFormat = readU32le(blob + 28);
+        uint32_t pixelWidth = readU32le(blob + 36);
+        uint32_t pixelHeight = readU32le(blob + 40);
+        uint32_t numberOfFaces = readU32le(blob + 52);
+        uint32_t bytesOfKeyValueData = readU32le(blob + 60);
+
+        // glType == 0 marks compressed data; cubemaps and arrays are
+        // not raster tile content
+        if (glType != 0 || numberOfFaces > 1) { return false; }
+        if (!isSupportedCompressedFormat(glInternalFormat)) { return false; }
+
+        size_t offset = 64 + bytesOfKeyValueData;
+        if (offset + 4 > size) { return false; }
+
+        // Take level 0 only; see setCompressedData
+        uint32_t imageSize = readU32le(blob + offset);
+        offset += 4;
+        if (offset + imageSize > size) { return false; }
+
+        setCompressedData(glInternalFormat, pixelWidth, pixelHeight,
+                          blob + offset, imageSize);
+        return true;
+    }
+
+    // Raw .astc file as written by ARM's astcenc
+    if (size > 16 &&
+        blob[0] == 0x13 && blob[1] == 0xAB && blob[2] == 0xA1 && blob[3] == 0x5C) {
+
+        int blockX = blob[4];
+        int blockY = blob[5];
+        int blockZ = blob[6];
+        unsigned int width = blob[7] | blob[8] << 8 | blob[9] << 16;
+        unsigned int height = blob[10] | blob[11] << 8 | blob[12] << 16;
+
+        if (blockZ != 1) { return false; }
+
+        // The KHR extension enumerates the 2d block footprints
+        // contiguously from 4x4 up to 12x12
+        GLenum format = 0;
+        static const struct { int x, y; GLenum fmt; } blocks[] = {
+            {  4,  4, GL_COMPRESSED_RGBA_ASTC_4x4_KHR },
+            {  5,  4, 0x93B1 }, {  5,  5, 0x93B2 },
+            {  6,  5, 0x93B3 }, {  6,  6, 0x93B4 },
+            {  8,  5, 0x93B5 }, {  8,  6, 0x93B6 }, {  8,  8, 0x93B7 },
+            { 10,  5, 0x93B8 }, { 10,  6, 0x93B9 },
+            { 10,  8, 0x93BA }, { 10, 10, 0x93BB },
+            { 12, 10, 0x93BC }, { 12, 12, GL_COMPRESSED_RGBA_ASTC_12x12_KHR },
+        };
+        for (auto& b : blocks) {
+            if (b.x == blockX && b.y == blockY) { format = b.fmt; break; }
+        }
+
+        if (format == 0 || !isSupportedCompressedFormat(format)) { return false; }
+
+        setCompressedData(format, width, height, blob + 16, size - 16);
+        return true;
+    }
+
+    return false;
+}
+
 void Texture::setDirty(size_t _yoff, size_t _height) {
     // FIXME: check that dirty range is valid for texture size!
     size_t max = _yoff + _height;
@@ -191,8 +408,6 @@ void Texture::generate(GLuint _textureUnit) {
     GL_CHECK(glTexParameteri(m_target, GL_TEXTURE_WRAP_T, m_options.wrapping.wrapt));
 
     m_generation = RenderState::generation();
-
-    m_mainThreadJobQueue.makeCurrentThreadTarget();
 }
 
 void Texture::checkValidity() {
@@ -208,6 +423,25 @@ bool Texture::isValid() const {
         && m_glHandle != 0);
 }
 
+void Texture::dispose() {
+    if (m_glHandle) {
+        RenderState::queueTextureDeletion(m_target, m_glHandle, m_generation);
+        m_glHandle = 0;
+    }
+
+    m_data.clear();
+    m_data.shrink_to_fit();
+    m_mipmaps.clear();
+    m_mipmaps.shrink_to_fit();
+    m_compressedData.clear();
+    m_compressedData.shrink_to_fit();
+    m_compressedFormat = 0;
+    accountPixelBuffers();
+
+    m_dirtyRanges.clear();
+    m_shouldResize = true;
+}
+
 void Texture::update(GLuint _textureUnit) {
 
     checkValidity();
@@ -216,10 +450,29 @@ void Texture::update(GLuint _textureUnit) {
         return;
     }
 
+    // Compressed payloads have no partial-update path; the whole
+    // level is (re-)specified in one call
+    if (m_compressedFormat != 0) {
+        if (m_glHandle == 0) {
+            generate(_textureUnit);
+        } else {
+            bind(_textureUnit);
+        }
+
+        GL_CHECK(glCompressedTexImage2D(m_target, 0, m_compressedFormat,
+                     m_width, m_height, 0, m_compressedData.size(),
+                     m_compressedData.data()));
+
+        m_shouldResize = false;
+        m_dirtyRanges.clear();
+        return;
+    }
+
     if (m_glHandle == 0) {
         if (m_data.size() == 0) {
             size_t divisor = sizeof(GLuint) / bytesPerPixel();
             m_data.resize((m_width * m_height) / divisor, 0);
+            accountPixelBuffers();
         }
     }
 
@@ -254,8 +507,7 @@ void Texture::update(GLuint _textureUnit, const GLuint* data) {
                      GL_UNSIGNED_BYTE, data));
 
         if (data && m_generateMipmaps) {
-            // generate the mipmaps for this texture
-            GL_CHECK(glGenerateMipmap(m_target));
+            uploadMipmaps();
         }
         m_shouldResize = false;
         m_dirtyRanges.clear();
@@ -264,15 +516,70 @@ void Texture::update(GLuint _textureUnit, const GLuint* data) {
     size_t bpp = bytesPerPixel();
     size_t divisor = sizeof(GLuint) / bpp;
 
-    for (auto& range : m_dirtyRanges) {
-        size_t offset =  (range.min * m_width) / divisor;
-        GL_CHECK(glTexSubImage2D(m_target, 0, 0, range.min, m_width, range.max - range.min,
+    // A fully dirty texture is re-specified instead of updated in
+    // place: like buffer orphaning this lets the driver allocate
+    // fresh storage rather than synchronize with a frame still
+    // sampling the old contents. Raster tiles updating a recycled
+    // texture take this path.
+    if (m_dirtyRanges.size() == 1 &&
+        m_dirtyRanges.front().min == 0 &&
+        m_dirtyRanges.front().max == m_height) {
+
+        GL_CHECK(glTexImage2D(m_target, 0, m_options.internalFormat,
+                     m_width, m_height, 0, m_options.format,
+                     GL_UNSIGNED_BYTE, data));
+
+        if (data && m_generateMipmaps) {
+            uploadMipmaps();
+        }
+        m_dirtyRanges.clear();
+        return;
+    }
+
+    // Merge ranges separated by a few rows; one larger upload is
+    // cheaper than several glTexSubImage2D calls on most drivers.
+    const size_t mergeGap = 8;
+
+    for (auto it = m_dirtyRanges.begin(); it != m_dirtyRanges.end();) {
+        size_t min = it->min;
+        size_t max = it->max;
+
+        auto next = it + 1;
+        while (next != m_dirtyRanges.end() && next->min - max <= mergeGap) {
+            max = next->max;
+            ++next;
+        }
+
+        size_t offset =  (min * m_width) / divisor;
+        GL_CHECK(glTexSubImage2D(m_target, 0, 0, min, m_width, max - min,
                         m_options.format, GL_UNSIGNED_BYTE,
                         data + offset));
+        it = next;
     }
     m_dirtyRanges.clear();
 }
 
+void Texture::uploadMipmaps() {
+
+    if (m_mipmaps.empty()) {
+        // No precomputed chain - have the driver generate it
+        GL_CHECK(glGenerateMipmap(m_target));
+        return;
+    }
+
+    unsigned int w = m_width;
+    unsigned int h = m_height;
+    int level = 1;
+
+    for (auto& mip : m_mipmaps) {
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+        GL_CHECK(glTexImage2D(m_target, level++, m_options.internalFormat,
+                     w, h, 0, m_options.format,
+                     GL_UNSIGNED_BYTE, mip.data()));
+    }
+}
+
 void Texture::resize(const unsigned int _width, const unsigned int _height) {
     m_width = _width;
     m_height = _height;
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "gl.h"
-#include "util/jobQueue.h"
 
 #include <vector>
 #include <memory>
@@ -66,6 +65,11 @@ public:
 
     GLuint getGlHandle() { return m_glHandle; }
 
+    const TextureOptions& getOptions() const { return m_options; }
+
+    /* Cpu-side pixel buffer; filled until the first upload */
+    const std::vector<GLuint>& getData() const { return m_data; }
+
     /* Sets texture data
      *
      * Has less priority than set sub data
@@ -76,9 +80,21 @@ public:
     void setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
                     uint16_t _width, uint16_t _height, uint16_t _stride);
 
+    /* Hands a pre-compressed pixel payload (ETC2/ASTC) to the texture;
+     * uploaded as-is with glCompressedTexImage2D, no CPU decode */
+    void setCompressedData(GLenum _internalFormat, unsigned int _width, unsigned int _height,
+                           const unsigned char* _data, size_t _size);
+
+    /* Whether this texture holds a compressed payload */
+    bool isCompressed() const { return m_compressedFormat != 0; }
+
     /* Checks whether the texture has valid data and has been successfully uploaded to GPU */
     bool isValid() const;
 
+    /* Release the GL texture and CPU pixel buffers. The texture
+     * becomes invalid and is regenerated on the next update(). */
+    void dispose();
+
     typedef std::pair<GLuint, GLuint> TextureSlot;
 
     static void invalidateAllTextures();
@@ -94,6 +110,12 @@ protected:
 
     TextureOptions m_options;
     std::vector<GLuint> m_data;
+
+    // Pre-compressed payload; when set, m_data stays empty and
+    // update() uploads this with glCompressedTexImage2D
+    std::vector<unsigned char> m_compressedData;
+    GLenum m_compressedFormat = 0;
+
     GLuint m_glHandle;
 
     struct DirtyRange {
@@ -104,6 +126,10 @@ protected:
 
     bool m_shouldResize;
 
+    // Mip levels computed on the CPU (setData on a worker thread), so
+    // the GL thread uploads them instead of running glGenerateMipmap
+    std::vector<std::vector<GLuint>> m_mipmaps;
+
     unsigned int m_width;
     unsigned int m_height;
 
@@ -115,7 +141,25 @@ private:
 
     size_t bytesPerPixel();
 
-    JobQueue m_mainThreadJobQueue;
+    // Recognizes compressed-texture containers (KTX, raw ASTC) in the
+    // blob; returns true when the payload was accepted via
+    // setCompressedData. Unsupported formats fall through to stb_image.
+    bool loadCompressedImage(const unsigned char* blob, unsigned int size);
+
+    // Box-filters m_data into m_mipmaps; only possible for 4bpp
+    // power-of-two textures, otherwise leaves m_mipmaps empty and
+    // update() falls back to glGenerateMipmap
+    void generateMipmapsCpu();
+
+    // Uploads the precomputed mip chain, or runs glGenerateMipmap
+    // when none was computed
+    void uploadMipmaps();
+
+    // Reports pixel buffer size changes to the MemoryBudget texture
+    // category; called after m_data or m_mipmaps change
+    void accountPixelBuffers();
+
+    size_t m_accountedBytes = 0;
 
     bool m_generateMipmaps;
 };
@@ -34,6 +34,8 @@ class UniformLocation {
 public:
     UniformLocation(const std::string& _name) : name(_name) {}
 
+    const std::string& getName() const { return name; }
+
 private:
     const std::string name;
 
@@ -26,7 +26,7 @@ void Vao::init(ShaderProgram& _program, const std::vector<std::pair<uint32_t, ui
 
     GL_CHECK(glGenVertexArrays(m_glnVAOs, m_glVAOs));
 
-    fastmap<std::string, GLuint> locations;
+    hashmap<GLuint> locations;
 
     // FIXME (use a bindAttrib instead of getLocation) to make those locations shader independent
     for (auto& attrib : _layout.getAttribs()) {
@@ -1,4 +1,5 @@
 #include "gl/vertexLayout.h"
+#include "gl/renderState.h"
 #include "gl/shaderProgram.h"
 #include "gl/error.h"
 #include "platform.h"
@@ -57,7 +58,7 @@ size_t VertexLayout::getOffset(std::string _attribName) {
     return 0;
 }
 
-void VertexLayout::enable(const fastmap<std::string, GLuint>& _locations, size_t _byteOffset) {
+void VertexLayout::enable(const hashmap<GLuint>& _locations, size_t _byteOffset) {
 
     for (auto& attrib : m_attribs) {
         auto it = _locations.find(attrib.name);
@@ -85,10 +86,25 @@ void VertexLayout::enable(ShaderProgram& _program, size_t _byteOffset, void* _pt
 
     GLuint glProgram = _program.getGlProgram();
 
+    // Resolve attribute locations by name only when the program (or the
+    // GL context generation, which invalidates all handles) changed;
+    // every following draw walks the plain location array.
+    if (m_locations.program != glProgram ||
+        m_locations.generation != RenderState::generation()) {
+
+        m_locations.locations.clear();
+        for (auto& attrib : m_attribs) {
+            m_locations.locations.push_back(_program.getAttribLocation(attrib.name));
+        }
+        m_locations.program = glProgram;
+        m_locations.generation = RenderState::generation();
+    }
+
     // Enable all attributes for this layout
-    for (auto& attrib : m_attribs) {
+    for (size_t i = 0; i < m_attribs.size(); i++) {
+        auto& attrib = m_attribs[i];
 
-        GLint location = _program.getAttribLocation(attrib.name);
+        GLint location = m_locations.locations[i];
 
         if (location != -1) {
             auto& loc = s_enabledAttribs[location];
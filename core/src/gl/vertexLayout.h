@@ -30,7 +30,7 @@ public:
 
     void enable(ShaderProgram& _program, size_t _byteOffset, void* _ptr = nullptr);
 
-    void enable(const fastmap<std::string, GLuint>& _locations, size_t _bytOffset);
+    void enable(const hashmap<GLuint>& _locations, size_t _bytOffset);
 
     GLint getStride() const { return m_stride; };
 
@@ -47,6 +47,17 @@ private:
     std::vector<VertexAttrib> m_attribs;
     GLint m_stride;
 
+    // Attribute locations resolved for the program this layout was last
+    // drawn with; a layout belongs to one style's shader, so a single
+    // entry suffices. Keeps the per-attribute name lookups out of the
+    // per-draw enable() path.
+    struct AttribLocations {
+        GLuint program = 0;
+        int generation = -1;
+        std::vector<GLint> locations;
+    };
+    AttribLocations m_locations;
+
 };
 
 }
@@ -39,6 +39,20 @@ public:
         return m_step > m_duration;
     }
 
+    /* Normalized step at which a fade-in of the given interpolation
+     * reaches _value; used to restart a reversed fade without a jump */
+    static float stepForValue(Interpolation _interpolation, float _value) {
+        switch (_interpolation) {
+            case Interpolation::linear:
+                return _value;
+            case Interpolation::pow:
+                return sqrt(_value);
+            case Interpolation::sine:
+                return asin(_value) * 2.f / M_PI;
+        }
+        return _value;
+    }
+
 private:
 
     Interpolation m_interpolation = Interpolation::linear;
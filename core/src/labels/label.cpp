@@ -1,6 +1,7 @@
 #include "label.h"
 
 #include "util/geom.h"
+#include <algorithm>
 #include "glm/gtx/rotate_vector.hpp"
 #include "tangram.h"
 
@@ -41,8 +42,7 @@ bool Label::updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _scree
         {
             glm::vec2 p0 = m_transform.modelPosition1;
 
-            screenPosition = worldToScreenSpace(_mvp, glm::vec4(p0, 0.0, 1.0),
-                                                _screenSize, clipped);
+            screenPosition = worldToScreenSpace(_mvp, p0, _screenSize, clipped);
 
             if (_testVisibility && clipped) {
                 return false;
@@ -59,10 +59,8 @@ bool Label::updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _scree
             glm::vec2 p0 = m_transform.modelPosition1;
             glm::vec2 p2 = m_transform.modelPosition2;
 
-            glm::vec2 ap0 = worldToScreenSpace(_mvp, glm::vec4(p0, 0.0, 1.0),
-                                               _screenSize, clipped);
-            glm::vec2 ap2 = worldToScreenSpace(_mvp, glm::vec4(p2, 0.0, 1.0),
-                                               _screenSize, clipped);
+            glm::vec2 ap0 = worldToScreenSpace(_mvp, p0, _screenSize, clipped);
+            glm::vec2 ap2 = worldToScreenSpace(_mvp, p2, _screenSize, clipped);
 
             // check whether the label is behind the camera using the
             // perspective division factor
@@ -81,8 +79,7 @@ bool Label::updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _scree
 
             glm::vec2 p1 = glm::vec2(p2 + p0) * 0.5f;
 
-            glm::vec2 ap1 = worldToScreenSpace(_mvp, glm::vec4(p1, 0.0, 1.0),
-                                               _screenSize, clipped);
+            glm::vec2 ap1 = worldToScreenSpace(_mvp, p1, _screenSize, clipped);
 
             // Keep screen position center at world center (less sliding in tilted view)
             screenPosition = ap1;
@@ -166,12 +163,44 @@ void Label::enterState(const State& _state, float _alpha) {
 
     m_state = _state;
     setAlpha(_alpha);
+
+    // outside of the fading states the alpha above is final
+    if (m_state != State::fading_in && m_state != State::fading_out) {
+        m_transform.state.fadeDuration = 0.f;
+    }
 }
 
 void Label::setAlpha(float _alpha) {
     m_transform.state.alpha = CLAMP(_alpha, 0.0, 1.0);
 }
 
+void Label::setFade(bool _in, FadeEffect::Interpolation _ease, float _duration, float _time) {
+    m_transform.state.fadeStart = _time;
+    m_transform.state.fadeDuration = _duration;
+    m_transform.state.fadeParams = float(int(_ease) * 2 + (_in ? 1 : 0));
+}
+
+glm::u16vec4 Label::fadeVertexAttrib() const {
+    uint32_t start = uint32_t(std::max(m_transform.state.fadeStart, 0.f) * 1000.f);
+    uint32_t duration = uint32_t(m_transform.state.fadeDuration * 1000.f);
+
+    return { uint16_t(start & 0xffff), uint16_t(start >> 16),
+             uint16_t(std::min(duration, uint32_t(0xffff))),
+             uint16_t(m_transform.state.fadeParams) };
+}
+
+size_t Label::dedupKey() const {
+    // Bucket the screen position so the copies of a label built in
+    // adjacent tiles - whose projected positions agree to well below
+    // a pixel - collide on the same key.
+    size_t seed = m_options.paramHash;
+    hash_combine(seed, int(m_transform.state.screenPos.x * 0.25f));
+    hash_combine(seed, int(m_transform.state.screenPos.y * 0.25f));
+    hash_combine(seed, int(m_dim.x));
+    hash_combine(seed, int(m_dim.y));
+    return seed;
+}
+
 void Label::resetState() {
     if (m_state == State::dead) { return; }
 
@@ -222,7 +251,7 @@ bool Label::update(const glm::mat4& _mvp, const glm::vec2& _screenSize, float _z
     return true;
 }
 
-bool Label::evalState(const glm::vec2& _screenSize, float _dt) {
+bool Label::evalState(const glm::vec2& _screenSize, float _dt, float _time) {
 
     // if (Tangram::getDebugFlag(DebugFlags::all_labels)) {
     //     enterState(State::visible, 1.0);
@@ -237,6 +266,8 @@ bool Label::evalState(const glm::vec2& _screenSize, float _dt) {
                 m_fade = FadeEffect(false, m_options.hideTransition.ease,
                                     m_options.hideTransition.time);
                 enterState(State::fading_out, 1.0);
+                setFade(false, m_options.hideTransition.ease,
+                        m_options.hideTransition.time, _time);
                 animate = true;
             }
             break;
@@ -255,7 +286,18 @@ bool Label::evalState(const glm::vec2& _screenSize, float _dt) {
             break;
         case State::fading_out:
             if (!m_occluded) {
-                enterState(State::fading_in, m_transform.state.alpha);
+                // Restart the show transition from the current alpha,
+                // backdating its start so the reversal is continuous
+                // on screen.
+                auto& t = m_options.showTransition;
+                float alpha = m_transform.state.alpha;
+                float step = FadeEffect::stepForValue(t.ease, alpha);
+
+                m_fade = FadeEffect(true, t.ease, t.time);
+                m_fade.update(step * t.time);
+
+                enterState(State::fading_in, alpha);
+                setFade(true, t.ease, t.time, _time - step * t.time);
                 animate = true;
                 break;
             }
@@ -272,6 +314,8 @@ bool Label::evalState(const glm::vec2& _screenSize, float _dt) {
                 m_fade = FadeEffect(true, m_options.showTransition.ease,
                                     m_options.showTransition.time);
                 enterState(State::fading_in, 0.0);
+                setFade(true, m_options.showTransition.ease,
+                        m_options.showTransition.time, _time);
                 animate = true;
             }
             break;
@@ -287,6 +331,8 @@ bool Label::evalState(const glm::vec2& _screenSize, float _dt) {
                 m_fade = FadeEffect(true, m_options.showTransition.ease,
                                     m_options.showTransition.time);
                 enterState(State::fading_in, 0.0);
+                setFade(true, m_options.showTransition.ease,
+                        m_options.showTransition.time, _time);
                 animate = true;
             }
             break;
@@ -2,6 +2,7 @@
 
 #include "glm/vec2.hpp"
 #include "glm/mat4x4.hpp"
+#include "glm/gtc/type_precision.hpp"
 #include <climits> // needed in aabb.h
 #include "aabb.h"
 #include "obb.h"
@@ -53,6 +54,12 @@ public:
             glm::vec2 screenPos;
             glm::vec2 rotation;
             float alpha = 0.f;
+            // Shader-evaluated fade, in scene time seconds; a duration
+            // of zero means no fade is running and alpha is final
+            float fadeStart = 0.f;
+            float fadeDuration = 0.f;
+            // FadeEffect::Interpolation * 2 + (fading in ? 1 : 0)
+            float fadeParams = 0.f;
         } state;
     };
 
@@ -89,7 +96,17 @@ public:
     /* Push the pending transforms to the vbo by updating the vertices */
     virtual void pushTransform() = 0;
 
-    bool evalState(const glm::vec2& _screenSize, float _dt);
+    bool evalState(const glm::vec2& _screenSize, float _dt, float _time = 0.f);
+
+    /* Fade parameters packed for the label vertex attributes: start
+     * time split into two uint16 milliseconds words, duration in
+     * milliseconds and the eased-in/out selector; evaluated against
+     * u_time in the point/text vertex shader */
+    glm::u16vec4 fadeVertexAttrib() const;
+
+    /* Whether a shader-evaluated fade is running; while it is, quads
+     * carry full alpha and the shader applies the fade factor */
+    bool fadeActive() const { return m_transform.state.fadeDuration > 0.f; }
 
     /* Update the screen position of the label */
     bool updateScreenTransform(const glm::mat4& _mvp, const glm::vec2& _screenSize,
@@ -111,6 +128,11 @@ public:
     void resetState();
 
     size_t hash() const { return m_options.paramHash; }
+
+    /* Identity for cross-tile deduplication: rule parameters combined
+     * with the label dimensions and a screen-position bucket, so the
+     * same feature built in neighboring tiles maps to one key */
+    size_t dedupKey() const;
     const glm::vec2& dimension() const { return m_dim; }
     /* Gets for label options: color and offset */
     const Options& options() const { return m_options; }
@@ -128,6 +150,15 @@ public:
 
     LabelProperty::Anchor anchorType() const { return m_anchorType; }
 
+    /* Number of anchor placements this label can try; 1 when only the
+     * primary anchor exists */
+    virtual size_t anchorCount() const { return 1; }
+
+    /* Re-anchors the label to fallback placement @_index, shifting the
+     * screen transform and bounds of the current pass accordingly.
+     * Returns false when the label has no such placement. */
+    virtual bool setAnchorIndex(size_t _index) { return false; }
+
     virtual glm::vec2 center() const;
 
     void enterState(const State& _state, float _alpha = 1.0f);
@@ -142,6 +173,8 @@ private:
 
     void setAlpha(float _alpha);
 
+    void setFade(bool _in, FadeEffect::Interpolation _ease, float _duration, float _time);
+
     // the current label state
     State m_state;
     // the label fade effect
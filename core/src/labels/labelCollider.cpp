@@ -58,8 +58,10 @@ void LabelCollider::handleRepeatGroup(size_t startPos) {
 
 void LabelCollider::process() {
 
-    // Sort labels so that all labels of one repeat group are next to each other
-    std::sort(m_labels.begin(), m_labels.end(),
+    // Sort labels so that all labels of one repeat group are next to each other.
+    // Stable, so labels comparing equal keep their insertion order and
+    // builds stay byte-identical across runs and sort implementations.
+    std::stable_sort(m_labels.begin(), m_labels.end(),
               [](auto* l1, auto* l2) {
                   if (l1->options().priority != l2->options().priority) {
                       // lower numeric priority means higher priority
@@ -95,6 +97,79 @@ void LabelCollider::process() {
          m_aabbs.push_back(label->aabb());
     }
 
+    // Pre-filter for label-dense tiles: a candidate whose box lies
+    // entirely inside the box of a strictly higher-priority candidate
+    // can never survive the narrow phase against it, so it is rejected
+    // here without entering the broadphase, whose pair count grows
+    // quadratically within crowded cells. Candidates are swept from
+    // high to low priority over a coarse grid; labels with a parent
+    // are not used as containers since they may be occluded through
+    // their link later.
+    {
+        const float cellSize = 128;
+        int cols = std::max(1, int(m_screenSize.x / cellSize));
+        int rows = std::max(1, int(m_screenSize.y / cellSize));
+        glm::vec2 cell = { m_screenSize.x / cols, m_screenSize.y / rows };
+
+        std::vector<std::vector<size_t>> cells(cols * rows);
+
+        std::vector<Label*> kept;
+        std::vector<AABB> keptAabbs;
+        kept.reserve(m_labels.size());
+        keptAabbs.reserve(m_aabbs.size());
+
+        // m_labels is sorted with the highest priority last
+        for (size_t n = m_labels.size(); n-- > 0;) {
+            auto* label = m_labels[n];
+            const auto& aabb = m_aabbs[n];
+
+            int x0 = std::max(0, std::min(cols - 1, int(aabb.min.x / cell.x)));
+            int y0 = std::max(0, std::min(rows - 1, int(aabb.min.y / cell.y)));
+            int x1 = std::max(0, std::min(cols - 1, int(aabb.max.x / cell.x)));
+            int y1 = std::max(0, std::min(rows - 1, int(aabb.max.y / cell.y)));
+
+            bool covered = false;
+            for (int y = y0; y <= y1 && !covered; y++) {
+                for (int x = x0; x <= x1 && !covered; x++) {
+                    for (size_t other : cells[y * cols + x]) {
+                        if (kept[other]->options().priority >= label->options().priority) {
+                            continue;
+                        }
+                        const auto& box = keptAabbs[other];
+                        if (box.min.x <= aabb.min.x && box.min.y <= aabb.min.y &&
+                            box.max.x >= aabb.max.x && box.max.y >= aabb.max.y) {
+                            covered = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (covered) {
+                label->occlude();
+                label->enterState(Label::State::dead, 0.0f);
+                continue;
+            }
+
+            size_t idx = kept.size();
+            kept.push_back(label);
+            keptAabbs.push_back(aabb);
+
+            if (!label->parent()) {
+                for (int y = y0; y <= y1; y++) {
+                    for (int x = x0; x <= x1; x++) {
+                        cells[y * cols + x].push_back(idx);
+                    }
+                }
+            }
+        }
+
+        // The sweep reversed the order; repeat groups stay adjacent and
+        // the pair resolution below orders by priority itself
+        m_labels.swap(kept);
+        m_aabbs.swap(keptAabbs);
+    }
+
     m_isect2d.resize({m_screenSize.x / 128, m_screenSize.y / 128}, m_screenSize);
 
     m_isect2d.intersect(m_aabbs);
@@ -200,6 +275,81 @@ void LabelCollider::process() {
         }
     }
 
+    // Anchor fallback pass: a point label occluded at its primary
+    // anchor may still fit at one of its alternates. The extents are
+    // known from the build, so each candidate placement is a plain
+    // bounds offset tested against the labels that survived - no
+    // re-layout. Candidates go in priority order and revived labels
+    // join the survivors, so two rivals cannot claim the same spot.
+    // Repeat-grouped labels are skipped; reviving one would bypass
+    // the distance check above.
+    {
+        std::vector<size_t> retry;
+        for (size_t i = 0; i < m_labels.size(); i++) {
+            auto* label = m_labels[i];
+            if (label->isOccluded() && label->anchorCount() > 1 &&
+                !label->parent() && label->options().repeatGroup == 0) {
+                retry.push_back(i);
+            }
+        }
+
+        if (!retry.empty()) {
+            const float cellSize = 128;
+            int cols = std::max(1, int(m_screenSize.x / cellSize));
+            int rows = std::max(1, int(m_screenSize.y / cellSize));
+            glm::vec2 cell = { m_screenSize.x / cols, m_screenSize.y / rows };
+
+            std::vector<std::vector<Label*>> cells(cols * rows);
+
+            auto forCells = [&](const AABB& _aabb, auto _fn) {
+                int x0 = std::max(0, std::min(cols - 1, int(_aabb.min.x / cell.x)));
+                int y0 = std::max(0, std::min(rows - 1, int(_aabb.min.y / cell.y)));
+                int x1 = std::max(0, std::min(cols - 1, int(_aabb.max.x / cell.x)));
+                int y1 = std::max(0, std::min(rows - 1, int(_aabb.max.y / cell.y)));
+
+                for (int y = y0; y <= y1; y++) {
+                    for (int x = x0; x <= x1; x++) {
+                        _fn(cells[y * cols + x]);
+                    }
+                }
+            };
+
+            for (auto* label : m_labels) {
+                if (label->isOccluded()) { continue; }
+                forCells(label->aabb(), [&](auto& _cell) { _cell.push_back(label); });
+            }
+
+            // m_labels holds the highest priority first here
+            for (size_t i : retry) {
+                auto* label = m_labels[i];
+
+                bool placed = false;
+                for (size_t a = 1; a < label->anchorCount() && !placed; a++) {
+                    if (!label->setAnchorIndex(a)) { break; }
+
+                    placed = true;
+                    forCells(label->aabb(), [&](auto& _cell) {
+                        if (!placed) { return; }
+                        for (auto* other : _cell) {
+                            if (intersect(label->obb(), other->obb())) {
+                                placed = false;
+                                break;
+                            }
+                        }
+                    });
+                }
+
+                if (placed) {
+                    label->occlude(false);
+                    forCells(label->aabb(), [&](auto& _cell) { _cell.push_back(label); });
+                } else {
+                    // Keep the primary placement for later frames
+                    label->setAnchorIndex(0);
+                }
+            }
+        }
+    }
+
     for (auto* label : m_labels) {
 
         // Manage link occlusion (unified icon labels)
@@ -20,6 +20,9 @@ public:
 
     void process();
 
+    // Number of labels collected so far in this layout round
+    size_t size() const { return m_labels.size(); }
+
 private:
 
     void handleRepeatGroup(size_t startPos);
@@ -18,6 +18,17 @@ void LabelSet::setLabels(std::vector<std::unique_ptr<Label>>& _labels) {
                     std::move_iterator<iter_t>(_labels.end()));
 
     _labels.clear();
+
+    rebuildInteractiveIndex();
+}
+
+void LabelSet::rebuildInteractiveIndex() {
+    m_interactiveLabels.clear();
+    for (auto& label : m_labels) {
+        if (label->options().interactive) {
+            m_interactiveLabels.push_back(label.get());
+        }
+    }
 }
 
 }
@@ -13,6 +13,10 @@ public:
     const auto& getLabels() const { return m_labels; }
     auto& getLabels() { return m_labels; }
 
+    /* Labels with interactive options, indexed once when the set is
+     * built; picking queries touch only these */
+    const auto& getInteractiveLabels() const { return m_interactiveLabels; }
+
     virtual ~LabelSet();
 
     bool draw(ShaderProgram& _shader) override { return true; }
@@ -21,10 +25,15 @@ public:
 
     void setLabels(std::vector<std::unique_ptr<Label>>& _labels);
 
+    /* Recreate the interactive index from the current labels; needed
+     * after moving labels between sets */
+    void rebuildInteractiveIndex();
+
     void reset();
 
 protected:
     std::vector<std::unique_ptr<Label>> m_labels;
+    std::vector<Label*> m_interactiveLabels;
 };
 
 }
@@ -20,23 +20,73 @@
 
 namespace Tangram {
 
+// Transition starts allowed per frame before the remainder of a batch
+// is phased in on the following frames
+#define MIN_FADE_STARTS_PER_FRAME 64
+// A batch is never stretched over more than this many frames, keeping
+// the stagger well inside the fade duration
+#define MAX_FADE_SPREAD_FRAMES 4
+
+namespace {
+
+// Whether evalState would start a new fade for this label with the
+// occlusion result of the current pass. Running animations and the
+// cheap non-animating state flips are not deferrable.
+bool startsTransition(const Label* _label) {
+    switch (_label->state()) {
+        case Label::State::visible:
+            return _label->isOccluded();
+        case Label::State::wait_occ:
+        case Label::State::sleep:
+            return !_label->isOccluded();
+        default:
+            return false;
+    }
+}
+
+// Partition the screen into a coarse 4x2 grid; deferred fades are
+// released region by region so the stagger reads as a sweep rather
+// than scattered popping
+int fadeRegion(const glm::vec2& _pos, const glm::vec2& _screenSize) {
+    int col = glm::clamp(int(_pos.x / _screenSize.x * 4.f), 0, 3);
+    int row = glm::clamp(int(_pos.y / _screenSize.y * 2.f), 0, 1);
+    return row * 4 + col;
+}
+
+}
+
 Labels::Labels()
     : m_needUpdate(false),
       m_lastZoom(0.0f) {}
 
 Labels::~Labels() {}
 
+void Labels::clear() {
+    m_grid.clear();
+    m_labelOrder.clear();
+    m_dedupKeys.clear();
+    m_labels.clear();
+    m_tileStates.clear();
+    m_deferredFades.clear();
+}
+
 // int Labels::LODDiscardFunc(float _maxZoom, float _zoom) {
 //     return (int) MIN(floor(((log(-_zoom + (_maxZoom + 2)) / log(_maxZoom + 2) * (_maxZoom )) * 0.5)), MAX_LOD);
 // }
 
-void Labels::updateLabels(const View& _view, float _dt,
+void Labels::updateLabels(const View& _view, float _dt, float _time,
                           const std::vector<std::unique_ptr<Style>>& _styles,
                           const std::vector<std::shared_ptr<Tile>>& _tiles,
                           bool _onlyTransitions) {
 
     // Keep labels for debugDraw
-    if (!_onlyTransitions) { m_labels.clear(); }
+    if (!_onlyTransitions) {
+        m_labels.clear();
+        // Force the next transition pass to visit every tile again.
+        m_tileStates.clear();
+        // The full pass reschedules transitions from scratch.
+        m_deferredFades.clear();
+    }
 
     m_needUpdate = false;
 
@@ -58,6 +108,18 @@ void Labels::updateLabels(const View& _view, float _dt,
 
         glm::mat4 mvp = _view.getViewProjectionMatrix() * tile->getModelMatrix();
 
+        if (_onlyTransitions) {
+            // Skip tiles whose transform is unchanged and whose
+            // labels settled in a previous pass - nothing to
+            // recompute until the view or the tile set changes.
+            auto it = m_tileStates.find(tile.get());
+            if (it != m_tileStates.end() && !it->second.active && it->second.mvp == mvp) {
+                continue;
+            }
+        }
+
+        bool tileActive = false;
+
         for (const auto& style : _styles) {
             const auto& mesh = tile->getMesh(*style);
             if (!mesh) { continue; }
@@ -72,18 +134,49 @@ void Labels::updateLabels(const View& _view, float _dt,
 
                 if (_onlyTransitions) {
                     if (!label->canOcclude() || label->visibleState()) {
-                        m_needUpdate |= label->evalState(screenSize, _dt);
+                        bool animating = label->evalState(screenSize, _dt, _time);
+                        m_needUpdate |= animating;
+                        tileActive |= animating;
                         label->pushTransform();
                     }
                 } else if (label->canOcclude()) {
                     m_labels.emplace_back(label.get(), proxyTile);
                 } else {
-                    m_needUpdate |= label->evalState(screenSize, _dt);
+                    m_needUpdate |= label->evalState(screenSize, _dt, _time);
                     label->pushTransform();
                 }
             }
         }
+
+        if (_onlyTransitions) {
+            m_tileStates[tile.get()] = { mvp, tileActive };
+        }
+    }
+
+    if (_onlyTransitions) {
+        // Start the next slice of fades deferred by the last full pass
+        startPendingFades(screenSize, _dt, _time);
+    }
+}
+
+void Labels::startPendingFades(const glm::vec2& _screenSize, float _dt, float _time) {
+
+    size_t budget = m_fadeStartBudget;
+
+    while (budget-- > 0 && !m_deferredFades.empty()) {
+        auto& deferred = m_deferredFades.back();
+
+        // Re-apply the occlusion result of the scheduling pass; the
+        // per-frame update() has reset it since
+        deferred.label->occlude(deferred.occluded);
+        m_needUpdate |= deferred.label->evalState(_screenSize, _dt, _time);
+        deferred.label->pushTransform();
+
+        m_deferredFades.pop_back();
     }
+
+    // Keep the transition pass running until the queue drains
+    m_needUpdate |= !m_deferredFades.empty();
 }
 
 void Labels::skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const {
@@ -122,9 +215,9 @@ void Labels::skipTransitions(const std::vector<const Style*>& _styles, Tile& _ti
 
 std::shared_ptr<Tile> findProxy(int32_t _sourceID, const TileID& _proxyID,
                                 const std::vector<std::shared_ptr<Tile>>& _tiles,
-                                std::unique_ptr<TileCache>& _cache) {
+                                TileCache& _cache) {
 
-    auto proxy = _cache->contains(_sourceID, _proxyID);
+    auto proxy = _cache.contains(_sourceID, _proxyID);
     if (proxy) { return proxy; }
 
     for (auto& tile : _tiles) {
@@ -137,7 +230,7 @@ std::shared_ptr<Tile> findProxy(int32_t _sourceID, const TileID& _proxyID,
 
 void Labels::skipTransitions(const std::vector<std::unique_ptr<Style>>& _styles,
                              const std::vector<std::shared_ptr<Tile>>& _tiles,
-                             std::unique_ptr<TileCache>& _cache, float _currentZoom) const {
+                             TileCache& _cache, float _currentZoom) const {
 
     std::vector<const Style*> styles;
 
@@ -214,8 +307,20 @@ void Labels::sortLabels() {
 
 void Labels::handleOcclusions() {
 
-    m_isect2d.clear();
-    m_repeatGroups.clear();
+    m_labelOrder.clear();
+    m_dedupKeys.clear();
+
+    // Labels of tiles evicted since the last pass were destroyed with
+    // their meshes but are still bucketed in the grid; drop those
+    // entries before any candidate walk can report them. retain()
+    // never dereferences the stored pointers.
+    m_liveLabels.clear();
+    for (auto& entry : m_labels) { m_liveLabels.insert(entry.label); }
+    m_grid.retain(m_liveLabels);
+
+    m_grid.startFrame();
+
+    int order = 0;
 
     for (auto& entry : m_labels){
         auto* l = entry.label;
@@ -227,6 +332,16 @@ void Labels::handleOcclusions() {
             continue;
         }
 
+        // Duplicates of a label already placed in this pass - the
+        // same feature built in another tile at the same screen
+        // position - are dropped before touching the grid. The sort
+        // above ranks ready tiles and previously visible labels
+        // first, so the kept copy is the one already on screen.
+        if (!m_dedupKeys.insert(l->dedupKey()).second) {
+            l->occlude();
+            continue;
+        }
+
         // Skip label if another label of this repeatGroup is
         // within repeatDistance.
         if (l->options().repeatDistance > 0.f) {
@@ -236,51 +351,85 @@ void Labels::handleOcclusions() {
             }
         }
 
-        // Skip label if it intersects with a previous label.
         auto aabb = l->aabb();
-        aabb.m_userData = static_cast<void*>(l);
 
-        m_isect2d.intersect(aabb, [](auto& a, auto& b) {
-                auto* l1 = static_cast<Label*>(a.m_userData);
-                auto* l2 = static_cast<Label*>(b.m_userData);
+        // Re-bucket the label when its AABB moved into other cells
+        // since the previous frame.
+        m_grid.update(l, aabb);
+        m_labelOrder[l] = order;
+
+        // Skip label if it intersects with a previous label. Only
+        // labels placed earlier in this pass count as occluders.
+        m_grid.forEachCandidate(aabb, [&](Label* other) {
+                if (l->isOccluded() || other == l) { return; }
 
-                if (intersect(l1->obb(), l2->obb())) {
-                    l1->occlude();
-                    // Drop label
-                    return false;
+                // The order lookup must come before any dereference of
+                // other: it filters both labels not placed yet and any
+                // entry that slipped past the purge above.
+                auto it = m_labelOrder.find(other);
+                if (it == m_labelOrder.end() || it->second >= order) { return; }
+
+                if (other->isOccluded()) { return; }
+
+                if (intersect(l->obb(), other->obb())) {
+                    l->occlude();
                 }
-                // Continue
-                return true;
             });
 
-        if (l->options().repeatDistance > 0.f) {
-            m_repeatGroups[l->options().repeatGroup].push_back(l);
+        if (l->isOccluded()) {
+            // Drop label
+            m_grid.remove(l);
+            m_labelOrder.erase(l);
+            continue;
         }
+
+        order++;
     }
+
+    // Drop entries of labels that left the screen or died.
+    m_grid.prune();
 }
 
 bool Labels::withinRepeatDistance(Label *_label) {
-    float threshold2 = pow(_label->options().repeatDistance, 2);
-
-    auto it = m_repeatGroups.find(_label->options().repeatGroup);
-    if (it != m_repeatGroups.end()) {
-        for (auto* ll : it->second) {
-            float d2 = distance2(_label->center(), ll->center());
-            if (d2 < threshold2) {
-                return true;
+
+    float repeatDistance = _label->options().repeatDistance;
+    float threshold2 = repeatDistance * repeatDistance;
+    size_t repeatGroup = _label->options().repeatGroup;
+    glm::vec2 center = _label->center();
+
+    // Query the broadphase grid with a box of the repeat radius around
+    // the label's center instead of scanning the whole group: a group
+    // member within repeatDistance has its center inside this box, so
+    // its cells are covered by the query. Only members placed earlier
+    // in this pass count, which is exactly membership in m_labelOrder.
+    SpatialGrid::AABB box(center.x - repeatDistance, center.y - repeatDistance,
+                          center.x + repeatDistance, center.y + repeatDistance);
+
+    bool found = false;
+    m_grid.forEachCandidate(box, [&](Label* other) {
+            if (found || other == _label) { return; }
+            // Membership check first - it is the only filter that
+            // does not dereference other.
+            if (m_labelOrder.find(other) == m_labelOrder.end()) { return; }
+            if (other->options().repeatDistance <= 0.f) { return; }
+            if (other->options().repeatGroup != repeatGroup) { return; }
+            if (other->isOccluded()) { return; }
+
+            if (distance2(center, other->center()) < threshold2) {
+                found = true;
             }
-        }
-    }
-    return false;
+        });
+
+    return found;
 }
 
-void Labels::updateLabelSet(const View& _view, float _dt,
+void Labels::updateLabelSet(const View& _view, float _dt, float _time,
                             const std::vector<std::unique_ptr<Style>>& _styles,
                             const std::vector<std::shared_ptr<Tile>>& _tiles,
-                            std::unique_ptr<TileCache>& _cache) {
+                            TileCache& _cache) {
 
     /// Collect and update labels from visible tiles
-    updateLabels(_view, _dt, _styles, _tiles, false);
+    updateLabels(_view, _dt, _time, _styles, _tiles, false);
 
     sortLabels();
 
@@ -291,8 +440,7 @@ void Labels::updateLabelSet(const View& _view, float _dt,
         m_lastZoom = _view.getZoom();
     }
 
-    m_isect2d.resize({_view.getWidth() / 256, _view.getHeight() / 256},
-                     {_view.getWidth(), _view.getHeight()});
+    m_grid.resize({256, 256}, {_view.getWidth(), _view.getHeight()});
 
     handleOcclusions();
 
@@ -300,12 +448,36 @@ void Labels::updateLabelSet(const View& _view, float _dt,
 
     glm::vec2 screenSize = glm::vec2(_view.getWidth(), _view.getHeight());
 
+    // A zoom flip changes the occlusion result of most labels at once,
+    // and starting every fade in the same frame pays evalState plus a
+    // vertex re-push for each of them. New transitions are queued
+    // instead and started a budget's worth per frame.
     for (auto& entry : m_labels) {
         Label* label = entry.label;
 
-        m_needUpdate |= label->evalState(screenSize, _dt);
+        if (startsTransition(label)) {
+            int region = fadeRegion(label->transform().state.screenPos, screenSize);
+            m_deferredFades.push_back({label, label->isOccluded(), region});
+            continue;
+        }
+
+        m_needUpdate |= label->evalState(screenSize, _dt, _time);
         label->pushTransform();
     }
+
+    // Released back to front, so descending region order sweeps the
+    // screen top-left to bottom-right
+    std::stable_sort(m_deferredFades.begin(), m_deferredFades.end(),
+                     [](const DeferredFade& _a, const DeferredFade& _b) {
+                         return _a.region > _b.region;
+                     });
+
+    m_fadeStartBudget = std::max(size_t(MIN_FADE_STARTS_PER_FRAME),
+                                 (m_deferredFades.size() + MAX_FADE_SPREAD_FRAMES - 1)
+                                     / MAX_FADE_SPREAD_FRAMES);
+
+    // The first slice starts right away; small batches complete here
+    startPendingFades(screenSize, _dt, _time);
 }
 
 const std::vector<TouchItem>& Labels::getFeaturesAtPoint(const View& _view, float _dt,
@@ -336,10 +508,11 @@ const std::vector<TouchItem>& Labels::getFeaturesAtPoint(const View& _view, floa
             auto labelMesh = dynamic_cast<const LabelSet*>(mesh.get());
             if (!labelMesh) { continue; }
 
-            for (auto& label : labelMesh->getLabels()) {
+            // Only the pre-indexed interactive labels can be picked;
+            // meshes without any are skipped wholesale
+            for (auto* label : labelMesh->getInteractiveLabels()) {
 
                 auto& options = label->options();
-                if (!options.interactive) { continue; }
 
                 if (!_visibleOnly) {
                     label->updateScreenTransform(mvp, screenSize, false);
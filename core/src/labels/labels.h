@@ -2,6 +2,7 @@
 
 #include "label.h"
 #include "spriteLabel.h"
+#include "spatialGrid.h"
 #include "tile/tileID.h"
 #include "data/properties.h"
 #include "isect2d.h"
@@ -12,6 +13,7 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <set>
 
 #define PERF_TRACE __attribute__ ((noinline))
@@ -34,10 +36,12 @@ public:
 
     void drawDebug(const View& _view);
 
-    void updateLabelSet(const View& _view, float _dt, const std::vector<std::unique_ptr<Style>>& _styles,
-                        const std::vector<std::shared_ptr<Tile>>& _tiles, std::unique_ptr<TileCache>& _cache);
+    void updateLabelSet(const View& _view, float _dt, float _time,
+                        const std::vector<std::unique_ptr<Style>>& _styles,
+                        const std::vector<std::shared_ptr<Tile>>& _tiles, TileCache& _cache);
 
-    PERF_TRACE void updateLabels(const View& _view, float _dt, const std::vector<std::unique_ptr<Style>>& _styles,
+    PERF_TRACE void updateLabels(const View& _view, float _dt, float _time,
+                                 const std::vector<std::unique_ptr<Style>>& _styles,
                                  const std::vector<std::shared_ptr<Tile>>& _tiles, bool _onlyTransitions = true);
 
     const std::vector<TouchItem>& getFeaturesAtPoint(const View& _view, float _dt,
@@ -47,6 +51,11 @@ public:
 
     bool needUpdate() const { return m_needUpdate; }
 
+    // Drops all bookkeeping that points into tile meshes. Must be
+    // called when a new scene is set: the old scene's tiles go away
+    // with it and the persistent grid would keep dangling pointers.
+    void clear();
+
 private:
 
     using AABB = isect2d::AABB<glm::vec2>;
@@ -56,7 +65,7 @@ private:
 
     void skipTransitions(const std::vector<std::unique_ptr<Style>>& _styles,
                          const std::vector<std::shared_ptr<Tile>>& _tiles,
-                         std::unique_ptr<TileCache>& _cache, float _currentZoom) const;
+                         TileCache& _cache, float _currentZoom) const;
 
     PERF_TRACE void skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const;
 
@@ -66,9 +75,27 @@ private:
 
     PERF_TRACE bool withinRepeatDistance(Label *_label);
 
+    void startPendingFades(const glm::vec2& _screenSize, float _dt, float _time);
+
     bool m_needUpdate;
 
-    isect2d::ISect2D<glm::vec2> m_isect2d;
+    // Persistent broad-phase for handleOcclusions; stationary labels
+    // keep their grid cells between frames.
+    SpatialGrid m_grid;
+
+    // Priority order assigned to the labels placed in the current
+    // handleOcclusions pass; rebuilt each pass.
+    std::unordered_map<Label*, int> m_labelOrder;
+
+    // Cross-tile identity index of the current pass: the same feature
+    // is built independently in every tile it crosses, so its copies
+    // collapse to the first (highest-ranked) entry here instead of
+    // each paying for a grid slot and collision tests.
+    std::unordered_set<size_t> m_dedupKeys;
+
+    // Scratch set of the labels collected for the current pass, used
+    // to purge grid entries of labels that died with evicted tiles.
+    std::unordered_set<Label*> m_liveLabels;
 
     std::vector<TouchItem> m_touchItems;
 
@@ -89,7 +116,28 @@ private:
 
     std::vector<LabelEntry> m_labels;
 
-    std::unordered_map<size_t, std::vector<Label*>> m_repeatGroups;
+    // Per-tile bookkeeping for the transition-only update path. A
+    // tile whose mvp is unchanged and whose labels finished animating
+    // is skipped entirely on idle frames. Cleared whenever a full
+    // updateLabelSet pass runs.
+    struct TileLabelState {
+        glm::mat4 mvp;
+        bool active;
+    };
+    std::unordered_map<const Tile*, TileLabelState> m_tileStates;
+
+    // Transition starts deferred past the per-frame budget, with the
+    // occlusion result of the pass that scheduled them. Released a
+    // budget's worth per frame, ordered by screen region so the
+    // stagger reads as a sweep. Rebuilt on every full updateLabelSet
+    // pass, so the label pointers never outlive their tiles.
+    struct DeferredFade {
+        Label* label;
+        bool occluded;
+        int region;
+    };
+    std::vector<DeferredFade> m_deferredFades;
+    size_t m_fadeStartBudget = 0;
 
     float m_lastZoom;
 };
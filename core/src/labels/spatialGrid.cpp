@@ -0,0 +1,116 @@
+#include "labels/spatialGrid.h"
+
+#include "labels/label.h"
+
+#include <algorithm>
+
+namespace Tangram {
+
+void SpatialGrid::resize(glm::vec2 _cellSize, glm::vec2 _screenSize) {
+
+    int cols = std::max(1, int(_screenSize.x / _cellSize.x));
+    int rows = std::max(1, int(_screenSize.y / _cellSize.y));
+
+    if (cols == m_cols && rows == m_rows && _cellSize == m_cellSize) {
+        return;
+    }
+
+    m_cols = cols;
+    m_rows = rows;
+    m_cellSize = { _screenSize.x / cols, _screenSize.y / rows };
+
+    m_cells.assign(m_cols * m_rows, {});
+    m_entries.clear();
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsFor(const AABB& _aabb) const {
+
+    CellRange range;
+    range.x0 = std::max(0, std::min(m_cols - 1, int(_aabb.min.x / m_cellSize.x)));
+    range.y0 = std::max(0, std::min(m_rows - 1, int(_aabb.min.y / m_cellSize.y)));
+    range.x1 = std::max(0, std::min(m_cols - 1, int(_aabb.max.x / m_cellSize.x)));
+    range.y1 = std::max(0, std::min(m_rows - 1, int(_aabb.max.y / m_cellSize.y)));
+
+    return range;
+}
+
+void SpatialGrid::insertCells(Label* _label, const CellRange& _range) {
+    for (int y = _range.y0; y <= _range.y1; y++) {
+        for (int x = _range.x0; x <= _range.x1; x++) {
+            m_cells[y * m_cols + x].push_back(_label);
+        }
+    }
+}
+
+void SpatialGrid::removeCells(Label* _label, const CellRange& _range) {
+    for (int y = _range.y0; y <= _range.y1; y++) {
+        for (int x = _range.x0; x <= _range.x1; x++) {
+            auto& cell = m_cells[y * m_cols + x];
+            auto it = std::find(cell.begin(), cell.end(), _label);
+            if (it != cell.end()) {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+void SpatialGrid::update(Label* _label, const AABB& _aabb) {
+
+    CellRange range = cellsFor(_aabb);
+
+    auto it = m_entries.find(_label);
+    if (it == m_entries.end()) {
+        insertCells(_label, range);
+        m_entries.emplace(_label, Entry{ range, m_frame });
+        return;
+    }
+
+    if (!(it->second.range == range)) {
+        removeCells(_label, it->second.range);
+        insertCells(_label, range);
+        it->second.range = range;
+    }
+    it->second.lastFrame = m_frame;
+}
+
+void SpatialGrid::remove(Label* _label) {
+
+    auto it = m_entries.find(_label);
+    if (it == m_entries.end()) { return; }
+
+    removeCells(_label, it->second.range);
+    m_entries.erase(it);
+}
+
+void SpatialGrid::prune() {
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.lastFrame != m_frame) {
+            removeCells(it->first, it->second.range);
+            it = m_entries.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void SpatialGrid::retain(const std::unordered_set<Label*>& _live) {
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (_live.find(it->first) == _live.end()) {
+            removeCells(it->first, it->second.range);
+            it = m_entries.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void SpatialGrid::clear() {
+
+    for (auto& cell : m_cells) { cell.clear(); }
+    m_entries.clear();
+}
+
+}
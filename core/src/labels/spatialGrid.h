@@ -0,0 +1,99 @@
+#pragma once
+
+#include "isect2d.h"
+#include "glm_vec.h" // for isect2d.h
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Tangram {
+
+class Label;
+
+/* Persistent screen-space broad-phase grid for label occlusion.
+ *
+ * Labels keep their cell assignment across frames and are only
+ * re-bucketed when their screen AABB moved into different cells, so
+ * an update where most labels are stationary (e.g. only tiles
+ * changed, or a fade running) touches almost nothing, while a pan or
+ * zoom degrades gracefully to a full rebuild. Entries not refreshed
+ * during a frame are dropped by prune().
+ */
+class SpatialGrid {
+
+public:
+
+    using AABB = isect2d::AABB<glm::vec2>;
+
+    /* Resizes the grid; clears all entries when dimensions change */
+    void resize(glm::vec2 _cellSize, glm::vec2 _screenSize);
+
+    /* Begins a new frame of updates */
+    void startFrame() { m_frame++; }
+
+    /* Syncs _label's cells with _aabb and marks it live this frame */
+    void update(Label* _label, const AABB& _aabb);
+
+    /* Removes _label from its cells */
+    void remove(Label* _label);
+
+    /* Drops entries that were not updated during this frame */
+    void prune();
+
+    /* Drops entries whose label is not in _live. Touches only the
+     * stored pointers, so it is safe to call while some entries
+     * already dangle. */
+    void retain(const std::unordered_set<Label*>& _live);
+
+    /* Drops all entries */
+    void clear();
+
+    /* Calls _fn for every label sharing a cell with _aabb. A label
+     * spanning several of the aabb's cells is reported once per
+     * shared cell. */
+    template<typename Fn>
+    void forEachCandidate(const AABB& _aabb, Fn _fn) const {
+        CellRange range = cellsFor(_aabb);
+
+        for (int y = range.y0; y <= range.y1; y++) {
+            for (int x = range.x0; x <= range.x1; x++) {
+                for (auto* other : m_cells[y * m_cols + x]) {
+                    _fn(other);
+                }
+            }
+        }
+    }
+
+private:
+
+    struct CellRange {
+        int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+
+        bool operator==(const CellRange& _other) const {
+            return x0 == _other.x0 && y0 == _other.y0 &&
+                   x1 == _other.x1 && y1 == _other.y1;
+        }
+    };
+
+    struct Entry {
+        CellRange range;
+        uint32_t lastFrame = 0;
+    };
+
+    CellRange cellsFor(const AABB& _aabb) const;
+
+    void insertCells(Label* _label, const CellRange& _range);
+    void removeCells(Label* _label, const CellRange& _range);
+
+    int m_cols = 0;
+    int m_rows = 0;
+    glm::vec2 m_cellSize { 0 };
+
+    uint32_t m_frame = 0;
+
+    std::vector<std::vector<Label*>> m_cells;
+    std::unordered_map<Label*, Entry> m_entries;
+};
+
+}
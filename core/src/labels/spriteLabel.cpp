@@ -8,7 +8,6 @@ namespace Tangram {
 using namespace LabelProperty;
 
 const float SpriteVertex::position_scale = 4.0f;
-const float SpriteVertex::alpha_scale = 65535.0f;
 const float SpriteVertex::texture_scale = 65535.0f;
 
 SpriteLabel::SpriteLabel(Label::Transform _transform, glm::vec2 _size, Label::Options _options,
@@ -61,11 +60,12 @@ void SpriteLabel::pushTransform() {
 
     auto& quad = m_labels.quads[m_labelsPos];
 
-    SpriteVertex::State state {
-        quad.color,
-        uint16_t(m_transform.state.alpha * SpriteVertex::alpha_scale),
-        0,
-    };
+    // Modulate the base alpha into the color's alpha byte; while a
+    // shader-evaluated fade runs, the base is full alpha and the
+    // vertex shader applies the fade factor
+    uint32_t alpha = uint32_t((fadeActive() ? 1.f : m_transform.state.alpha) * 255.f);
+    uint32_t color = (quad.color & 0x00ffffff) |
+                     ((((quad.color >> 24) * alpha) / 255) << 24);
 
     auto& style = m_labels.m_style;
 
@@ -73,12 +73,15 @@ void SpriteLabel::pushTransform() {
 
     glm::i16vec2 sp = glm::i16vec2(m_transform.state.screenPos * SpriteVertex::position_scale);
 
+    glm::u16vec4 fade = fadeVertexAttrib();
+
     for (int i = 0; i < 4; i++) {
         SpriteVertex& v = quadVertices[i];
         v.pos = sp + quad.quad[i].pos;
         v.uv = quad.quad[i].uv;
         //v.extrude = quad.quad[i].extrude;
-        v.state = state;
+        v.color = color;
+        v.fade = fade;
     }
 }
 
@@ -8,17 +8,18 @@ namespace Tangram {
 class SpriteLabels;
 class PointStyle;
 
+// 20 bytes per vertex; the base alpha is folded into the color's
+// alpha byte when quads are pushed, so no separate alpha/scale
+// attributes are streamed for sprites (unlike TextVertex). Fade
+// transitions are evaluated in the shader from the fade attribute.
 struct SpriteVertex {
     glm::i16vec2 pos;
     glm::u16vec2 uv;
-    struct State {
-        uint32_t color;
-        uint16_t alpha;
-        uint16_t scale;
-    } state;
+    uint32_t color;
+    // Packed fade parameters, see Label::fadeVertexAttrib()
+    glm::u16vec4 fade;
 
     static const float position_scale;
-    static const float alpha_scale;
     static const float texture_scale;
 };
 
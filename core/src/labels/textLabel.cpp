@@ -5,6 +5,8 @@
 #include "gl/dynamicQuadMesh.h"
 #include "util/geom.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 using namespace LabelProperty;
@@ -13,9 +15,11 @@ const float TextVertex::position_scale = 4.0f;
 const float TextVertex::alpha_scale = 65535.0f;
 
 TextLabel::TextLabel(Label::Transform _transform, Type _type, Label::Options _options,
-                     Anchor _anchor, TextLabel::FontVertexAttributes _attrib,
+                     Anchor _anchor, std::vector<Anchor> _anchors,
+                     TextLabel::FontVertexAttributes _attrib,
                      glm::vec2 _dim,  TextLabels& _labels, Range _vertexRange)
     : Label(_transform, _dim, _type, _options, _anchor),
+      m_anchors(std::move(_anchors)),
       m_textLabels(_labels),
       m_vertexRange(_vertexRange),
       m_fontAttrib(_attrib) {
@@ -27,6 +31,30 @@ void TextLabel::applyAnchor(const glm::vec2& _dimension, const glm::vec2& _origi
     m_anchor = _origin + LabelProperty::anchorDirection(_anchor) * _dimension * 0.5f;
 }
 
+size_t TextLabel::anchorCount() const {
+    // Linked labels get their anchor from the parent and line labels
+    // are placed along their segment - neither can be re-anchored
+    if (m_parent || m_type != Type::point) { return 1; }
+
+    return std::max<size_t>(1, m_anchors.size());
+}
+
+bool TextLabel::setAnchorIndex(size_t _index) {
+    if (_index >= anchorCount() || m_anchors.empty()) { return false; }
+
+    glm::vec2 previous = m_anchor;
+
+    m_anchorType = m_anchors[_index];
+    applyAnchor(m_dim, glm::vec2(0.0), m_anchorType);
+
+    // Shift the screen position of the running pass; later updates
+    // re-derive it from the model position and the new anchor
+    m_transform.state.screenPos += m_anchor - previous;
+    updateBBoxes(0);
+
+    return true;
+}
+
 void TextLabel::updateBBoxes(float _zoomFract) {
 
     glm::vec2 dim = m_dim - m_options.buffer;
@@ -41,17 +69,28 @@ void TextLabel::updateBBoxes(float _zoomFract) {
                 dim.x, dim.y);
 }
 
+// Streams the label's glyph quads into the style's per-atlas dynamic
+// mesh. Only labels in a visible state are pushed, so the per-frame
+// vertex stream is bounded by what is on screen, and the static quad
+// geometry in m_textLabels.quads is built once per tile; this pass
+// only adds the screen transform and fade state.
 void TextLabel::pushTransform() {
     if (!visibleState()) { return; }
 
     bool rotate = (m_transform.state.rotation.x != 1.f);
     glm::vec2 rotation = {m_transform.state.rotation.x, -m_transform.state.rotation.y};
 
+    // While a shader-evaluated fade runs, quads carry full alpha and
+    // the vertex shader applies the fade factor - the bytes pushed
+    // each frame of the transition stay identical.
+    float alpha = fadeActive() ? 1.f : m_transform.state.alpha;
+
     TextVertex::State state {
         m_fontAttrib.fill,
         m_fontAttrib.stroke,
-        uint16_t(m_transform.state.alpha * TextVertex::alpha_scale),
+        uint16_t(alpha * TextVertex::alpha_scale),
         uint16_t(m_fontAttrib.fontScale),
+        fadeVertexAttrib(),
     };
 
     auto it = m_textLabels.quads.begin() + m_vertexRange.start;
@@ -61,9 +100,9 @@ void TextLabel::pushTransform() {
     glm::i16vec2 sp = glm::i16vec2(m_transform.state.screenPos * TextVertex::position_scale);
 
     for (; it != end; ++it) {
-        auto quad = *it;
+        const auto& quad = *it;
 
-        auto* quadVertices = style.getMesh(it->atlas).pushQuad();
+        auto* quadVertices = style.getMesh(quad.atlas).pushQuad();
         for (int i = 0; i < 4; i++) {
             TextVertex& v = quadVertices[i];
             if (rotate) {
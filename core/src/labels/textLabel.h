@@ -25,6 +25,8 @@ struct TextVertex {
         uint32_t stroke;
         uint16_t alpha;
         uint16_t scale;
+        // Packed fade parameters, see Label::fadeVertexAttrib()
+        glm::u16vec4 fade;
     } state;
 
     const static float position_scale;
@@ -42,11 +44,16 @@ public:
     };
 
     TextLabel(Label::Transform _transform, Type _type, Label::Options _options,
-              LabelProperty::Anchor _anchor, TextLabel::FontVertexAttributes _attrib,
+              LabelProperty::Anchor _anchor, std::vector<LabelProperty::Anchor> _anchors,
+              TextLabel::FontVertexAttributes _attrib,
               glm::vec2 _dim, TextLabels& _labels, Range _vertexRange);
 
     void updateBBoxes(float _zoomFract) override;
 
+    size_t anchorCount() const override;
+
+    bool setAnchorIndex(size_t _index) override;
+
     Range& quadRange() { return m_vertexRange; }
 
 protected:
@@ -57,6 +64,10 @@ private:
     void applyAnchor(const glm::vec2& _dimension, const glm::vec2& _origin,
                      LabelProperty::Anchor _anchor) override;
 
+    // Fallback anchor placements in try-order; empty for single-anchor
+    // labels, otherwise [0] is the primary anchor
+    std::vector<LabelProperty::Anchor> m_anchors;
+
     // Back-pointer to owning container
     const TextLabels& m_textLabels;
     // first vertex and count in m_textLabels quads
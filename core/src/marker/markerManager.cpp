@@ -0,0 +1,366 @@
+#include "markerManager.h"
+
+#include "platform.h"
+#include "gl/renderState.h"
+#include "gl/vertexLayout.h"
+#include "util/builders.h"
+#include "util/geom.h"
+#include "util/mapProjection.h"
+#include "view/view.h"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace Tangram {
+
+MarkerManager::MarkerManager() {
+
+    auto vertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+        {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+    }));
+
+    m_mesh = std::make_unique<DynamicQuadMesh<MarkerVertex>>(vertexLayout, GL_TRIANGLES);
+
+    std::string vertShaderSrcStr = R"END(
+        #ifdef GL_ES
+        precision mediump float;
+        #endif
+        uniform mat4 u_proj;
+        attribute vec2 a_position;
+        attribute vec4 a_color;
+        varying vec4 v_color;
+        void main() {
+            v_color = a_color;
+            gl_Position = u_proj * vec4(a_position, 0.0, 1.0);
+        }
+    )END";
+    std::string fragShaderSrcStr = R"END(
+        #ifdef GL_ES
+        precision mediump float;
+        #endif
+        varying vec4 v_color;
+        void main(void) {
+            gl_FragColor = v_color;
+        }
+    )END";
+
+    m_shader = std::make_unique<ShaderProgram>();
+    m_shader->setSourceStrings(fragShaderSrcStr, vertShaderSrcStr);
+
+    m_polylineLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+        {"a_extrude", 2, GL_FLOAT, false, 0},
+        {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+    }));
+
+    // Positions are world meters relative to the mesh anchor; the line
+    // width is applied here from the per-vertex extrusion normal, so a
+    // zoom only changes u_meters_per_pixel and never touches the mesh
+    std::string polylineVertSrcStr = R"END(
+        #ifdef GL_ES
+        precision highp float;
+        #endif
+        uniform mat4 u_mvp;
+        uniform float u_meters_per_pixel;
+        attribute vec2 a_position;
+        attribute vec2 a_extrude;
+        attribute vec4 a_color;
+        varying vec4 v_color;
+        void main() {
+            v_color = a_color;
+            vec2 pos = a_position + a_extrude * u_meters_per_pixel;
+            gl_Position = u_mvp * vec4(pos, 0.0, 1.0);
+        }
+    )END";
+    std::string polylineFragSrcStr = R"END(
+        #ifdef GL_ES
+        precision mediump float;
+        #endif
+        varying vec4 v_color;
+        void main(void) {
+            gl_FragColor = v_color;
+        }
+    )END";
+
+    m_polylineShader = std::make_unique<ShaderProgram>();
+    m_polylineShader->setSourceStrings(polylineFragSrcStr, polylineVertSrcStr);
+}
+
+MarkerManager::~MarkerManager() {}
+
+MarkerID MarkerManager::add(double _lng, double _lat, float _size, unsigned int _color) {
+
+    static MercatorProjection projection;
+
+    glm::dvec2 meters = projection.LonLatToMeters({ _lng, _lat });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_markers[slot] = { meters, _size, _color, true };
+    } else {
+        slot = m_markers.size();
+        m_markers.push_back({ meters, _size, _color, true });
+    }
+    m_count++;
+
+    requestRender(RenderDirty::full);
+
+    return MarkerID(slot + 1);
+}
+
+MarkerID MarkerManager::addPolyline(const double* _coordinates, size_t _count, float _width,
+                                    unsigned int _color) {
+
+    if (_count < 2) { return 0; }
+
+    static MercatorProjection projection;
+
+    std::vector<glm::dvec2> points;
+    points.reserve(_count);
+    for (size_t i = 0; i < _count; i++) {
+        points.push_back(projection.LonLatToMeters({ _coordinates[i * 2],
+                                                     _coordinates[i * 2 + 1] }));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_markers[slot] = { points[0], _width, _color, true, std::move(points) };
+    } else {
+        slot = m_markers.size();
+        m_markers.push_back({ points[0], _width, _color, true, std::move(points) });
+    }
+    m_count++;
+    m_polylineCount++;
+    m_polylinesDirty = true;
+
+    requestRender(RenderDirty::full);
+
+    return MarkerID(slot + 1);
+}
+
+bool MarkerManager::setPolylinePoints(MarkerID _id, const double* _coordinates, size_t _count) {
+
+    if (_count < 2) { return false; }
+
+    static MercatorProjection projection;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t slot = size_t(_id) - 1;
+    if (_id == 0 || slot >= m_markers.size() || !m_markers[slot].active ||
+        m_markers[slot].points.empty()) {
+        return false;
+    }
+
+    auto& points = m_markers[slot].points;
+    points.clear();
+    points.reserve(_count);
+    for (size_t i = 0; i < _count; i++) {
+        points.push_back(projection.LonLatToMeters({ _coordinates[i * 2],
+                                                     _coordinates[i * 2 + 1] }));
+    }
+    m_polylinesDirty = true;
+
+    requestRender(RenderDirty::full);
+
+    return true;
+}
+
+bool MarkerManager::setPosition(MarkerID _id, double _lng, double _lat) {
+    // setPositions expects interleaved lng/lat pairs; the two scalar
+    // parameters are not adjacent in memory.
+    double coordinates[2] = { _lng, _lat };
+    return setPositions(&_id, coordinates, 1) == 1;
+}
+
+size_t MarkerManager::setPositions(const MarkerID* _ids, const double* _coordinates, size_t _count) {
+
+    static MercatorProjection projection;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t moved = 0;
+    for (size_t i = 0; i < _count; i++) {
+        size_t slot = size_t(_ids[i]) - 1;
+        if (_ids[i] == 0 || slot >= m_markers.size() || !m_markers[slot].active ||
+            !m_markers[slot].points.empty()) {
+            continue;
+        }
+        m_markers[slot].meters = projection.LonLatToMeters({ _coordinates[i * 2],
+                                                             _coordinates[i * 2 + 1] });
+        moved++;
+    }
+
+    if (moved > 0) { requestRender(RenderDirty::full); }
+
+    return moved;
+}
+
+bool MarkerManager::remove(MarkerID _id) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t slot = size_t(_id) - 1;
+    if (_id == 0 || slot >= m_markers.size() || !m_markers[slot].active) {
+        return false;
+    }
+    m_markers[slot].active = false;
+    if (!m_markers[slot].points.empty()) {
+        m_markers[slot].points.clear();
+        m_polylineCount--;
+        m_polylinesDirty = true;
+    }
+    m_freeSlots.push_back(slot);
+    m_count--;
+
+    requestRender(RenderDirty::full);
+
+    return true;
+}
+
+void MarkerManager::removeAll() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_markers.clear();
+    m_freeSlots.clear();
+    m_count = 0;
+    if (m_polylineCount > 0) {
+        m_polylineCount = 0;
+        m_polylinesDirty = true;
+    }
+
+    requestRender(RenderDirty::full);
+}
+
+void MarkerManager::buildPolylineMesh() {
+
+    if (m_polylineCount == 0) {
+        m_polylineMesh.reset();
+        return;
+    }
+
+    MeshData<PolylineVertex> data;
+
+    GLuint color = 0xffffffff;
+    float halfWidth = 1.f;
+
+    // Round caps and joins; annotation lines are typically routes and
+    // tracks drawn wide enough for bevel corners to show
+    PolyLineBuilder builder([&](const glm::vec3& coord, const glm::vec2& enormal, const glm::vec2& uv) {
+        data.vertices.push_back({ glm::vec2(coord.x, coord.y), enormal * halfWidth, color });
+    }, CapTypes::round, JoinTypes::round);
+
+    bool first = true;
+    Line line;
+
+    for (const auto& marker : m_markers) {
+        if (!marker.active || marker.points.size() < 2) { continue; }
+
+        if (first) {
+            m_polylineOrigin = marker.points[0];
+            first = false;
+        }
+
+        color = marker.color;
+        halfWidth = marker.size * 0.5f;
+
+        line.clear();
+        line.reserve(marker.points.size());
+        for (const auto& p : marker.points) {
+            line.push_back(Point(p.x - m_polylineOrigin.x, p.y - m_polylineOrigin.y, 0.f));
+        }
+
+        Builders::buildPolyLine(line, builder);
+
+        data.indices.insert(data.indices.end(),
+                            builder.indices.begin(),
+                            builder.indices.end());
+        data.offsets.emplace_back(builder.indices.size(), builder.numVertices);
+        builder.clear();
+    }
+
+    m_polylineMesh = std::make_unique<Mesh<PolylineVertex>>(m_polylineLayout,
+                                                            GL_TRIANGLES, GL_DYNAMIC_DRAW);
+    m_polylineMesh->compile(std::move(data));
+}
+
+void MarkerManager::draw(View& _view, float _pixelScale) {
+
+    m_mesh->clear();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_polylinesDirty) {
+            buildPolylineMesh();
+            m_polylinesDirty = false;
+        }
+
+        if (m_count == 0) { return; }
+
+        glm::vec2 screenSize(_view.getWidth(), _view.getHeight());
+        const glm::mat4 viewProj = _view.getViewProjectionMatrix();
+        const glm::dvec3& viewPos = _view.getPosition();
+
+        for (const auto& marker : m_markers) {
+            if (!marker.active || !marker.points.empty()) { continue; }
+
+            bool clipped = false;
+            glm::vec2 screen = worldToScreenSpace(viewProj,
+                glm::vec4(marker.meters.x - viewPos.x, marker.meters.y - viewPos.y, 0.0, 1.0),
+                screenSize, clipped);
+
+            if (clipped) { continue; }
+
+            float half = marker.size * _pixelScale * 0.5f;
+
+            auto* quad = m_mesh->pushQuad();
+            quad[0] = {{ screen.x - half, screen.y - half }, marker.color};
+            quad[1] = {{ screen.x + half, screen.y - half }, marker.color};
+            quad[2] = {{ screen.x - half, screen.y + half }, marker.color};
+            quad[3] = {{ screen.x + half, screen.y + half }, marker.color};
+        }
+    }
+
+    if (m_mesh->numberOfVertices() == 0 && !m_polylineMesh) { return; }
+
+    RenderState::blending(GL_TRUE);
+    RenderState::blendingFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::depthTest(GL_FALSE);
+    RenderState::depthWrite(GL_FALSE);
+    RenderState::culling(GL_FALSE);
+
+    // Polylines draw below point markers, in world space: the mvp only
+    // folds in the view each frame while the mesh stays untouched
+    if (m_polylineMesh && m_polylineShader->use()) {
+        const glm::dvec3& viewPos = _view.getPosition();
+        glm::mat4 mvp = _view.getViewProjectionMatrix() *
+            glm::translate(glm::mat4(1.f), glm::vec3(float(m_polylineOrigin.x - viewPos.x),
+                                                     float(m_polylineOrigin.y - viewPos.y), 0.f));
+        m_polylineShader->setUniformMatrix4f(m_uMvp, mvp);
+        m_polylineShader->setUniformf(m_uMetersPerPixel,
+                                      _pixelScale / _view.pixelsPerMeter());
+
+        m_polylineMesh->draw(*m_polylineShader);
+    }
+
+    if (m_mesh->numberOfVertices() > 0 && m_shader->use()) {
+        glm::mat4 proj = glm::ortho(0.f, _view.getWidth(), _view.getHeight(), 0.f, -1.f, 1.f);
+        m_shader->setUniformMatrix4f(m_uProj, proj);
+
+        m_mesh->upload();
+        m_mesh->draw(*m_shader);
+    }
+
+    RenderState::culling(GL_TRUE);
+}
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "gl/dynamicQuadMesh.h"
+#include "gl/shaderProgram.h"
+#include "glm/vec2.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+class View;
+
+typedef unsigned int MarkerID;
+
+/* Dynamic point and polyline annotations drawn above tile geometry.
+ *
+ * Markers live outside the tile pipeline: positions are plain mercator
+ * coordinates updated in place, and the quads are rebuilt into a single
+ * GL_DYNAMIC_DRAW mesh each frame. Moving markers therefore costs one
+ * sub-buffer upload instead of re-tiling a client data source.
+ *
+ * Polyline annotations keep a persistent world-space mesh with the
+ * line width expanded in the vertex shader, so panning and zooming
+ * touch only uniforms; the mesh is re-tessellated and re-uploaded
+ * only when an annotation is added, changed or removed.
+ */
+class MarkerManager {
+
+public:
+
+    MarkerManager();
+    ~MarkerManager();
+
+    /* Add a marker at the given longitude and latitude, drawn as a quad
+     * of _size logical pixels with the given ABGR color; returns its id */
+    MarkerID add(double _lng, double _lat, float _size, unsigned int _color);
+
+    /* Add a polyline annotation from _count interleaved longitude,
+     * latitude pairs, drawn _width logical pixels wide with the given
+     * ABGR color. Shares the id space with point markers and is removed
+     * the same way; returns 0 when fewer than two points are given. */
+    MarkerID addPolyline(const double* _coordinates, size_t _count, float _width, unsigned int _color);
+
+    /* Replace the points of a polyline annotation; returns false for an
+     * unknown, removed or non-polyline id or fewer than two points */
+    bool setPolylinePoints(MarkerID _id, const double* _coordinates, size_t _count);
+
+    /* Move one marker; returns false for an unknown or removed id */
+    bool setPosition(MarkerID _id, double _lng, double _lat);
+
+    /* Move _count markers at once; _coordinates holds interleaved
+     * longitude, latitude pairs. Returns the number of markers moved. */
+    size_t setPositions(const MarkerID* _ids, const double* _coordinates, size_t _count);
+
+    /* Remove one marker; returns false for an unknown or removed id */
+    bool remove(MarkerID _id);
+
+    void removeAll();
+
+    size_t size() const { return m_count; }
+
+    /* Rebuild and draw the marker mesh for the current view; called
+     * once per frame on the GL thread */
+    void draw(View& _view, float _pixelScale);
+
+private:
+
+    struct Marker {
+        glm::dvec2 meters;
+        float size;
+        unsigned int color;
+        bool active;
+        // Polyline annotations only; empty for point markers. 'size'
+        // then holds the line width in logical pixels.
+        std::vector<glm::dvec2> points;
+    };
+
+    struct MarkerVertex {
+        glm::vec2 pos;
+        GLuint color;
+    };
+
+    struct PolylineVertex {
+        // Meters relative to m_polylineOrigin
+        glm::vec2 pos;
+        // Tesselation normal scaled by half the line width in logical
+        // pixels; expanded to meters in the vertex shader
+        glm::vec2 extrude;
+        GLuint color;
+    };
+
+    /* Re-tessellates all polyline annotations into one persistent mesh.
+     * Runs on the GL thread with the marker store locked. */
+    void buildPolylineMesh();
+
+    // Marker ids are indices into this store offset by one; removed
+    // slots stay in place and are reused by later adds.
+    std::vector<Marker> m_markers;
+    std::vector<size_t> m_freeSlots;
+    size_t m_count = 0;
+
+    // Guards the marker store; markers may be added or moved from the
+    // application thread while draw() runs on the GL thread.
+    mutable std::mutex m_mutex;
+
+    std::unique_ptr<DynamicQuadMesh<MarkerVertex>> m_mesh;
+    std::unique_ptr<ShaderProgram> m_shader;
+
+    UniformLocation m_uProj{"u_proj"};
+
+    // Set when a polyline annotation changed; the mesh is rebuilt on
+    // the GL thread at the next draw
+    bool m_polylinesDirty = false;
+    size_t m_polylineCount = 0;
+
+    // Common anchor of the polyline mesh, chosen at rebuild so vertex
+    // positions stay small enough for float precision
+    glm::dvec2 m_polylineOrigin = { 0, 0 };
+
+    std::shared_ptr<VertexLayout> m_polylineLayout;
+    std::unique_ptr<Mesh<PolylineVertex>> m_polylineMesh;
+    std::unique_ptr<ShaderProgram> m_polylineShader;
+
+    UniformLocation m_uMvp{"u_mvp"};
+    UniformLocation m_uMetersPerPixel{"u_meters_per_pixel"};
+
+};
+
+}
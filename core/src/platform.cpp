@@ -0,0 +1,39 @@
+#include "platform.h"
+
+#include <atomic>
+
+// Built on the platform's synchronous bytesFromFile, so every backend
+// gets the overlap without a native async read path of its own.
+std::future<FileData> bytesFromFileAsync(const char* _path) {
+    std::string path(_path);
+
+    return std::async(std::launch::async, [path]() {
+            FileData data;
+            data.bytes = bytesFromFile(path.c_str(), data.size);
+            return data;
+        });
+}
+
+// Highest dirty level requested since the last clearRenderRequest();
+// written from worker threads (network completions, tile builds) and
+// read by the embedder's render loop.
+static std::atomic<unsigned char> s_renderDirty{0};
+
+void requestRender(RenderDirty _dirty) {
+
+    auto level = static_cast<unsigned char>(_dirty);
+    auto prev = s_renderDirty.load();
+    while (prev < level && !s_renderDirty.compare_exchange_weak(prev, level)) {}
+
+    if (_dirty != RenderDirty::none) {
+        requestRender();
+    }
+}
+
+RenderDirty pendingRenderRequest() {
+    return static_cast<RenderDirty>(s_renderDirty.load());
+}
+
+void clearRenderRequest() {
+    s_renderDirty.store(0);
+}
@@ -5,6 +5,7 @@
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <cstdio>
 
 /* Print a formatted message to the console
@@ -20,6 +21,27 @@ using MapReady = std::function<void(void)>;
  */
 void requestRender();
 
+/* Classification of how much of a requested frame needs redrawing */
+enum class RenderDirty : unsigned char {
+    none = 0,   // No visual change is pending
+    labels = 1, // Only the label passes changed (fades, placements)
+    full = 2,   // A full redraw is needed
+};
+
+/* Request a new frame carrying a dirty classification. Requests
+ * coalesce to the highest pending level, readable with
+ * pendingRenderRequest(); an embedder can skip the frame when the
+ * pending level is 'none' or run a reduced pass for 'labels'.
+ */
+void requestRender(RenderDirty _dirty);
+
+/* Returns the highest dirty level requested since the last
+ * clearRenderRequest(); Map::render() clears the level after drawing
+ */
+RenderDirty pendingRenderRequest();
+
+void clearRenderRequest();
+
 /* If called with 'true', the windowing system will re-draw frames continuously;
  * otherwise new frames will only be drawn when 'requestRender' is called.
  */
@@ -45,6 +67,34 @@ std::string stringFromFile(const char* _path);
  */
 unsigned char* bytesFromFile(const char* _path, size_t& _size);
 
+/* Result of an asynchronous file read, see bytesFromFileAsync()
+ *
+ * bytes is allocated like bytesFromFile() and owned by the receiver;
+ * nullptr with size 0 when the file could not be read.
+ */
+struct FileData {
+    unsigned char* bytes = nullptr;
+    size_t size = 0;
+};
+
+/* Begin reading a file in the background
+ *
+ * Returns a future resolving to the contents of the file at _path.
+ * Issue the reads for every file a load will need as soon as their
+ * paths are known and take each result where the bytes are parsed, so
+ * storage latency overlaps the parsing of earlier files instead of
+ * serializing with it.
+ */
+std::future<FileData> bytesFromFileAsync(const char* _path);
+
+/* Resolve a bundle- or asset-relative path to an absolute filesystem path
+ *
+ * On platforms without a resource bundle the path is returned unchanged.
+ * This lets libraries open bundled files lazily by path instead of
+ * receiving their full contents up front.
+ */
+std::string resolveAssetPath(const char* _path);
+
 /* Function type for receiving data from a successful network request */
 using UrlCallback = std::function<void(std::vector<char>&&)>;
 
@@ -19,6 +19,17 @@ public:
     const auto& source() const { return m_source; }
     const auto& collections() const { return m_collections; }
 
+    /* Build-time geometry LOD: interior polygon rings whose drawn
+     * area stays below this many square pixels are dropped before
+     * style building. 0 disables the filter. */
+    float minRingArea() const { return m_minRingArea; }
+    void setMinRingArea(float _minRingArea) { m_minRingArea = _minRingArea; }
+
+private:
+
+    // See minRingArea()
+    float m_minRingArea = 0.f;
+
 };
 
 }
@@ -11,9 +11,48 @@
 #include "util/hash.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace Tangram {
 
+namespace {
+
+// Extent of the feature's bounding box in tile units - the larger of
+// its width and height. Points have no extent to measure.
+float featureExtent(const Feature& _feature) {
+
+    glm::vec2 min(std::numeric_limits<float>::max());
+    glm::vec2 max(std::numeric_limits<float>::lowest());
+
+    auto expand = [&](const Line& _line) {
+        for (const auto& p : _line) {
+            min.x = std::min(min.x, p.x);
+            min.y = std::min(min.y, p.y);
+            max.x = std::max(max.x, p.x);
+            max.y = std::max(max.y, p.y);
+        }
+    };
+
+    switch (_feature.geometryType) {
+    case GeometryType::lines:
+        for (const auto& line : _feature.lines) { expand(line); }
+        break;
+    case GeometryType::polygons:
+        for (const auto& polygon : _feature.polygons) {
+            for (const auto& line : polygon) { expand(line); }
+        }
+        break;
+    default:
+        return 0.f;
+    }
+
+    if (max.x < min.x) { return 0.f; }
+
+    return std::max(max.x - min.x, max.y - min.y);
+}
+
+}
+
 DrawRuleData::DrawRuleData(std::string _name, int _id,
                            std::vector<StyleParam> _parameters)
     : parameters(std::move(_parameters)),
@@ -141,17 +180,11 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
         // Merge rules from layer into accumulated set
         mergeRules(layer);
 
-        // Push each of the layer's matching sublayers onto the stack
-        for (const auto& sublayer : layer.sublayers()) {
-            // Skip matching this sublayer if marked not visible
-            if (!sublayer.visible()) {
-                continue;
-            }
-
-            if (sublayer.filter().eval(_feature, _ctx)) {
-                m_queuedLayers.push_back(&sublayer);
-            }
-        }
+        // Push each of the layer's matching sublayers onto the stack;
+        // invisible sublayers are already dropped from the dispatch
+        // index and sublayers sharing an equality filter key resolve
+        // with a single property lookup.
+        layer.matchSublayers(_feature, _ctx, m_queuedLayers);
     }
 
     return true;
@@ -163,11 +196,16 @@ void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
     // If no rules matched the feature, return immediately
     if (!match(_feature, _layer, _ctx)) { return; }
 
+    // Bounding box extent of the feature, computed on demand for the
+    // first rule with a 'min_feature_size' parameter and shared by
+    // the others.
+    float extent = -1.f;
+
     // For each matched rule, find the style to be used and
     // build the feature with the rule's parameters
     for (auto& rule : m_matchedRules) {
 
-        StyleBuilder* style = _builder.getStyleBuilder(rule.getStyleName());
+        StyleBuilder* style = _builder.getStyleBuilder(rule);
         if (!style) {
             LOGN("Invalid style %s", rule.getStyleName().c_str());
             continue;
@@ -204,16 +242,42 @@ void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
                     }
                 }
             } else if (param->stops) {
+
+                float zoom = _ctx.getKeywordZoom();
+                if (zoom != m_stopsCacheZoom) {
+                    m_stopsCache.clear();
+                    m_stopsCacheZoom = zoom;
+                }
+
                 m_evaluated[i] = *param;
-                param = &m_evaluated[i];
 
-                Stops::eval(*param->stops, param->key, _ctx.getKeywordZoom(),
-                            m_evaluated[i].value);
+                auto cached = m_stopsCache.find(param);
+                if (cached != m_stopsCache.end()) {
+                    m_evaluated[i].value = cached->second;
+                } else {
+                    Stops::eval(*param->stops, param->key, zoom,
+                                m_evaluated[i].value);
+                    m_stopsCache[param] = m_evaluated[i].value;
+                }
+
+                param = &m_evaluated[i];
             }
         }
 
         if (valid) {
 
+            // Drop line and polygon features whose bounding box covers
+            // less than the rule's minimum size in screen pixels at the
+            // built zoom - they would tessellate to sub-pixel geometry.
+            float minSize = 0.f;
+            if (rule.get(StyleParamKey::min_feature_size, minSize) && minSize > 0.f &&
+                _feature.geometryType != GeometryType::points) {
+
+                if (extent < 0.f) { extent = featureExtent(_feature); }
+
+                if (extent * m_pixelsPerTile < minSize) { continue; }
+            }
+
             // build outline explicitly with outline style
             const auto& outlineStyleName = rule.findParameter(StyleParamKey::outline_style);
             if (outlineStyleName) {
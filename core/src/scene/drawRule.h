@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scene/styleParam.h"
+#include "util/fastmap.h"
 
 #include <vector>
 #include <set>
@@ -95,7 +96,7 @@ struct DrawRule {
     template<typename T>
     bool get(StyleParamKey _key, T& _value) const {
         if (auto& param = findParameter(_key)) {
-            return StyleParam::Value::visit(param.value, StyleParam::visitor<T>{ _value });
+            return param.get(_value);
         }
         return false;
     }
@@ -103,7 +104,7 @@ struct DrawRule {
     template<typename T>
     const T* get(StyleParamKey _key) const {
         if (auto& param = findParameter(_key)) {
-            return StyleParam::Value::visit(param.value, StyleParam::visitor_ptr<T>{});
+            return param.getPtr<T>();
         }
         return nullptr;
     }
@@ -122,6 +123,10 @@ public:
     void apply(const Feature& _feature, const SceneLayer& _sceneLayer,
                StyleContext& _ctx, TileBuilder& _builder);
 
+    /* Set the size in screen pixels that one tile unit covers at the
+     * built zoom, for evaluating 'min_feature_size' rule parameters */
+    void setPixelsPerTile(float _pixelsPerTile) { m_pixelsPerTile = _pixelsPerTile; }
+
     // internal
     bool match(const Feature& _feature, const SceneLayer& _layer, StyleContext& _ctx);
 
@@ -138,6 +143,17 @@ private:
     // Container for dynamically-evaluated parameters
     StyleParam m_evaluated[StyleParamKeySize];
 
+    // Stops results only depend on the zoom, which is fixed for all
+    // features of a tile, so evaluated values are memoized per source
+    // parameter until the zoom changes. The parameter pointer
+    // identifies rule and key: merged rules reference the original
+    // StyleParams of the scene layers.
+    fastmap<const StyleParam*, StyleParam::Value> m_stopsCache;
+    float m_stopsCacheZoom = -1;
+
+    // See setPixelsPerTile()
+    float m_pixelsPerTile = 256;
+
 };
 
 }
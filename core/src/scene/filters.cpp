@@ -3,7 +3,10 @@
 #include "data/tileData.h"
 #include "platform.h"
 
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 namespace Tangram {
 
@@ -109,8 +112,11 @@ int Filter::filterCost() const {
         // the chance to fail early check them before Existence
         return 20;
 
-    case Data::type<EqualitySet>::value:
-        return data.get<EqualitySet>().keyword == FilterKeyword::undefined ? 10 : 1;
+    case Data::type<EqualitySet>::value: {
+        auto& f = data.get<EqualitySet>();
+        // Sets compare against each value in turn
+        return f.keyword == FilterKeyword::undefined ? 10 + int(f.values.size()) : 1;
+    }
 
     case Data::type<Equality>::value:
         return data.get<Equality>().keyword == FilterKeyword::undefined ? 10 : 1;
@@ -126,6 +132,37 @@ int Filter::filterCost() const {
     return 0;
 }
 
+int Filter::filterSelectivity() const {
+
+    switch (data.get_type_index()) {
+
+    case Data::type<Existence>::value:
+        // Layers usually filter on keys that their features carry, so a
+        // positive existence check rejects little
+        return data.get<Existence>().exists ? 1 : 4;
+
+    case Data::type<EqualitySet>::value: {
+        auto& f = data.get<EqualitySet>();
+        if (f.keyword != FilterKeyword::undefined) { return 2; }
+        // Each accepted value lets more features through
+        int n = int(f.values.size());
+        return n >= 7 ? 1 : 8 - n;
+    }
+
+    case Data::type<Equality>::value:
+        // A single accepted value rejects most features; keyword keys
+        // ($geometry) only take a handful of values
+        return data.get<Equality>().keyword == FilterKeyword::undefined ? 8 : 2;
+
+    case Data::type<Filter::Range>::value:
+        return 4;
+
+    default:
+        break;
+    }
+    return 0;
+}
+
 const std::string& Filter::key() const {
     static const std::string empty = "";
 
@@ -208,9 +245,9 @@ int compareSetFilter(const Filter& a, const Filter& b) {
 }
 
 
-void Filter::sort(std::vector<Filter>& _filters) {
+void Filter::sort(std::vector<Filter>& _filters, bool _shortCircuitOnMatch) {
     std::sort(_filters.begin(), _filters.end(),
-              [](Filter& a, Filter& b) {
+              [=](Filter& a, Filter& b) {
 
                   // Sort simple filters by eval cost
                   int ma = a.filterCost();
@@ -222,6 +259,14 @@ void Filter::sort(std::vector<Filter>& _filters) {
                           return diff < 0;
                       }
 
+                      // At equal cost run the operand most likely to
+                      // short-circuit the operator first
+                      int sa = a.filterSelectivity();
+                      int sb = b.filterSelectivity();
+                      if (sa != sb) {
+                          return _shortCircuitOnMatch ? sa < sb : sa > sb;
+                      }
+
                       // just for consistent ordering
                       // (and using > to prefer $zoom over $geom)
                       return a.key() > b.key();
@@ -347,25 +392,25 @@ struct matcher {
         return true;
     }
     bool operator() (const Filter::Existence& f) const {
-        return f.exists == props.contains(f.key);
+        return f.exists == props.contains(f.keyId);
     }
     bool operator() (const Filter::EqualitySet& f) const {
         auto& value = (f.keyword == FilterKeyword::undefined)
-            ? props.get(f.key)
+            ? props.get(f.keyId)
             : ctx.getKeyword(f.keyword);
 
         return Value::visit(value, match_equal_set{f.values});
     }
     bool operator() (const Filter::Equality& f) const {
         auto& value = (f.keyword == FilterKeyword::undefined)
-            ? props.get(f.key)
+            ? props.get(f.keyId)
             : ctx.getKeyword(f.keyword);
 
         return Value::visit(value, match_equal{f.value});
     }
     bool operator() (const Filter::Range& f) const {
         auto& value = (f.keyword == FilterKeyword::undefined)
-            ? props.get(f.key)
+            ? props.get(f.keyId)
             : ctx.getKeyword(f.keyword);
 
         return Value::visit(value, match_range{f});
@@ -382,4 +427,225 @@ bool Filter::eval(const Feature& feat, StyleContext& ctx) const {
     return Data::visit(data, matcher(feat, ctx));
 }
 
+// Recognizer for trivial JS predicates of the form
+// 'function() { return <operand> <compare> <operand>; }' where one
+// operand is a feature property or keyword and the other a literal.
+namespace {
+
+struct JsOperand {
+    enum Type { none, property, string, number, geometry };
+    Type type = none;
+    std::string str;
+    double num = 0;
+};
+
+enum class JsCompare { none, eq, neq, lt, lte, gt, gte };
+
+void skipSpace(const char*& p, const char* end) {
+    while (p != end && std::isspace(static_cast<unsigned char>(*p))) { p++; }
+}
+
+bool skipToken(const char*& p, const char* end, const char* token) {
+    size_t len = std::strlen(token);
+    if (size_t(end - p) < len || std::strncmp(p, token, len) != 0) { return false; }
+    p += len;
+    return true;
+}
+
+bool isIdentChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+bool parseIdent(const char*& p, const char* end, std::string& _ident) {
+    if (p == end || std::isdigit(static_cast<unsigned char>(*p)) || !isIdentChar(*p)) {
+        return false;
+    }
+    const char* start = p;
+    while (p != end && isIdentChar(*p)) { p++; }
+    _ident.assign(start, p);
+    return true;
+}
+
+bool parseString(const char*& p, const char* end, std::string& _out) {
+    char quote = *p++;
+    const char* start = p;
+    // bail on escape sequences instead of interpreting them
+    while (p != end && *p != quote) {
+        if (*p == '\\') { return false; }
+        p++;
+    }
+    if (p == end) { return false; }
+    _out.assign(start, p);
+    p++;
+    return true;
+}
+
+bool parseOperand(const char*& p, const char* end, JsOperand& _operand) {
+    skipSpace(p, end);
+    if (p == end) { return false; }
+
+    if (*p == '\'' || *p == '"') {
+        _operand.type = JsOperand::string;
+        return parseString(p, end, _operand.str);
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(*p)) ||
+        *p == '.' || *p == '-' || *p == '+') {
+        char* numEnd = nullptr;
+        _operand.num = std::strtod(p, &numEnd);
+        if (numEnd == p) { return false; }
+        _operand.type = JsOperand::number;
+        p = numEnd;
+        return true;
+    }
+
+    std::string ident;
+    if (!parseIdent(p, end, ident)) { return false; }
+
+    if (ident == "feature") {
+        if (p != end && *p == '.') {
+            p++;
+            _operand.type = JsOperand::property;
+            return parseIdent(p, end, _operand.str);
+        }
+        if (p != end && *p == '[') {
+            p++;
+            skipSpace(p, end);
+            if (p == end || (*p != '\'' && *p != '"')) { return false; }
+            if (!parseString(p, end, _operand.str)) { return false; }
+            skipSpace(p, end);
+            if (p == end || *p != ']') { return false; }
+            p++;
+            _operand.type = JsOperand::property;
+            return true;
+        }
+        return false;
+    }
+
+    if (ident == "$zoom" || ident == "$geometry") {
+        _operand.type = JsOperand::property;
+        _operand.str = ident;
+        return true;
+    }
+
+    // The global geometry constants; only meaningful when compared
+    // against the $geometry keyword.
+    if (ident == "point" || ident == "line" || ident == "polygon") {
+        _operand.type = JsOperand::geometry;
+        _operand.str = ident;
+        return true;
+    }
+
+    return false;
+}
+
+JsCompare parseCompare(const char*& p, const char* end) {
+    skipSpace(p, end);
+    if (skipToken(p, end, "===")) { return JsCompare::eq; }
+    if (skipToken(p, end, "!==")) { return JsCompare::neq; }
+    if (skipToken(p, end, "==")) { return JsCompare::eq; }
+    if (skipToken(p, end, "!=")) { return JsCompare::neq; }
+    if (skipToken(p, end, ">=")) { return JsCompare::gte; }
+    if (skipToken(p, end, "<=")) { return JsCompare::lte; }
+    if (skipToken(p, end, ">")) { return JsCompare::gt; }
+    if (skipToken(p, end, "<")) { return JsCompare::lt; }
+    return JsCompare::none;
+}
+
+Filter buildCompare(const JsOperand& _prop, JsCompare _op, const JsOperand& _literal) {
+
+    switch (_op) {
+    case JsCompare::eq:
+    case JsCompare::neq: {
+        Value value;
+        if (_literal.type == JsOperand::number) {
+            value = _literal.num;
+        } else if (_literal.type == JsOperand::string) {
+            value = _literal.str;
+        } else if (_literal.type == JsOperand::geometry &&
+                   _prop.str == "$geometry") {
+            value = _literal.str;
+        } else {
+            return Filter();
+        }
+        auto filter = Filter::MatchEquality(_prop.str, { value });
+        if (_op == JsCompare::eq) { return filter; }
+        return Filter::MatchNone({ std::move(filter) });
+    }
+    case JsCompare::gte:
+    case JsCompare::lt: {
+        // Range covers [min, max) - the other comparisons have no
+        // exact native equivalent and stay with the JS context.
+        if (_literal.type != JsOperand::number ||
+            _prop.str == "$geometry") {
+            return Filter();
+        }
+        if (_op == JsCompare::gte) {
+            return Filter::MatchRange(_prop.str, _literal.num, INFINITY);
+        }
+        return Filter::MatchRange(_prop.str, -INFINITY, _literal.num);
+    }
+    default:
+        return Filter();
+    }
+}
+
+}
+
+Filter Filter::fromFunctionSource(const std::string& _source) {
+
+    const char* p = _source.data();
+    const char* end = p + _source.size();
+
+    if (!skipToken(p, end, "function")) { return Filter(); }
+    skipSpace(p, end);
+    if (!skipToken(p, end, "(")) { return Filter(); }
+    skipSpace(p, end);
+    if (!skipToken(p, end, ")")) { return Filter(); }
+    skipSpace(p, end);
+    if (!skipToken(p, end, "{")) { return Filter(); }
+    skipSpace(p, end);
+    if (!skipToken(p, end, "return")) { return Filter(); }
+    if (p != end && isIdentChar(*p)) { return Filter(); }
+
+    skipSpace(p, end);
+    bool parens = skipToken(p, end, "(");
+
+    JsOperand lhs, rhs;
+    if (!parseOperand(p, end, lhs)) { return Filter(); }
+
+    JsCompare op = parseCompare(p, end);
+    if (op == JsCompare::none) { return Filter(); }
+
+    if (!parseOperand(p, end, rhs)) { return Filter(); }
+
+    skipSpace(p, end);
+    if (parens && !skipToken(p, end, ")")) { return Filter(); }
+    skipSpace(p, end);
+    skipToken(p, end, ";");
+    skipSpace(p, end);
+    if (!skipToken(p, end, "}")) { return Filter(); }
+    skipSpace(p, end);
+    if (p != end) { return Filter(); }
+
+    // Normalize to (property compare literal), mirroring the
+    // comparison when the literal is on the left.
+    bool lhsIsProp = (lhs.type == JsOperand::property);
+    bool rhsIsProp = (rhs.type == JsOperand::property);
+    if (lhsIsProp == rhsIsProp) { return Filter(); }
+
+    if (rhsIsProp) {
+        std::swap(lhs, rhs);
+        switch (op) {
+        case JsCompare::lt: op = JsCompare::gt; break;
+        case JsCompare::lte: op = JsCompare::gte; break;
+        case JsCompare::gt: op = JsCompare::lt; break;
+        case JsCompare::gte: op = JsCompare::lte; break;
+        default: break;
+        }
+    }
+
+    return buildCompare(lhs, op, rhs);
+}
+
 }
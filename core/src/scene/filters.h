@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/propertyKey.h"
 #include "util/variant.h"
 
 #include <vector>
@@ -27,24 +28,30 @@ struct Filter {
         std::vector<Filter> operands;
     };
 
+    // Property keys are interned at filter creation, so feature
+    // lookups during evaluation compare 32-bit key ids.
     struct EqualitySet {
         std::string key;
+        uint32_t keyId;
         std::vector<Value> values;
         FilterKeyword keyword;
     };
     struct Equality {
         std::string key;
+        uint32_t keyId;
         Value value;
         FilterKeyword keyword;
     };
     struct Range {
         std::string key;
+        uint32_t keyId;
         float min;
         float max;
         FilterKeyword keyword;
     };
     struct Existence {
         std::string key;
+        uint32_t keyId;
         bool exists;
     };
     struct Function {
@@ -68,7 +75,7 @@ struct Filter {
 
     // Create an 'any', 'all', or 'none' filter
     inline static Filter MatchAny(std::vector<Filter> filters) {
-        sort(filters);
+        sort(filters, true);
         return { OperatorAny{ std::move(filters) }};
     }
     inline static Filter MatchAll(std::vector<Filter> filters) {
@@ -82,23 +89,29 @@ struct Filter {
     // Create an 'equality' filter
     inline static Filter MatchEquality(const std::string& k, const std::vector<Value>& vals) {
         if (vals.size() == 1) {
-            return { Equality{ k, vals[0], keywordType(k) }};
+            return { Equality{ k, PropertyKey::intern(k), vals[0], keywordType(k) }};
         } else {
-            return { EqualitySet{ k, vals, keywordType(k) }};
+            return { EqualitySet{ k, PropertyKey::intern(k), vals, keywordType(k) }};
         }
     }
     // Create a 'range' filter
     inline static Filter MatchRange(const std::string& k, float min, float max) {
-        return { Range{ k, min, max, keywordType(k) }};
+        return { Range{ k, PropertyKey::intern(k), min, max, keywordType(k) }};
     }
     // Create an 'existence' filter
     inline static Filter MatchExistence(const std::string& k, bool ex) {
-        return { Existence{ k, ex }};
+        return { Existence{ k, PropertyKey::intern(k), ex }};
     }
     // Create an 'function' filter with reference to Scene function id
     inline static Filter MatchFunction(uint32_t id) {
         return { Function{ id }};
     }
+    // Try to translate a trivial JS predicate source like
+    // "function() { return feature.kind == 'park'; }" into the
+    // equivalent native filter, so evaluating it does not call into
+    // the JS context per feature. Returns a 'none' filter when the
+    // source is not a single simple comparison.
+    static Filter fromFunctionSource(const std::string& source);
 
     static FilterKeyword keywordType(const std::string& _key) {
         if (_key == "$geometry") {
@@ -110,9 +123,17 @@ struct Filter {
     }
 
     /* Public for testing */
-    static void sort(std::vector<Filter>& filters);
+    // Reorder operands so that cheap filters run before expensive ones
+    // and, at equal cost, the operand most likely to short-circuit the
+    // operator runs first. 'all'/'none' short-circuit on a rejection, so
+    // they want the most selective operand first; 'any' short-circuits
+    // on a match and wants the least selective one.
+    static void sort(std::vector<Filter>& filters, bool shortCircuitOnMatch = false);
     void print(int _indent = 0) const;
     int filterCost() const;
+    // Estimated chance that this filter rejects a feature; larger means
+    // more selective. A compile-time stand-in for measured selectivity.
+    int filterSelectivity() const;
     const bool isOperator() const;
     const std::string& key() const;
     const std::vector<Filter>& operands() const;
@@ -4,6 +4,7 @@
 #include "util/topologicalSort.h"
 #include "yaml-cpp/yaml.h"
 
+#include <functional>
 #include <regex>
 
 using YAML::Node;
@@ -13,6 +14,44 @@ namespace Tangram {
 
 std::atomic_uint Importer::progressCounter(0);
 
+// Parsed scene fragments keyed by path, kept for the lifetime of the process
+// so that reloading a scene only re-parses the documents that changed.
+struct SceneFragment {
+    size_t hash = 0;
+    Node node;
+};
+
+static std::mutex s_fragmentMutex;
+static std::map<std::string, SceneFragment> s_fragmentCache;
+
+bool Importer::getCachedFragment(const std::string& scenePath, size_t contentHash, Node& node) {
+
+    std::lock_guard<std::mutex> lock(s_fragmentMutex);
+
+    auto it = s_fragmentCache.find(scenePath);
+    if (it == s_fragmentCache.end()) { return false; }
+    if (contentHash != 0 && it->second.hash != contentHash) { return false; }
+
+    // Nodes share their underlying storage, so hand out a copy that
+    // normalization and merging may mutate freely
+    node = YAML::Clone(it->second.node);
+    return true;
+}
+
+void Importer::cacheFragment(const std::string& scenePath, size_t contentHash, const Node& node) {
+
+    // Failed parses yield a null node - do not remember those
+    if (!node.IsMap()) { return; }
+
+    std::lock_guard<std::mutex> lock(s_fragmentMutex);
+    s_fragmentCache[scenePath] = { contentHash, YAML::Clone(node) };
+}
+
+void Importer::clearFragmentCache() {
+    std::lock_guard<std::mutex> lock(s_fragmentMutex);
+    s_fragmentCache.clear();
+}
+
 bool isUrl(const std::string &path) {
     static const std::regex r("^(http|https):/");
     std::smatch match;
@@ -35,17 +74,20 @@ Node Importer::applySceneImports(const std::string& scenePath, const std::string
             std::unique_lock<std::mutex> lock(sceneMutex);
 
             m_condition.wait(lock, [&, this]{
-                    if (m_sceneQueue.empty()) {
-                        // Not busy at all?
-                        if (progressCounter == 0) { return true; }
-                    } else {
-                        // More work and not completely busy?
-                        if (progressCounter < MAX_SCENE_DOWNLOAD) { return true; }
-                    }
-
-                    return false;
+                    // Wake up for newly discovered imports, parses that are
+                    // ready to merge, or when the last worker is done
+                    return !m_sceneQueue.empty() || !m_parsedScenes.empty()
+                        || progressCounter == 0;
                 });
 
+            // A document may only queue its imports once it is registered,
+            // so drain finished parses before dispatching new ones
+            if (!m_parsedScenes.empty()) {
+                auto parsed = std::move(m_parsedScenes.back());
+                m_parsedScenes.pop_back();
+                processScene(parsed.first, std::move(parsed.second));
+                continue;
+            }
 
             if (m_sceneQueue.empty()) {
                 if (progressCounter == 0) {
@@ -57,53 +99,102 @@ Node Importer::applySceneImports(const std::string& scenePath, const std::string
             path = m_sceneQueue.back();
             m_sceneQueue.pop_back();
 
+            // Skip scenes that are already processed or being fetched
             if (m_scenes.find(path) != m_scenes.end()) { continue; }
+            if (m_pendingScenes.find(path) != m_pendingScenes.end()) { continue; }
+            m_pendingScenes.insert(path);
+
+            if (!isUrl(path)) { m_sceneFiles.push_back(path); }
         }
 
         // TODO: generic handling of uri
         if (isUrl(path)) {
+            m_isCacheable = false;
+
+            // Remote fragments can not be revalidated without fetching them
+            // again, so any cached copy is reused as is; clearFragmentCache()
+            // forces a refresh
+            Node cached;
+            if (getCachedFragment(path, 0, cached)) {
+                std::unique_lock<std::mutex> lock(sceneMutex);
+                m_parsedScenes.emplace_back(path, std::move(cached));
+                continue;
+            }
+
             progressCounter++;
             startUrlRequest(path,
                     [&, p = path](std::vector<char>&& rawData) {
 
                     if (!rawData.empty()) {
+                        std::string sceneString(rawData.data(), rawData.size());
+                        // Parsing is the bulk of the work - keep it off the lock
+                        auto node = parseSceneString(p, sceneString);
+                        cacheFragment(p, std::hash<std::string>()(sceneString), node);
+
                         std::unique_lock<std::mutex> lock(sceneMutex);
-                        processScene(p, std::string(rawData.data(), rawData.size()));
+                        m_parsedScenes.emplace_back(p, std::move(node));
                     }
                     progressCounter--;
                     m_condition.notify_all();
             });
         } else {
-            std::unique_lock<std::mutex> lock(sceneMutex);
-            processScene(path, getSceneString(path));
+            progressCounter++;
+            // Parse local documents on worker threads, so sibling imports of
+            // a large bundle get parsed concurrently
+            m_parseJobs.push_back(std::async(std::launch::async, [&, p = path]{
+                    auto sceneString = getSceneString(p);
+                    auto contentHash = std::hash<std::string>()(sceneString);
+
+                    // Documents whose content did not change since the last
+                    // import skip the parse entirely
+                    Node node;
+                    if (!getCachedFragment(p, contentHash, node)) {
+                        node = parseSceneString(p, sceneString);
+                        cacheFragment(p, contentHash, node);
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(sceneMutex);
+                        m_parsedScenes.emplace_back(p, std::move(node));
+                    }
+                    progressCounter--;
+                    m_condition.notify_all();
+            }));
         }
     }
 
+    m_parseJobs.clear();
+
     auto root = importScenes(fullPath);
 
     return root;
 }
 
-void Importer::processScene(const std::string &scenePath, const std::string &sceneString) {
+Node Importer::parseSceneString(const std::string& scenePath, const std::string& sceneString) {
 
-    LOGD("Process: '%s'", scenePath.c_str());
+    Node sceneNode;
 
     try {
-        auto sceneNode = YAML::Load(sceneString);
+        sceneNode = YAML::Load(sceneString);
+    }
+    catch (YAML::ParserException e) {
+        LOGE("Parsing scene config '%s': %s", scenePath.c_str(), e.what());
+    }
 
-        normalizeSceneImports(sceneNode, scenePath);
-        normalizeSceneDataSources(sceneNode, scenePath);
-        normalizeSceneTextures(sceneNode, scenePath);
+    return sceneNode;
+}
 
-        m_scenes[scenePath] = sceneNode;
+void Importer::processScene(const std::string& scenePath, Node sceneNode) {
 
-        for (const auto& import : getScenesToImport(sceneNode)) {
-            m_sceneQueue.push_back(import);
-            m_condition.notify_all();
-        }
-    }
-    catch (YAML::ParserException e) {
-        LOGE("Parsing scene config '%s'", e.what());
+    LOGD("Process: '%s'", scenePath.c_str());
+
+    normalizeSceneImports(sceneNode, scenePath);
+    normalizeSceneDataSources(sceneNode, scenePath);
+    normalizeSceneTextures(sceneNode, scenePath);
+
+    m_scenes[scenePath] = sceneNode;
+
+    for (const auto& import : getScenesToImport(sceneNode)) {
+        m_sceneQueue.push_back(import);
     }
 }
 
@@ -9,6 +9,7 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <future>
 
 #include "util/fastmap.h"
 
@@ -27,10 +28,28 @@ public:
     // Loads the main scene with deep merging dependentent imported scenes.
     Node applySceneImports(const std::string& scenePath, const std::string& resourceRoot = "");
 
+    // The local files the imported bundle was resolved from, in the order
+    // they were processed.
+    const std::vector<std::string>& sceneFiles() const { return m_sceneFiles; }
+
+    // Whether the resolved document may be cached: false when any part of
+    // the bundle came over the network and can not be revalidated locally.
+    bool isCacheable() const { return m_isCacheable; }
+
+    // Drops all cached scene fragments, forcing the next import to re-fetch
+    // and re-parse every document.
+    static void clearFragmentCache();
+
 // protected for testing purposes, else could be private
 protected:
     virtual std::string getSceneString(const std::string& scenePath);
-    void processScene(const std::string& scenePath, const std::string& sceneString);
+
+    // Parse a scene document. Runs on worker threads and touches no shared
+    // state; imported documents are independent until they are merged.
+    static Node parseSceneString(const std::string& scenePath, const std::string& sceneString);
+
+    // Normalize paths in a parsed document, register it and queue its imports.
+    void processScene(const std::string& scenePath, Node sceneNode);
 
     // Get the sequence of scene names that are designated to be imported into the
     // input scene node by its 'import' fields.
@@ -55,17 +74,31 @@ protected:
     std::string normalizePath(const std::string& path, const std::string& parentPath);
 
 private:
+
+    // Fills @node with a copy of the cached parse for @scenePath when its
+    // content hash still matches. Pass hash 0 to accept any cached content,
+    // for remote fragments that can not be revalidated without fetching
+    // them again.
+    static bool getCachedFragment(const std::string& scenePath, size_t contentHash, Node& node);
+
+    static void cacheFragment(const std::string& scenePath, size_t contentHash, const Node& node);
+
     // import scene to respective root nodes
     std::map<std::string, Node> m_scenes;
     std::unordered_set<std::string> m_globalTextures;
     std::unordered_map<std::string, std::string> m_textureNames;
 
     std::vector<std::string> m_sceneQueue;
+    std::vector<std::string> m_sceneFiles;
+    // parsed documents waiting to be normalized and merged on the loading thread
+    std::vector<std::pair<std::string, Node>> m_parsedScenes;
+    std::vector<std::future<void>> m_parseJobs;
+    // scenes whose fetch has started but that are not yet in m_scenes
+    std::unordered_set<std::string> m_pendingScenes;
+    bool m_isCacheable = true;
     static std::atomic_uint progressCounter;
     std::mutex sceneMutex;
     std::condition_variable m_condition;
-
-    const unsigned int MAX_SCENE_DOWNLOAD = 4;
 };
 
 }
@@ -41,8 +41,14 @@ void Light::setSpecularColor(const glm::vec4 _specular) {
 }
 
 void Light::setOrigin(LightOrigin origin) {
-    m_dynamic = true;
     m_origin = origin;
+    // Camera is the default origin and needs no per-frame view
+    // transform; a light that states it explicitly can still be
+    // folded into the shader source. World and ground origins are
+    // transformed with the view each frame, so they need uniforms.
+    if (origin != LightOrigin::camera) {
+        m_dynamic = true;
+    }
 }
 
 void Light::injectSourceBlocks(ShaderProgram& _shader) {
@@ -68,12 +74,18 @@ void Light::setupProgram(const View& _view, LightUniforms& _uniforms) {
 
 void Light::assembleLights(std::map<std::string, std::vector<std::string>>& _sourceBlocks) {
 
+    // Nothing to assemble when no light injected code into this program;
+    // the 'lighting' pragma then stays empty instead of splicing the
+    // whole set of lighting functions into an unlit shader
+    auto lightingBlocks = _sourceBlocks.find("__lighting");
+    if (lightingBlocks == _sourceBlocks.end()) { return; }
+
     // Create strings to contain the assembled lighting source code
     std::stringstream lighting;
 
     // Concatenate all strings at the "__lighting" keys
     // (struct definitions and function definitions)
-    for (const auto& string : _sourceBlocks["__lighting"]) {
+    for (const auto& string : lightingBlocks->second) {
         lighting << '\n';
         lighting << string;
     }
@@ -86,9 +98,12 @@ void Light::assembleLights(std::map<std::string, std::vector<std::string>>& _sou
 
     std::string tag = "#pragma tangram: lights_to_compute";
     std::stringstream lights;
-    for (const auto& string : _sourceBlocks["__lights_to_compute"]) {
-        lights << '\n';
-        lights << string;
+    auto computeBlocks = _sourceBlocks.find("__lights_to_compute");
+    if (computeBlocks != _sourceBlocks.end()) {
+        for (const auto& string : computeBlocks->second) {
+            lights << '\n';
+            lights << string;
+        }
     }
 
     size_t pos = lightingBlock.find(tag) + tag.length();
@@ -104,6 +119,13 @@ LightType Light::getType() {
     return m_type;
 }
 
+bool Light::isIdentity() const {
+    return !m_dynamic &&
+           m_type == LightType::ambient &&
+           m_ambient == glm::vec4(1.f) &&
+           m_specular == glm::vec4(0.f);
+}
+
 std::string Light::getUniformName() {
 	return "u_" + m_name;
 }
@@ -88,6 +88,11 @@ public:
     /*  Get the type of light, especially to identify the class and specific methods to it. */
     virtual LightType getType();
 
+    /*  Returns true when this light multiplies the geometry color by plain white:
+     *  a non-dynamic full-white ambient light with no specular contribution. Such
+     *  lights can be skipped entirely when assembling a style's shader. */
+    bool isIdentity() const;
+
     /*  GLSL line to compute the specific light instance */
     virtual std::string getInstanceComputeBlock();
 
@@ -24,6 +24,13 @@ PointLight::~PointLight() {}
 
 void PointLight::setPosition(UnitVec<glm::vec3> pos) {
     m_position = pos;
+    // Pixel-unit components scale with the view's pixels-per-meter,
+    // so the position must be converted and re-sent per frame
+    for (int i = 0; i < pos.size; i++) {
+        if (pos.units[i] == Unit::pixel) {
+            m_dynamic = true;
+        }
+    }
 }
 
 void PointLight::setAttenuation(float _att) {
@@ -103,6 +103,21 @@ int Scene::getIdForName(const std::string& _name) const {
     return it - m_names.begin();
 }
 
+void Scene::bindRuleStyles() {
+    m_styleIdForRule.assign(m_names.size(), -1);
+
+    for (size_t i = 0; i < m_names.size(); i++) {
+        if (auto* style = findStyle(m_names[i])) {
+            m_styleIdForRule[i] = style->getID();
+        }
+    }
+}
+
+int Scene::getStyleIdForRule(int _ruleId) const {
+    if (_ruleId < 0 || size_t(_ruleId) >= m_styleIdForRule.size()) { return -1; }
+    return m_styleIdForRule[_ruleId];
+}
+
 const Light* Scene::findLight(const std::string &_name) const {
     for (auto& light : m_lights) {
         if (light->getInstanceName() == _name) { return light.get(); }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "scene/filters.h"
 #include "util/color.h"
 #include "util/fastmap.h"
 #include "view/view.h"
@@ -7,6 +8,7 @@
 #include <atomic>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -46,6 +48,18 @@ public:
         glm::vec2 obliqueAxis = {0, 1};
     };
 
+    struct Fog {
+        bool enabled = false;
+
+        // Horizon color distant fragments fade into
+        Color color;
+
+        // Scale, in (0, 1], on the far ground distance covered by tiles;
+        // fractions pull the far edge of the visible-tile set in
+        // (see View::setHorizonClipScale)
+        float distance = 1.f;
+    };
+
     Camera m_camera;
 
     enum animate {
@@ -66,9 +80,12 @@ public:
     auto& lights() { return m_lights; };
     auto& textures() { return m_textures; };
     auto& functions() { return m_jsFunctions; };
+    auto& filterCache() { return m_filterCache; };
     auto& spriteAtlases() { return m_spriteAtlases; };
     auto& stops() { return m_stops; }
     auto& background() { return m_background; }
+    auto& fog() { return m_fog; }
+    const auto& fog() const { return m_fog; }
     auto& fontContext() { return m_fontContext; }
     auto& globals() { return m_globals; }
     Style* findStyle(const std::string& _name);
@@ -85,6 +102,17 @@ public:
     const auto& fontContext() const { return m_fontContext; }
     const auto& globals() const { return m_globals; }
 
+    // Scene JS functions compiled to duktape bytecode by the first
+    // worker StyleContext initialized for this scene; the remaining
+    // worker contexts load the bytecode instead of recompiling from
+    // source. Guarded by its mutex since workers start up concurrently.
+    struct FunctionBytecode {
+        std::mutex mutex;
+        std::vector<std::string> blobs;
+    };
+
+    auto& functionBytecode() const { return m_functionBytecode; }
+
     const Style* findStyle(const std::string& _name) const;
     const Light* findLight(const std::string& _name) const;
 
@@ -94,6 +122,16 @@ public:
     int addIdForName(const std::string& _name);
     int getIdForName(const std::string& _name) const;
 
+    /* Binds each interned name to the index of the style it selects,
+     * resolved once after styles and layers are loaded. Names that
+     * match no style - including all non-rule names - map to -1. */
+    void bindRuleStyles();
+
+    /* Style index bound to the rule name id @_ruleId, or -1 when the
+     * rule names no style and dispatch must fall back to the merged
+     * style parameter. */
+    int getStyleIdForRule(int _ruleId) const;
+
     const int32_t id;
 
     bool useScenePosition = true;
@@ -137,11 +175,24 @@ private:
     // integer indices into this container to represent strings
     std::vector<std::string> m_names;
 
+    // Style index per name id, filled by bindRuleStyles()
+    std::vector<int> m_styleIdForRule;
+
     std::vector<std::string> m_jsFunctions;
+
+    // Compiled Filter trees keyed by the serialized content of their
+    // YAML node, so identical subtrees - common through anchors and
+    // import duplication - compile once per scene load. Filled by
+    // SceneLoader::generateFilter and cleared when loading finishes.
+    std::unordered_map<std::string, Filter> m_filterCache;
+
+    mutable FunctionBytecode m_functionBytecode;
     std::list<Stops> m_stops;
 
     Color m_background;
 
+    Fog m_fog;
+
     std::shared_ptr<FontContext> m_fontContext;
 
     animate m_animated = none;
@@ -0,0 +1,87 @@
+#include "sceneCache.h"
+
+#include "platform.h"
+#include "util/hash.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <cstdio>
+
+namespace Tangram {
+
+std::string SceneCache::cachePath(const std::string& _scenePath) {
+    return _scenePath + ".cache";
+}
+
+size_t SceneCache::bundleHash(const std::vector<std::string>& _files) {
+    size_t seed = 0;
+
+    for (const auto& path : _files) {
+        auto content = stringFromFile(path.c_str());
+        if (content.empty()) { return 0; }
+
+        hash_combine(seed, content);
+    }
+    return seed;
+}
+
+bool SceneCache::load(const std::string& _scenePath, YAML::Node& _root) {
+
+    auto data = stringFromFile(cachePath(_scenePath).c_str());
+    if (data.empty()) { return false; }
+
+    YAML::Node cache;
+    try { cache = YAML::Load(data); }
+    catch (YAML::ParserException e) {
+        LOGW("Parsing scene cache '%s'", e.what());
+        return false;
+    }
+
+    YAML::Node files = cache["files"];
+    YAML::Node hash = cache["hash"];
+    YAML::Node scene = cache["scene"];
+
+    if (!files || !files.IsSequence() || !hash || !scene) { return false; }
+
+    std::vector<std::string> paths;
+    for (const auto& file : files) { paths.push_back(file.Scalar()); }
+
+    size_t current = bundleHash(paths);
+    if (current == 0 || std::to_string(current) != hash.Scalar()) {
+        LOGD("Scene cache for '%s' is stale", _scenePath.c_str());
+        return false;
+    }
+
+    _root = scene;
+    return true;
+}
+
+bool SceneCache::store(const std::string& _scenePath, const YAML::Node& _root,
+                       const std::vector<std::string>& _files) {
+
+    if (_files.empty()) { return false; }
+
+    size_t hash = bundleHash(_files);
+    if (hash == 0) { return false; }
+
+    YAML::Node cache;
+    for (const auto& file : _files) { cache["files"].push_back(file); }
+    cache["hash"] = std::to_string(hash);
+    cache["scene"] = _root;
+
+    auto out = YAML::Dump(cache);
+
+    auto path = cachePath(_scenePath);
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        LOGD("Can not write scene cache '%s'", path.c_str());
+        return false;
+    }
+
+    bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+    fclose(file);
+
+    return ok;
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace YAML {
+    class Node;
+}
+
+namespace Tangram {
+
+/*
+ * Caches the resolved scene document - imports merged, paths normalized and
+ * styles mixed - on disk next to the scene file, keyed by a hash over the
+ * source files of the bundle. Warm starts with an unchanged bundle then go
+ * straight from one document parse to applyConfig, skipping import
+ * resolution and style mixing.
+ */
+struct SceneCache {
+
+    /* Looks up the cached document for the scene at @_scenePath and fills
+     * @_root when the cache is present and none of its source files changed.
+     */
+    static bool load(const std::string& _scenePath, YAML::Node& _root);
+
+    /* Writes the resolved document @_root for the scene at @_scenePath,
+     * recording a hash over the current contents of @_files for validation.
+     */
+    static bool store(const std::string& _scenePath, const YAML::Node& _root,
+                      const std::vector<std::string>& _files);
+
+    static std::string cachePath(const std::string& _scenePath);
+
+private:
+
+    // Combined hash over the contents of the bundle files, 0 when any of
+    // them can not be read.
+    static size_t bundleHash(const std::vector<std::string>& _files);
+
+    SceneCache() = delete;
+
+};
+
+}
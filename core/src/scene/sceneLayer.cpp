@@ -1,9 +1,15 @@
 #include "sceneLayer.h"
 
+#include "data/tileData.h"
+
 #include <algorithm>
 
 namespace Tangram {
 
+// Minimum number of sublayers testing the same key before an index
+// entry pays off over just evaluating their filters
+static const size_t minIndexFanOut = 4;
+
 SceneLayer::SceneLayer(std::string _name, Filter _filter,
                        std::vector<DrawRuleData> _rules,
                        std::vector<SceneLayer> _sublayers,
@@ -16,6 +22,86 @@ SceneLayer::SceneLayer(std::string _name, Filter _filter,
 
     setDepth(1);
 
+    buildSublayerIndex();
+
+}
+
+// Returns the filter of @_layer when it is a plain string equality on
+// a feature property, i.e. the forms the dispatch index can handle
+static const Filter::Equality* indexableFilter(const SceneLayer& _layer) {
+
+    if (!_layer.filter().data.is<Filter::Equality>()) { return nullptr; }
+
+    auto& eq = _layer.filter().data.get<Filter::Equality>();
+    if (eq.keyword != FilterKeyword::undefined) { return nullptr; }
+    if (!eq.value.is<std::string>()) { return nullptr; }
+
+    return &eq;
+}
+
+void SceneLayer::buildSublayerIndex() {
+
+    m_indices.clear();
+    m_unindexedSublayers.clear();
+
+    // Count sublayers testing each key with an indexable equality
+    fastmap<uint32_t, size_t> fanOut;
+
+    for (auto& sublayer : m_sublayers) {
+        // Visibility is set at construction, so layers marked not
+        // visible are dropped from matching here already
+        if (!sublayer.visible()) { continue; }
+
+        if (auto* eq = indexableFilter(sublayer)) {
+            fanOut[eq->keyId]++;
+        }
+    }
+
+    for (size_t i = 0; i < m_sublayers.size(); i++) {
+        auto& sublayer = m_sublayers[i];
+        if (!sublayer.visible()) { continue; }
+
+        auto* eq = indexableFilter(sublayer);
+        if (!eq || fanOut[eq->keyId] < minIndexFanOut) {
+            m_unindexedSublayers.push_back(uint16_t(i));
+            continue;
+        }
+
+        auto it = std::find_if(m_indices.begin(), m_indices.end(),
+                               [&](const auto& index) {
+                                   return index.keyId == eq->keyId;
+                               });
+        if (it == m_indices.end()) {
+            m_indices.push_back({ eq->keyId, {} });
+            it = m_indices.end() - 1;
+        }
+        it->values[eq->value.get<std::string>()].push_back(uint16_t(i));
+    }
+}
+
+void SceneLayer::matchSublayers(const Feature& _feature, StyleContext& _ctx,
+                                std::vector<const SceneLayer*>& _matches) const {
+
+    for (auto i : m_unindexedSublayers) {
+        auto& sublayer = m_sublayers[i];
+        if (sublayer.filter().eval(_feature, _ctx)) {
+            _matches.push_back(&sublayer);
+        }
+    }
+
+    for (auto& index : m_indices) {
+        auto& value = _feature.props.get(index.keyId);
+        if (!value.is<std::string>()) { continue; }
+
+        auto it = index.values.find(value.get<std::string>());
+        if (it == index.values.end()) { continue; }
+
+        // The lookup established the sublayers' equality filters, no
+        // further evaluation needed
+        for (auto i : it->second) {
+            _matches.push_back(&m_sublayers[i]);
+        }
+    }
 }
 
 void SceneLayer::setDepth(size_t _d) {
@@ -3,23 +3,39 @@
 #include "scene/drawRule.h"
 #include "scene/filters.h"
 #include "scene/styleParam.h"
+#include "util/fastmap.h"
 
 #include <string>
 #include <vector>
 
 namespace Tangram {
 
+class StyleContext;
 struct Feature;
 
 class SceneLayer {
 
+    // Dispatch index over sublayers whose filter is a plain string
+    // equality: when several sublayers test the same property key,
+    // the feature value is looked up once and only the sublayers
+    // whose filter value matches are visited, instead of evaluating
+    // every sublayer filter per feature.
+    struct SublayerIndex {
+        uint32_t keyId;
+        fastmap<std::string, std::vector<uint16_t>> values;
+    };
+
     Filter m_filter;
     std::string m_name;
     std::vector<DrawRuleData> m_rules;
     std::vector<SceneLayer> m_sublayers;
+    std::vector<SublayerIndex> m_indices;
+    std::vector<uint16_t> m_unindexedSublayers;
     size_t m_depth = 0;
     bool m_visible;
 
+    void buildSublayerIndex();
+
 public:
 
     SceneLayer(std::string _name, Filter _filter,
@@ -34,6 +50,11 @@ public:
     const auto& depth() const { return m_depth; }
     const auto& visible() const { return m_visible; }
 
+    // Append the sublayers whose filter matches @_feature to
+    // @_matches, using the equality dispatch index where possible
+    void matchSublayers(const Feature& _feature, StyleContext& _ctx,
+                        std::vector<const SceneLayer*>& _matches) const;
+
     void setDepth(size_t _d);
 };
 
@@ -2,6 +2,7 @@
 #include "scene.h"
 #include "sceneLoader.h"
 #include "lights.h"
+#include "data/bundleSource.h"
 #include "data/clientGeoJsonSource.h"
 #include "data/geoJsonSource.h"
 #include "data/mvtSource.h"
@@ -16,14 +17,17 @@
 #include "style/debugTextStyle.h"
 #include "style/pointStyle.h"
 #include "style/rasterStyle.h"
+#include "debug/trace.h"
 #include "scene/dataLayer.h"
 #include "scene/filters.h"
 #include "scene/importer.h"
+#include "scene/sceneCache.h"
 #include "scene/sceneLayer.h"
 #include "scene/spriteAtlas.h"
 #include "scene/stops.h"
 #include "scene/styleMixer.h"
 #include "scene/styleParam.h"
+#include "scene/texturePacker.h"
 #include "util/base64.h"
 #include "util/yamlHelper.h"
 #include "view/view.h"
@@ -50,15 +54,34 @@ const std::string DELIMITER = ":";
 constexpr size_t CACHE_SIZE = 16 * (1024 * 1024);
 
 std::mutex SceneLoader::m_textureMutex;
+std::vector<std::function<void()>> SceneLoader::m_textureTasks;
+std::vector<std::future<void>> SceneLoader::m_textureJobs;
 
 bool SceneLoader::loadScene(std::shared_ptr<Scene> _scene) {
 
     Node& root = _scene->config();
 
+    std::string fullPath = _scene->resourceRoot() + _scene->path();
+
+    // Warm start: the cached document already has imports resolved and
+    // styles mixed
+    if (SceneCache::load(fullPath, root)) {
+        applyConfig(root, _scene, true);
+        return true;
+    }
+
     Importer sceneImporter;
 
-    if ((root = sceneImporter.applySceneImports(_scene->path(), _scene->resourceRoot())) ) {
+    Trace::begin("sceneImports");
+    root = sceneImporter.applySceneImports(_scene->path(), _scene->resourceRoot());
+    Trace::end("sceneImports");
+
+    if (root) {
         applyConfig(root, _scene);
+
+        if (sceneImporter.isCacheable()) {
+            SceneCache::store(fullPath, root, sceneImporter.sceneFiles());
+        }
         return true;
     }
     return false;
@@ -102,6 +125,50 @@ void SceneLoader::applyUpdates(Node& root, const std::vector<SceneUpdate>& updat
     }
 }
 
+bool SceneLoader::applyUniformUpdate(const SceneUpdate& update, const std::shared_ptr<Scene>& scene) {
+
+    auto keys = splitString(update.keys, COMPONENT_PATH_DELIMITER);
+
+    // Only paths of the form styles.<style>.shaders.uniforms.<name> hold
+    // plain uniform values; everything else may affect tile geometry.
+    if (keys.size() != 5 || keys[0] != "styles" || keys[2] != "shaders" || keys[3] != "uniforms") {
+        return false;
+    }
+
+    Style* style = nullptr;
+    for (auto& s : scene->styles()) {
+        if (s->getName() == keys[1]) {
+            style = s.get();
+            break;
+        }
+    }
+    if (!style) { return false; }
+
+    Node value;
+    try {
+        value = YAML::Load(update.value);
+    } catch (YAML::ParserException e) {
+        LOGW("Cannot update scene - value invalid: %s", e.what());
+        return false;
+    }
+
+    StyleUniform styleUniform;
+    if (!parseStyleUniforms(value, scene, styleUniform)) { return false; }
+
+    for (auto& uniformPair : style->styleUniforms()) {
+        if (uniformPair.first.getName() != keys[4]) { continue; }
+
+        // Changing the uniform type would change the shader source, so
+        // that still takes the rebuild path.
+        if (uniformPair.second.which() != styleUniform.value.which()) { return false; }
+
+        uniformPair.second = std::move(styleUniform.value);
+        return true;
+    }
+
+    return false;
+}
+
 void printFilters(const SceneLayer& layer, int indent){
     LOG("%*s >>> %s\n", indent, "", layer.name().c_str());
     layer.filter().print(indent + 2);
@@ -159,7 +226,9 @@ void SceneLoader::parseGlobals(const Node& node, const std::shared_ptr<Scene>& s
     }
 }
 
-bool SceneLoader::applyConfig(Node& config, const std::shared_ptr<Scene>& _scene) {
+bool SceneLoader::applyConfig(Node& config, const std::shared_ptr<Scene>& _scene, bool stylesMixed) {
+
+    Trace::Scope trace("applyConfig");
 
     // Instantiate built-in styles
     _scene->styles().emplace_back(new PolygonStyle("polygons"));
@@ -197,12 +266,18 @@ bool SceneLoader::applyConfig(Node& config, const std::shared_ptr<Scene>& _scene
         }
     }
 
+    // Decode local texture files in parallel with parsing the styles and
+    // layers below; the yaml document itself must stay on this thread
+    runTextureTasks();
+
     if (Node styles = config["styles"]) {
-        StyleMixer mixer;
-        try {
-            mixer.mixStyleNodes(styles);
-        } catch (YAML::RepresentationException e) {
-            LOGNode("Mixing styles: '%s'", styles, e.what());
+        if (!stylesMixed) {
+            StyleMixer mixer;
+            try {
+                mixer.mixStyleNodes(styles);
+            } catch (YAML::RepresentationException e) {
+                LOGNode("Mixing styles: '%s'", styles, e.what());
+            }
         }
         for (const auto& entry : styles) {
             try {
@@ -236,6 +311,19 @@ bool SceneLoader::applyConfig(Node& config, const std::shared_ptr<Scene>& _scene
         }
     }
 
+    // With styles sorted and all rule names interned, bind rules to
+    // style indices so per-feature dispatch needs no string lookup
+    _scene->bindRuleStyles();
+
+    // Check parsed parameter types once here, so the typed accessors
+    // used during tile builds can rely on them
+    for (const auto& layer : _scene->layers()) {
+        validateLayerParams(layer);
+    }
+
+    // The memoized filters only serve layer loading
+    _scene->filterCache().clear();
+
     if (Node lights = config["lights"]) {
         for (const auto& light : lights) {
             try { loadLight(light, _scene); }
@@ -267,11 +355,21 @@ bool SceneLoader::applyConfig(Node& config, const std::shared_ptr<Scene>& _scene
 
     loadBackground(config["scene"]["background"], _scene);
 
+    loadFog(config["scene"]["fog"], _scene);
+
     Node animated = config["scene"]["animated"];
     if (animated) {
         _scene->animated(animated.as<bool>());
     }
 
+    // Join the texture jobs: styles may reference the textures and sprite
+    // atlases when building below
+    finishTextureTasks();
+
+    // Merge sprite atlas textures into shared pages, so sprite and
+    // icon drawing needs only a few binds per frame
+    TexturePacker::packAtlases(*_scene);
+
     for (auto& style : _scene->styles()) {
         style->build(*_scene);
     }
@@ -555,48 +653,81 @@ std::shared_ptr<Texture> SceneLoader::fetchTexture(const std::string& name, cons
         texture = std::make_shared<Texture>(nullptr, 0, options, generateMipmaps, true);
     } else {
 
+        // Like the network path, file reads and image decodes run off the
+        // loading thread: start with a default texture and queue a task that
+        // fills it in and updates dependent sprite nodes. The tasks are
+        // joined before applyConfig() returns.
+        texture = std::make_shared<Texture>(nullptr, 0, options, generateMipmaps, true);
+
         if (url.substr(0, 22) == "data:image/png;base64,") {
             // Skip data: prefix
             auto data = url.substr(22);
 
-            std::vector<unsigned char> blob;
+            m_textureTasks.push_back([=]() {
+                    std::vector<unsigned char> blob;
 
-            try {
-                blob = Base64::decode(data);
-            } catch(std::runtime_error e) {
-                LOGE("Can't decode Base64 texture '%s'", e.what());
-            }
+                    try {
+                        blob = Base64::decode(data);
+                    } catch(std::runtime_error e) {
+                        LOGE("Can't decode Base64 texture '%s'", e.what());
+                    }
 
-            if (blob.empty()) {
-                LOGE("Can't decode Base64 texture");
-                return nullptr;
-            }
-            texture = std::make_shared<Texture>(0, 0, options, generateMipmaps);
+                    if (blob.empty()) {
+                        LOGE("Can't decode Base64 texture");
+                        return;
+                    }
 
-            if (!texture->loadImageFromMemory(blob.data(), blob.size(), false)) {
-                LOGE("Invalid Base64 texture");
-            }
+                    std::lock_guard<std::mutex> lock(m_textureMutex);
+                    auto tex = texture;
+                    if (!tex->loadImageFromMemory(blob.data(), blob.size(), false)) {
+                        LOGE("Invalid Base64 texture");
+                    }
+                    updateSpriteNodes(name, tex, scene);
+                });
 
         } else {
-            size_t size = 0;
-            unsigned char* blob = bytesFromFile(url.c_str(), size);
+            // Start the file read right away instead of when the task
+            // runs: the bytes arrive from storage while the rest of the
+            // scene parses, and the queued task only decodes
+            auto read = std::make_shared<std::future<FileData>>(bytesFromFileAsync(url.c_str()));
 
-            if (!blob) {
-                LOGE("Can't load texture resource at url '%s'", url.c_str());
-                return nullptr;
-            }
-            texture = std::make_shared<Texture>(0, 0, options, generateMipmaps);
+            m_textureTasks.push_back([=]() {
+                    FileData file = read->get();
 
-            if (!texture->loadImageFromMemory(blob, size, false)) {
-                LOGE("Invalid texture data '%s'", url.c_str());
-            }
-            free(blob);
+                    if (!file.bytes) {
+                        LOGE("Can't load texture resource at url '%s'", url.c_str());
+                        return;
+                    }
+
+                    std::lock_guard<std::mutex> lock(m_textureMutex);
+                    auto tex = texture;
+                    if (!tex->loadImageFromMemory(file.bytes, file.size, false)) {
+                        LOGE("Invalid texture data '%s'", url.c_str());
+                    }
+                    free(file.bytes);
+                    updateSpriteNodes(name, tex, scene);
+                });
         }
     }
 
     return texture;
 }
 
+void SceneLoader::runTextureTasks() {
+    for (auto& task : m_textureTasks) {
+        m_textureJobs.push_back(std::async(std::launch::async, std::move(task)));
+    }
+    m_textureTasks.clear();
+}
+
+void SceneLoader::finishTextureTasks() {
+    // Start tasks queued after the textures block, e.g. for material textures
+    runTextureTasks();
+
+    for (auto& job : m_textureJobs) { job.wait(); }
+    m_textureJobs.clear();
+}
+
 bool SceneLoader::loadTexture(const std::string& url, const std::shared_ptr<Scene>& scene) {
     TextureOptions options = {GL_RGBA, GL_RGBA, {GL_LINEAR, GL_LINEAR}, {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE}};
 
@@ -695,6 +826,20 @@ void SceneLoader::loadStyleProps(Style& style, Node styleNode, const std::shared
         }
     }
 
+    if (Node smoothNode = styleNode["smooth_edges"]) {
+        bool smooth;
+        if (getBool(smoothNode, smooth, "smooth_edges")) {
+            style.setSmoothEdges(smooth);
+        }
+    }
+
+    if (Node prepassNode = styleNode["depth_prepass"]) {
+        bool prepass;
+        if (getBool(prepassNode, prepass, "depth_prepass")) {
+            style.setDepthPrepass(prepass);
+        }
+    }
+
     if (Node texcoordsNode = styleNode["texcoords"]) {
         style.setTexCoordsGeneration(texcoordsNode.as<bool>());
     }
@@ -712,6 +857,15 @@ void SceneLoader::loadStyleProps(Style& style, Node styleNode, const std::shared
         }
     }
 
+    if (Node mergeNode = styleNode["merge_lines"]) {
+        if (auto polylineStyle = dynamic_cast<PolylineStyle*>(&style)) {
+            bool merge;
+            if (getBool(mergeNode, merge, "merge_lines")) {
+                polylineStyle->setMergeLines(merge);
+            }
+        }
+    }
+
     if (Node dashBackgroundColor = styleNode["dash_background_color"]) {
         if (auto polylineStyle = dynamic_cast<PolylineStyle*>(&style)) {
             glm::vec4 backgroundColor = getColorAsVec4(dashBackgroundColor);
@@ -821,7 +975,12 @@ void SceneLoader::loadSource(const std::string& name, const Node& source, const
     }
 
     std::string type = source["type"].Scalar();
-    std::string url = source["url"].Scalar();
+
+    // Offline bundle sources may come without a url
+    std::string url;
+    if (auto urlNode = source["url"]) {
+        url = urlNode.Scalar();
+    }
     int32_t maxZoom = 18;
 
     if (auto maxZoomNode = source["max_zoom"]) {
@@ -871,6 +1030,18 @@ void SceneLoader::loadSource(const std::string& name, const Node& source, const
         sourcePtr = std::shared_ptr<DataSource>(new TopoJsonSource(name, url, maxZoom));
     } else if (type == "MVT") {
         sourcePtr = std::shared_ptr<DataSource>(new MVTSource(name, url, maxZoom));
+    } else if (type == "Bundle") {
+        std::string bundlePath;
+        if (auto bundleNode = source["bundle"]) {
+            bundlePath = bundleNode.Scalar();
+        }
+        if (bundlePath.empty()) {
+            LOGW("Bundle source '%s' needs a 'bundle' directory path, skipping", name.c_str());
+        } else {
+            // With a tiled url the bundle is filled from the network on
+            // misses, otherwise the source is strictly offline
+            sourcePtr = std::shared_ptr<DataSource>(new BundleSource(name, bundlePath, tiled ? url : "", maxZoom));
+        }
     } else if (type == "Raster") {
         TextureOptions options = {GL_RGBA, GL_RGBA, {GL_LINEAR, GL_LINEAR}, {GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE} };
         bool generateMipmaps = false;
@@ -1127,6 +1298,24 @@ Filter SceneLoader::generateFilter(Node _filter, Scene& scene) {
 
     if (!_filter) {  return Filter(); }
 
+    // Identical filter subtrees - YAML anchors and import duplication
+    // produce plenty - compile once per scene and are copied on later
+    // hits. Keyed by serialized content, so equal subtrees match even
+    // when they are distinct nodes.
+    std::string key = Dump(_filter);
+
+    auto& cache = scene.filterCache();
+    auto it = cache.find(key);
+    if (it != cache.end()) { return it->second; }
+
+    Filter filter = compileFilter(_filter, scene);
+    cache.emplace(std::move(key), filter);
+
+    return filter;
+}
+
+Filter SceneLoader::compileFilter(Node _filter, Scene& scene) {
+
     std::vector<Filter> filters;
 
     switch (_filter.Type()) {
@@ -1135,6 +1324,11 @@ Filter SceneLoader::generateFilter(Node _filter, Scene& scene) {
         const std::string& val = _filter.Scalar();
 
         if (val.compare(0, 8, "function") == 0) {
+            // Simple comparison predicates evaluate as native filters,
+            // only genuinely dynamic code goes through the JS context.
+            Filter native = Filter::fromFunctionSource(val);
+            if (!native.data.is<none_type>()) { return native; }
+
             scene.functions().push_back(val);
             return Filter::MatchFunction(scene.functions().size()-1);
         }
@@ -1506,6 +1700,22 @@ SceneLayer SceneLoader::loadSublayer(Node layer, const std::string& layerName, c
     return { layerName, std::move(filter), rules, std::move(sublayers), visible };
 }
 
+void SceneLoader::validateLayerParams(const SceneLayer& layer) {
+
+    for (const auto& rule : layer.rules()) {
+        for (const auto& param : rule.parameters) {
+            if (!StyleParam::validateType(param.key, param.value)) {
+                LOGW("Draw parameter '%s' in layer '%s' holds an unexpected type",
+                     StyleParam::keyName(param.key).c_str(), layer.name().c_str());
+            }
+        }
+    }
+
+    for (const auto& sublayer : layer.sublayers()) {
+        validateLayerParams(sublayer);
+    }
+}
+
 void SceneLoader::loadLayer(const std::pair<Node, Node>& layer, const std::shared_ptr<Scene>& scene) {
 
     const std::string& name = layer.first.Scalar();
@@ -1541,7 +1751,19 @@ void SceneLoader::loadLayer(const std::pair<Node, Node>& layer, const std::share
 
     auto sublayer = loadSublayer(layer.second, name, scene);
 
-    scene->layers().push_back({ std::move(sublayer), source, collections });
+    DataLayer dataLayer{ std::move(sublayer), source, collections };
+
+    if (Node lod = layer.second["lod"]) {
+        if (Node ringArea = lod["min_ring_area"]) {
+            try {
+                dataLayer.setMinRingArea(ringArea.as<float>());
+            } catch (const BadConversion& e) {
+                LOGW("Expected a number for min_ring_area in layer '%s'", name.c_str());
+            }
+        }
+    }
+
+    scene->layers().push_back(std::move(dataLayer));
 }
 
 void SceneLoader::loadBackground(Node background, const std::shared_ptr<Scene>& scene) {
@@ -1559,4 +1781,29 @@ void SceneLoader::loadBackground(Node background, const std::shared_ptr<Scene>&
     }
 }
 
+void SceneLoader::loadFog(Node fog, const std::shared_ptr<Scene>& scene) {
+
+    if (!fog) { return; }
+
+    auto& f = scene->fog();
+    f.enabled = true;
+
+    // The horizon blends into the clear color unless one is given
+    f.color = scene->background();
+
+    if (Node colorNode = fog["color"]) {
+        std::string str;
+        if (colorNode.IsScalar()) {
+            str = colorNode.Scalar();
+        } else if (colorNode.IsSequence()) {
+            str = parseSequence(colorNode);
+        }
+        f.color.abgr = StyleParam::parseColor(str);
+    }
+
+    if (Node distanceNode = fog["distance"]) {
+        f.distance = distanceNode.as<float>(f.distance);
+    }
+}
+
 }
@@ -9,6 +9,8 @@
 #include <tuple>
 #include <sstream>
 #include <mutex>
+#include <future>
+#include <functional>
 
 #include "yaml-cpp/yaml.h"
 #include "glm/vec2.hpp"
@@ -42,13 +44,20 @@ struct SceneLoader {
 
     static bool loadScene(std::shared_ptr<Scene> _scene);
     static bool loadConfig(const std::string& _sceneString, Node& _root);
-    static bool applyConfig(Node& config, const std::shared_ptr<Scene>& scene);
+    // Set stylesMixed for documents that already had their style mixins
+    // applied, e.g. resolved documents restored by SceneCache
+    static bool applyConfig(Node& config, const std::shared_ptr<Scene>& scene, bool stylesMixed = false);
     static void applyUpdates(Node& root, const std::vector<SceneUpdate>& updates);
+    // Try to apply an update to the running scene without a config rebuild.
+    // Only existing shader uniform values can be swapped live; returns false
+    // for structural changes, which need the full applyConfig path.
+    static bool applyUniformUpdate(const SceneUpdate& update, const std::shared_ptr<Scene>& scene);
     static void applyGlobalProperties(Node& node, const std::shared_ptr<Scene>& scene);
 
     /*** all public for testing ***/
 
     static void loadBackground(Node background, const std::shared_ptr<Scene>& scene);
+    static void loadFog(Node fog, const std::shared_ptr<Scene>& scene);
     static void loadSource(const std::string& name, const Node& source, const Node& sources, const std::shared_ptr<Scene>& scene);
     static void loadSourceRasters(std::shared_ptr<DataSource>& source, Node rasterNode, const Node& sources,
                                   const std::shared_ptr<Scene>& scene);
@@ -61,7 +70,12 @@ struct SceneLoader {
     static void loadMaterial(Node matNode, Material& material, const std::shared_ptr<Scene>& scene, Style& style);
     static void loadShaderConfig(Node shaders, Style& style, const std::shared_ptr<Scene>& scene);
     static SceneLayer loadSublayer(Node layer, const std::string& name, const std::shared_ptr<Scene>& scene);
+    // One-time check that each parsed draw-rule literal holds the type
+    // its key promises; the typed StyleParam accessors rely on this
+    static void validateLayerParams(const SceneLayer& layer);
     static Filter generateFilter(Node filter, Scene& scene);
+    // Uncached compilation of one filter node, see generateFilter()
+    static Filter compileFilter(Node filter, Scene& scene);
     static Filter generateAnyFilter(Node filter, Scene& scene);
     static Filter generateNoneFilter(Node filter, Scene& scene);
     static Filter generatePredicate(Node filter, std::string _key);
@@ -92,7 +106,18 @@ struct SceneLoader {
 
     static bool loadStyle(const std::string& styleName, Node config, const std::shared_ptr<Scene>& scene);
 
+    /*
+     * Local file and base64 texture decodes are independent of the rest of the
+     * scene setup. fetchTexture() queues them as tasks; runTextureTasks() starts
+     * them on parallel jobs once the sprite atlases they update exist and
+     * finishTextureTasks() joins them before the styles are built.
+     */
+    static void runTextureTasks();
+    static void finishTextureTasks();
+
     static std::mutex m_textureMutex;
+    static std::vector<std::function<void()>> m_textureTasks;
+    static std::vector<std::future<void>> m_textureJobs;
     SceneLoader() = delete;
 
 };
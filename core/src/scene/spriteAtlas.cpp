@@ -32,6 +32,16 @@ void SpriteAtlas::updateSpriteNodes(std::shared_ptr<Texture> _texture) {
     }
 }
 
+void SpriteAtlas::remapTo(std::shared_ptr<Texture> _texture, glm::vec2 _offset) {
+    m_texture = _texture;
+    for (auto& spriteNode : m_spritesNodes) {
+        // Shift the origin into the shared page; addSpriteNode derives
+        // the uvs from the new texture size
+        addSpriteNode(spriteNode.first.k, spriteNode.second.m_origin + _offset,
+                      spriteNode.second.m_size);
+    }
+}
+
 void SpriteAtlas::bind(GLuint _slot) {
     m_texture->update(_slot);
     m_texture->bind(_slot);
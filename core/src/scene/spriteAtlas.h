@@ -25,6 +25,12 @@ public:
     bool getSpriteNode(const std::string& _name, SpriteNode& _node) const;
     void updateSpriteNodes(std::shared_ptr<Texture> _texture);
 
+    /* Move this atlas into _texture with its sprites located _offset
+     * pixels from the origin, remapping all sprite uvs */
+    void remapTo(std::shared_ptr<Texture> _texture, glm::vec2 _offset);
+
+    const auto& texture() const { return m_texture; }
+
     /* Bind the atlas in the driver */
     void bind(GLuint _slot);
 
@@ -10,6 +10,8 @@
 
 namespace Tangram {
 
+constexpr int Stops::MAX_ZOOM;
+
 auto Stops::Colors(const YAML::Node& _node) -> Stops {
     Stops stops;
     if (!_node.IsSequence()) { return stops; }
@@ -32,6 +34,7 @@ auto Stops::Colors(const YAML::Node& _node) -> Stops {
         }
         stops.frames.emplace_back(key, color);
     }
+    stops.finalize();
     return stops;
 }
 
@@ -71,6 +74,7 @@ auto Stops::FontSize(const YAML::Node& _node) -> Stops {
         }
     }
 
+    stops.finalize();
     return stops;
 }
 
@@ -116,6 +120,7 @@ auto Stops::Offsets(const YAML::Node& _node, const std::vector<Unit>& _units) ->
         }
     }
 
+    stops.finalize();
     return stops;
 }
 
@@ -172,12 +177,12 @@ auto Stops::Widths(const YAML::Node& _node, const MapProjection& _projection, co
         }
     }
     // Append stop at max-zoom to continue scaling after the last stop
-    // TODO: define MAX_ZOOM == 24
-    if (lastIsMeter && lastKey < 24) {
-        float w = widthMeterToPixel(24, tileSize, lastMeter);
-        stops.frames.emplace_back(24, w);
+    if (lastIsMeter && lastKey < MAX_ZOOM) {
+        float w = widthMeterToPixel(MAX_ZOOM, tileSize, lastMeter);
+        stops.frames.emplace_back(MAX_ZOOM, w);
     }
 
+    stops.finalize();
     return stops;
 }
 
@@ -201,6 +206,7 @@ auto Stops::Numbers(const YAML::Node& node) -> Stops {
         stops.frames.emplace_back(key, value);
     }
 
+    stops.finalize();
     return stops;
 }
 
@@ -253,6 +259,15 @@ auto Stops::evalFloat(float _key) const -> float {
 auto Stops::evalColor(float _key) const -> uint32_t {
     if (frames.empty()) { return 0; }
 
+    // Tile builds evaluate at integer zooms, where the pre-mixed
+    // color is just an array lookup
+    if (!zoomColors.empty()) {
+        int z = int(_key);
+        if (_key == float(z) && z >= 0 && z <= MAX_ZOOM) {
+            return zoomColors[z];
+        }
+    }
+
     auto upper = nearestHigherFrame(_key);
     auto lower = upper - 1;
     if (upper == frames.end())  {
@@ -292,10 +307,49 @@ auto Stops::evalVec2(float _key) const -> glm::vec2 {
 
 auto Stops::nearestHigherFrame(float _key) const -> std::vector<Frame>::const_iterator {
 
+    if (!frameIndex.empty()) {
+        int z = int(_key);
+        if (z < 0) { z = 0; } else if (z > MAX_ZOOM) { z = MAX_ZOOM; }
+
+        // The table holds the result for integer keys; fractional
+        // keys (and frame keys between integer zooms) advance at most
+        // past the frames within the same zoom interval
+        auto it = frames.begin() + frameIndex[z];
+        while (it != frames.end() && it->key < _key) { ++it; }
+        return it;
+    }
+
     return std::lower_bound(frames.begin(), frames.end(), _key,
                             [](const Frame& f, float z) { return f.key < z; });
 }
 
+void Stops::finalize() {
+
+    frameIndex.clear();
+    zoomColors.clear();
+
+    // Frame counts beyond the index range stay with the binary search
+    if (frames.empty() || frames.size() > UINT8_MAX) { return; }
+
+    frameIndex.reserve(MAX_ZOOM + 1);
+    for (int z = 0; z <= MAX_ZOOM; z++) {
+        auto it = std::lower_bound(frames.begin(), frames.end(), float(z),
+                                   [](const Frame& f, float key) { return f.key < key; });
+        frameIndex.push_back(uint8_t(it - frames.begin()));
+    }
+
+    // Pre-mix color stops at each integer zoom; built into a local
+    // first so evalColor uses the frames until the table is complete
+    if (frames[0].value.is<Color>()) {
+        std::vector<uint32_t> mixed;
+        mixed.reserve(MAX_ZOOM + 1);
+        for (int z = 0; z <= MAX_ZOOM; z++) {
+            mixed.push_back(evalColor(float(z)));
+        }
+        zoomColors = std::move(mixed);
+    }
+}
+
 void Stops::eval(const Stops& _stops, StyleParamKey _key, float _zoom, StyleParam::Value& _result) {
     if (StyleParam::isColor(_key)) {
         _result = _stops.evalColor(_zoom);
@@ -4,6 +4,7 @@
 #include "scene/styleParam.h"
 #include "variant.hpp"
 
+#include <cstdint>
 #include <vector>
 
 namespace YAML {
@@ -27,16 +28,30 @@ struct Stops {
     };
 
     std::vector<Frame> frames;
+
+    static constexpr int MAX_ZOOM = 24;
+
+    // Nearest-higher-frame index per integer zoom and pre-mixed
+    // colors, built by finalize() once after parsing, so per-feature
+    // evaluation is an array index plus lerp instead of a binary
+    // search. Empty until finalize() ran; evaluation then falls back
+    // to the search.
+    std::vector<uint8_t> frameIndex;
+    std::vector<uint32_t> zoomColors;
+
     static Stops Colors(const YAML::Node& _node);
     static Stops Widths(const YAML::Node& _node, const MapProjection& _projection, const std::vector<Unit>& _units);
     static Stops FontSize(const YAML::Node& _node);
     static Stops Offsets(const YAML::Node& _node, const std::vector<Unit>& _units);
     static Stops Numbers(const YAML::Node& node);
 
-    Stops(const std::vector<Frame>& _frames) : frames(_frames) {}
+    Stops(const std::vector<Frame>& _frames) : frames(_frames) { finalize(); }
     Stops(const Stops& rhs) = default;
     Stops() {}
 
+    // Build the per-integer-zoom lookup tables from the parsed frames
+    void finalize();
+
     auto evalFloat(float _key) const -> float;
     auto evalWidth(float _key) const -> float;
     auto evalColor(float _key) const -> uint32_t;
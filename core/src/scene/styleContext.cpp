@@ -2,6 +2,7 @@
 
 #include "platform.h"
 #include "data/propertyItem.h"
+#include "data/propertyKey.h"
 #include "data/tileData.h"
 #include "scene/filters.h"
 #include "scene/scene.h"
@@ -9,6 +10,9 @@
 
 #include "duktape.h"
 
+#include <cstring>
+#include <mutex>
+
 #define DUMP(...) // do { logMsg(__VA_ARGS__); duk_dump_context_stderr(m_ctx); } while(0)
 #define DBG(...) do { logMsg(__VA_ARGS__); duk_dump_context_stderr(m_ctx); } while(0)
 
@@ -31,6 +35,11 @@ static const std::vector<std::string> s_geometryStrings = {
 StyleContext::StyleContext() {
     m_ctx = duk_create_heap_default();
 
+    // The functions array stays pinned at the bottom of the value
+    // stack so the per-feature eval path indexes it directly; replaced
+    // in setFunctions()
+    duk_push_array(m_ctx);
+
     //// Create global geometry constants
     // TODO make immutable
     duk_push_number(m_ctx, GeometryType::points);
@@ -163,11 +172,41 @@ void StyleContext::initFunctions(const Scene& _scene) {
     }
     m_sceneId = _scene.id;
 
-    setFunctions(_scene.functions());
+    // Scene updates often leave the function list untouched; the
+    // functions compiled into this heap are still valid then
+    if (_scene.functions() != m_functions) {
+        m_functions = _scene.functions();
+
+        auto& cache = _scene.functionBytecode();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        setFunctions(m_functions, &cache.blobs);
+    }
     setSceneGlobals(_scene.globals());
 }
 
 bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
+    return setFunctions(_functions, nullptr);
+}
+
+// Safe-call target: replaces the bytecode buffer at stack top with the
+// loaded function, trapping errors from corrupt or mismatched dumps.
+static duk_ret_t loadFunctionBytecode(duk_context* _ctx) {
+    duk_load_function(_ctx);
+    return 1;
+}
+
+bool StyleContext::setFunctions(const std::vector<std::string>& _functions,
+                                std::vector<std::string>* _bytecode) {
+
+    // The interned strings of the old functions go away with them
+    m_keyIdCache.clear();
+
+    // An empty cache means this is the first context to initialize for
+    // the scene: compile from source and dump bytecode for the others.
+    bool dump = _bytecode && _bytecode->empty();
+    bool load = _bytecode && !_bytecode->empty();
+
+    if (dump) { _bytecode->resize(_functions.size()); }
 
     auto arr_idx = duk_push_array(m_ctx);
     int id = 0;
@@ -175,10 +214,41 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
     bool ok = true;
 
     for (auto& function : _functions) {
+
+        if (load) {
+            auto& blob = (*_bytecode)[id];
+            if (!blob.empty()) {
+                void* buffer = duk_push_fixed_buffer(m_ctx, blob.size());
+                std::memcpy(buffer, blob.data(), blob.size());
+
+                if (duk_safe_call(m_ctx, loadFunctionBytecode, 1, 1) == 0) {
+                    duk_put_prop_index(m_ctx, arr_idx, id);
+                    id++;
+                    continue;
+                }
+                LOGW("Bytecode load failed: %s", duk_safe_to_string(m_ctx, -1));
+                duk_pop(m_ctx);
+                // fall through to compiling from source
+            }
+        }
+
         duk_push_string(m_ctx, function.c_str());
         duk_push_string(m_ctx, "");
 
         if (duk_pcompile(m_ctx, DUK_COMPILE_FUNCTION) == 0) {
+            if (dump) {
+                // duk_dump_function consumes the value at stack top,
+                // so dump a copy and keep the function itself.
+                duk_dup_top(m_ctx);
+                duk_dump_function(m_ctx);
+
+                duk_size_t size = 0;
+                auto* data = static_cast<const char*>(duk_get_buffer(m_ctx, -1, &size));
+                if (data && size > 0) {
+                    (*_bytecode)[id].assign(data, size);
+                }
+                duk_pop(m_ctx);
+            }
             duk_put_prop_index(m_ctx, arr_idx, id);
         } else {
             LOGW("Compile failed: %s\n%s\n---",
@@ -190,10 +260,14 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
         id++;
     }
 
+    duk_dup_top(m_ctx);
     if (!duk_put_global_string(m_ctx, FUNC_ID)) {
         LOGE("'fns' object not set");
     }
 
+    // Swap the new array into the pinned bottom slot
+    duk_replace(m_ctx, 0);
+
     DUMP("setFunctions\n");
     return ok;
 }
@@ -250,24 +324,16 @@ void StyleContext::clear() {
 }
 
 bool StyleContext::evalFunction(FunctionID id) {
-    // Get all functions (array) in context
-    if (!duk_get_global_string(m_ctx, FUNC_ID)) {
-        LOGE("EvalFilterFn - functions array not initialized");
-        duk_pop(m_ctx); // pop [undefined] sitting at stack top
-        return false;
-    }
 
-    // Get function at index `id` from functions array, put it at stack top
-    if (!duk_get_prop_index(m_ctx, -1, id)) {
+    // Get function at index `id` from the functions array pinned at
+    // the stack bottom; this runs once per (feature, function), so the
+    // global lookup of the array is amortized away here.
+    if (!duk_get_prop_index(m_ctx, 0, id)) {
         LOGE("EvalFilterFn - function %d not set", id);
         duk_pop(m_ctx); // pop "undefined" sitting at stack top
-        duk_pop(m_ctx); // pop functions (array) now sitting at stack top
         return false;
     }
 
-    // pop fns array
-    duk_remove(m_ctx, -2);
-
     // call popped function (sitting at stack top), evaluated value is put on stack top
     if (duk_pcall(m_ctx, 0) != 0) {
         LOGE("EvalFilterFn: %s", duk_safe_to_string(m_ctx, -1));
@@ -436,6 +502,29 @@ void StyleContext::parseStyleResult(StyleParamKey _key, StyleParam::Value& _val)
 }
 
 // Implements Proxy handler.has(target_object, key)
+uint32_t StyleContext::propertyKeyId(const char* _key) const {
+
+    // Duktape interns heap strings, so a key written literally in a style
+    // function keeps its pointer across calls. The string compare guards
+    // against a collected temporary whose address got reused; it is still
+    // far cheaper than the allocation and lock of a key table lookup.
+    for (const auto& entry : m_keyIdCache) {
+        if (entry.ptr == _key && entry.key == _key) {
+            return entry.id;
+        }
+    }
+
+    uint32_t id = PropertyKey::find(_key);
+
+    // Keys that are not interned yet may be added by tiles parsed later,
+    // so a negative result must not be remembered
+    if (id != PropertyKey::invalid && m_keyIdCache.size() < 64) {
+        m_keyIdCache.push_back({_key, _key, id});
+    }
+
+    return id;
+}
+
 duk_ret_t StyleContext::jsHasProperty(duk_context *_ctx) {
 
     duk_get_prop_string(_ctx, 0, INSTANCE_ID);
@@ -447,7 +536,10 @@ duk_ret_t StyleContext::jsHasProperty(duk_context *_ctx) {
     }
 
     const char* key = duk_require_string(_ctx, 1);
-    duk_push_boolean(_ctx, attr->m_feature->props.contains(key));
+
+    uint32_t keyId = attr->propertyKeyId(key);
+    duk_push_boolean(_ctx, keyId != PropertyKey::invalid &&
+                           attr->m_feature->props.contains(keyId));
 
     return 1;
 }
@@ -467,7 +559,13 @@ duk_ret_t StyleContext::jsGetProperty(duk_context *_ctx) {
     // Get the property name (second parameter)
     const char* key = duk_require_string(_ctx, 1);
 
-    auto it = attr->m_feature->props.get(key);
+    uint32_t keyId = attr->propertyKeyId(key);
+    if (keyId == PropertyKey::invalid) {
+        duk_push_undefined(_ctx);
+        return 1;
+    }
+
+    const auto& it = attr->m_feature->props.get(keyId);
     if (it.is<std::string>()) {
         duk_push_string(_ctx, it.get<std::string>().c_str());
     } else if (it.is<double>()) {
@@ -8,6 +8,7 @@
 #include <memory>
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 struct duk_hthread;
 typedef struct duk_hthread duk_context;
@@ -78,18 +79,42 @@ private:
     static int jsGetProperty(duk_context *_ctx);
     static int jsHasProperty(duk_context *_ctx);
 
+    // Sets up the function array, loading precompiled bytecode from
+    // @_bytecode where available and filling it in when empty, so the
+    // scene functions are compiled once instead of per worker context.
+    bool setFunctions(const std::vector<std::string>& _functions,
+                      std::vector<std::string>* _bytecode);
+
     bool evalFunction(FunctionID id);
     void parseStyleResult(StyleParamKey _key, StyleParam::Value& _val) const;
     void parseSceneGlobals(const YAML::Node& node, const std::string& key, int seqIndex, int dukObject);
 
+    // Resolves a property name passed from a style function to its
+    // interned key id, caching per duktape string pointer so repeated
+    // accesses skip the global key table.
+    uint32_t propertyKeyId(const char* _key) const;
+
     std::array<Value, 4> m_keywords;
     int m_keywordGeom= -1;
     int m_keywordZoom = -1;
 
     int32_t m_sceneId = -1;
 
+    // Function sources currently compiled into the heap, compared on
+    // scene changes so unchanged functions are not recompiled.
+    std::vector<std::string> m_functions;
+
     const Feature* m_feature = nullptr;
 
+    struct CachedKey {
+        const char* ptr;
+        std::string key;
+        uint32_t id;
+    };
+    // Key names seen from style functions; cleared when the functions
+    // are replaced, since their interned strings go away with them.
+    mutable std::vector<CachedKey> m_keyIdCache;
+
     mutable duk_context *m_ctx;
 };
 
@@ -22,6 +22,7 @@ const std::map<std::string, StyleParamKey> s_StyleParamMap = {
     {"extrude", StyleParamKey::extrude},
     {"interactive", StyleParamKey::interactive},
     {"join", StyleParamKey::join},
+    {"min_feature_size", StyleParamKey::min_feature_size},
     {"miter_limit", StyleParamKey::miter_limit},
     {"none", StyleParamKey::none},
     {"offset", StyleParamKey::offset},
@@ -278,6 +279,7 @@ StyleParam::Value StyleParam::parseString(StyleParamKey key, const std::string&
         return Width(width);
     }
     case StyleParamKey::miter_limit:
+    case StyleParamKey::min_feature_size:
     case StyleParamKey::outline_miter_limit:
     case StyleParamKey::text_font_stroke_width: {
         double num;
@@ -308,6 +310,84 @@ StyleParam::Value StyleParam::parseString(StyleParamKey key, const std::string&
     return none_type{};
 }
 
+bool StyleParam::validateType(StyleParamKey _key, const Value& _value) {
+
+    // none_type marks an unset literal: dynamic parameters carry
+    // their value in stops/function and defaults apply otherwise
+    if (_value.is<none_type>()) { return true; }
+
+    // Mirrors the types parseString produces per key
+    switch (_key) {
+    case StyleParamKey::extrude:
+    case StyleParamKey::text_offset:
+    case StyleParamKey::offset:
+    case StyleParamKey::size:
+        return _value.is<glm::vec2>();
+
+    case StyleParamKey::transition_hide_time:
+    case StyleParamKey::transition_show_time:
+    case StyleParamKey::transition_selected_time:
+    case StyleParamKey::text_transition_hide_time:
+    case StyleParamKey::text_transition_show_time:
+    case StyleParamKey::text_transition_selected_time:
+    case StyleParamKey::text_font_size:
+    case StyleParamKey::miter_limit:
+    case StyleParamKey::min_feature_size:
+    case StyleParamKey::outline_miter_limit:
+    case StyleParamKey::text_font_stroke_width:
+        return _value.is<float>();
+
+    case StyleParamKey::text_font_family:
+    case StyleParamKey::text_font_weight:
+    case StyleParamKey::text_font_style:
+    case StyleParamKey::text_align:
+    case StyleParamKey::anchor:
+    case StyleParamKey::text_anchor:
+    case StyleParamKey::text_source:
+    case StyleParamKey::text_transform:
+    case StyleParamKey::sprite:
+    case StyleParamKey::sprite_default:
+    case StyleParamKey::style:
+    case StyleParamKey::outline_style:
+    case StyleParamKey::text_repeat_group:
+        return _value.is<std::string>();
+
+    case StyleParamKey::centroid:
+    case StyleParamKey::interactive:
+    case StyleParamKey::text_interactive:
+    case StyleParamKey::tile_edges:
+    case StyleParamKey::visible:
+    case StyleParamKey::text_visible:
+    case StyleParamKey::outline_visible:
+    case StyleParamKey::collide:
+    case StyleParamKey::text_collide:
+        return _value.is<bool>();
+
+    case StyleParamKey::text_wrap:
+    case StyleParamKey::order:
+    case StyleParamKey::outline_order:
+    case StyleParamKey::priority:
+    case StyleParamKey::text_priority:
+    case StyleParamKey::color:
+    case StyleParamKey::outline_color:
+    case StyleParamKey::text_font_fill:
+    case StyleParamKey::text_font_stroke_color:
+    case StyleParamKey::cap:
+    case StyleParamKey::outline_cap:
+    case StyleParamKey::join:
+    case StyleParamKey::outline_join:
+        return _value.is<uint32_t>();
+
+    case StyleParamKey::text_repeat_distance:
+    case StyleParamKey::width:
+    case StyleParamKey::outline_width:
+        return _value.is<Width>();
+
+    default:
+        return true;
+    }
+}
+
 std::string StyleParam::toString() const {
 
     std::string k(keyName(key));
@@ -30,6 +30,7 @@ enum class StyleParamKey : uint8_t {
     text_interactive,
     join,
     miter_limit,
+    min_feature_size,
     none,
     offset,
     text_offset,
@@ -187,30 +188,28 @@ struct StyleParam {
 
     static const std::string& keyName(StyleParamKey _key);
 
+    /* Typed value access without visitor dispatch: one type-index
+     * compare guards a direct load from the variant storage. The
+     * stored type of every parsed parameter is checked against its
+     * key once at scene compile (see validateType), so the mismatch
+     * path is effectively never taken at tile-build time. */
     template<typename T>
-    struct visitor {
-        using result_type = bool;
-        T& out;
-        bool operator()(const T& v) const {
-            out = v;
-            return true;
-        }
-        template<typename O>
-        bool operator()(const O v) const {
-            return false;
-        }
-    };
+    bool get(T& _out) const {
+        if (!value.is<T>()) { return false; }
+        _out = value.get<T>();
+        return true;
+    }
+
     template<typename T>
-    struct visitor_ptr {
-        using result_type = const T*;
-        const T* operator()(const T& v) const {
-            return &v;
-        }
-        template<typename O>
-        const T* operator()(const O v) const {
-            return nullptr;
-        }
-    };
+    const T* getPtr() const {
+        if (!value.is<T>()) { return nullptr; }
+        return &value.get<T>();
+    }
+
+    /* Whether @_value holds the type that parseString produces for
+     * @_key. Dynamic parameters - functions and stops, which store
+     * none_type until evaluated - always pass. */
+    static bool validateType(StyleParamKey _key, const Value& _value);
 };
 
 }
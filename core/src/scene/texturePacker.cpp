@@ -0,0 +1,141 @@
+#include "texturePacker.h"
+
+#include "platform.h"
+#include "gl/texture.h"
+#include "scene/scene.h"
+#include "scene/spriteAtlas.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Tangram {
+namespace TexturePacker {
+
+// Conservative cap below common GL_MAX_TEXTURE_SIZE limits
+#define MAX_PAGE_SIZE 2048
+
+// Padding around each packed texture, so linear filtering at sprite
+// edges never bleeds into a neighbor
+#define PAGE_PADDING 1
+
+static bool isPackable(const Texture& _tex) {
+
+    if (_tex.getWidth() == 0 || _tex.getHeight() == 0) { return false; }
+    if (_tex.getData().empty()) { return false; }
+
+    if (_tex.getWidth() + 2 * PAGE_PADDING > MAX_PAGE_SIZE ||
+        _tex.getHeight() + 2 * PAGE_PADDING > MAX_PAGE_SIZE) {
+        return false;
+    }
+
+    auto& options = _tex.getOptions();
+
+    // Sub-rectangle sampling rules out wrapping modes other than
+    // clamp, and per-sprite mip chains cannot be shared.
+    if (options.format != GL_RGBA) { return false; }
+    if (options.wrapping.wraps != GL_CLAMP_TO_EDGE ||
+        options.wrapping.wrapt != GL_CLAMP_TO_EDGE) {
+        return false;
+    }
+    if (options.filtering.min != GL_LINEAR && options.filtering.min != GL_NEAREST) {
+        return false;
+    }
+
+    return true;
+}
+
+static unsigned int nextPowerOfTwo(unsigned int _n) {
+    unsigned int p = 1;
+    while (p < _n) { p <<= 1; }
+    return p;
+}
+
+void packAtlases(Scene& _scene) {
+
+    struct PackEntry {
+        SpriteAtlas* atlas;
+        std::shared_ptr<Texture> texture;
+        unsigned int x = 0;
+        unsigned int y = 0;
+    };
+
+    std::vector<PackEntry> entries;
+    size_t area = 0;
+    unsigned int maxWidth = 0;
+
+    for (auto& item : _scene.spriteAtlases()) {
+        auto& atlas = item.second;
+        if (!atlas || !atlas->texture()) { continue; }
+        if (!isPackable(*atlas->texture())) { continue; }
+
+        auto& tex = atlas->texture();
+        entries.push_back({ atlas.get(), tex });
+        area += (tex->getWidth() + 2 * PAGE_PADDING) * (tex->getHeight() + 2 * PAGE_PADDING);
+        maxWidth = std::max(maxWidth, tex->getWidth() + 2u * PAGE_PADDING);
+    }
+
+    // Nothing to merge
+    if (entries.size() < 2) { return; }
+
+    // Taller textures first keeps the shelf rows dense
+    std::sort(entries.begin(), entries.end(),
+              [](const PackEntry& a, const PackEntry& b) {
+                  return a.texture->getHeight() > b.texture->getHeight();
+              });
+
+    unsigned int pageWidth = nextPowerOfTwo(maxWidth);
+    while (pageWidth < MAX_PAGE_SIZE && pageWidth * pageWidth < area) {
+        pageWidth <<= 1;
+    }
+
+    // Shelf-pack the entries left to right, top to bottom
+    unsigned int shelfX = 0;
+    unsigned int shelfY = 0;
+    unsigned int shelfHeight = 0;
+
+    for (auto& entry : entries) {
+        unsigned int w = entry.texture->getWidth() + 2 * PAGE_PADDING;
+        unsigned int h = entry.texture->getHeight() + 2 * PAGE_PADDING;
+
+        if (shelfX + w > pageWidth) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        entry.x = shelfX + PAGE_PADDING;
+        entry.y = shelfY + PAGE_PADDING;
+
+        shelfX += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+
+    unsigned int pageHeight = nextPowerOfTwo(shelfY + shelfHeight);
+    if (pageHeight > MAX_PAGE_SIZE) {
+        // The scene's sprites exceed one page; keep separate textures
+        // rather than splitting atlases across pages.
+        LOGW("Scene sprite textures exceed one atlas page, skipping texture packing");
+        return;
+    }
+
+    TextureOptions options = { GL_RGBA, GL_RGBA,
+                               { GL_LINEAR, GL_LINEAR },
+                               { GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE } };
+
+    auto page = std::make_shared<Texture>(pageWidth, pageHeight, options, false);
+
+    for (auto& entry : entries) {
+        auto& tex = entry.texture;
+
+        page->setSubData(tex->getData().data(), entry.x, entry.y,
+                         tex->getWidth(), tex->getHeight(), tex->getWidth());
+
+        entry.atlas->remapTo(page, glm::vec2(entry.x, entry.y));
+    }
+
+    LOG("Packed %d sprite atlases into one %dx%d page",
+        int(entries.size()), int(pageWidth), int(pageHeight));
+}
+
+}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+
+namespace Tangram {
+
+class Scene;
+
+namespace TexturePacker {
+
+/* Merges the scene's compatible sprite-atlas textures into shared
+ * atlas pages, remapping the sprite uvs of each atlas. Styles keep
+ * their SpriteAtlas handles, so point and sprite drawing across all
+ * tiles binds the shared page instead of one texture per atlas.
+ *
+ * Must run after all scene textures are loaded and before any of them
+ * is uploaded. Only atlases backed by RGBA, clamp-wrapped textures
+ * without mipmapping are merged; others are left untouched.
+ */
+void packAtlases(Scene& _scene);
+
+}
+
+}
@@ -77,6 +77,21 @@ void Material::setNormal(MaterialTexture _normalTexture){
     }
 }
 
+bool Material::isPlainWhite() const {
+
+    if (m_bEmission || m_normal_texture.tex) { return false; }
+
+    if (m_bAmbient) {
+        return !m_ambient_texture.tex && m_ambient == glm::vec4(1.f);
+    }
+    if (m_bDiffuse) {
+        // Without an ambient term the diffuse color modulates the
+        // ambient light accumulator instead
+        return !m_diffuse_texture.tex && m_diffuse == glm::vec4(1.f);
+    }
+    return false;
+}
+
 std::string mappingTypeToString(MappingType type) {
     switch(type) {
         case MappingType::uv:        return "UV";
@@ -110,6 +110,12 @@ public:
     /*  Method to pass it self as a uniform to the shader program */
     virtual void setupProgram(MaterialUniforms& _uniforms);
 
+    /* Returns true when this material leaves a white ambient light term
+     * unchanged: no emission, no textures and a full-white ambient (or
+     * diffuse, which stands in for a disabled ambient) color. Styles use
+     * this to prune the lighting path from shaders it cannot affect. */
+    bool isPlainWhite() const;
+
     bool hasEmission() const { return m_bEmission; }
     bool hasAmbient() const { return m_bAmbient; }
     bool hasDiffuse() const { return m_bDiffuse; }
@@ -45,7 +45,9 @@ public:
     virtual ~PointStyle();
 
     auto& getMesh() const { return m_mesh; }
-    virtual size_t dynamicMeshSize() const override { return m_mesh->bufferSize(); }
+    virtual size_t dynamicMeshSize() const override {
+        return m_mesh->bufferSize() + m_textStyle->dynamicMeshSize();
+    }
 
     virtual std::unique_ptr<StyleBuilder> createBuilder() const override;
 
@@ -25,6 +25,10 @@ void IconMesh::setTextLabels(std::unique_ptr<StyledMesh> _textLabels) {
 
     labels.clear();
 
+    // The text labels changed owner; both indices must follow
+    mesh->rebuildInteractiveIndex();
+    rebuildInteractiveIndex();
+
     textLabels = std::move(_textLabels);
 }
 
@@ -79,6 +83,7 @@ void PointStyleBuilder::setup(const Tile& _tile) {
     m_zoom = _tile.getID().z;
     m_spriteLabels = std::make_unique<SpriteLabels>(m_style);
 
+    m_textStyleBuilder->clearPropertiesRef();
     m_textStyleBuilder->setup(_tile);
     m_iconMesh = std::make_unique<IconMesh>();
 }
@@ -137,7 +142,7 @@ auto PointStyleBuilder::applyRule(const DrawRule& _rule, const Properties& _prop
     LabelProperty::anchor(anchor, p.anchor);
 
     if (p.labelOptions.interactive) {
-        p.labelOptions.properties = std::make_shared<Properties>(_props);
+        p.labelOptions.properties = propertiesRef(_props);
     }
 
     std::hash<PointStyle::Parameters> hash;
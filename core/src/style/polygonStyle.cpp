@@ -18,6 +18,11 @@
 
 #include <cmath>
 
+// Polygon vertices are quantized to keep meshes small: positions are
+// 16-bit fixed point with 8192 units per tile span (leaving headroom
+// for geometry extending outside the tile), normals are normalized
+// 8-bit and texture coordinates normalized 16-bit. The vertex shader
+// decodes with UNPACK_POSITION, so the scales must match polygon.vs.
 constexpr float position_scale = 8192.0f;
 constexpr float texture_scale = 65535.0f;
 constexpr float normal_scale = 127.0f;
@@ -84,7 +89,7 @@ struct PolygonStyleBuilder : public StyleBuilder {
 
 public:
 
-    struct {
+    struct Parameters {
         uint32_t order = 0;
         uint32_t color = 0xffffffff;
         glm::vec2 extrude;
@@ -96,10 +101,37 @@ public:
         m_tileUnitsPerMeter = _tile.getInverseScale();
         m_zoom = _tile.getID().z;
         m_meshData.clear();
+        m_deferred.clear();
+        m_lastRuleHash = 0;
+
+        // Drop hole rings covering less than a quarter pixel at the
+        // size the tile is actually displayed; see PolygonBuilder
+        float pixelsPerUnit = _tile.getProjection()->TileSize() * m_style.pixelScale()
+            * powf(2.f, _tile.getID().s - _tile.getID().z);
+        m_builder.minHoleArea = 0.25f / (pixelsPerUnit * pixelsPerUnit);
+
+        // Bind the vertex sink once per tile; rebinding the
+        // std::function per feature allocates on every call.
+        m_builder.addVertex = [this](const glm::vec3& coord,
+                                     const glm::vec3& normal,
+                                     const glm::vec2& uv) {
+            m_meshData.vertices.push_back({ coord, m_params.order, normal, uv, m_params.color });
+        };
+    }
+
+    void sizeHint(size_t _points, size_t _linePoints, size_t _polygonPoints) override {
+        // The cap uses at most one vertex and three indices per ring
+        // point; extrusion walls come on top but are the exception.
+        m_meshData.vertices.reserve(_polygonPoints);
+        m_meshData.indices.reserve(_polygonPoints * 3);
     }
 
     void addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) override;
 
+    bool hasDeferredGeometry() const override { return !m_deferred.empty(); }
+
+    void buildDeferredGeometry() override;
+
     const Style& style() const override { return m_style; }
 
     std::unique_ptr<StyledMesh> build() override;
@@ -112,24 +144,41 @@ public:
 
 private:
 
+    void tessellate(const Polygon& _polygon);
+
     const PolygonStyle& m_style;
 
     PolygonBuilder m_builder;
 
     MeshData<V> m_meshData;
 
+    // Features set aside by addPolygon for tessellation after the
+    // first-phase publish, with their evaluated parameters
+    struct DeferredPolygon {
+        Polygon polygon;
+        Parameters params;
+    };
+    std::vector<DeferredPolygon> m_deferred;
+
     float m_tileUnitsPerMeter;
     int m_zoom;
 
+    // Hash of the last parsed rule's parameter set; consecutive
+    // features of a layer usually match the identical merged rule, so
+    // parameter lookups can be skipped. 0 forces a re-parse.
+    size_t m_lastRuleHash = 0;
+
 };
 
 template <class V>
 std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
     if (m_meshData.vertices.empty()) { return nullptr; }
 
+    m_meshData.weld();
+
     auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(),
                                                       m_style.drawMode());
-    mesh->compile(m_meshData);
+    mesh->compile(std::move(m_meshData));
     m_meshData.clear();
 
     return std::move(mesh);
@@ -137,30 +186,69 @@ std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
 
 template <class V>
 void PolygonStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties& _props) {
-    _rule.get(StyleParamKey::color, m_params.color);
-    _rule.get(StyleParamKey::extrude, m_params.extrude);
-    _rule.get(StyleParamKey::order, m_params.order);
 
-    if (Tangram::getDebugFlag(Tangram::DebugFlags::proxy_colors)) {
-        m_params.color <<= (m_zoom % 6);
+    // Stops are already resolved once per zoom when rules are merged,
+    // so the parsed parameters only change with the matched parameter
+    // set - unless a parameter is a per-feature function.
+    size_t hash = _rule.getParamSetHash();
+    bool dynamic = _rule.isJSFunction(StyleParamKey::color)
+        || _rule.isJSFunction(StyleParamKey::extrude)
+        || _rule.isJSFunction(StyleParamKey::order);
+
+    bool ruleChanged = dynamic || hash != m_lastRuleHash;
+
+    if (ruleChanged) {
+        _rule.get(StyleParamKey::color, m_params.color);
+        _rule.get(StyleParamKey::extrude, m_params.extrude);
+        _rule.get(StyleParamKey::order, m_params.order);
+
+        if (Tangram::getDebugFlag(Tangram::DebugFlags::proxy_colors)) {
+            m_params.color <<= (m_zoom % 6);
+        }
+
+        m_lastRuleHash = dynamic ? 0 : hash;
     }
 
     auto& extrude = m_params.extrude;
-    m_params.minHeight = getLowerExtrudeMeters(extrude, _props) * m_tileUnitsPerMeter;
-    m_params.height = getUpperExtrudeMeters(extrude, _props) * m_tileUnitsPerMeter;
+
+    // NAN markers ('extrude: true') pull heights from the feature
+    // properties, so those must be resolved for every feature.
+    if (ruleChanged || std::isnan(extrude[0]) || std::isnan(extrude[1])) {
+        m_params.minHeight = getLowerExtrudeMeters(extrude, _props) * m_tileUnitsPerMeter;
+        m_params.height = getUpperExtrudeMeters(extrude, _props) * m_tileUnitsPerMeter;
+    }
 
 }
 
+// Ring count above which a feature's triangulation is deferred past
+// the first-phase publish; earcut time grows superlinearly with ring
+// count, and one such feature can hold the worker long enough to
+// delay the whole tile.
+#define POLYGON_MAX_RINGS_INLINE 64
+
 template <class V>
 void PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) {
 
     parseRule(_rule, _props);
 
-    m_builder.addVertex = [this](const glm::vec3& coord,
-                                 const glm::vec3& normal,
-                                 const glm::vec2& uv) {
-        m_meshData.vertices.push_back({ coord, m_params.order, normal, uv, m_params.color });
-    };
+    if (_polygon.size() > POLYGON_MAX_RINGS_INLINE) {
+        m_deferred.push_back({ _polygon, m_params });
+        return;
+    }
+
+    tessellate(_polygon);
+}
+
+template <class V>
+void PolygonStyleBuilder<V>::tessellate(const Polygon& _polygon) {
+
+    // Pre-size the vertex buffer: the cap needs at most one vertex
+    // per point, walls add four per edge.
+    size_t numPoints = 0;
+    for (auto& line : _polygon) { numPoints += line.size(); }
+    size_t estimate = numPoints;
+    if (m_params.minHeight != m_params.height) { estimate += numPoints * 4; }
+    m_meshData.vertices.reserve(m_meshData.vertices.size() + estimate);
 
     if (m_params.minHeight != m_params.height) {
         Builders::buildPolygonExtrusion(_polygon, m_params.minHeight,
@@ -178,6 +266,16 @@ void PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Propertie
     m_builder.clear();
 }
 
+template <class V>
+void PolygonStyleBuilder<V>::buildDeferredGeometry() {
+
+    for (auto& deferred : m_deferred) {
+        m_params = deferred.params;
+        tessellate(deferred.polygon);
+    }
+    m_deferred.clear();
+}
+
 std::unique_ptr<StyleBuilder> PolygonStyle::createBuilder() const {
     if (m_texCoordsGeneration) {
         auto builder = std::make_unique<PolygonStyleBuilder<PolygonVertex>>(*this);
@@ -21,6 +21,10 @@
 #include "glm/vec3.hpp"
 #include "glm/gtc/type_precision.hpp"
 
+// Polyline vertices are fully 16-bit quantized: fixed point positions
+// and extrusion vectors, with line width and layer packed into the
+// spare .zw components. The scales must match the UNPACK_* macros in
+// polyline.vs.
 constexpr float extrusion_scale = 4096.0f;
 constexpr float position_scale = 8192.0f;
 constexpr float texture_scale = 8192.0f;
@@ -126,11 +130,52 @@ void PolylineStyle::constructShaderProgram() {
     m_shaderProgram->setSourceStrings(SHADER_SOURCE(polyline_fs),
                                       SHADER_SOURCE(polyline_vs));
 
+    if (m_smoothEdges) {
+        // The across-line texcoord doubles as the edge distance
+        m_texCoordsGeneration = true;
+        m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_LINE_SMOOTH_EDGES\n", false);
+        m_shaderProgram->addSourceBlock("extensions",
+            ShaderProgram::getExtensionDeclaration("OES_standard_derivatives"), false);
+    }
+
     if (m_texCoordsGeneration) {
         m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_USE_TEX_COORDS\n");
     }
 }
 
+namespace {
+
+// Lines are merged at the resolution the mesh is quantized to anyway
+glm::i32vec2 quantized(const Point& _point) {
+    return { glm::round(_point.x * position_scale),
+             glm::round(_point.y * position_scale) };
+}
+
+// Append or prepend _src to _dst, reversed when needed, if they share
+// an endpoint. Returns false when the lines do not connect.
+bool joinLines(Line& _dst, const Line& _src) {
+
+    auto dstFront = quantized(_dst.front());
+    auto dstBack = quantized(_dst.back());
+    auto srcFront = quantized(_src.front());
+    auto srcBack = quantized(_src.back());
+
+    if (dstBack == srcFront) {
+        _dst.insert(_dst.end(), _src.begin() + 1, _src.end());
+    } else if (dstBack == srcBack) {
+        _dst.insert(_dst.end(), _src.rbegin() + 1, _src.rend());
+    } else if (dstFront == srcBack) {
+        _dst.insert(_dst.begin(), _src.begin(), _src.end() - 1);
+    } else if (dstFront == srcFront) {
+        _dst.insert(_dst.begin(), _src.rbegin(), _src.rend() - 1);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}
+
 template <class V>
 struct PolylineStyleBuilder : public StyleBuilder {
 
@@ -151,16 +196,50 @@ public:
                 height = { glm::round(_height * position_scale), _order * order_scale};
                 width = { glm::round(_width * extrusion_scale), glm::round(_dWdZ * extrusion_scale) };
             }
+
+            bool operator==(const Attributes& _other) const {
+                return height == _other.height &&
+                       width == _other.width &&
+                       color == _other.color &&
+                       miterLimit == _other.miterLimit &&
+                       cap == _other.cap &&
+                       join == _other.join;
+            }
         } fill, stroke;
 
         bool keepTileEdges = false;
         bool closedPolygon = false;
         bool outlineOn = false;
         bool lineOn = true;
+
+        bool operator==(const Parameters& _other) const {
+            return fill == _other.fill &&
+                   stroke == _other.stroke &&
+                   keepTileEdges == _other.keepTileEdges &&
+                   closedPolygon == _other.closedPolygon &&
+                   outlineOn == _other.outlineOn &&
+                   lineOn == _other.lineOn;
+        }
+    };
+
+    // Lines collected for merging: one group per styling result and
+    // feature name, joined into strips when the mesh is built.
+    struct MergeGroup {
+        Parameters params;
+        std::string name;
+        std::vector<Line> lines;
     };
 
     void setup(const Tile& _tile) override;
 
+    void sizeHint(size_t _points, size_t _linePoints, size_t _polygonPoints) override {
+        // The extrusion emits two vertices per line point and six
+        // indices per segment; joins add a little on top. The stroke
+        // mesh is left to grow on demand - outlines are the exception.
+        m_meshData[0].vertices.reserve(_linePoints * 2 + _linePoints / 4);
+        m_meshData[0].indices.reserve(_linePoints * 6);
+    }
+
     const Style& style() const override { return m_style; }
 
     void addFeature(const Feature& _feat, const DrawRule& _rule) override;
@@ -184,10 +263,13 @@ public:
 
 private:
 
+    void flushMergeGroups();
+
     const PolylineStyle& m_style;
     PolyLineBuilder m_builder;
 
     std::vector<MeshData<V>> m_meshData;
+    std::vector<MergeGroup> m_mergeGroups;
 
     float m_tileUnitsPerMeter;
     float m_tileSizePixels;
@@ -210,15 +292,59 @@ void PolylineStyleBuilder<V>::setup(const Tile& tile) {
     // 'source' tile, which will have a larger effective pixel size at the
     // 'style' zoom level. This scaling is performed in the vertex shader to
     // prevent loss of precision for small dimensions in packed attributes.
+
+    // Drop line detail below half a pixel before tesselation. The
+    // tile is displayed at m_overzoom2 times its own size when
+    // overzoomed, so the tolerance shrinks accordingly; at low zooms
+    // dense source geometry collapses to what is actually visible.
+    m_builder.simplificationTolerance =
+        0.5f / (m_tileSizePixels * m_style.pixelScale() * m_overzoom2);
+
+    m_mergeGroups.clear();
+}
+
+template <class V>
+void PolylineStyleBuilder<V>::flushMergeGroups() {
+
+    for (auto& group : m_mergeGroups) {
+        auto& lines = group.lines;
+
+        // Join end-matching lines within the group. A successful join
+        // changes the endpoints, so the remaining lines are rescanned.
+        for (size_t i = 0; i < lines.size(); i++) {
+            for (size_t j = i + 1; j < lines.size();) {
+                if (joinLines(lines[i], lines[j])) {
+                    if (j < lines.size() - 1) {
+                        lines[j] = std::move(lines.back());
+                    }
+                    lines.pop_back();
+                    j = i + 1;
+                } else {
+                    j++;
+                }
+            }
+        }
+
+        for (const auto& line : lines) {
+            addMesh(line, group.params);
+        }
+    }
+    m_mergeGroups.clear();
 }
 
 template <class V>
 std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
+
+    flushMergeGroups();
+
     if (m_meshData[0].vertices.empty() &&
         m_meshData[1].vertices.empty()) {
         return nullptr;
     }
 
+    m_meshData[0].weld();
+    m_meshData[1].weld();
+
     auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(), m_style.drawMode());
 
     bool painterMode = (m_style.blendMode() == Blending::overlay ||
@@ -383,6 +509,27 @@ void PolylineStyleBuilder<V>::addFeature(const Feature& _feat, const DrawRule& _
         // Line geometries are never clipped to tiles, so keep all segments
         params.keepTileEdges = true;
 
+        if (m_style.mergeLines()) {
+            const auto& name = _feat.props.getString("name");
+
+            MergeGroup* group = nullptr;
+            for (auto& candidate : m_mergeGroups) {
+                if (candidate.params == params && candidate.name == name) {
+                    group = &candidate;
+                    break;
+                }
+            }
+            if (!group) {
+                m_mergeGroups.push_back({ params, name, {} });
+                group = &m_mergeGroups.back();
+            }
+
+            for (auto& line : _feat.lines) {
+                if (line.size() > 1) { group->lines.push_back(line); }
+            }
+            return;
+        }
+
         for (auto& line : _feat.lines) {
             addMesh(line, params);
         }
@@ -23,11 +23,19 @@ public:
 
     void setDashBackgroundColor(const glm::vec4 _dashBackgroundColor);
 
+    /* When set, lines with matching endpoints, styling and name are
+     * joined into continuous strips before tesselation. Road networks
+     * often arrive chopped into short features; merging them renders
+     * joins instead of stacked end caps and shares their vertices. */
+    void setMergeLines(bool _mergeLines) { m_mergeLines = _mergeLines; }
+    bool mergeLines() const { return m_mergeLines; }
+
 private:
 
     std::vector<int> m_dashArray;
     std::shared_ptr<Texture> m_texture;
     bool m_dashBackground = false;
+    bool m_mergeLines = false;
     glm::vec4 m_dashBackgroundColor;
 
     UniformLocation m_uTexture{"u_texture"};
@@ -43,15 +43,32 @@ void Style::build(const Scene& _scene) {
 
     m_shaderProgram->setDescription("{style:" + m_name + "}");
 
-    switch (m_lightingType) {
-        case LightingType::vertex:
-            m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_LIGHTING_VERTEX\n", false);
-            break;
-        case LightingType::fragment:
-            m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_LIGHTING_FRAGMENT\n", false);
-            break;
-        default:
-            break;
+    bool lit = m_lightingType != LightingType::none;
+
+    // When every light multiplies the geometry color by plain white the
+    // whole lighting path compiles to an identity; skip the lighting
+    // defines and light injection so the program is built without any
+    // lighting code. This covers the default scene setup of a single
+    // white ambient light and an untextured white material.
+    if (lit && m_material.material && m_material.material->isPlainWhite()) {
+        bool identity = true;
+        for (auto& light : _scene.lights()) {
+            if (!light->isIdentity()) { identity = false; break; }
+        }
+        if (identity) { lit = false; }
+    }
+
+    if (lit) {
+        switch (m_lightingType) {
+            case LightingType::vertex:
+                m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_LIGHTING_VERTEX\n", false);
+                break;
+            case LightingType::fragment:
+                m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_LIGHTING_FRAGMENT\n", false);
+                break;
+            default:
+                break;
+        }
     }
     
     if (m_blend == Blending::inlay) {
@@ -59,12 +76,20 @@ void Style::build(const Scene& _scene) {
     } else if (m_blend == Blending::overlay) {
         m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_BLEND_OVERLAY\n", false);
     }
+
+    // With fog, distant fragments blend into the horizon color; this
+    // hides the far cutoff of the visible-tile set when the clip scale
+    // pulls it in (see View::setHorizonClipScale)
+    if (_scene.fog().enabled) {
+        m_fog = true;
+        m_shaderProgram->addSourceBlock("defines", "#define TANGRAM_FOG\n", false);
+    }
     
     if (m_material.material) {
         m_material.uniforms = m_material.material->injectOnProgram(*m_shaderProgram);
     }
 
-    if (m_lightingType != LightingType::none) {
+    if (lit) {
         for (auto& light : _scene.lights()) {
             auto uniforms = light->injectOnProgram(*m_shaderProgram);
             if (uniforms) {
@@ -178,6 +203,10 @@ void Style::onBeginDrawFrame(const View& _view, Scene& _scene) {
     // Reset the currently used texture unit to 0
     RenderState::resetTextureUnit();
 
+    // Any raster binding from the previous pass died with the unit
+    // reset above
+    m_rasterBinding.textures.clear();
+
     // Set time uniforms style's shader programs
     m_shaderProgram->setUniformf(m_uTime, _scene.time());
 
@@ -203,6 +232,18 @@ void Style::onBeginDrawFrame(const View& _view, Scene& _scene) {
     m_shaderProgram->setUniformMatrix4f(m_uView, _view.getViewMatrix());
     m_shaderProgram->setUniformMatrix4f(m_uProj, _view.getProjectionMatrix());
 
+    if (m_fog) {
+        const auto& fog = _scene.fog();
+        // Fully fogged just before the tile clip distance, so the edge
+        // of the visible-tile set is never seen
+        float end = _view.maxTileDistance() * 0.95f;
+        m_shaderProgram->setUniformf(m_uFogDistance, end * 0.6f, end);
+        m_shaderProgram->setUniformf(m_uFogColor,
+                                     fog.color.r / 255.f,
+                                     fog.color.g / 255.f,
+                                     fog.color.b / 255.f);
+    }
+
     setupShaderUniforms(_scene);
 
     // Configure render state
@@ -252,38 +293,58 @@ void Style::draw(const Tile& _tile) {
     TileID tileID = _tile.getID();
 
     if (hasRasters() && !_tile.rasters().empty()) {
-        UniformTextureArray textureIndexUniform;
-        UniformArray2f rasterSizeUniform;
-        UniformArray3f rasterOffsetsUniform;
+        auto& binding = m_rasterBinding;
+
+        // Collect this tile's raster textures and per-tile offsets;
+        // overzoomed tiles sample a window of their ancestor texture
+        binding.scratch.clear();
+        binding.offsets.clear();
 
         for (auto& raster : _tile.rasters()) {
             if (raster.isValid()) {
-                auto& texture = raster.texture;
-                auto texUnit = RenderState::nextAvailableTextureUnit();
-                texture->update(texUnit);
-                texture->bind(texUnit);
-
-                textureIndexUniform.slots.push_back(texUnit);
-                rasterSizeUniform.push_back({texture->getWidth(), texture->getHeight()});
+                binding.scratch.push_back(raster.texture.get());
 
                 if (tileID.z > raster.tileID.z) {
                     float dz = tileID.z - raster.tileID.z;
                     float dz2 = powf(2.f, dz);
 
-                    rasterOffsetsUniform.push_back({
+                    binding.offsets.push_back({
                             fmodf(tileID.x, dz2) / dz2,
                                 (dz2 - 1.f - fmodf(tileID.y, dz2)) / dz2,
                                 1.f / dz2
                                 });
                 } else {
-                    rasterOffsetsUniform.push_back({0, 0, 1});
+                    binding.offsets.push_back({0, 0, 1});
                 }
             }
         }
 
-        m_shaderProgram->setUniformi(m_uRasters, textureIndexUniform);
-        m_shaderProgram->setUniformf(m_uRasterSizes, rasterSizeUniform);
-        m_shaderProgram->setUniformf(m_uRasterOffsets, rasterOffsetsUniform);
+        // Rebind and resend the sampler arrays only when the texture
+        // set differs from the previous tile's; tiles overzoomed from
+        // the same ancestors just update their offsets
+        if (binding.scratch != binding.textures) {
+            for (size_t i = 0; i < binding.textures.size(); i++) {
+                RenderState::releaseTextureUnit();
+            }
+            binding.textures.swap(binding.scratch);
+
+            UniformTextureArray textureIndexUniform;
+            UniformArray2f rasterSizeUniform;
+
+            for (auto* texture : binding.textures) {
+                auto texUnit = RenderState::nextAvailableTextureUnit();
+                texture->update(texUnit);
+                texture->bind(texUnit);
+
+                textureIndexUniform.slots.push_back(texUnit);
+                rasterSizeUniform.push_back({texture->getWidth(), texture->getHeight()});
+            }
+
+            m_shaderProgram->setUniformi(m_uRasters, textureIndexUniform);
+            m_shaderProgram->setUniformf(m_uRasterSizes, rasterSizeUniform);
+        }
+
+        m_shaderProgram->setUniformf(m_uRasterOffsets, binding.offsets);
     }
 
     m_shaderProgram->setUniformMatrix4f(m_uModel, _tile.getModelMatrix());
@@ -298,13 +359,8 @@ void Style::draw(const Tile& _tile) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
     }
 
-    if (hasRasters()) {
-        for (auto& raster : _tile.rasters()) {
-            if (raster.isValid()) {
-                RenderState::releaseTextureUnit();
-            }
-        }
-    }
+    // Raster texture units stay held for the next tile; they are
+    // released when the binding changes or the pass ends
 }
 
 bool StyleBuilder::checkRule(const DrawRule& _rule) const {
@@ -360,6 +416,14 @@ StyleBuilder::StyleBuilder(const Style& _style) {
     }
 }
 
+std::shared_ptr<Properties> StyleBuilder::propertiesRef(const Properties& _props) const {
+    if (m_lastProps != &_props) {
+        m_lastProps = &_props;
+        m_lastPropsRef = std::make_shared<Properties>(_props);
+    }
+    return m_lastPropsRef;
+}
+
 void StyleBuilder::addPoint(const Point& _point, const Properties& _props, const DrawRule& _rule) {
     // No-op by default
 }
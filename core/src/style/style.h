@@ -20,6 +20,7 @@ class Tile;
 class MapProjection;
 class Material;
 struct MaterialUniforms;
+class Texture;
 class VertexLayout;
 class View;
 class Scene;
@@ -52,6 +53,17 @@ struct StyledMesh {
     virtual bool draw(ShaderProgram& _shader) = 0;
     virtual size_t bufferSize() const = 0;
 
+    /* Copies the mesh data into GL buffer objects; drawing uploads
+     * lazily, this allows staging uploads ahead of the first draw.
+     * No-op for meshes without their own GL buffers. */
+    virtual void upload() {}
+
+    /* Hash of the built, not yet uploaded geometry; 0 for meshes whose
+     * content is produced at draw time (e.g. labels). Tests and
+     * benchmarks compare these hashes across builds to verify that
+     * pipeline changes are output-neutral. */
+    virtual size_t contentHash() const { return 0; }
+
     virtual ~StyledMesh() {}
 };
 
@@ -64,6 +76,15 @@ public:
 
     virtual void setup(const Tile& _tile) = 0;
 
+    /* Hint of the geometry volume of the tile about to be built: total
+     * point counts per geometry type, summed over all features. Point
+     * counts are known after parsing, so builders can pre-size their
+     * buffers once instead of reallocating while features stream in.
+     * The counts are an upper bound - rules route only a subset of
+     * features to each style. The default ignores the hint.
+     */
+    virtual void sizeHint(size_t _points, size_t _linePoints, size_t _polygonPoints) {}
+
     virtual void addFeature(const Feature& _feat, const DrawRule& _rule);
 
     /* Build styled vertex data for point geometry */
@@ -75,6 +96,15 @@ public:
     /* Build styled vertex data for polygon geometry */
     virtual void addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule);
 
+    /* Whether addFeature set geometry aside to be tessellated after the
+     * first-phase tile is published; see buildDeferredGeometry() */
+    virtual bool hasDeferredGeometry() const { return false; }
+
+    /* Tessellates geometry set aside during addFeature. Runs on the
+     * worker after the partial tile is published, so one pathological
+     * feature no longer delays the tile's first display. */
+    virtual void buildDeferredGeometry() {}
+
     /* Create a new mesh object using the vertex layout corresponding to this style */
     virtual std::unique_ptr<StyledMesh> build() = 0;
 
@@ -84,8 +114,23 @@ public:
 
     virtual const Style& style() const = 0;
 
+    /* Drops the per-feature properties memo below; called once per
+     * tile, since feature addresses are only stable within one build */
+    void clearPropertiesRef() { m_lastProps = nullptr; m_lastPropsRef.reset(); }
+
 protected:
     bool m_hasColorShaderBlock = false;
+
+    /* Shared handle on a copy of _props, retained with interactive
+     * labels for pick results. Consecutive calls for the same feature
+     * return the same copy, so a feature matched by several
+     * interactive rules or label types is kept once instead of once
+     * per label. */
+    std::shared_ptr<Properties> propertiesRef(const Properties& _props) const;
+
+private:
+    mutable const Properties* m_lastProps = nullptr;
+    mutable std::shared_ptr<Properties> m_lastPropsRef;
 };
 
 /* Means of constructing and rendering map geometry
@@ -129,9 +174,18 @@ protected:
     /* animated property */
     bool m_animated = false;
 
+    /* See hasDepthPrepass() */
+    bool m_depthPrepass = false;
+
     /* Whether the style should generate texture coordinates */
     bool m_texCoordsGeneration = false;
 
+    /* See setSmoothEdges() */
+    bool m_smoothEdges = false;
+
+    /* Whether the scene enables fog; set at build() */
+    bool m_fog = false;
+
     /* Set uniform values when @_updateUniforms is true,
      */
     void setupShaderUniforms(Scene& _scene);
@@ -146,6 +200,8 @@ protected:
     UniformLocation m_uMetersPerPixel{"u_meters_per_pixel"};
     UniformLocation m_uView{"u_view"};
     UniformLocation m_uProj{"u_proj"};
+    UniformLocation m_uFogColor{"u_fog_color"};
+    UniformLocation m_uFogDistance{"u_fog_distance"};
     // Tile uniforms
     UniformLocation m_uModel{"u_model"};
     UniformLocation m_uTileOrigin{"u_tile_origin"};
@@ -156,6 +212,17 @@ protected:
 
     RasterType m_rasterType = RasterType::none;
 
+    /* Raster binding held for the tile drawn last in the current
+     * pass. Overzoomed tiles usually share their parent's textures,
+     * so consecutive tiles reuse the bound units and only the raster
+     * offsets are resent (see draw()). */
+    struct RasterBinding {
+        std::vector<Texture*> textures; // currently bound
+        std::vector<Texture*> scratch;
+        UniformArray3f offsets;
+    };
+    RasterBinding m_rasterBinding;
+
 private:
 
     std::vector<StyleUniform> m_styleUniforms;
@@ -210,6 +277,14 @@ public:
     void setBlendMode(Blending _blendMode) { m_blend = _blendMode; }
     void setBlendOrder(int _blendOrder) { m_blendOrder = _blendOrder; }
 
+    /* Whether this style's tiles are drawn depth-only first, so the
+     * main pass shades each pixel once. Worthwhile for opaque styles
+     * with heavy overdraw, like extruded buildings; only honored for
+     * blend mode 'none'. */
+    bool hasDepthPrepass() const { return m_depthPrepass && m_blend == Blending::none; }
+
+    void setDepthPrepass(bool _depthPrepass) { m_depthPrepass = _depthPrepass; }
+
     /* Whether or not the style is animated */
     bool isAnimated() { return m_animated; }
 
@@ -251,6 +326,14 @@ public:
 
     void setRasterType(RasterType _rasterType) { m_rasterType = _rasterType; }
 
+    /* Whether edges are antialiased analytically in the fragment
+     * shader. Honored by styles that carry an edge-distance varying
+     * (polylines, via their across-line texcoord); lets a scene drop
+     * MSAA from the surface config without visible stair-stepping.
+     * Effective for styles drawn with blending. */
+    void setSmoothEdges(bool _smoothEdges) { m_smoothEdges = _smoothEdges; }
+    bool smoothEdges() const { return m_smoothEdges; }
+
     void setTexCoordsGeneration(bool _texCoordsGeneration) { m_texCoordsGeneration = _texCoordsGeneration; }
 
     bool genTexCoords() const { return m_texCoordsGeneration; }
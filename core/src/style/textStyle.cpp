@@ -30,6 +30,7 @@ void TextStyle::constructVertexLayout() {
         {"a_stroke", 4, GL_UNSIGNED_BYTE, true, 0},
         {"a_alpha", 1, GL_UNSIGNED_SHORT, true, 0},
         {"a_scale", 1, GL_UNSIGNED_SHORT, false, 0},
+        {"a_fade", 4, GL_UNSIGNED_SHORT, false, 0},
     }));
 }
 
@@ -37,6 +37,11 @@ public:
         TextLabelProperty::Align align = TextLabelProperty::Align::center;
         LabelProperty::Anchor anchor = LabelProperty::Anchor::center;
 
+        // Anchor placements tried in order by the collision pass when
+        // the previous one collides; the first entry is the primary
+        // anchor. Empty for single-anchor labels.
+        std::vector<LabelProperty::Anchor> anchors;
+
         float fontScale = 1;
         float lineSpacing = 0;
     };
@@ -81,6 +86,12 @@ public:
      */
     void onBeginDrawFrame(const View& _view, Scene& _scene) override;
 
+    /* Text isn't drawn per tile: visible glyph quads from all tiles are
+     * batched into m_meshes (one per atlas page) during label update and
+     * drawn in onBeginDrawFrame, so the per-tile pass has nothing to do.
+     * Skipping it saves the tile uniform setup for every visible tile. */
+    void draw(const Tile& _tile) override {}
+
     std::unique_ptr<StyleBuilder> createBuilder() const override;
 
     DynamicQuadMesh<TextVertex>& getMesh(size_t id) const;
@@ -118,6 +129,9 @@ namespace std {
             hash_combine(seed, int(p.transform));
             hash_combine(seed, int(p.align));
             hash_combine(seed, int(p.anchor));
+            for (auto& anchor : p.anchors) {
+                hash_combine(seed, int(anchor));
+            }
             hash_combine(seed, optionsHash(p.labelOptions));
             return seed;
         }
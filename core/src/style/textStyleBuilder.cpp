@@ -341,11 +341,31 @@ TextStyle::Parameters TextStyleBuilder::applyRule(const DrawRule& _rule,
     p.labelOptions.repeatDistance *= m_style.pixelScale();
 
     if (p.interactive) {
-        p.labelOptions.properties = std::make_shared<Properties>(_props);
+        p.labelOptions.properties = propertiesRef(_props);
     }
 
     if (anchor) {
-        LabelProperty::anchor(*anchor, p.anchor);
+        // A comma-separated list names fallback placements, tried in
+        // order by the collision pass; the first entry is the primary
+        size_t start = 0;
+        while (start < anchor->length()) {
+            size_t end = anchor->find(',', start);
+            if (end == std::string::npos) { end = anchor->length(); }
+
+            size_t first = anchor->find_first_not_of(" \t", start);
+            size_t last = anchor->find_last_not_of(" \t", end - 1);
+
+            if (first != std::string::npos && first < end && first <= last) {
+                LabelProperty::Anchor a;
+                if (LabelProperty::anchor(anchor->substr(first, last - first + 1), a)) {
+                    p.anchors.push_back(a);
+                }
+            }
+            start = end + 1;
+        }
+
+        if (!p.anchors.empty()) { p.anchor = p.anchors.front(); }
+        if (p.anchors.size() < 2) { p.anchors.clear(); }
     }
 
     if (auto* transform = _rule.get<std::string>(StyleParamKey::text_transform)) {
@@ -506,6 +526,7 @@ void TextStyleBuilder::addLabel(const TextStyle::Parameters& _params, Label::Typ
     int quadsCount = m_quads.size() - quadsStart;
 
     m_labels.emplace_back(new TextLabel(_transform, _type, _params.labelOptions, _params.anchor,
+                                        _params.anchors,
                                         {m_attributes.fill, m_attributes.stroke, m_attributes.fontScale},
                                         {m_attributes.width, m_attributes.height},
                                         *m_textLabels, {quadsStart, quadsCount}));
@@ -1,22 +1,28 @@
 #include "tangram.h"
 
 #include "platform.h"
+#include "scene/dataLayer.h"
 #include "scene/scene.h"
 #include "scene/sceneLoader.h"
 #include "style/material.h"
 #include "style/style.h"
 #include "labels/labels.h"
+#include "marker/markerManager.h"
 #include "text/fontContext.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
 #include "gl/error.h"
+#include "gl/frameBuffer.h"
 #include "gl/shaderProgram.h"
 #include "gl/renderState.h"
 #include "gl/primitives.h"
 #include "util/asyncWorker.h"
+#include "util/util.h"
+#include "util/frameGovernor.h"
 #include "util/inputHandler.h"
 #include "tile/tileCache.h"
 #include "util/fastmap.h"
+#include "util/memoryBudget.h"
 #include "view/view.h"
 #include "data/clientGeoJsonSource.h"
 #include "gl.h"
@@ -25,13 +31,40 @@
 #include "util/jobQueue.h"
 #include "debug/textDisplay.h"
 #include "debug/frameInfo.h"
+#include "debug/buildTelemetry.h"
+#include "debug/tileLatency.h"
 
+#include <algorithm>
 #include <cmath>
 #include <bitset>
+#include <thread>
 
 namespace Tangram {
 
-const static size_t MAX_WORKERS = 2;
+// Tile-builder threads: one per hardware core beyond the render
+// thread, within bounds - single-core targets get one worker instead
+// of paying for stacks they cannot run, and big desktops don't
+// multiply scene contexts past any benefit
+static int numTileWorkers() {
+    int cores = int(std::thread::hardware_concurrency());
+    if (cores <= 0) { return 2; }
+    return std::min(std::max(cores - 1, 1), 6);
+}
+
+// Per-frame byte budget for staging the meshes of newly built tiles
+const static size_t MAX_TILE_UPLOAD_BYTES = 4 * 1024 * 1024;
+
+// Per-frame time budget for tile bookkeeping; after a burst of
+// finished builds, finalization past the deadline carries over to the
+// next frame instead of blowing the frame budget
+const static float MAX_TILE_UPDATE_MS = 4.f;
+
+// Shortest time between two label collision passes while the view
+// moves. Between passes labels keep their placement decisions and
+// only their screen transforms follow the view, so the expensive
+// sort-and-collide work leaves the per-frame path; a decision lagging
+// a few frames is not visible, a long label frame is.
+const static float LABEL_COLLISION_INTERVAL = 0.1f;
 
 enum class EaseField { position, zoom, rotation, tilt };
 
@@ -39,7 +72,10 @@ class Map::Impl {
 
 public:
 
-    void setScene(std::shared_ptr<Scene>& _scene);
+    // _rebuildSources names the sources whose tiles must be rebuilt
+    // for a scene update; nullptr rebuilds everything (fresh loads)
+    void setScene(std::shared_ptr<Scene>& _scene,
+                  const std::vector<std::string>* _rebuildSources = nullptr);
 
     void setEase(EaseField _f, Ease _e);
     void clearEase(EaseField _f);
@@ -51,36 +87,124 @@ public:
 
     void setPixelScale(float _pixelsPerPoint);
 
+    /* Computes the visible set at the endpoint of the active camera
+     * ease and hands it to the tile manager as prefetch, so eased
+     * moves land on built tiles instead of blurry proxies. */
+    void primeEaseTargetTiles();
+
     std::mutex tilesMutex;
     std::mutex sceneMutex;
 
     View view;
     Labels labels;
+    MarkerManager markers;
+    FrameGovernor frameGovernor;
     AsyncWorker asyncWorker;
     InputHandler inputHandler{view};
-    TileWorker tileWorker{MAX_WORKERS};
+    TileWorker tileWorker{numTileWorkers()};
     TileManager tileManager{tileWorker};
 
     std::vector<SceneUpdate> sceneUpdates;
-    std::array<Ease, 4> eases;
+    EaseManager eases;
+
+    // Endpoint of the active camera ease; fields are set by the eased
+    // setters and reset when the eases settle
+    struct EaseTarget {
+        bool hasPosition = false;
+        double lon = 0.0;
+        double lat = 0.0;
+        bool hasZoom = false;
+        float zoom = 0.f;
+        bool hasRotation = false;
+        float rotation = 0.f;
+        bool hasTilt = false;
+        float tilt = 0.f;
+    };
+    EaseTarget easeTarget;
+
+    // Visible set at the ease endpoint, fed to the tile manager as
+    // prefetch while the ease runs
+    std::set<TileID> easeTargetTiles;
+
+    // Open scene-update transactions; while positive, applySceneUpdates
+    // defers until the outermost commit. Guarded by sceneMutex.
+    int sceneUpdateTransactions = 0;
+    bool applyOnCommit = false;
+
+    // Scratch buffer for the per-style tile collection in render();
+    // kept as a member so its capacity survives between frames
+    std::vector<const Tile*> drawTiles;
 
     std::shared_ptr<Scene> scene = std::make_shared<Scene>();
     std::shared_ptr<Scene> nextScene = nullptr;
 
+    // Render target for renderOffscreen(), created on first use
+    std::unique_ptr<FrameBuffer> offscreenTarget;
+
+    // True while render() draws into offscreenTarget
+    bool offscreenPass = false;
+
+    // Time since the last label collision pass, see LABEL_COLLISION_INTERVAL
+    float labelCollisionDelay = 0.f;
+
+    // Pending asynchronous pick query - a single slot, so a stream of
+    // pointer moves coalesces to the newest position. Guarded by
+    // pickMutex; queries may be posted from any thread.
+    struct PickQuery {
+        float x = 0.f;
+        float y = 0.f;
+        FeaturePickCallback callback;
+    };
+    std::mutex pickMutex;
+    PickQuery pendingPick;
+
     bool cacheGlState;
 
 };
 
 void Map::Impl::setEase(EaseField _f, Ease _e) {
-    eases[static_cast<size_t>(_f)] = _e;
-    requestRender();
+    eases.set(static_cast<size_t>(_f), _e);
+    requestRender(RenderDirty::full);
 }
 void Map::Impl::clearEase(EaseField _f) {
-    static Ease none = {};
-    eases[static_cast<size_t>(_f)] = none;
+    eases.clear(static_cast<size_t>(_f));
+
+    switch (_f) {
+        case EaseField::position: easeTarget.hasPosition = false; break;
+        case EaseField::zoom:     easeTarget.hasZoom = false; break;
+        case EaseField::rotation: easeTarget.hasRotation = false; break;
+        case EaseField::tilt:     easeTarget.hasTilt = false; break;
+    }
+
+    if (easeTarget.hasPosition || easeTarget.hasZoom ||
+        easeTarget.hasRotation || easeTarget.hasTilt) {
+        primeEaseTargetTiles();
+    } else {
+        easeTargetTiles.clear();
+    }
 }
 
-static std::bitset<8> g_flags = 0;
+void Map::Impl::primeEaseTargetTiles() {
+
+    // Run a copy of the view at the ease endpoint; its visible set is
+    // requested right away so the animation lands on built tiles
+    View target = view;
+
+    if (easeTarget.hasPosition) {
+        glm::dvec2 meters =
+            view.getMapProjection().LonLatToMeters({easeTarget.lon, easeTarget.lat});
+        target.setPosition(meters.x, meters.y);
+    }
+    if (easeTarget.hasZoom) { target.setZoom(easeTarget.zoom); }
+    if (easeTarget.hasRotation) { target.setRoll(easeTarget.rotation); }
+    if (easeTarget.hasTilt) { target.setPitch(easeTarget.tilt); }
+
+    target.update();
+
+    easeTargetTiles = target.getVisibleTiles();
+}
+
+static std::bitset<16> g_flags = 0;
 
 Map::Map() {
 
@@ -95,7 +219,8 @@ Map::~Map() {
     JobQueue::runJobsForCurrentThread();
 }
 
-void Map::Impl::setScene(std::shared_ptr<Scene>& _scene) {
+void Map::Impl::setScene(std::shared_ptr<Scene>& _scene,
+                         const std::vector<std::string>* _rebuildSources) {
     {
         std::lock_guard<std::mutex> lock(sceneMutex);
         scene = _scene;
@@ -128,9 +253,15 @@ void Map::Impl::setScene(std::shared_ptr<Scene>& _scene) {
         view.setZoom(scene->startZoom);
     }
 
+    auto& fog = scene->fog();
+    view.setHorizonClipScale(fog.enabled ? fog.distance : 1.f);
+
     inputHandler.setView(view);
-    tileManager.setDataSources(_scene->dataSources());
+    tileManager.setDataSources(_scene->dataSources(), _rebuildSources);
     tileWorker.setScene(_scene);
+    // The old scene's tiles are gone; drop label state pointing into
+    // their meshes.
+    labels.clear();
     setPixelScale(view.pixelScale());
 
     bool animated = scene->animated() == Scene::animate::yes;
@@ -158,6 +289,16 @@ void Map::loadScene(const char* _scenePath, bool _useScenePosition) {
     }
 }
 
+void Map::shareResourcesFrom(Map& _other) {
+
+    auto scene = _other.impl->scene;
+    impl->setScene(scene);
+
+    // Adopt the other map's cache after the scene: setDataSources()
+    // clears the cache it holds, which must not hit the shared one
+    impl->tileManager.setTileCache(_other.impl->tileManager.getTileCache());
+}
+
 void Map::loadSceneAsync(const char* _scenePath, bool _useScenePosition, MapReady _platformCallback) {
     LOG("Loading scene file (async): %s", _scenePath);
 
@@ -198,37 +339,127 @@ void Map::queueSceneUpdate(const char* _path, const char* _value) {
     impl->sceneUpdates.push_back({_path, _value});
 }
 
+void Map::beginSceneUpdates() {
+    std::lock_guard<std::mutex> lock(impl->sceneMutex);
+    impl->sceneUpdateTransactions++;
+}
+
+void Map::commitSceneUpdates() {
+    {
+        std::lock_guard<std::mutex> lock(impl->sceneMutex);
+        if (impl->sceneUpdateTransactions == 0) {
+            LOGW("commitSceneUpdates without matching beginSceneUpdates");
+            return;
+        }
+        if (--impl->sceneUpdateTransactions > 0) { return; }
+
+        if (!impl->applyOnCommit) { return; }
+        impl->applyOnCommit = false;
+    }
+
+    applySceneUpdates();
+}
+
+bool Map::isSceneUpdatePending() {
+    std::lock_guard<std::mutex> lock(impl->sceneMutex);
+    return !impl->sceneUpdates.empty() || bool(impl->nextScene);
+}
+
 void Map::applySceneUpdates() {
 
     LOG("Applying %d scene updates", impl->sceneUpdates.size());
 
+    {
+        std::lock_guard<std::mutex> lock(impl->sceneMutex);
+        if (impl->sceneUpdateTransactions > 0) {
+            // Deferred to the outermost commitSceneUpdates, which
+            // applies everything queued meanwhile in one pass
+            impl->applyOnCommit = true;
+            return;
+        }
+    }
+
     if (impl->nextScene) {
         // Changes are automatically applied once the scene is loaded
         return;
     }
 
-    std::vector<SceneUpdate> updates;
+    std::vector<SceneUpdate> queued;
     {
         std::lock_guard<std::mutex> lock(impl->sceneMutex);
         if (impl->sceneUpdates.empty()) { return; }
 
+        queued = impl->sceneUpdates;
+        impl->sceneUpdates.clear();
+    }
+
+    // Shader uniform values can be swapped on the live scene without
+    // rebuilding any tiles; only structural changes (layers, filters,
+    // sources) need the full config rebuild below.
+    std::vector<SceneUpdate> updates;
+    std::vector<SceneUpdate> uniformUpdates;
+    for (auto& update : queued) {
+        if (SceneLoader::applyUniformUpdate(update, impl->scene)) {
+            uniformUpdates.push_back(update);
+        } else {
+            updates.push_back(update);
+        }
+    }
+
+    if (!uniformUpdates.empty()) {
+        // Write the new values through to the config so that a later
+        // full rebuild starts from the updated document.
+        SceneLoader::applyUpdates(impl->scene->config(), uniformUpdates);
+        requestRender(RenderDirty::full);
+    }
+
+    if (updates.empty()) { return; }
+
+    // Scope the tile rebuild: when every structural update stays under
+    // a single layer, only that layer's source can produce different
+    // geometry, so tiles of the other sources survive the scene swap.
+    // Paths outside 'layers' (styles, sources, fonts, ...) or layers
+    // that cannot be resolved fall back to rebuilding everything.
+    bool layerScoped = true;
+    std::vector<std::string> rebuildSources;
+    for (auto& update : updates) {
+        auto keys = splitString(update.keys, '.');
+
+        const DataLayer* layer = nullptr;
+        if (keys.size() >= 2 && keys[0] == "layers") {
+            for (auto& l : impl->scene->layers()) {
+                if (l.name() == keys[1]) { layer = &l; break; }
+            }
+        }
+        if (!layer) {
+            layerScoped = false;
+            break;
+        }
+        if (std::find(rebuildSources.begin(), rebuildSources.end(),
+                      layer->source()) == rebuildSources.end()) {
+            rebuildSources.push_back(layer->source());
+        }
+    }
+    if (!layerScoped) { rebuildSources.clear(); }
+
+    {
+        std::lock_guard<std::mutex> lock(impl->sceneMutex);
         impl->nextScene = std::make_shared<Scene>(*impl->scene);
         impl->nextScene->useScenePosition = false;
-
-        updates = impl->sceneUpdates;
-        impl->sceneUpdates.clear();
     }
 
     JobQueue mainThreadJobQueue;
     mainThreadJobQueue.makeCurrentThreadTarget();
 
-    runAsyncTask([scene = impl->nextScene, updates = std::move(updates), mainThreadJobQueue, this](){
+    runAsyncTask([scene = impl->nextScene, updates = std::move(updates),
+                  layerScoped, rebuildSources = std::move(rebuildSources),
+                  mainThreadJobQueue, this](){
 
             SceneLoader::applyUpdates(scene->config(), updates);
 
             bool ok = SceneLoader::applyConfig(scene->config(), scene);
 
-            mainThreadJobQueue.add([scene, ok, this]() {
+            mainThreadJobQueue.add([scene, ok, layerScoped, rebuildSources, this]() {
                     if (scene == impl->nextScene) {
                         std::lock_guard<std::mutex> lock(impl->sceneMutex);
                         impl->nextScene.reset();
@@ -236,7 +467,7 @@ void Map::applySceneUpdates() {
 
                     if (ok) {
                         auto s = scene;
-                        impl->setScene(s);
+                        impl->setScene(s, layerScoped ? &rebuildSources : nullptr);
                         applySceneUpdates();
                     }
                 });
@@ -258,6 +489,7 @@ void Map::resize(int _newWidth, int _newHeight) {
 bool Map::update(float _dt) {
 
     FrameInfo::beginUpdate();
+    FrameInfo::beginScope(FrameInfo::Scope::update);
 
     JobQueue::runJobsForCurrentThread();
 
@@ -265,15 +497,21 @@ bool Map::update(float _dt) {
 
     bool viewComplete = true;
 
-    for (auto& ease : impl->eases) {
-        if (!ease.finished()) {
-            ease.update(_dt);
-            viewComplete = false;
-        }
+    // Step all camera eases in one pass; steps are batched to a
+    // fixed timestep inside the manager
+    if (impl->eases.update(_dt)) {
+        viewComplete = false;
     }
 
     impl->inputHandler.update(_dt);
 
+    // Boost the tile workers while the user interacts, so the tiles
+    // the interaction exposes build at interactive priority
+    impl->tileWorker.setInteractive(impl->inputHandler.recentlyActive());
+
+    impl->frameGovernor.update(_dt);
+    impl->view.setLodBias(impl->frameGovernor.lodBias());
+
     impl->view.update();
 
     for (const auto& style : impl->scene->styles()) {
@@ -289,25 +527,83 @@ bool Map::update(float _dt) {
             impl->view.getZoom()
         };
 
-        impl->tileManager.updateTileSets(viewState, impl->view.getVisibleTiles());
+        FrameInfo::beginScope(FrameInfo::Scope::tileUpdate);
+        // Prefetch the endpoint of an active camera ease, or tiles
+        // along the current fling, so motion reveals built tiles
+        if (!impl->eases.active()) {
+            impl->easeTargetTiles.clear();
+            impl->easeTarget = Impl::EaseTarget{};
+        }
+        if (!impl->easeTargetTiles.empty()) {
+            impl->tileManager.setPrefetchTiles(impl->easeTargetTiles);
+        } else {
+            impl->tileManager.setPrefetchTiles(
+                impl->view.getPrefetchTiles(impl->inputHandler.velocityPan(),
+                                            impl->inputHandler.velocityZoom()));
+        }
+        impl->tileManager.updateTileSets(viewState, impl->view.getVisibleTiles(),
+                                         MAX_TILE_UPDATE_MS);
+        FrameInfo::endScope(FrameInfo::Scope::tileUpdate);
 
         auto& tiles = impl->tileManager.getVisibleTiles();
 
+        FrameInfo::beginScope(FrameInfo::Scope::labelUpdate);
+
+        impl->labelCollisionDelay += _dt;
+
         if (impl->view.changedOnLastUpdate() ||
             impl->tileManager.hasTileSetChanged()) {
 
             for (const auto& tile : tiles) {
                 tile->update(_dt, impl->view);
             }
-            impl->labels.updateLabelSet(impl->view, _dt, impl->scene->styles(), tiles,
-                                        impl->tileManager.getTileCache());
 
-        } else {
-            impl->labels.updateLabels(impl->view, _dt, impl->scene->styles(), tiles);
+            if (impl->tileManager.hasTileSetChanged() ||
+                impl->labelCollisionDelay >= LABEL_COLLISION_INTERVAL) {
+
+                impl->labelCollisionDelay = 0.f;
+                impl->labels.updateLabelSet(impl->view, _dt, impl->scene->time(),
+                                            impl->scene->styles(), tiles,
+                                            *impl->tileManager.getTileCache());
+            } else {
+                // Defer the collision pass; transforms still follow
+                // the view every frame
+                impl->labels.updateLabels(impl->view, _dt, impl->scene->time(),
+                                          impl->scene->styles(), tiles);
+            }
+
+        } else if (!impl->frameGovernor.throttleLabels()) {
+            // While degraded, pure fade updates run every other frame;
+            // updates tied to view or tile changes are never skipped
+            impl->labels.updateLabels(impl->view, _dt, impl->scene->time(),
+                                      impl->scene->styles(), tiles);
+        }
+
+        FrameInfo::endScope(FrameInfo::Scope::labelUpdate);
+
+        // Resolve a pending asynchronous pick against the labels just
+        // updated. Running here keeps the scan out of the render pass
+        // and bounds it to once per frame.
+        FeaturePickCallback pickCallback;
+        float pickX = 0.f, pickY = 0.f;
+        {
+            std::lock_guard<std::mutex> lock(impl->pickMutex);
+            if (impl->pendingPick.callback) {
+                pickX = impl->pendingPick.x;
+                pickY = impl->pendingPick.y;
+                pickCallback = std::move(impl->pendingPick.callback);
+                impl->pendingPick.callback = nullptr;
+            }
+        }
+        if (pickCallback) {
+            pickCallback(impl->labels.getFeaturesAtPoint(impl->view, _dt,
+                                                         impl->scene->styles(),
+                                                         tiles, pickX, pickY));
         }
     }
 
     FrameInfo::endUpdate();
+    FrameInfo::endScope(FrameInfo::Scope::update);
 
     bool viewChanged = impl->view.changedOnLastUpdate();
     bool tilesChanged = impl->tileManager.hasTileSetChanged();
@@ -321,20 +617,30 @@ bool Map::update(float _dt) {
     }
 
     // Request for render if labels are in fading in/out states
-    if (impl->labels.needUpdate()) { requestRender(); }
+    if (impl->labels.needUpdate()) { requestRender(RenderDirty::labels); }
 
     return viewComplete;
 }
 
 void Map::render() {
 
+    // This frame covers whatever was pending; dirty levels raised
+    // from here on accumulate for the next frame
+    clearRenderRequest();
+
+    BuildTelemetry::beginFrameGuard();
+
     FrameInfo::beginFrame();
+    FrameInfo::beginScope(FrameInfo::Scope::render);
 
     // Invalidate render states for new frame
     if (!impl->cacheGlState) {
         RenderState::invalidate();
     }
 
+    // Free retired GL resources within a small time budget
+    RenderState::flushResourceDeletions();
+
     // Set up openGL for new frame
     RenderState::depthWrite(GL_TRUE);
     auto& color = impl->scene->background();
@@ -348,23 +654,160 @@ void Map::render() {
     {
         std::lock_guard<std::mutex> lock(impl->tilesMutex);
 
-        // Loop over all styles
+        const auto& tiles = impl->tileManager.getVisibleTiles();
+
+        // Stage the meshes of newly built tiles within a per-frame
+        // byte budget. When a burst of tiles lands at once this turns
+        // the upload spike into a ramp over a few frames; tiles still
+        // pending are skipped below and their proxies keep drawing
+        // (TileManager holds proxies until a tile is GL-ready).
+        FrameInfo::beginScope(FrameInfo::Scope::tileUpload);
+        size_t uploadBudget = MAX_TILE_UPLOAD_BYTES;
+        int uploadsQueued = 0;
+        for (const auto& tile : tiles) {
+            if (tile->isGlReady()) { continue; }
+            if (uploadBudget == 0) {
+                uploadsQueued++;
+                continue;
+            }
+            size_t bytes = tile->upload();
+            uploadBudget -= std::min(bytes, uploadBudget);
+        }
+        if (uploadsQueued > 0) { requestRender(RenderDirty::full); }
+        FrameInfo::endScope(FrameInfo::Scope::tileUpload);
+
+        // Backpressure for the tile pipeline: while more built tiles
+        // wait here than fit the upload budget, the workers hold off
+        // building further ones
+        impl->tileWorker.setUploadBacklog(uploadsQueued);
+
+        // Persistent buffer - keeps its capacity across frames so the
+        // style passes stay free of allocator traffic
+        auto& drawTiles = impl->drawTiles;
+        drawTiles.reserve(tiles.size());
+
+        // Budget for synchronous shader builds in this frame. After a
+        // scene swap every style needs its program compiled and
+        // linked; doing all of them in the first frame blocks it for
+        // hundreds of ms on some mobile drivers. Styles over budget
+        // are skipped and picked up on the following frames.
+        int shaderBuildBudget = 2;
+
+        // Loop over all styles; they are sorted by blend mode at
+        // scene load so the cached blend/depth state rarely changes
+        // between passes.
         for (const auto& style : impl->scene->styles()) {
 
+            // Collect the tiles that carry a mesh for this style. A
+            // style with no tile meshes and an empty dynamic mesh has
+            // nothing to draw, so its program bind, frame uniforms
+            // and render-state setup are skipped entirely.
+            drawTiles.clear();
+            for (const auto& tile : tiles) {
+                if (!tile->isGlReady()) { continue; }
+                if (tile->getMesh(*style)) {
+                    drawTiles.push_back(tile.get());
+                }
+            }
+
+            if (drawTiles.empty() && style->dynamicMeshSize() == 0) {
+                continue;
+            }
+
+            // Draw ready tiles before proxy tiles for opaque styles.
+            // Proxies are pushed back in depth by u_proxy_depth, so
+            // fragments they would shade underneath an already drawn
+            // tile fail the early depth test instead of adding
+            // overdraw; the tile list keeps its zoom order otherwise,
+            // drawing finer proxies over coarser ones. Raster styles
+            // additionally group tiles sampling the same (usually
+            // ancestor) texture, so consecutive draws hit the style's
+            // raster-binding cache.
+            if (style->blendMode() == Blending::none) {
+                bool rasters = style->hasRasters();
+                std::stable_sort(drawTiles.begin(), drawTiles.end(),
+                                 [&](const Tile* a, const Tile* b) {
+                                     if (a->isProxy() != b->isProxy()) { return !a->isProxy(); }
+                                     if (!rasters) { return false; }
+                                     auto* ta = a->rasters().empty() ? nullptr : a->rasters()[0].texture.get();
+                                     auto* tb = b->rasters().empty() ? nullptr : b->rasters()[0].texture.get();
+                                     return ta < tb;
+                                 });
+            }
+
+            if (style->getShaderProgram()->needsBuild()) {
+                if (shaderBuildBudget == 0) {
+                    // Compile on one of the next frames
+                    requestRender(RenderDirty::full);
+                    continue;
+                }
+                shaderBuildBudget--;
+            }
+
+            FrameInfo::beginStylePass(style->getName());
+
             style->onBeginDrawFrame(impl->view, *(impl->scene));
 
-            // Loop over all tiles in m_tileSet
-            for (const auto& tile : impl->tileManager.getVisibleTiles()) {
+            if (style->hasDepthPrepass() && !drawTiles.empty()) {
+                // Lay down depth only, then shade against it with
+                // GL_LEQUAL - each pixel runs the fragment shader once
+                // however deep the geometry stacks up (think extruded
+                // building walls drawn back to front within a tile).
+                RenderState::colorWrite(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                for (const auto* tile : drawTiles) {
+                    style->draw(*tile);
+                }
+                RenderState::colorWrite(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                RenderState::depthFunc(GL_LEQUAL);
+            }
+
+            for (const auto* tile : drawTiles) {
                 style->draw(*tile);
             }
 
+            if (style->hasDepthPrepass()) {
+                RenderState::depthFunc(GL_LESS);
+            }
+
             style->onEndDrawFrame();
+
+            FrameInfo::endStylePass();
         }
+
+        // Don't keep stale tile pointers beyond the locked scope
+        drawTiles.clear();
     }
 
+    impl->markers.draw(impl->view, impl->view.pixelScale());
+
     impl->labels.drawDebug(impl->view);
 
+    FrameInfo::endScope(FrameInfo::Scope::render);
+
     FrameInfo::draw(impl->view, impl->tileManager);
+
+    // The depth contents are never needed once the frame ends; the
+    // hint lets tiling GPUs drop the depth store instead of resolving
+    // it to memory. Offscreen passes render into their own target and
+    // are read back right after, so they skip the hint.
+    if (Hardware::supportsDiscardFramebuffer && !impl->offscreenPass) {
+        const GLenum discards[] = { GL_DEPTH };
+        GL_CHECK(glDiscardFramebufferEXT(GL_FRAMEBUFFER, 1, discards));
+    }
+
+    BuildTelemetry::endFrameGuard();
+}
+
+bool Map::isAnimating() {
+    return impl->eases.active() || impl->labels.needUpdate();
+}
+
+FrameStats Map::getFrameStats() {
+    return FrameInfo::stats();
+}
+
+TileLatencyStats Map::getTileLatencyStats() {
+    return TileLatency::stats();
 }
 
 int Map::getViewportHeight() {
@@ -383,12 +826,34 @@ void Map::captureSnapshot(unsigned int* _data) {
     GL_CHECK(glReadPixels(0, 0, impl->view.getWidth(), impl->view.getHeight(), GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)_data));
 }
 
+bool Map::renderOffscreen(unsigned int* _data) {
+
+    auto& target = impl->offscreenTarget;
+
+    if (!target || target->getWidth() != impl->view.getWidth() ||
+        target->getHeight() != impl->view.getHeight()) {
+        target = std::make_unique<FrameBuffer>(impl->view.getWidth(),
+                                               impl->view.getHeight());
+    }
+
+    if (!target->bind()) { return false; }
+
+    impl->offscreenPass = true;
+    render();
+    impl->offscreenPass = false;
+
+    target->readPixels(_data);
+    target->unbind();
+
+    return true;
+}
+
 void Map::Impl::setPositionNow(double _lon, double _lat) {
 
     glm::dvec2 meters = view.getMapProjection().LonLatToMeters({ _lon, _lat});
     view.setPosition(meters.x, meters.y);
     inputHandler.cancelFling();
-    requestRender();
+    requestRender(RenderDirty::full);
 
 }
 
@@ -406,6 +871,11 @@ void Map::setPositionEased(double _lon, double _lat, float _duration, EaseType _
     auto cb = [=](float t) { impl->setPositionNow(ease(lon_start, _lon, t, _e), ease(lat_start, _lat, t, _e)); };
     impl->setEase(EaseField::position, { _duration, cb });
 
+    impl->easeTarget.hasPosition = true;
+    impl->easeTarget.lon = _lon;
+    impl->easeTarget.lat = _lat;
+    impl->primeEaseTargetTiles();
+
 }
 
 void Map::getPosition(double& _lon, double& _lat) {
@@ -421,7 +891,7 @@ void Map::Impl::setZoomNow(float _z) {
 
     view.setZoom(_z);
     inputHandler.cancelFling();
-    requestRender();
+    requestRender(RenderDirty::full);
 
 }
 
@@ -438,6 +908,10 @@ void Map::setZoomEased(float _z, float _duration, EaseType _e) {
     auto cb = [=](float t) { impl->setZoomNow(ease(z_start, _z, t, _e)); };
     impl->setEase(EaseField::zoom, { _duration, cb });
 
+    impl->easeTarget.hasZoom = true;
+    impl->easeTarget.zoom = _z;
+    impl->primeEaseTargetTiles();
+
 }
 
 float Map::getZoom() {
@@ -449,7 +923,7 @@ float Map::getZoom() {
 void Map::Impl::setRotationNow(float _radians) {
 
     view.setRoll(_radians);
-    requestRender();
+    requestRender(RenderDirty::full);
 
 }
 
@@ -472,6 +946,10 @@ void Map::setRotationEased(float _radians, float _duration, EaseType _e) {
     auto cb = [=](float t) { impl->setRotationNow(ease(radians_start, _radians, t, _e)); };
     impl->setEase(EaseField::rotation, { _duration, cb });
 
+    impl->easeTarget.hasRotation = true;
+    impl->easeTarget.rotation = _radians;
+    impl->primeEaseTargetTiles();
+
 }
 
 float Map::getRotation() {
@@ -484,7 +962,7 @@ float Map::getRotation() {
 void Map::Impl::setTiltNow(float _radians) {
 
     view.setPitch(_radians);
-    requestRender();
+    requestRender(RenderDirty::full);
 
 }
 
@@ -501,6 +979,10 @@ void Map::setTiltEased(float _radians, float _duration, EaseType _e) {
     auto cb = [=](float t) { impl->setTiltNow(ease(tilt_start, _radians, t, _e)); };
     impl->setEase(EaseField::tilt, { _duration, cb });
 
+    impl->easeTarget.hasTilt = true;
+    impl->easeTarget.tilt = _radians;
+    impl->primeEaseTargetTiles();
+
 }
 
 float Map::getTilt() {
@@ -536,12 +1018,168 @@ bool Map::lngLatToScreenPosition(double _lng, double _lat, double* _x, double* _
     return !clipped && withinViewport;
 }
 
+MarkerID Map::markerAdd(double _lng, double _lat, float _size, unsigned int _color) {
+    return impl->markers.add(_lng, _lat, _size, _color);
+}
+
+MarkerID Map::markerAddPolyline(const double* _coordinates, size_t _count, float _width,
+                                unsigned int _color) {
+    return impl->markers.addPolyline(_coordinates, _count, _width, _color);
+}
+
+bool Map::markerSetPolylinePoints(MarkerID _id, const double* _coordinates, size_t _count) {
+    return impl->markers.setPolylinePoints(_id, _coordinates, _count);
+}
+
+bool Map::markerSetPosition(MarkerID _id, double _lng, double _lat) {
+    return impl->markers.setPosition(_id, _lng, _lat);
+}
+
+size_t Map::markerSetPositions(const MarkerID* _ids, const double* _coordinates, size_t _count) {
+    return impl->markers.setPositions(_ids, _coordinates, _count);
+}
+
+bool Map::markerRemove(MarkerID _id) {
+    return impl->markers.remove(_id);
+}
+
+void Map::markerRemoveAll() {
+    impl->markers.removeAll();
+}
+
 void Map::setPixelScale(float _pixelsPerPoint) {
 
     impl->setPixelScale(_pixelsPerPoint);
 
 }
 
+void Map::setTargetFrameRate(float _fps) {
+
+    impl->frameGovernor.setTargetFrameTime(_fps > 0.f ? 1.f / _fps : 0.f);
+
+}
+
+void Map::setMaxTileWorkers(int _count) {
+
+    impl->tileWorker.setMaxActiveWorkers(_count);
+
+}
+
+void Map::onMemoryPressure(MemoryPressure _level) {
+
+    if (_level == MemoryPressure::none) { return; }
+
+    auto& tileCache = impl->tileManager.getTileCache();
+
+    if (_level == MemoryPressure::moderate) {
+        impl->tileManager.releaseCachedMemory(tileCache->getMemoryUsage() / 2, false);
+    } else {
+        impl->tileManager.releaseCachedMemory(0, true);
+        impl->scene->fontContext()->shedIdlePages();
+    }
+
+    LOG("Memory pressure %d, usage now %s", static_cast<int>(_level),
+        MemoryBudget::toString().c_str());
+
+}
+
+// Plain-text session snapshot, versioned so stale files from older
+// builds are rejected instead of misparsed
+#define SESSION_SNAPSHOT_TAG "tangram-session"
+#define SESSION_SNAPSHOT_VERSION 1
+
+bool Map::saveSessionSnapshot(const char* _path) {
+
+    FILE* file = fopen(_path, "w");
+    if (!file) {
+        LOGW("Could not write session snapshot '%s'", _path);
+        return false;
+    }
+
+    double lon, lat;
+    getPosition(lon, lat);
+
+    fprintf(file, "%s %d\n", SESSION_SNAPSHOT_TAG, SESSION_SNAPSHOT_VERSION);
+    fprintf(file, "camera %.8f %.8f %f %f %f\n",
+            lon, lat, getZoom(), getRotation(), getTilt());
+
+    for (const auto& id : impl->view.getVisibleTiles()) {
+        fprintf(file, "tile %d %d %d\n", id.z, id.x, id.y);
+    }
+
+    return fclose(file) == 0;
+}
+
+bool Map::loadSessionSnapshot(const char* _path) {
+
+    FILE* file = fopen(_path, "r");
+    if (!file) { return false; }
+
+    char tag[24];
+    int version = 0;
+    if (fscanf(file, "%23s %d", tag, &version) != 2 ||
+        strcmp(tag, SESSION_SNAPSHOT_TAG) != 0 ||
+        version != SESSION_SNAPSHOT_VERSION) {
+        LOGW("Ignoring unreadable session snapshot '%s'", _path);
+        fclose(file);
+        return false;
+    }
+
+    double lon, lat;
+    float zoom, rotation, tilt;
+    if (fscanf(file, "%23s %lf %lf %f %f %f",
+               tag, &lon, &lat, &zoom, &rotation, &tilt) != 6 ||
+        strcmp(tag, "camera") != 0) {
+        LOGW("Ignoring unreadable session snapshot '%s'", _path);
+        fclose(file);
+        return false;
+    }
+
+    setPosition(lon, lat);
+    setZoom(zoom);
+    setRotation(rotation);
+    setTilt(tilt);
+
+    std::set<TileID> tiles;
+    int x, y, z;
+    while (fscanf(file, "%23s %d %d %d", tag, &z, &x, &y) == 4 &&
+           strcmp(tag, "tile") == 0) {
+        // A stale or hand-edited snapshot must not issue requests for
+        // nonsense tiles: z has to be a usable zoom and x/y valid
+        // tile indices at that zoom.
+        if (z < 0 || z > int(View::s_maxZoom) ||
+            x < 0 || x >= (1 << z) ||
+            y < 0 || y >= (1 << z)) {
+            LOGW("Skipping out-of-range tile %d/%d/%d in session snapshot", z, x, y);
+            continue;
+        }
+        tiles.insert(TileID(x, y, z));
+    }
+    fclose(file);
+
+    // Seed the saved visible set as prefetch tiles, so their loads
+    // start with the first update instead of after the view settles
+    if (!tiles.empty()) {
+        impl->tileManager.setPrefetchTiles(std::move(tiles));
+    }
+
+    requestRender(RenderDirty::full);
+
+    return true;
+}
+
+MemoryUsage Map::getMemoryUsage() {
+
+    MemoryUsage usage;
+    usage.rawTiles = MemoryBudget::getUsage(MemoryBudget::rawTiles);
+    usage.tileMeshes = MemoryBudget::getUsage(MemoryBudget::meshes);
+    usage.textures = MemoryBudget::getUsage(MemoryBudget::textures);
+    usage.decodedPixels = MemoryBudget::getUsage(MemoryBudget::decodedPixels);
+    usage.total = MemoryBudget::getTotalUsage();
+    return usage;
+
+}
+
 void Map::Impl::setPixelScale(float _pixelsPerPoint) {
 
     view.setPixelScale(_pixelsPerPoint);
@@ -555,7 +1193,7 @@ void Map::Impl::setPixelScale(float _pixelsPerPoint) {
 void Map::setCameraType(int _type) {
 
     impl->view.setCameraType(static_cast<CameraType>(_type));
-    requestRender();
+    requestRender(RenderDirty::full);
 
 }
 
@@ -581,7 +1219,7 @@ void Map::clearDataSource(DataSource& _source, bool _data, bool _tiles) {
     if (_tiles) { impl->tileManager.clearTileSet(_source.id()); }
     if (_data) { _source.clearData(); }
 
-    requestRender();
+    requestRender(RenderDirty::full);
 }
 
 void Map::handleTapGesture(float _posX, float _posY) {
@@ -658,6 +1296,24 @@ const std::vector<TouchItem>& Map::pickFeaturesAt(float _x, float _y) {
                                            _x, _y);
 }
 
+void Map::pickFeaturesAt(float _x, float _y, FeaturePickCallback _onResult) {
+
+    if (!_onResult) { return; }
+
+    FeaturePickCallback superseded;
+    {
+        std::lock_guard<std::mutex> lock(impl->pickMutex);
+        superseded = std::move(impl->pendingPick.callback);
+        impl->pendingPick = { _x, _y, std::move(_onResult) };
+    }
+
+    // A query replaced before resolving still gets an answer
+    if (superseded) { superseded({}); }
+
+    // Make sure an update runs to resolve the query
+    requestRender(RenderDirty::full);
+}
+
 void Map::runAsyncTask(std::function<void()> _task) {
     impl->asyncWorker.enqueue(std::move(_task));
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "data/properties.h"
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Tangram {
@@ -21,6 +23,8 @@ struct SceneUpdate {
     std::string value;
 };
 
+typedef unsigned int MarkerID;
+
 enum class EaseType : char {
     linear = 0,
     cubic,
@@ -28,6 +32,56 @@ enum class EaseType : char {
     sine,
 };
 
+// CPU timings of the last completed frame in milliseconds, polled
+// via Map::getFrameStats(). GPU timings would need the disjoint
+// timer query extension entry points, which the GL bindings do not
+// expose; the per-pass CPU scopes cover submission cost.
+struct FrameStats {
+    float update = 0.f;      // Total time in Map::update
+    float tileUpdate = 0.f;  // TileManager::updateTileSets
+    float labelUpdate = 0.f; // Labels::update
+    float tileUpload = 0.f;  // Mesh staging within the upload budget
+    float render = 0.f;      // Total time in Map::render
+    // Draw time per style pass, in draw order
+    std::vector<std::pair<std::string, float>> stylePasses;
+};
+
+// Severity of a memory warning forwarded by the embedder, see
+// Map::onMemoryPressure()
+enum class MemoryPressure : char {
+    none = 0,  // Pressure has passed; no immediate action
+    moderate,  // The OS asks for memory back
+    critical,  // The process is about to be killed
+};
+
+// Bytes held per pipeline component, polled via Map::getMemoryUsage().
+// Mirrors the categories of the central MemoryBudget accounting.
+struct MemoryUsage {
+    size_t rawTiles = 0;      // raw downloads cached across all DataSources
+    size_t tileMeshes = 0;    // built tile meshes held by the tile cache
+    size_t textures = 0;      // pixel data held by Textures, incl. glyph atlases
+    size_t decodedPixels = 0; // decoded raster pixels cached by RasterSources
+    size_t total = 0;
+};
+
+// Per-stage tile latency percentiles in milliseconds, aggregated over
+// every tile drawn since launch and polled via getTileLatencyStats().
+// Answers where the time between requesting a tile and first drawing
+// it went: fetching the bytes, building meshes on a worker, or
+// staging the meshes on the GL thread.
+struct TileLatencyStats {
+    struct Stage {
+        float p50 = 0.f;
+        float p90 = 0.f;
+        float p99 = 0.f;
+    };
+    Stage fetch;  // load issued until raw bytes available
+    Stage build;  // bytes available until the worker build finished
+    Stage upload; // build finished until meshes staged for drawing
+    Stage total;  // load issued until meshes staged
+    uint32_t samples = 0;
+};
+
 class Map {
 
 public:
@@ -42,6 +96,14 @@ public:
     // Load the scene at the given absolute file path synchronously
     void loadScene(const char* _scenePath, bool _useScenePosition = false);
 
+    // Share the loaded scene, tile cache and glyph atlases of another map
+    // instance, instead of loading a scene into this one. Intended for
+    // auxiliary views like an overview inset that render the same style in
+    // the same GL context as the main map; both views draw from one pool of
+    // built tiles and one set of font atlases. Call after the other map has
+    // loaded its scene, and again whenever it loads a new one.
+    void shareResourcesFrom(Map& _other);
+
     // Request an update to the scene configuration; the path is a series of yaml keys
     // separated by a '.' and the value is a string of yaml to replace the current value
     // at the given path in the scene
@@ -50,6 +112,17 @@ public:
     // Apply all previously requested scene updates
     void applySceneUpdates();
 
+    // Scene-update transaction: between begin and the matching commit,
+    // applySceneUpdates calls are deferred, so updates queued from
+    // several places build the scene in a single pass at the outermost
+    // commit. Transactions nest.
+    void beginSceneUpdates();
+    void commitSceneUpdates();
+
+    // Whether queued scene updates have not been applied yet or an
+    // asynchronous scene rebuild is still in progress
+    bool isSceneUpdatePending();
+
     // Initialize graphics resources; OpenGL context must be created prior to calling this
     void setupGL();
 
@@ -64,6 +137,19 @@ public:
     // Render a new frame of the map view (if needed)
     void render();
 
+    // Returns true while any camera ease or label transition is running;
+    // embedders can stop invalidating frames when this is false and no
+    // render was requested
+    bool isAnimating();
+
+    // Gets the per-stage timings of the last completed frame; call from
+    // the thread running update() and render()
+    FrameStats getFrameStats();
+
+    // Gets per-stage tile latency percentiles aggregated since launch;
+    // may be called from any thread
+    TileLatencyStats getTileLatencyStats();
+
     // Gets the viewport height in physical pixels (framebuffer size)
     int getViewportHeight();
 
@@ -76,6 +162,42 @@ public:
     // Gets the pixel scale
     float getPixelScale();
 
+    // Set a target frame rate; when recent frames consistently miss it
+    // the engine adaptively degrades (throttled label fades, reduced
+    // tile zoom) until the budget is met again. A value of 0 or less
+    // disables the governor (default)
+    void setTargetFrameRate(float _fps);
+
+    // Cap the number of tile-builder threads allowed to run
+    // concurrently. The pool is sized from the hardware at startup
+    // and scales with load within this cap; pass 1 while the device
+    // is on battery saver or idle, 0 to restore the hardware size
+    void setMaxTileWorkers(int _count);
+
+    // Forward an OS memory warning; call from the thread running
+    // update(). 'moderate' halves the cached tile meshes and drops
+    // decoded raster pixels; 'critical' additionally empties the tile
+    // and raw download caches and releases unreferenced glyph atlas
+    // pages. Configured cache limits are unchanged, so the caches
+    // refill once the pressure passes
+    void onMemoryPressure(MemoryPressure _level);
+
+    // Gets the bytes currently held per pipeline component
+    MemoryUsage getMemoryUsage();
+
+    // Write a small warm-start snapshot - camera state and the visible
+    // tile set - to the file at _path; call when the app is paused.
+    // Returns false when the file could not be written
+    bool saveSessionSnapshot(const char* _path);
+
+    // Restore a snapshot written by saveSessionSnapshot(): the camera
+    // returns to the saved pose and the saved tiles are requested in
+    // one pass - served from the disk cache when one is configured -
+    // instead of waiting for the view to discover them. Call after the
+    // scene load has been started. Returns false when the file is
+    // missing or malformed
+    bool loadSessionSnapshot(const char* _path);
+
     // Capture a snapshot of the current frame and store it in the allocated _data
     // _data is expected to be of size getViewportHeight() * getViewportWidth()
     // Pixel data is stored starting from the lower left corner of the viewport
@@ -83,6 +205,16 @@ public:
     // Each unsigned int corresponds to an RGBA pixel value
     void captureSnapshot(unsigned int* _data);
 
+    // Render the current view into an offscreen framebuffer and read the
+    // result back into _data as 32-bit RGBA pixels; _data must hold
+    // viewport width * height entries. The previously bound render target
+    // is restored afterwards. Together with update() this allows headless
+    // imagery generation without a window-owned framebuffer: position the
+    // view on a tile, resize() to the tile resolution, call update() until
+    // it returns true and then renderOffscreen(). Returns false when the
+    // offscreen target could not be created
+    bool renderOffscreen(unsigned int* _data);
+
     // Set the position of the map view in degrees longitude and latitude; if duration
     // (in seconds) is provided, position eases to the set value over the duration;
     // calling either version of the setter overrides all previous calls
@@ -148,6 +280,40 @@ public:
 
     void clearDataSource(DataSource& _source, bool _data, bool _tiles);
 
+    // Add a dynamic point marker at the given longitude and latitude, drawn
+    // as a screen-aligned quad of _size logical pixels with the given ABGR
+    // color; returns its id. Markers are drawn above tile geometry and move
+    // without rebuilding any tiles.
+    MarkerID markerAdd(double _lng, double _lat, float _size, unsigned int _color);
+
+    // Add a dynamic polyline annotation from _count interleaved longitude,
+    // latitude pairs, drawn _width logical pixels wide with the given ABGR
+    // color. The line bypasses the tile pipeline: it is tessellated once
+    // into a persistent mesh and only uniforms change with the view.
+    // Shares the id space with point markers; returns 0 when fewer than
+    // two points are given.
+    MarkerID markerAddPolyline(const double* _coordinates, size_t _count, float _width,
+                               unsigned int _color);
+
+    // Replace the points of a polyline annotation; returns false if the id
+    // does not name a live polyline or fewer than two points are given
+    bool markerSetPolylinePoints(MarkerID _id, const double* _coordinates, size_t _count);
+
+    // Move a marker to the given longitude and latitude; returns false if
+    // the id does not name a live marker
+    bool markerSetPosition(MarkerID _id, double _lng, double _lat);
+
+    // Move _count markers in one call; _coordinates holds interleaved
+    // longitude, latitude pairs matching _ids. Returns the number of
+    // markers moved.
+    size_t markerSetPositions(const MarkerID* _ids, const double* _coordinates, size_t _count);
+
+    // Remove a marker; returns false if the id does not name a live marker
+    bool markerRemove(MarkerID _id);
+
+    // Remove all markers
+    void markerRemoveAll();
+
     // Respond to a tap at the given screen coordinates (x right, y down)
     void handleTapGesture(float _posX, float _posY);
 
@@ -174,8 +340,22 @@ public:
     // efficiency, but can cause errors if your application code makes OpenGL calls (false by default)
     void useCachedGlState(bool _use);
 
+    // Synchronous picking; scans the interactive labels of all visible
+    // tiles before returning. Prefer the asynchronous overload from
+    // pointer-move handlers.
     const std::vector<TouchItem>& pickFeaturesAt(float _x, float _y);
 
+    // Receives the picked items sorted by distance; empty when nothing
+    // was hit or the query was superseded by a newer one
+    using FeaturePickCallback = std::function<void(const std::vector<TouchItem>&)>;
+
+    // Asynchronous picking: the query is queued and resolved during the
+    // next update(), after label transforms have been refreshed, keeping
+    // the render pass free of pick work. At most one query is pending -
+    // a newer query supersedes an unresolved older one - so a stream of
+    // pointer moves costs one scan per frame however fast it arrives.
+    void pickFeaturesAt(float _x, float _y, FeaturePickCallback _onResult);
+
     // Run this task asynchronously to Tangram's main update loop.
     void runAsyncTask(std::function<void()> _task);
 
@@ -195,6 +375,7 @@ enum DebugFlags {
     tangram_infos,      // Various text tangram debug info printed on the screen
     all_labels,         // Draw all labels
     tangram_stats,      // Tangram frame graph stats
+    tracing,            // Record scopes into the trace ring, see debug/trace.h
 };
 
 // Set debug features on or off using a boolean (see debug.h)
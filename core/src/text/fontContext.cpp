@@ -1,12 +1,20 @@
 #include "fontContext.h"
 
 #include "platform.h"
+#include "debug/buildTelemetry.h"
+#include "gl/hardware.h"
+#include "text/glyphSdfPass.h"
 
 #define SDF_IMPLEMENTATION
 #include "sdf.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <memory>
 
+#include <sys/stat.h>
+
 #define DEFAULT "fonts/NotoSans-Regular.ttf"
 #define FONT_AR "fonts/NotoNaskh-Regular.ttf"
 #define FONT_HE "fonts/NotoSansHebrew-Regular.ttf"
@@ -23,6 +31,10 @@
 
 #define MIN_LINE_WIDTH 4
 
+// Upper bound on cached shaped-text layouts; entries are a handful of
+// quads each, so this stays within a few hundred kB.
+#define SHAPED_CACHE_MAX_ENTRIES 2048
+
 namespace Tangram {
 
 FontContext::FontContext() :
@@ -62,25 +74,21 @@ FontContext::FontContext() :
     }
 #elif defined(PLATFORM_IOS)
 
+    // Hand alfons bundle-resolved paths instead of the file contents:
+    // faces are opened lazily on first use, so scene load only touches
+    // the font headers and fallbacks that never shape a glyph stay off
+    // the heap entirely.
     int size = BASE_SIZE;
     auto loadFonts = [&](const char* path) {
-        size_t dataSize;
-        char* data = reinterpret_cast<char*>(bytesFromFile(path, dataSize));
-        if (data) {
-            for (int i = 0; i < 3; i++, size += STEP_SIZE) {
-                m_font[i] = m_alfons.addFont("default", alfons::InputSource(data, dataSize), size);
-            }
-            free(data);
+        std::string resolved = resolveAssetPath(path);
+        for (int i = 0; i < 3; i++, size += STEP_SIZE) {
+            m_font[i] = m_alfons.addFont("default", alfons::InputSource(resolved), size);
         }
     };
     auto addFaces = [&](const char* path) {
-        size_t dataSize;
-        char* data = reinterpret_cast<char*>(bytesFromFile(path, dataSize));
-        if (data) {
-            for (int i = 0; i < 3; i++, size += STEP_SIZE) {
-                    m_font[i]->addFace(m_alfons.addFontFace(alfons::InputSource(data, dataSize), size));
-            }
-            free(data);
+        std::string resolved = resolveAssetPath(path);
+        for (int i = 0; i < 3; i++, size += STEP_SIZE) {
+            m_font[i]->addFace(m_alfons.addFontFace(alfons::InputSource(resolved), size));
         }
     };
 
@@ -111,6 +119,23 @@ void FontContext::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height
     m_textures.emplace_back();
 }
 
+// FNV-1a over the glyph bitmap and its layout parameters
+static uint64_t glyphHash(const unsigned char* _src, uint16_t _gw, uint16_t _gh, uint16_t _pad) {
+    uint64_t hash = 0xcbf29ce484222325;
+    auto mix = [&](const unsigned char* _data, size_t _size) {
+        for (size_t i = 0; i < _size; i++) {
+            hash = (hash ^ _data[i]) * 0x100000001b3;
+        }
+    };
+    uint16_t dims[3] = { _gw, _gh, _pad };
+    mix(reinterpret_cast<const unsigned char*>(dims), sizeof(dims));
+    mix(_src, size_t(_gw) * _gh);
+    return hash;
+}
+
+// Out of line for the unique_ptr to the forward-declared GlyphSdfPass
+FontContext::~FontContext() {}
+
 // Synchronized on m_mutex in layoutText(), called on tile-worker threads
 void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
                            const unsigned char* src, uint16_t pad) {
@@ -119,10 +144,28 @@ void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_
 
     auto& texData = m_textures[id].texData;
     auto& texture = m_textures[id].texture;
-    m_textures[id].dirty = true;
+
+    // The page buffer may have been reclaimed while the page was idle
+    if (texData.empty()) {
+        texData.resize(GlyphTexture::size * GlyphTexture::size);
+    }
 
     uint16_t stride = GlyphTexture::size;
-    uint16_t width =  GlyphTexture::size;
+
+    uint16_t padWidth = gw + pad * 2;
+    uint16_t padHeight = gh + pad * 2;
+    unsigned char* region = &texData[gx + gy * stride];
+
+    // The distance field only depends on the glyph bitmap, so baked
+    // output can be replayed for identical glyphs - within this run
+    // or, with a cache path set, across app starts.
+    uint64_t key = glyphHash(src, gw, gh, pad);
+
+    if (loadCachedGlyph(key, region, stride, padWidth, padHeight)) {
+        m_textures[id].dirty = true;
+        texture.setDirty(gy, padHeight);
+        return;
+    }
 
     unsigned char* dst = &texData[(gx + pad) + (gy + pad) * stride];
 
@@ -130,20 +173,271 @@ void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_
         std::memcpy(dst + y * stride, src + pos, gw);
     }
 
-    dst = &texData[gx + gy * width];
-    gw += pad * 2;
-    gh += pad * 2;
+    // On capable contexts the distance transform runs as a
+    // render-to-texture pass on the GL thread (see GlyphSdfPass) and
+    // the worker only rasterizes coverage
+    if (Hardware::supportsGlyphGpuSdf && !m_sdfPassFailed) {
+        m_gpuPendingGlyphs.push_back({ id, gx, gy, gw, gh, pad, key, region });
+        return;
+    }
+
+    // Defer the expensive SDF transform: the worker that triggered
+    // this layout bakes it after m_mutex is released, so other
+    // workers aren't serialized behind the font lock meanwhile.
+    m_pendingGlyphs.push_back({ id, gx, gy, gw, gh, pad, key, region });
+}
+
+void FontContext::bakeGlyphs(std::vector<PendingGlyph>& _pending) {
+
+    if (_pending.empty()) { return; }
+
+    uint16_t stride = GlyphTexture::size;
+    uint16_t width =  GlyphTexture::size;
+
+    std::vector<unsigned char> sdfBuffer;
+
+    for (auto& glyph : _pending) {
+
+        uint16_t padWidth = glyph.gw + glyph.pad * 2;
+        uint16_t padHeight = glyph.gh + glyph.pad * 2;
+
+        // The atlas page is pinned by this layout's refs and pending
+        // glyph regions never overlap, so writing through the region
+        // pointer captured under m_mutex is safe. m_textures itself
+        // must not be indexed here: another worker may be growing it.
+        unsigned char* region = glyph.region;
+
+        size_t bytes = padWidth * padHeight * sizeof(float) * 3;
+        if (sdfBuffer.size() < bytes) {
+            sdfBuffer.resize(bytes);
+        }
+
+        sdfBuildDistanceFieldNoAlloc(region, width, m_sdfRadius,
+                                     region, padWidth, padHeight, width,
+                                     &sdfBuffer[0]);
+
+        storeCachedGlyph(glyph.key, region, stride, padWidth, padHeight);
+    }
+
+    // Only mark textures dirty once their content is complete, so
+    // updateTextures never uploads a half-baked glyph.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& glyph : _pending) {
+        m_textures[glyph.id].dirty = true;
+        m_textures[glyph.id].texture.setDirty(glyph.gy, glyph.gh + glyph.pad * 2);
+    }
+}
+
+// Upper bound on in-memory cached glyph blocks; typical entries are
+// around 1kB, so this keeps the cache within a few MB.
+#define GLYPH_CACHE_MAX_ENTRIES 4096
+
+bool FontContext::loadCachedGlyph(uint64_t _key, unsigned char* _dst, uint16_t _stride,
+                                  uint16_t _width, uint16_t _height) {
+
+    size_t bytes = size_t(_width) * _height;
+
+    std::lock_guard<std::mutex> lock(m_glyphCacheMutex);
+
+    auto it = m_glyphCache.find(_key);
+
+    if (it == m_glyphCache.end() && !m_glyphCachePath.empty()) {
+        // Try the on-disk cache and promote the entry to memory
+        auto path = m_glyphCachePath + "/" + std::to_string(_key) + ".sdf";
+
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file) {
+            std::vector<unsigned char> block(bytes);
+            size_t read = fread(block.data(), 1, bytes, file);
+            fclose(file);
+
+            if (read == bytes) {
+                it = m_glyphCache.emplace(_key, std::move(block)).first;
+            }
+        }
+    }
+
+    if (it == m_glyphCache.end() || it->second.size() != bytes) {
+        return false;
+    }
+
+    const unsigned char* block = it->second.data();
+    for (size_t y = 0; y < _height; y++) {
+        std::memcpy(_dst + y * _stride, block + y * _width, _width);
+    }
+    return true;
+}
+
+void FontContext::storeCachedGlyph(uint64_t _key, const unsigned char* _src, uint16_t _stride,
+                                   uint16_t _width, uint16_t _height) {
+
+    std::vector<unsigned char> block(size_t(_width) * _height);
+    for (size_t y = 0; y < _height; y++) {
+        std::memcpy(block.data() + y * _width, _src + y * _stride, _width);
+    }
+
+    std::lock_guard<std::mutex> lock(m_glyphCacheMutex);
+
+    if (!m_glyphCachePath.empty()) {
+        auto path = m_glyphCachePath + "/" + std::to_string(_key) + ".sdf";
+
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file) {
+            fwrite(block.data(), 1, block.size(), file);
+            fclose(file);
+        }
+    }
+
+    if (m_glyphCache.size() < GLYPH_CACHE_MAX_ENTRIES) {
+        m_glyphCache.emplace(_key, std::move(block));
+    }
+}
+
+void FontContext::setGlyphCachePath(const std::string& _path) {
+    {
+        std::lock_guard<std::mutex> lock(m_glyphCacheMutex);
+        m_glyphCachePath = _path;
+        mkdir(_path.c_str(), S_IRWXU);
+    }
+    prewarmRecordedGlyphs();
+}
+
+#define GLYPH_USAGE_FILE "/glyph_usage"
+
+// Flush threshold: new codepoints arrive in bursts when entering an
+// unseen region and then tail off, so a small batch keeps the record
+// current without rewriting the file for every label.
+#define GLYPH_USAGE_FLUSH 32
+
+void FontContext::saveGlyphUsage() {
+
+    auto path = m_glyphCachePath + GLYPH_USAGE_FILE;
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) { return; }
+
+    for (uint32_t codepoint : m_usedCodepoints) {
+        fprintf(file, "%u\n", codepoint);
+    }
+    fclose(file);
+
+    m_unsavedCodepoints = 0;
+}
+
+void FontContext::recordGlyphUsage(const std::string& _text) {
+    std::lock_guard<std::mutex> lock(m_glyphCacheMutex);
+
+    if (m_glyphCachePath.empty()) { return; }
+
+    for (size_t i = 0; i < _text.size();) {
+        unsigned char c = _text[i];
+        uint32_t codepoint = c;
+        size_t len = 1;
+
+        if ((c >> 5) == 0x6) { len = 2; codepoint = c & 0x1f; }
+        else if ((c >> 4) == 0xe) { len = 3; codepoint = c & 0x0f; }
+        else if ((c >> 3) == 0x1e) { len = 4; codepoint = c & 0x07; }
+        else if (c >= 0x80) { i++; continue; }
+
+        if (i + len > _text.size()) { break; }
+        for (size_t k = 1; k < len; k++) {
+            codepoint = (codepoint << 6) | (_text[i + k] & 0x3f);
+        }
+        i += len;
+
+        if (m_usedCodepoints.insert(codepoint).second) {
+            m_unsavedCodepoints++;
+        }
+    }
+
+    if (m_unsavedCodepoints >= GLYPH_USAGE_FLUSH) {
+        saveGlyphUsage();
+    }
+}
+
+void FontContext::prewarmRecordedGlyphs() {
+
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    {
+        std::lock_guard<std::mutex> lock(m_glyphCacheMutex);
+        if (m_glyphCachePath.empty()) { return; }
 
-    size_t bytes = gw * gh * sizeof(float) * 3;
-    if (m_sdfBuffer.size() < bytes) {
-        m_sdfBuffer.resize(bytes);
+        auto path = m_glyphCachePath + GLYPH_USAGE_FILE;
+        FILE* file = fopen(path.c_str(), "r");
+        if (!file) { return; }
+
+        uint32_t codepoint;
+        while (fscanf(file, "%u", &codepoint) == 1) {
+            m_usedCodepoints.insert(codepoint);
+        }
+        fclose(file);
+
+        // Coalesce the set into consecutive ranges for the prewarm
+        std::vector<uint32_t> sorted(m_usedCodepoints.begin(),
+                                     m_usedCodepoints.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        for (uint32_t codepoint : sorted) {
+            if (!ranges.empty() && ranges.back().second + 1 == codepoint) {
+                ranges.back().second = codepoint;
+            } else {
+                ranges.push_back({codepoint, codepoint});
+            }
+        }
+    }
+
+    if (!ranges.empty()) {
+        LOG("Prewarming %d recorded glyph ranges", int(ranges.size()));
+        prewarmGlyphRanges(ranges);
     }
+}
 
-    sdfBuildDistanceFieldNoAlloc(dst, width, m_sdfRadius,
-                                 dst, gw, gh, width,
-                                 &m_sdfBuffer[0]);
+void FontContext::prewarmGlyphRanges(const std::vector<std::pair<uint32_t, uint32_t>>& _ranges) {
+
+    // Lay out batches of codepoints with the default fonts; this
+    // bakes their glyphs through the regular addGlyph path. The refs
+    // are deliberately not released, pinning the baked atlas pages.
+    TextStyle::Parameters params;
+    params.wordWrap = false;
+
+    std::vector<GlyphQuad> quads;
+    std::bitset<max_textures> refs;
+    glm::vec2 bbox;
+    std::string text;
+
+    auto flush = [&]() {
+        if (text.empty()) { return; }
+        for (auto& font : m_font) {
+            if (!font) { continue; }
+            params.font = font;
+            layoutText(params, text, quads, refs, bbox);
+            quads.clear();
+        }
+        text.clear();
+    };
 
-    texture.setDirty(gy, gh);
+    for (const auto& range : _ranges) {
+        for (uint32_t codepoint = range.first; codepoint <= range.second; codepoint++) {
+            // Append UTF-8
+            if (codepoint < 0x80) {
+                text += char(codepoint);
+            } else if (codepoint < 0x800) {
+                text += char(0xc0 | (codepoint >> 6));
+                text += char(0x80 | (codepoint & 0x3f));
+            } else if (codepoint < 0x10000) {
+                text += char(0xe0 | (codepoint >> 12));
+                text += char(0x80 | ((codepoint >> 6) & 0x3f));
+                text += char(0x80 | (codepoint & 0x3f));
+            } else {
+                text += char(0xf0 | (codepoint >> 18));
+                text += char(0x80 | ((codepoint >> 12) & 0x3f));
+                text += char(0x80 | ((codepoint >> 6) & 0x3f));
+                text += char(0x80 | (codepoint & 0x3f));
+            }
+
+            if (text.size() >= 256) { flush(); }
+        }
+        flush();
+    }
 }
 
 void FontContext::releaseAtlas(std::bitset<max_textures> _refs) {
@@ -156,20 +450,99 @@ void FontContext::releaseAtlas(std::bitset<max_textures> _refs) {
             LOGD("CLEAR ATLAS %d", i);
             m_atlas.clear(i);
             m_textures[i].texData.assign(GlyphTexture::size * GlyphTexture::size, 0);
+
+            // Cached layouts referencing this page hold texture
+            // coordinates of glyphs that were just recycled
+            for (auto it = m_shapedCache.begin(); it != m_shapedCache.end();) {
+                if (it->second.refs[i]) {
+                    it = m_shapedCache.erase(it);
+                } else {
+                    ++it;
+                }
+            }
         }
     }
 }
 
+// Frames an atlas page must stay unreferenced before its GL texture
+// and CPU copy are released; about ten seconds of idle time, so pages
+// survive quick pans back into a region but a long session touring
+// many scripts holds only the pages its current labels use.
+#define GLYPH_PAGE_IDLE_FRAMES 600
+
 void FontContext::updateTextures() {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    for (auto& gt : m_textures) {
+    // Bake GPU-routed glyph distance fields first, so the finished
+    // regions upload with this frame's dirty rows below. The readback
+    // keeps texData and the glyph cache holding the baked pixels.
+    if (!m_gpuPendingGlyphs.empty()) {
+        if (!m_sdfPass) {
+            m_sdfPass = std::make_unique<GlyphSdfPass>(GlyphTexture::size, m_sdfRadius);
+        }
+
+        uint16_t stride = GlyphTexture::size;
+
+        for (auto& glyph : m_gpuPendingGlyphs) {
+            auto& gt = m_textures[glyph.id];
+            // The page may have been reclaimed while the glyph waited
+            if (gt.texData.empty()) { continue; }
+
+            uint16_t padWidth = glyph.gw + glyph.pad * 2;
+            uint16_t padHeight = glyph.gh + glyph.pad * 2;
+            unsigned char* region = &gt.texData[glyph.gx + glyph.gy * stride];
+
+            if (!m_sdfPass->bake(region, stride, padWidth, padHeight)) {
+                // The pass cannot run on this context; finish this
+                // glyph on the CPU and route later ones back to the
+                // worker-side bake
+                m_sdfPassFailed = true;
+                std::vector<unsigned char> tmp(padWidth * padHeight * sizeof(float) * 3);
+                sdfBuildDistanceFieldNoAlloc(region, stride, m_sdfRadius,
+                                             region, padWidth, padHeight, stride,
+                                             tmp.data());
+            }
+
+            storeCachedGlyph(glyph.key, region, stride, padWidth, padHeight);
+
+            gt.dirty = true;
+            gt.texture.setDirty(glyph.gy, padHeight);
+        }
+        m_gpuPendingGlyphs.clear();
+    }
+
+    for (size_t i = 0; i < m_textures.size(); i++) {
+        auto& gt = m_textures[i];
+
+        if (m_atlasRefCount[i] > 0) {
+            gt.idleFrames = 0;
+        } else if (!gt.texData.empty() &&
+                   (++gt.idleFrames >= GLYPH_PAGE_IDLE_FRAMES || m_shedIdlePages)) {
+            // alfons already recycled the page's glyphs when its last
+            // label was released; the buffers are rebuilt through the
+            // regular addGlyph path when the page id is handed out
+            // again.
+            LOGD("RECLAIM ATLAS %d", int(i));
+            gt.texData = {};
+            gt.texture.dispose();
+            gt.dirty = false;
+        }
+
+        if (gt.texData.empty()) { continue; }
+
         if (gt.dirty || !gt.texture.isValid()) {
             gt.dirty = false;
             auto td = reinterpret_cast<const GLuint*>(gt.texData.data());
             gt.texture.update(0, td);
         }
     }
+
+    m_shedIdlePages = false;
+}
+
+void FontContext::shedIdlePages() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shedIdlePages = true;
 }
 
 void FontContext::bindTexture(alfons::AtlasID _id, GLuint _unit) {
@@ -181,17 +554,47 @@ void FontContext::bindTexture(alfons::AtlasID _id, GLuint _unit) {
 bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string& _text,
                              std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs, glm::vec2& _size) {
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    ShapedTextKey key { _params.font.get(), _text, _params.fontScale,
+                        _params.lineSpacing, _params.maxLineWidth,
+                        uint8_t(_params.align), _params.wordWrap };
+
+    // Identical strings are laid out over and over as they recur
+    // across tiles; replay the finished quads instead of shaping and
+    // wrapping them again.
+    auto cached = m_shapedCache.find(key);
+    if (cached != m_shapedCache.end()) {
+        auto& entry = cached->second;
+
+        _quads.insert(_quads.end(), entry.quads.begin(), entry.quads.end());
+
+        for (size_t i = 0; i < m_textures.size(); i++) {
+            if (entry.refs[i] && !_refs[i]) {
+                _refs[i] = true;
+                m_atlasRefCount[i]++;
+            }
+        }
+        _size = entry.size;
+        return true;
+    }
+
+    BuildTelemetry::beginShaping();
 
     alfons::LineLayout line = m_shaper.shape(_params.font, _text);
 
     if (line.shapes().size() == 0) {
         LOGD("Empty text line");
+        BuildTelemetry::endShaping();
         return false;
     }
 
     line.setScale(_params.fontScale);
 
+    // New strings pass here once - the shaped cache replays repeats -
+    // so the usage record stays proportional to distinct codepoints
+    recordGlyphUsage(_text);
+
     // m_batch.drawShapeRange() calls FontContext's TextureCallback for new glyphs
     // and MeshCallback (drawGlyph) for vertex quads of each glyph in LineLayout.
 
@@ -209,6 +612,8 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
         m_batch.drawShapeRange(line, 0, line.shapes().size(), position, metrics);
     }
 
+    BuildTelemetry::endShaping();
+
     // TextLabel parameter: Dimension
     float width = metrics.aabb.z - metrics.aabb.x;
     float height = metrics.aabb.w - metrics.aabb.y;
@@ -217,14 +622,25 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
     glm::vec2 offset((metrics.aabb.x + width * 0.5) * TextVertex::position_scale,
                      (metrics.aabb.y + height * 0.5) * TextVertex::position_scale);
 
+    // Bake deferred glyph SDFs outside the lock; addGlyph only runs
+    // under m_mutex, so the pending list is exactly this layout's.
+    auto pending = std::move(m_pendingGlyphs);
+    m_pendingGlyphs.clear();
+
     auto it = _quads.begin() + quadsStart;
     if (it == _quads.end()) {
         // No glyphs added
+        lock.unlock();
+        bakeGlyphs(pending);
         return false;
     }
 
+    std::bitset<max_textures> usedPages;
+
     while (it != _quads.end()) {
 
+        usedPages[it->atlas] = true;
+
         if (!_refs[it->atlas]) {
             _refs[it->atlas] = true;
             m_atlasRefCount[it->atlas]++;
@@ -239,6 +655,17 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const std::string&
 
     _size = glm::vec2(width, height);
 
+    if (m_shapedCache.size() < SHAPED_CACHE_MAX_ENTRIES) {
+        ShapedText entry;
+        entry.quads.assign(_quads.begin() + quadsStart, _quads.end());
+        entry.refs = usedPages;
+        entry.size = _size;
+        m_shapedCache.emplace(std::move(key), std::move(entry));
+    }
+
+    lock.unlock();
+    bakeGlyphs(pending);
+
     return true;
 }
 
@@ -289,20 +716,31 @@ auto FontContext::getFont(const std::string& _family, const std::string& _style,
     // Assuming bundled ttf file follows this convention
     auto bundledFontPath = "fonts/" + _family + "-" + _weight + _style + ".ttf";
 
-    do {
-        if (!m_sceneResourceRoot.empty()) {
-            auto resourceFontPath = m_sceneResourceRoot + bundledFontPath;
-            data = bytesFromFile(resourceFontPath.c_str(), dataSize);
-            if (data) { break; }
-        }
-
-        data = bytesFromFile(bundledFontPath.c_str(), dataSize);
-        if (data) { break; }
-
+    // Probe the candidate files concurrently; they are still taken in
+    // priority order below, but their storage latency overlaps instead
+    // of adding up when the first candidates are missing
+    std::future<FileData> resourceRead;
+    if (!m_sceneResourceRoot.empty()) {
+        auto resourceFontPath = m_sceneResourceRoot + bundledFontPath;
+        resourceRead = bytesFromFileAsync(resourceFontPath.c_str());
+    }
+    auto bundledRead = bytesFromFileAsync(bundledFontPath.c_str());
+
+    FileData resource;
+    if (resourceRead.valid()) { resource = resourceRead.get(); }
+    FileData bundled = bundledRead.get();
+
+    if (resource.bytes) {
+        data = resource.bytes;
+        dataSize = resource.size;
+        free(bundled.bytes);
+    } else if (bundled.bytes) {
+        data = bundled.bytes;
+        dataSize = bundled.size;
+    } else {
         auto sysFontPath = systemFontPath(_family, _weight, _style);
         data = bytesFromFile(sysFontPath.c_str(), dataSize);
-
-    } while(0);
+    }
 
     if (!data) {
         LOGE("Could not load font file %s", fontName.c_str());
@@ -15,12 +15,18 @@
 #include "alfons/inputSource.h"
 
 #include "gl/texture.h"
+#include "util/hash.h"
 
 #include <bitset>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace Tangram {
 
+class GlyphSdfPass;
+
 struct FontMetrics {
     float ascender, descender, lineHeight;
 };
@@ -39,6 +45,10 @@ struct GlyphTexture {
 
     bool dirty = false;
     size_t refCount = 0;
+
+    // Frames this page has spent without any label referencing it;
+    // counted in updateTextures to reclaim long-idle pages
+    int idleFrames = 0;
 };
 
 class FontContext : public alfons::TextureCallback {
@@ -48,6 +58,7 @@ public:
     static constexpr int max_textures = 64;
 
     FontContext();
+    ~FontContext();
 
     /* Synchronized on m_mutex on tile-worker threads
      * Called from alfons when a texture atlas needs to be created
@@ -69,6 +80,11 @@ public:
     /* Update all textures batches, uploads the data to the GPU */
     void updateTextures();
 
+    /* Releases every atlas page no label currently references on the
+     * next updateTextures() call, instead of waiting for the idle-frame
+     * reclaim. Used under memory pressure. */
+    void shedIdlePages();
+
     std::shared_ptr<alfons::Font> getFont(const std::string& _name, const std::string& _style,
                                           const std::string& _weight, float _size);
 
@@ -92,10 +108,141 @@ public:
 
     void setSceneResourceRoot(const std::string& sceneResourceRoot) { m_sceneResourceRoot = sceneResourceRoot; }
 
+    /* Sets a directory for the persistent glyph SDF cache. Baked
+     * distance fields are stored keyed by glyph bitmap content, so
+     * across runs glyphs skip the SDF math in addGlyph entirely. */
+    void setGlyphCachePath(const std::string& _path);
+
+    /* Bakes glyphs for the given unicode codepoint ranges into the
+     * atlas ahead of first use, e.g. common CJK ranges, so the first
+     * tiles with such labels don't stall on SDF generation. The
+     * baked atlas pages stay referenced. May be called from any
+     * thread, synchronized on m_mutex. */
+    void prewarmGlyphRanges(const std::vector<std::pair<uint32_t, uint32_t>>& _ranges);
+
+    /* Bakes the codepoints recorded by earlier runs in the glyph
+     * cache directory, so a returning user starts with the atlas
+     * already warmed for the labels of their region. Called by
+     * setGlyphCachePath once the path is known. */
+    void prewarmRecordedGlyphs();
+
 private:
+
+    // Note the codepoints of a shaped string in the usage record;
+    // flushed to the glyph cache directory as new ones accumulate.
+    // Takes m_glyphCacheMutex itself.
+    void recordGlyphUsage(const std::string& _text);
+
+    // Rewrite the usage record file. m_glyphCacheMutex must be held.
+    void saveGlyphUsage();
+
+    // A glyph whose bitmap was copied into the atlas but whose
+    // distance field still has to be baked. The bake runs outside
+    // m_mutex on the worker that requested the glyph, so several
+    // workers generate SDFs concurrently instead of serializing
+    // behind the font lock. The atlas region pointer is captured
+    // while m_mutex is held: indexing m_textures outside the lock
+    // would race with addTexture() growing the vector, while the
+    // page's heap buffer survives element moves.
+    struct PendingGlyph {
+        alfons::AtlasID id;
+        uint16_t gx, gy, gw, gh, pad;
+        uint64_t key;
+        unsigned char* region = nullptr;
+    };
+
+    // Bake the distance fields of _pending glyphs in place, then
+    // mark their textures dirty and store the baked blocks in the
+    // glyph cache. Called without m_mutex held.
+    void bakeGlyphs(std::vector<PendingGlyph>& _pending);
+
+    // Look up a baked SDF block for _key and copy it into the atlas
+    // region at _dst; returns false when neither the in-memory nor
+    // the on-disk cache has it. Called with m_mutex held.
+    bool loadCachedGlyph(uint64_t _key, unsigned char* _dst, uint16_t _stride,
+                         uint16_t _width, uint16_t _height);
+
+    // Store the baked SDF block at _src under _key, in memory and on
+    // disk when a cache path is set. Takes m_glyphCacheMutex itself.
+    void storeCachedGlyph(uint64_t _key, const unsigned char* _src, uint16_t _stride,
+                          uint16_t _width, uint16_t _height);
+
+    // Identifies one shaping run: the same string shaped with the
+    // same font, scale and wrapping parameters always produces the
+    // same quads, so the result can be shared between labels.
+    struct ShapedTextKey {
+        const alfons::Font* font;
+        std::string text;
+        float fontScale;
+        float lineSpacing;
+        uint32_t maxLineWidth;
+        uint8_t align;
+        bool wordWrap;
+
+        bool operator==(const ShapedTextKey& _other) const {
+            return font == _other.font &&
+                fontScale == _other.fontScale &&
+                lineSpacing == _other.lineSpacing &&
+                maxLineWidth == _other.maxLineWidth &&
+                align == _other.align &&
+                wordWrap == _other.wordWrap &&
+                text == _other.text;
+        }
+    };
+
+    struct ShapedTextKeyHash {
+        size_t operator()(const ShapedTextKey& _key) const {
+            size_t seed = std::hash<std::string>()(_key.text);
+            hash_combine(seed, _key.font);
+            hash_combine(seed, _key.fontScale);
+            hash_combine(seed, _key.lineSpacing);
+            hash_combine(seed, _key.maxLineWidth);
+            hash_combine(seed, _key.align);
+            hash_combine(seed, _key.wordWrap);
+            return seed;
+        }
+    };
+
+    // A finished layout: glyph quads already centered around the
+    // label origin, the atlas pages they reference and the text
+    // dimensions. Guarded by m_mutex; entries are dropped when one of
+    // their atlas pages is cleared, since the quad texture
+    // coordinates then point at recycled glyphs.
+    struct ShapedText {
+        std::vector<GlyphQuad> quads;
+        std::bitset<max_textures> refs;
+        glm::vec2 size;
+    };
+
+    std::unordered_map<ShapedTextKey, ShapedText, ShapedTextKeyHash> m_shapedCache;
+
     float m_sdfRadius;
     ScratchBuffer m_scratch;
-    std::vector<unsigned char> m_sdfBuffer;
+
+    // Glyphs waiting for their SDF bake, filled in addGlyph under
+    // m_mutex and drained by the worker that triggered them.
+    std::vector<PendingGlyph> m_pendingGlyphs;
+
+    // Glyphs routed to the GPU distance-field pass instead, baked in
+    // updateTextures() on the GL thread. Guarded by m_mutex.
+    std::vector<PendingGlyph> m_gpuPendingGlyphs;
+
+    // Render-to-texture distance transform, created lazily on the GL
+    // thread; once a bake fails, later glyphs fall back to the
+    // worker-side CPU path. Guarded by m_mutex.
+    std::unique_ptr<GlyphSdfPass> m_sdfPass;
+    bool m_sdfPassFailed = false;
+
+    // SDF output cache keyed by glyph bitmap content. Guarded by its
+    // own mutex since baking happens outside m_mutex.
+    std::mutex m_glyphCacheMutex;
+    std::unordered_map<uint64_t, std::vector<unsigned char>> m_glyphCache;
+    std::string m_glyphCachePath;
+
+    // Codepoints shaped so far, persisted next to the cached glyph
+    // blocks for prewarmRecordedGlyphs(). Guarded by m_glyphCacheMutex.
+    std::unordered_set<uint32_t> m_usedCodepoints;
+    int m_unsavedCodepoints = 0;
 
     std::mutex m_mutex;
     std::array<int, max_textures> m_atlasRefCount = {{0}};
@@ -106,6 +253,10 @@ private:
 
     std::vector<GlyphTexture> m_textures;
 
+    // Set by shedIdlePages(), consumed by the next updateTextures().
+    // Guarded by m_mutex.
+    bool m_shedIdlePages = false;
+
     // TextShaper to create <LineLayout> for a given text and Font
     alfons::TextShaper m_shaper;
 
@@ -0,0 +1,287 @@
+#include "glyphSdfPass.h"
+
+#include "platform.h"
+#include "gl/error.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl/vertexLayout.h"
+
+#include <cstring>
+
+// Not among the repo's gl.h prototypes
+#ifndef GL_VIEWPORT
+#define GL_VIEWPORT 0x0BA2
+#endif
+
+namespace Tangram {
+
+// Clip-space quad shared by all passes
+static const char* quad_vs = R"END(
+    attribute vec2 a_position;
+    varying vec2 v_uv;
+    void main() {
+        v_uv = a_position * 0.5 + 0.5;
+        gl_Position = vec4(a_position, 0.0, 1.0);
+    }
+)END";
+
+// Marks contour pixels as flood seeds. A pixel seeds when its coverage
+// is fractional or its inside/outside state differs from a 4-neighbor,
+// so purely binary bitmaps still produce a contour. rg hold the seed
+// position, b flags validity and a keeps the seed's coverage for the
+// sub-pixel term in the resolve pass.
+static const char* seed_fs = R"END(
+    #ifdef GL_ES
+    precision highp float;
+    #endif
+    uniform sampler2D u_tex;
+    uniform float u_texel;
+    varying vec2 v_uv;
+    void main() {
+        float a = texture2D(u_tex, v_uv).a;
+        float l = texture2D(u_tex, v_uv - vec2(u_texel, 0.0)).a;
+        float r = texture2D(u_tex, v_uv + vec2(u_texel, 0.0)).a;
+        float b = texture2D(u_tex, v_uv - vec2(0.0, u_texel)).a;
+        float t = texture2D(u_tex, v_uv + vec2(0.0, u_texel)).a;
+        float mn = min(min(l, r), min(b, t));
+        float mx = max(max(l, r), max(b, t));
+        bool edge = (a > 0.0 && a < 1.0) ||
+                    (a > 0.5 && mn <= 0.5) ||
+                    (a <= 0.5 && mx > 0.5);
+        gl_FragColor = edge ? vec4(v_uv, 1.0, a) : vec4(0.0);
+    }
+)END";
+
+// One jump-flood step: adopt the closest valid seed among this pixel
+// and its eight neighbors at the current step offset
+static const char* jfa_fs = R"END(
+    #ifdef GL_ES
+    precision highp float;
+    #endif
+    uniform sampler2D u_tex;
+    uniform float u_step;
+    varying vec2 v_uv;
+    void main() {
+        vec4 best = vec4(0.0);
+        float bestDist = 1e10;
+        for (int y = -1; y <= 1; y++) {
+            for (int x = -1; x <= 1; x++) {
+                vec4 s = texture2D(u_tex, v_uv + vec2(float(x), float(y)) * u_step);
+                if (s.b > 0.0) {
+                    vec2 diff = v_uv - s.rg;
+                    float d = dot(diff, diff);
+                    if (d < bestDist) {
+                        bestDist = d;
+                        best = s;
+                    }
+                }
+            }
+        }
+        gl_FragColor = best;
+    }
+)END";
+
+// Resolves the flooded seed map into the byte encoding of sdf.h:
+// 0 at +radius outside, 255 at -radius inside, 127/128 on the contour
+static const char* resolve_fs = R"END(
+    #ifdef GL_ES
+    precision highp float;
+    #endif
+    uniform sampler2D u_tex;
+    uniform sampler2D u_coverage;
+    uniform float u_size;
+    uniform float u_radius;
+    varying vec2 v_uv;
+    void main() {
+        float a = texture2D(u_coverage, v_uv).a;
+        vec4 s = texture2D(u_tex, v_uv);
+        float v;
+        if (s.b > 0.0) {
+            float d = length(v_uv - s.rg) * u_size;
+            // The seed's own coverage shifts the contour sub-pixel
+            float sd = (a > 0.5 ? -d : d) + (0.5 - s.a);
+            v = clamp(0.5 - sd / (2.0 * u_radius), 0.0, 1.0);
+        } else {
+            v = a > 0.5 ? 1.0 : 0.0;
+        }
+        gl_FragColor = vec4(v);
+    }
+)END";
+
+GlyphSdfPass::GlyphSdfPass(int _size, float _radius)
+    : m_size(_size),
+      m_radius(_radius) {}
+
+GlyphSdfPass::~GlyphSdfPass() {
+
+    // Owned and destroyed on the GL thread, so the objects are deleted
+    // directly instead of through a deletion queue
+    if (m_framebuffers[0]) {
+        GL_CHECK(glDeleteFramebuffers(2, m_framebuffers));
+    }
+    if (m_targets[0]) {
+        GL_CHECK(glDeleteTextures(2, m_targets));
+    }
+    if (m_coverageTexture) {
+        GL_CHECK(glDeleteTextures(1, &m_coverageTexture));
+    }
+}
+
+void GlyphSdfPass::init() {
+
+    m_initialized = true;
+
+    GL_CHECK(glGenTextures(1, &m_coverageTexture));
+    RenderState::texture(GL_TEXTURE_2D, m_coverageTexture);
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_size, m_size, 0,
+                          GL_ALPHA, GL_UNSIGNED_BYTE, nullptr));
+
+    GL_CHECK(glGenTextures(2, m_targets));
+    GL_CHECK(glGenFramebuffers(2, m_framebuffers));
+
+    m_valid = true;
+
+    for (int i = 0; i < 2; i++) {
+        RenderState::texture(GL_TEXTURE_2D, m_targets[i]);
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size, m_size, 0,
+                              GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+        GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffers[i]));
+        GL_CHECK(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                        GL_TEXTURE_2D, m_targets[i], 0));
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            LOGW("Glyph SDF framebuffer incomplete: %x", status);
+            m_valid = false;
+        }
+    }
+
+    m_seedShader = std::make_unique<ShaderProgram>();
+    m_seedShader->setSourceStrings(seed_fs, quad_vs);
+    m_jfaShader = std::make_unique<ShaderProgram>();
+    m_jfaShader->setSourceStrings(jfa_fs, quad_vs);
+    m_resolveShader = std::make_unique<ShaderProgram>();
+    m_resolveShader->setSourceStrings(resolve_fs, quad_vs);
+
+    auto layout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+    }));
+
+    MeshData<glm::vec2> quad;
+    quad.vertices = {{-1.f, -1.f}, {1.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f}};
+    quad.indices = {0, 1, 2, 2, 1, 3};
+    quad.offsets.emplace_back(6, 4);
+
+    m_quad = std::make_unique<Mesh<glm::vec2>>(layout, GL_TRIANGLES);
+    m_quad->compile(std::move(quad));
+}
+
+bool GlyphSdfPass::bake(unsigned char* _region, uint16_t _stride,
+                        uint16_t _width, uint16_t _height) {
+
+    if (!m_initialized) { init(); }
+    if (!m_valid) { return false; }
+
+    // Zero-pad the region into a full page so the flood never picks up
+    // a stale seed from a previously baked glyph
+    m_coverage.assign(size_t(m_size) * m_size, 0);
+    for (uint16_t y = 0; y < _height; y++) {
+        std::memcpy(&m_coverage[y * m_size], _region + y * _stride, _width);
+    }
+
+    GLint previousFramebuffer = 0;
+    GLint viewport[4];
+    GL_CHECK(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer));
+    GL_CHECK(glGetIntegerv(GL_VIEWPORT, viewport));
+
+    RenderState::blending(GL_FALSE);
+    RenderState::depthTest(GL_FALSE);
+    RenderState::depthWrite(GL_FALSE);
+    RenderState::stencilTest(GL_FALSE);
+    RenderState::culling(GL_FALSE);
+
+    GLuint coverageUnit = RenderState::nextAvailableTextureUnit();
+    GLuint sourceUnit = RenderState::nextAvailableTextureUnit();
+
+    RenderState::textureUnit(coverageUnit);
+    RenderState::texture(GL_TEXTURE_2D, m_coverageTexture);
+    GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size, m_size,
+                             GL_ALPHA, GL_UNSIGNED_BYTE, m_coverage.data()));
+
+    GL_CHECK(glViewport(0, 0, m_size, m_size));
+
+    bool ok = true;
+
+    // Seed the contour into the first target
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffers[0]));
+    if (m_seedShader->use()) {
+        m_seedShader->setUniformi(m_uSeedTex, coverageUnit);
+        m_seedShader->setUniformf(m_uSeedTexel, 1.f / m_size);
+        m_quad->draw(*m_seedShader);
+    } else {
+        ok = false;
+    }
+
+    // Flood with halving steps; after the 1-texel step every pixel
+    // holds its nearest contour seed
+    int source = 0;
+    if (ok && m_jfaShader->use()) {
+        for (int step = m_size / 2; step >= 1; step /= 2) {
+            int target = 1 - source;
+            GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffers[target]));
+            RenderState::textureUnit(sourceUnit);
+            RenderState::texture(GL_TEXTURE_2D, m_targets[source]);
+            m_jfaShader->setUniformi(m_uJfaTex, sourceUnit);
+            m_jfaShader->setUniformf(m_uJfaStep, float(step) / m_size);
+            m_quad->draw(*m_jfaShader);
+            source = target;
+        }
+    } else {
+        ok = false;
+    }
+
+    // Resolve into the free target and read the glyph region back
+    if (ok && m_resolveShader->use()) {
+        GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffers[1 - source]));
+        RenderState::textureUnit(sourceUnit);
+        RenderState::texture(GL_TEXTURE_2D, m_targets[source]);
+        m_resolveShader->setUniformi(m_uResolveTex, sourceUnit);
+        m_resolveShader->setUniformi(m_uResolveCoverage, coverageUnit);
+        m_resolveShader->setUniformf(m_uResolveSize, float(m_size));
+        m_resolveShader->setUniformf(m_uResolveRadius, m_radius);
+        m_quad->draw(*m_resolveShader);
+
+        m_readback.resize(size_t(_width) * _height * 4);
+        GL_CHECK(glReadPixels(0, 0, _width, _height, GL_RGBA,
+                              GL_UNSIGNED_BYTE, m_readback.data()));
+
+        for (uint16_t y = 0; y < _height; y++) {
+            for (uint16_t x = 0; x < _width; x++) {
+                _region[y * _stride + x] = m_readback[(y * _width + x) * 4];
+            }
+        }
+    } else {
+        ok = false;
+    }
+
+    GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer));
+    GL_CHECK(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+
+    RenderState::releaseTextureUnit();
+    RenderState::releaseTextureUnit();
+
+    if (!ok) { m_valid = false; }
+
+    return ok;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "gl.h"
+#include "gl/mesh.h"
+#include "gl/uniform.h"
+
+#include "glm/vec2.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+class ShaderProgram;
+
+/* GPU glyph distance-field generator
+ *
+ * Replaces the CPU distance transform for freshly rasterized glyphs:
+ * the coverage bitmap is uploaded to a scratch texture, contour pixels
+ * are seeded into an RGBA target and flooded with a jump-flood pass per
+ * power-of-two step, and a final pass resolves the signed distance into
+ * the byte encoding the text shaders expect (see include/sdf/sdf.h).
+ * The baked region is read back so the atlas page buffer and the glyph
+ * cache stay the source of truth for uploads.
+ *
+ * All GL objects are created lazily on the first bake(), which must run
+ * on the GL thread. Gated by Hardware::supportsGlyphGpuSdf.
+ */
+class GlyphSdfPass {
+
+public:
+
+    /* _size is the atlas page dimension, _radius the distance-field
+     * spread in pixels; both match the FontContext that owns the pass */
+    GlyphSdfPass(int _size, float _radius);
+    ~GlyphSdfPass();
+
+    GlyphSdfPass(const GlyphSdfPass&) = delete;
+    GlyphSdfPass& operator=(const GlyphSdfPass&) = delete;
+
+    /* Replace the coverage bitmap at _region (row stride _stride) with
+     * its distance field, in place. Returns false when the pass cannot
+     * run on this context, so the caller falls back to the CPU
+     * transform. */
+    bool bake(unsigned char* _region, uint16_t _stride,
+              uint16_t _width, uint16_t _height);
+
+private:
+
+    void init();
+
+    int m_size;
+    float m_radius;
+
+    bool m_initialized = false;
+    bool m_valid = false;
+
+    // Ping-pong color targets holding the nearest-seed map
+    GLuint m_framebuffers[2] = { 0, 0 };
+    GLuint m_targets[2] = { 0, 0 };
+    GLuint m_coverageTexture = 0;
+
+    std::unique_ptr<ShaderProgram> m_seedShader;
+    std::unique_ptr<ShaderProgram> m_jfaShader;
+    std::unique_ptr<ShaderProgram> m_resolveShader;
+
+    std::unique_ptr<Mesh<glm::vec2>> m_quad;
+
+    // Zero-padded coverage upload and RGBA readback staging
+    std::vector<unsigned char> m_coverage;
+    std::vector<unsigned char> m_readback;
+
+    UniformLocation m_uSeedTex{"u_tex"};
+    UniformLocation m_uSeedTexel{"u_texel"};
+    UniformLocation m_uJfaTex{"u_tex"};
+    UniformLocation m_uJfaStep{"u_step"};
+    UniformLocation m_uResolveTex{"u_tex"};
+    UniformLocation m_uResolveCoverage{"u_coverage"};
+    UniformLocation m_uResolveSize{"u_size"};
+    UniformLocation m_uResolveRadius{"u_radius"};
+
+};
+
+}
@@ -15,6 +15,26 @@ int TextWrapper::draw(alfons::TextBatch& _batch, const alfons::LineLayout& _line
 
     if (_line.shapes().size() == 0) { return 0; }
 
+    // Fast path for text that cannot wrap: no hard line breaks and
+    // fewer characters than one line holds - the common case for
+    // short street names - draws as a single range without break
+    // bookkeeping.
+    size_t chars = 0;
+    bool breaks = false;
+    for (auto& shape : _line.shapes()) {
+        if (shape.cluster) { chars++; }
+        if (shape.mustBreak) { breaks = true; break; }
+    }
+    if (!breaks && chars > 0 && chars < _maxLineChars) {
+        alfons::LineMetrics lineMetrics;
+        glm::vec2 position(0);
+
+        _batch.drawShapeRange(_line, 0, _line.shapes().size(), position, lineMetrics);
+
+        _layoutMetrics.addExtents(lineMetrics.aabb);
+        return 1;
+    }
+
     float lineWidth = 0;
     float maxWidth = 0;
     size_t charCount = 0;
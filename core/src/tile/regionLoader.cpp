@@ -0,0 +1,220 @@
+#include "regionLoader.h"
+
+#include "data/dataSource.h"
+#include "tile/tileTask.h"
+#include "platform.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Requests kept in flight at once; enough to saturate the multiplexed
+// fetcher without monopolizing it against interactive tile loads
+#define REGION_MAX_INFLIGHT 16
+
+// Latitude limit of the mercator projection
+#define MAX_LATITUDE 85.05112878
+
+namespace Tangram {
+
+RegionLoader::RegionLoader(std::shared_ptr<DataSource> _source, bool _prebuild)
+    : m_source(std::move(_source)),
+      m_prebuild(_prebuild) {}
+
+RegionLoader::~RegionLoader() {
+    cancel();
+}
+
+std::vector<TileID> RegionLoader::tilesInRegion(const BoundingBox& _lonLatBounds,
+                                                int _minZoom, int _maxZoom) {
+    std::vector<TileID> tiles;
+
+    if (_minZoom < 0 || _maxZoom < _minZoom) { return tiles; }
+
+    MercatorProjection projection;
+
+    glm::dvec2 sw(std::min(_lonLatBounds.min.x, _lonLatBounds.max.x),
+                  glm::clamp(std::min(_lonLatBounds.min.y, _lonLatBounds.max.y),
+                             -MAX_LATITUDE, MAX_LATITUDE));
+    glm::dvec2 ne(std::max(_lonLatBounds.min.x, _lonLatBounds.max.x),
+                  glm::clamp(std::max(_lonLatBounds.min.y, _lonLatBounds.max.y),
+                             -MAX_LATITUDE, MAX_LATITUDE));
+
+    glm::dvec2 minMeters = projection.LonLatToMeters(sw);
+    glm::dvec2 maxMeters = projection.LonLatToMeters(ne);
+
+    const double hc = MapProjection::HALF_CIRCUMFERENCE;
+
+    for (int z = _minZoom; z <= _maxZoom; z++) {
+
+        double tileSpan = 2.0 * hc / double(1 << z);
+        int last = (1 << z) - 1;
+
+        int xMin = glm::clamp(int(std::floor((minMeters.x + hc) / tileSpan)), 0, last);
+        int xMax = glm::clamp(int(std::floor((maxMeters.x + hc) / tileSpan)), 0, last);
+        // Tile y runs from north to south
+        int yMin = glm::clamp(int(std::floor((hc - maxMeters.y) / tileSpan)), 0, last);
+        int yMax = glm::clamp(int(std::floor((hc - minMeters.y) / tileSpan)), 0, last);
+
+        for (int x = xMin; x <= xMax; x++) {
+            for (int y = yMin; y <= yMax; y++) {
+                tiles.emplace_back(x, y, z);
+            }
+        }
+    }
+
+    return tiles;
+}
+
+bool RegionLoader::start(const BoundingBox& _lonLatBounds, int _minZoom, int _maxZoom,
+                         ProgressCallback _onProgress) {
+
+    auto tiles = tilesInRegion(_lonLatBounds, _minZoom, _maxZoom);
+    size_t total = tiles.size();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_active || tiles.empty()) { return false; }
+
+        m_pending = std::move(tiles);
+        m_next = 0;
+        m_inflightIds.clear();
+
+        m_progress = Progress();
+        m_progress.total = m_pending.size();
+
+        m_active = true;
+        m_canceled = false;
+        m_onProgress = std::move(_onProgress);
+    }
+
+    LOG("Region fetch: %d tiles, zoom %d-%d", int(total), _minZoom, _maxZoom);
+
+    dispatch();
+
+    return true;
+}
+
+void RegionLoader::cancel() {
+
+    std::vector<TileID> inflight;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_active) { return; }
+
+        m_canceled = true;
+        m_active = false;
+        m_onProgress = nullptr;
+
+        inflight = std::move(m_inflightIds);
+        m_inflightIds.clear();
+    }
+
+    for (auto& id : inflight) {
+        m_source->cancelLoadingTile(id);
+    }
+}
+
+RegionLoader::Progress RegionLoader::progress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_progress;
+}
+
+bool RegionLoader::isActive() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_active;
+}
+
+void RegionLoader::removeInflight(const TileID& _tileId) {
+    auto it = std::find(m_inflightIds.begin(), m_inflightIds.end(), _tileId);
+    if (it != m_inflightIds.end()) { m_inflightIds.erase(it); }
+}
+
+void RegionLoader::dispatch() {
+
+    while (true) {
+
+        TileID id = NOT_A_TILE;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_active || m_canceled) { return; }
+            if (m_next >= m_pending.size() ||
+                m_inflightIds.size() >= REGION_MAX_INFLIGHT) { return; }
+
+            id = m_pending[m_next++];
+            m_inflightIds.push_back(id);
+        }
+
+        auto task = m_source->createTask(id);
+
+        if (task->hasData()) {
+            // Already in one of the source's caches; the while loop
+            // continues dispatching
+            onTileDone(std::move(task));
+            continue;
+        }
+
+        bool started = m_source->loadTileData(std::move(task),
+            TileTaskCb{[this](std::shared_ptr<TileTask>&& _task) {
+                onTileDone(std::move(_task));
+                dispatch();
+            }});
+
+        if (!started) {
+            Progress snapshot;
+            ProgressCallback onProgress;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                removeInflight(id);
+                m_progress.failed++;
+                if (m_progress.finished()) { m_active = false; }
+                snapshot = m_progress;
+                onProgress = m_onProgress;
+            }
+            if (onProgress) { onProgress(snapshot); }
+        }
+    }
+}
+
+void RegionLoader::onTileDone(std::shared_ptr<TileTask> _task) {
+
+    auto& task = static_cast<DownloadTileTask&>(*_task);
+
+    bool prebuild = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_canceled) { return; }
+
+        removeInflight(task.tileId());
+
+        if (task.hasData()) {
+            m_progress.completed++;
+            m_progress.bytes += task.rawTileData.size();
+            prebuild = m_prebuild;
+        } else {
+            m_progress.failed++;
+        }
+
+        if (m_progress.finished()) { m_active = false; }
+    }
+
+    if (prebuild) {
+        // Parse and store into the binary parsed-tile cache, so the
+        // region later loads without any parse cost
+        m_source->parseCached(task, m_projection);
+    }
+
+    Progress snapshot;
+    ProgressCallback onProgress;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        snapshot = m_progress;
+        onProgress = m_onProgress;
+    }
+    if (onProgress) { onProgress(snapshot); }
+}
+
+}
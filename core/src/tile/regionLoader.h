@@ -0,0 +1,101 @@
+#pragma once
+
+#include "tile/tileID.h"
+#include "util/geom.h"
+#include "util/mapProjection.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+class DataSource;
+class TileTask;
+
+/* Bulk tile download for a geographic region.
+ *
+ * Enumerates the TileIDs covering a lon/lat bounding box over a zoom
+ * range and fetches them from one DataSource, keeping a fixed number
+ * of requests in flight so the multiplexed fetcher stays saturated
+ * without flooding it. Fetched tiles land in the source's caches, so
+ * a source with a disk cache or bundle attached comes out of a run
+ * fully stocked for offline use; with prebuild enabled each tile is
+ * additionally parsed into the binary parsed-tile cache as it
+ * arrives, moving the parse cost off the device session entirely.
+ *
+ * Progress is reported through a callback that runs on the fetcher's
+ * threads; the caller must not touch GL or scene state from it.
+ */
+class RegionLoader {
+
+public:
+
+    struct Progress {
+        size_t total = 0;
+        size_t completed = 0;
+        size_t failed = 0;
+        // Raw bytes fetched or read from cache so far
+        size_t bytes = 0;
+
+        bool finished() const { return completed + failed == total; }
+    };
+
+    using ProgressCallback = std::function<void(Progress)>;
+
+    /* @_prebuild: also parse each fetched tile into the source's
+     * binary parsed-tile cache (needs a disk cache on the source) */
+    RegionLoader(std::shared_ptr<DataSource> _source, bool _prebuild = false);
+
+    ~RegionLoader();
+
+    /* TileIDs covering _lonLatBounds for each zoom in
+     * [_minZoom, _maxZoom], ordered by ascending zoom */
+    static std::vector<TileID> tilesInRegion(const BoundingBox& _lonLatBounds,
+                                             int _minZoom, int _maxZoom);
+
+    /* Starts fetching the region; fails (returning false) when a run
+     * is already active or the region contains no tiles */
+    bool start(const BoundingBox& _lonLatBounds, int _minZoom, int _maxZoom,
+               ProgressCallback _onProgress);
+
+    /* Cancels the active run; in-flight requests are dropped */
+    void cancel();
+
+    Progress progress() const;
+
+    bool isActive() const;
+
+private:
+
+    // Fill the in-flight window from the pending list.
+    // Must be called without m_mutex held.
+    void dispatch();
+
+    void onTileDone(std::shared_ptr<TileTask> _task);
+
+    // Must be called with m_mutex held
+    void removeInflight(const TileID& _tileId);
+
+    std::shared_ptr<DataSource> m_source;
+
+    MercatorProjection m_projection;
+
+    bool m_prebuild;
+
+    mutable std::mutex m_mutex;
+
+    std::vector<TileID> m_pending;
+    size_t m_next = 0;
+    std::vector<TileID> m_inflightIds;
+
+    Progress m_progress;
+    bool m_active = false;
+    bool m_canceled = false;
+
+    ProgressCallback m_onProgress;
+
+};
+
+}
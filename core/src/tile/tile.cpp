@@ -1,6 +1,7 @@
 #include "tile.h"
 
 #include "data/dataSource.h"
+#include "debug/tileLatency.h"
 #include "style/style.h"
 #include "view/view.h"
 #include "tile/tileID.h"
@@ -84,6 +85,27 @@ const std::unique_ptr<StyledMesh>& Tile::getMesh(const Style& _style) const {
     return m_geometry[_style.getID()];
 }
 
+size_t Tile::upload() {
+    size_t bytes = 0;
+
+    for (auto& entry : m_geometry) {
+        if (entry) {
+            bytes += entry->bufferSize();
+            entry->upload();
+        }
+    }
+
+    if (!m_glReady) {
+        // First staging closes the tile's latency trace; traces with
+        // unset stamps are skipped inside record()
+        TileLatency::record(m_loadStart, m_loadData, m_loadBuilt,
+                            TileLatency::Clock::now());
+    }
+    m_glReady = true;
+
+    return bytes;
+}
+
 size_t Tile::getMemoryUsage() const {
     if (m_memoryUsage == 0) {
         for (auto& entry : m_geometry) {
@@ -5,6 +5,8 @@
 #include "gl/texture.h"
 #include "tileID.h"
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -75,6 +77,13 @@ public:
     /* Update tile origin based on wraping for this tile */
     void updateTileOrigin(const int _wrap);
 
+    /* Re-key an overzoomed tile to the styling zoom _s. The tile's
+     * footprint, scale and meshes only depend on x,y,z; s is passed to
+     * the shaders through u_tile_origin, which scale zoom-dependent
+     * attributes like line widths accordingly. Only meaningful while
+     * s differs from z. */
+    void setStyleZoom(int32_t _s) { m_id.s = _s; }
+
     void resetState();
 
     /* Get the sum in bytes of static <Mesh>es */
@@ -88,9 +97,29 @@ public:
 
     void setProxyState(bool isProxy) { m_proxyState = isProxy; }
 
+    /* Uploads all style meshes to the GPU and marks the tile ready to
+     * draw; returns the number of bytes staged. Called on the GL
+     * thread by the budgeted upload pass in Map::render. */
+    size_t upload();
+
+    /* Whether the meshes of this tile have been uploaded; until then
+     * the tile is skipped in drawing and its proxies stand in */
+    bool isGlReady() const { return m_glReady; }
+
+    /* Stage stamps carried over from the build task; recorded into the
+     * latency histograms when upload() first stages the meshes */
+    void setLoadStamps(std::chrono::steady_clock::time_point _start,
+                       std::chrono::steady_clock::time_point _data,
+                       std::chrono::steady_clock::time_point _built) {
+        m_loadStart = _start;
+        m_loadData = _data;
+        m_loadBuilt = _built;
+    }
+
 private:
 
-    const TileID m_id;
+    // Immutable apart from the styling zoom s (see setStyleZoom())
+    TileID m_id;
 
     const MapProjection* m_projection = nullptr;
 
@@ -106,6 +135,15 @@ private:
 
     bool m_proxyState = false;
 
+    // Written on the GL thread, read by TileManager on the update
+    // thread to decide when proxies can be released
+    std::atomic<bool> m_glReady{false};
+
+    // See setLoadStamps()
+    std::chrono::steady_clock::time_point m_loadStart;
+    std::chrono::steady_clock::time_point m_loadData;
+    std::chrono::steady_clock::time_point m_loadBuilt;
+
     glm::dvec2 m_tileOrigin; // South-West corner of the tile in 2D projection space in meters (e.g. mercator meters)
 
     glm::mat4 m_modelMatrix; // Matrix relating tile-local coordinates to global projection space coordinates;
@@ -113,7 +151,8 @@ private:
     // Distances from the global origin are too large to represent precisely in 32-bit floats, so we only apply the
     // relative translation from the view origin to the model origin immediately before drawing the tile.
 
-    // Map of <Style>s and their associated <Mesh>es
+    // Meshes indexed by the dense style ids assigned at scene load
+    // (Style::getID()), so the per-draw fetch is an array access
     std::vector<std::unique_ptr<StyledMesh>> m_geometry;
     std::vector<Raster> m_rasters;
 
@@ -1,25 +1,101 @@
 #include "tile/tileBuilder.h"
 
 #include "data/dataSource.h"
+#include "data/tileData.h"
 #include "gl/mesh.h"
+#include "platform.h"
 #include "scene/dataLayer.h"
 #include "scene/scene.h"
 #include "style/style.h"
 #include "tile/tile.h"
+#include "util/geom.h"
 #include "util/mapProjection.h"
 #include "view/view.h"
 
 namespace Tangram {
 
-TileBuilder::TileBuilder(std::shared_ptr<Scene> _scene)
-    : m_scene(_scene) {
+namespace {
 
-    m_styleContext.initFunctions(*_scene);
+// Copy _feature into _filtered without the interior polygon rings
+// whose area falls below _minArea (in tile units squared). Returns
+// false when no ring is dropped, so the caller keeps using the
+// original; tile data is shared across scenes and must not be
+// modified in place.
+bool dropSmallRings(const Feature& _feature, Feature& _filtered, float _minArea) {
+
+    bool dropped = false;
+
+    for (auto& polygon : _feature.polygons) {
+        for (size_t i = 1; i < polygon.size(); i++) {
+            auto& ring = polygon[i];
+            if (std::abs(signedArea(ring.begin(), ring.end())) < _minArea) {
+                dropped = true;
+                break;
+            }
+        }
+        if (dropped) { break; }
+    }
+
+    if (!dropped) { return false; }
+
+    _filtered.geometryType = _feature.geometryType;
+    _filtered.props = _feature.props;
+    _filtered.polygons.clear();
+
+    for (auto& polygon : _feature.polygons) {
+        _filtered.polygons.emplace_back();
+        auto& out = _filtered.polygons.back();
+
+        for (size_t i = 0; i < polygon.size(); i++) {
+            auto& ring = polygon[i];
+            // The exterior ring always stays; whole features are
+            // culled by min_feature_size in the draw rules instead
+            if (i > 0 && std::abs(signedArea(ring.begin(), ring.end())) < _minArea) {
+                continue;
+            }
+            out.push_back(ring);
+        }
+    }
+
+    return true;
+}
+
+}
+
+TileBuilder::TileBuilder(std::shared_ptr<Scene> _scene) {
+    setScene(std::move(_scene));
+}
+
+std::shared_ptr<Scene> TileBuilder::setScene(std::shared_ptr<Scene> _scene) {
+
+    auto previousScene = std::move(m_scene);
+    m_scene = std::move(_scene);
+
+    // Reuses the duktape heap; functions and globals that did not
+    // change with the scene survive as they are
+    m_styleContext.initFunctions(*m_scene);
 
     // Initialize StyleBuilders
-    for (auto& style : _scene->styles()) {
+    m_styleBuilder.clear();
+    for (auto& style : m_scene->styles()) {
         m_styleBuilder[style->getName()] = style->createBuilder();
     }
+
+    // Group layers by their source, so builds iterate only the layers
+    // that apply to the tile's source.
+    m_sourceLayers.clear();
+    for (auto& layer : m_scene->layers()) {
+        m_sourceLayers[layer.source()].push_back(&layer);
+    }
+
+    // Builders in scene style order, indexable by the style ids that
+    // rules were bound to at scene compile time
+    m_styleBuilderByStyle.clear();
+    for (auto& style : m_scene->styles()) {
+        m_styleBuilderByStyle.push_back(getStyleBuilder(style->getName()));
+    }
+
+    return previousScene;
 }
 
 TileBuilder::~TileBuilder() {}
@@ -31,7 +107,34 @@ StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     return it->second.get();
 }
 
+StyleBuilder* TileBuilder::getStyleBuilder(const DrawRule& _rule) {
+
+    // With an explicit 'style' parameter the style name can differ
+    // per matched layer, so resolve it by name each time.
+    if (_rule.contains(StyleParamKey::style)) {
+        return getStyleBuilder(_rule.getStyleName());
+    }
+
+    // Without an override the style is named by the rule itself,
+    // which was bound to a style index at scene compile time
+    int styleId = m_scene->getStyleIdForRule(_rule.id);
+    if (styleId < 0 || size_t(styleId) >= m_styleBuilderByStyle.size()) {
+        return getStyleBuilder(_rule.getStyleName());
+    }
+
+    return m_styleBuilderByStyle[styleId];
+}
+
 std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileData, const DataSource& _source) {
+    return build(_tileID, _tileData, _source, nullptr);
+}
+
+std::shared_ptr<Tile> TileBuilder::build(TileTask& _task, const TileData& _tileData, const DataSource& _source) {
+    return build(_task.tileId(), _tileData, _source, &_task);
+}
+
+std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileData,
+                                         const DataSource& _source, TileTask* _task) {
 
     auto tile = std::make_shared<Tile>(_tileID, *m_scene->mapProjection(), &_source);
 
@@ -39,14 +142,65 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
 
     m_styleContext.setKeywordZoom(_tileID.s);
 
+    float tileSize = m_scene->mapProjection()->TileSize() * m_scene->pixelScale();
+    float tileScale = pow(2, _tileID.s - _tileID.z);
+
+    // One tile unit spans the data tile, drawn scaled up when the
+    // tile is overzoomed
+    m_ruleSet.setPixelsPerTile(tileSize * tileScale);
+
     for (auto& builder : m_styleBuilder) {
-        if (builder.second)
+        if (builder.second) {
+            builder.second->clearPropertiesRef();
             builder.second->setup(*tile);
+        }
+    }
+
+    // Sizing pre-pass: sum the parsed point counts per geometry type so
+    // builders can reserve their mesh buffers once, instead of growing
+    // multi-MB vectors through repeated reallocations during the build.
+    size_t pointCount = 0;
+    size_t linePointCount = 0;
+    size_t polygonPointCount = 0;
+    for (const auto& collection : _tileData.layers) {
+        for (const auto& feat : collection.features) {
+            switch (feat.geometryType) {
+            case GeometryType::points:
+                pointCount += feat.points.size();
+                break;
+            case GeometryType::lines:
+                for (const auto& line : feat.lines) { linePointCount += line.size(); }
+                break;
+            case GeometryType::polygons:
+                for (const auto& polygon : feat.polygons) {
+                    for (const auto& ring : polygon) { polygonPointCount += ring.size(); }
+                }
+                break;
+            default:
+                break;
+            }
+        }
     }
 
-    for (const auto& datalayer : m_scene->layers()) {
+    for (auto& builder : m_styleBuilder) {
+        if (builder.second)
+            builder.second->sizeHint(pointCount, linePointCount, polygonPointCount);
+    }
 
-        if (datalayer.source() != _source.name()) { continue; }
+    // Count of features to process between cancellation checks, so
+    // the overhead on uncanceled builds stays negligible.
+    const int checkInterval = 64;
+    int untilCheck = checkInterval;
+
+    static const std::vector<const DataLayer*> emptyLayers;
+    auto layersIt = m_sourceLayers.find(_source.name());
+    const auto& sourceLayers =
+        layersIt != m_sourceLayers.end() ? layersIt->second : emptyLayers;
+
+    for (const auto* layerPtr : sourceLayers) {
+        const auto& datalayer = *layerPtr;
+
+        if (_task && _task->isCanceled()) { return nullptr; }
 
         for (const auto& collection : _tileData.layers) {
 
@@ -58,26 +212,74 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
                 if (!layerContainsCollection) { continue; }
             }
 
+            // Ring areas are compared in tile units; one tile unit
+            // spans tileSize * tileScale pixels on screen.
+            float minRingArea = datalayer.minRingArea() /
+                ((tileSize * tileScale) * (tileSize * tileScale));
+
+            Feature filtered;
+
             for (const auto& feat : collection.features) {
+                if (--untilCheck <= 0) {
+                    if (_task && _task->isCanceled()) { return nullptr; }
+                    untilCheck = checkInterval;
+                }
+                if (minRingArea > 0.f &&
+                    feat.geometryType == GeometryType::polygons &&
+                    dropSmallRings(feat, filtered, minRingArea)) {
+                    m_ruleSet.apply(filtered, datalayer, m_styleContext, *this);
+                    continue;
+                }
                 m_ruleSet.apply(feat, datalayer, m_styleContext, *this);
             }
         }
     }
 
-    float tileSize = m_scene->mapProjection()->TileSize() * m_scene->pixelScale();
-    float tileScale = pow(2, _tileID.s - _tileID.z);
+    if (_task && _task->isCanceled()) { return nullptr; }
 
     m_labelLayout.setup(tileSize, tileScale);
 
+    // Styles that added no layout items and hold no deferred geometry
+    // do not depend on the second phase, so their meshes can be built
+    // and published right away.
+    std::vector<StyleBuilder*> secondPhaseBuilders;
+
     for (auto& builder : m_styleBuilder) {
+        size_t count = m_labelLayout.size();
 
         builder.second->addLayoutItems(m_labelLayout);
+
+        if (m_labelLayout.size() != count || builder.second->hasDeferredGeometry()) {
+            secondPhaseBuilders.push_back(builder.second.get());
+        } else {
+            tile->setMesh(builder.second->style(), builder.second->build());
+        }
+    }
+
+    // Publish the geometry-only tile ahead of the label pass and any
+    // deferred tessellation, so a heavy tile shows its polygons and
+    // lines while labels are still placed. Tiles with raster subtasks
+    // are excluded; their samplers are only attached when the whole
+    // task completes.
+    if (_task && !secondPhaseBuilders.empty() && _task->subTasks().empty()) {
+        _task->setPartialTile(tile);
+        requestRender(RenderDirty::full);
     }
 
     m_labelLayout.process();
 
-    for (auto& builder : m_styleBuilder) {
-        tile->setMesh(builder.second->style(), builder.second->build());
+    if (_task && _task->isCanceled()) { return nullptr; }
+
+    for (auto* builder : secondPhaseBuilders) {
+        builder->buildDeferredGeometry();
+
+        if (_task && _task->partialTile()) {
+            // The tile may already be rendered - hand the mesh over to be
+            // attached on the main thread when the task completes
+            _task->addPendingMesh(builder->style(), builder->build());
+        } else {
+            tile->setMesh(builder->style(), builder->build());
+        }
     }
 
     return tile;
@@ -12,6 +12,7 @@ class DataSource;
 class Tile;
 struct TileData;
 class StyleBuilder;
+class TileTask;
 
 class TileBuilder {
 
@@ -21,13 +22,34 @@ public:
 
     ~TileBuilder();
 
+    // Rebinds this builder to @_scene in place, keeping the duktape heap
+    // and any compiled functions that the new scene shares with the old
+    // one. Returns the previous scene, whose GL resources the caller must
+    // release on the main thread.
+    std::shared_ptr<Scene> setScene(std::shared_ptr<Scene> _scene);
+
     StyleBuilder* getStyleBuilder(const std::string& _name);
 
+    // Resolves the StyleBuilder for a matched rule. Rules were bound
+    // to style indices at scene compile time, so the per-feature hot
+    // path is an array index; only rules carrying an explicit 'style'
+    // parameter still resolve by name.
+    StyleBuilder* getStyleBuilder(const DrawRule& _rule);
+
     std::shared_ptr<Tile> build(TileID _tileID, const TileData& _data, const DataSource& _source);
 
+    // Build variant used by TileWorker: _task serves as cancellation
+    // token, checked between build stages so a build whose tile has
+    // left the viewport aborts early and returns null.
+    std::shared_ptr<Tile> build(TileTask& _task, const TileData& _data, const DataSource& _source);
+
     const Scene& scene() const { return *m_scene; }
 
 private:
+
+    std::shared_ptr<Tile> build(TileID _tileID, const TileData& _data,
+                                const DataSource& _source, TileTask* _task);
+
     std::shared_ptr<Scene> m_scene;
 
     StyleContext m_styleContext;
@@ -35,7 +57,15 @@ private:
 
     LabelCollider m_labelLayout;
 
-    fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
+    hashmap<std::unique_ptr<StyleBuilder>> m_styleBuilder;
+
+    // Layers grouped by source name, flattened in setScene(). The scene
+    // is immutable between setScene() calls, so builds read these plain
+    // arrays without touching the scene.
+    hashmap<std::vector<const DataLayer*>> m_sourceLayers;
+
+    // StyleBuilders indexed by style id, in scene style order
+    std::vector<StyleBuilder*> m_styleBuilderByStyle;
 };
 
 }
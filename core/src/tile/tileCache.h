@@ -3,7 +3,9 @@
 #include "tile/tile.h"
 #include "tile/tileHash.h"
 #include "tile/tileID.h"
+#include "util/memoryBudget.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <list>
 #include <memory>
@@ -31,6 +33,8 @@ class TileCache {
     struct CacheEntry {
         TileCacheKey key;
         std::shared_ptr<Tile> tile;
+        // Position in the entry's per-source key list, see m_sourceKeys
+        std::list<TileCacheKey>::iterator sourceIt;
     };
 
     using CacheList = std::list<CacheEntry>;
@@ -45,9 +49,14 @@ public:
     std::vector<TileID> put(int32_t _sourceId, std::shared_ptr<Tile> _tile) {
         TileCacheKey k(_sourceId, _tile->getID());
 
-        m_cacheList.push_front({k, _tile});
+        auto& sourceKeys = m_sourceKeys[_sourceId];
+        sourceKeys.push_front(k);
+
+        m_cacheList.push_front({k, _tile, sourceKeys.begin()});
         m_cacheMap[k] = m_cacheList.begin();
         m_cacheUsage += _tile->getMemoryUsage();
+        m_sourceUsage[_sourceId] += _tile->getMemoryUsage();
+        MemoryBudget::add(MemoryBudget::meshes, _tile->getMemoryUsage());
 
         return limitCacheSize(m_cacheMaxUsage);
     }
@@ -58,10 +67,12 @@ public:
 
         auto it = m_cacheMap.find(k);
         if (it != m_cacheMap.end()) {
+            unlinkSource(*(it->second));
             std::swap(tile, (*(it->second)).tile);
             m_cacheList.erase(it->second);
             m_cacheMap.erase(it);
             m_cacheUsage -= tile->getMemoryUsage();
+            MemoryBudget::remove(MemoryBudget::meshes, tile->getMemoryUsage());
         }
         return tile;
     }
@@ -78,10 +89,17 @@ public:
     }
 
     std::vector<TileID> limitCacheSize(size_t _cacheSizeBytes) {
-        std::vector<TileID> poppedTileIDs;
         m_cacheMaxUsage = _cacheSizeBytes;
 
-        while (m_cacheUsage > m_cacheMaxUsage) {
+        return trimToSize(m_cacheMaxUsage);
+    }
+
+    /* Evicts least recently used tiles until at most _maxBytes are held;
+     * keeps the configured cache limit unchanged. */
+    std::vector<TileID> trimToSize(size_t _maxBytes) {
+        std::vector<TileID> poppedTileIDs;
+
+        while (size_t(m_cacheUsage) > _maxBytes) {
             if (m_cacheList.empty()) {
                 LOGE("Invalid cache state!");
                 m_cacheUsage = 0;
@@ -90,12 +108,16 @@ public:
             auto& tile = m_cacheList.back().tile;
             poppedTileIDs.push_back(tile->getID());
             m_cacheUsage -= tile->getMemoryUsage();
+            MemoryBudget::remove(MemoryBudget::meshes, tile->getMemoryUsage());
+            unlinkSource(m_cacheList.back());
             m_cacheMap.erase(m_cacheList.back().key);
             m_cacheList.pop_back();
         }
         return poppedTileIDs;
     }
 
+    size_t getMaxUsage() const { return m_cacheMaxUsage; }
+
     size_t getMemoryUsage() const {
         size_t sum = 0;
         for (auto& entry : m_cacheList) {
@@ -104,16 +126,70 @@ public:
         return sum;
     }
 
+    size_t getMemoryUsagePerSource(int32_t _sourceId) const {
+        auto it = m_sourceUsage.find(_sourceId);
+        return it != m_sourceUsage.end() ? it->second : 0;
+    }
+
     void clear() {
         m_cacheMap.clear();
         m_cacheList.clear();
+        m_sourceKeys.clear();
+        m_sourceUsage.clear();
+        if (m_cacheUsage > 0) {
+            MemoryBudget::remove(MemoryBudget::meshes, m_cacheUsage);
+        }
         m_cacheUsage = 0;
     }
 
+    /* Drops only the entries of one source, touching no others */
+    void clear(int32_t _sourceId) {
+        auto keys = m_sourceKeys.find(_sourceId);
+        if (keys == m_sourceKeys.end()) { return; }
+
+        for (const auto& key : keys->second) {
+            auto it = m_cacheMap.find(key);
+            if (it == m_cacheMap.end()) { continue; }
+
+            auto& tile = it->second->tile;
+            m_cacheUsage -= tile->getMemoryUsage();
+            MemoryBudget::remove(MemoryBudget::meshes, tile->getMemoryUsage());
+            m_cacheList.erase(it->second);
+            m_cacheMap.erase(it);
+        }
+        m_sourceKeys.erase(keys);
+        m_sourceUsage.erase(_sourceId);
+    }
+
 private:
+
+    // Remove the entry from the per-source index and byte accounting
+    void unlinkSource(const CacheEntry& _entry) {
+        int32_t sourceId = _entry.key.first;
+
+        auto keys = m_sourceKeys.find(sourceId);
+        if (keys == m_sourceKeys.end()) { return; }
+
+        keys->second.erase(_entry.sourceIt);
+
+        size_t bytes = _entry.tile->getMemoryUsage();
+        auto& usage = m_sourceUsage[sourceId];
+        usage -= std::min(bytes, usage);
+
+        if (keys->second.empty()) {
+            m_sourceKeys.erase(keys);
+            m_sourceUsage.erase(sourceId);
+        }
+    }
+
     CacheMap m_cacheMap;
     CacheList m_cacheList;
 
+    // Keys and byte usage of each source's entries, letting
+    // per-source operations touch only that source's entries
+    std::unordered_map<int32_t, std::list<TileCacheKey>> m_sourceKeys;
+    std::unordered_map<int32_t, size_t> m_sourceUsage;
+
     int m_cacheUsage;
     int m_cacheMaxUsage;
 };
@@ -5,10 +5,12 @@
 #include "tile/tile.h"
 #include "tileCache.h"
 #include "util/mapProjection.h"
+#include "util/memoryBudget.h"
 
 #include "glm/gtx/norm.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 #define DBG(...) // LOGD(__VA_ARGS__)
 
@@ -16,13 +18,17 @@ namespace Tangram {
 
 TileManager::TileManager(TileTaskQueue& _tileWorker) : m_workers(_tileWorker) {
 
-    m_tileCache = std::unique_ptr<TileCache>(new TileCache(DEFAULT_CACHE_SIZE));
+    m_tileCache = std::make_shared<TileCache>(DEFAULT_CACHE_SIZE);
+
+    MemoryBudget::setBudget(MemoryBudget::meshes, DEFAULT_CACHE_SIZE);
+    MemoryBudget::setBudget(MemoryBudget::rawTiles, DEFAULT_RAW_CACHE_BUDGET);
+    MemoryBudget::setTotalBudget(DEFAULT_TOTAL_BUDGET);
 
     // Callback to pass task from Download-Thread to Worker-Queue
     m_dataCallback = TileTaskCb{[this](std::shared_ptr<TileTask>&& task) {
 
          if (task->isReady()) {
-             requestRender();
+             requestRender(RenderDirty::full);
 
         } else if (task->hasData()) {
             m_workers.enqueue(std::move(task));
@@ -37,9 +43,18 @@ TileManager::~TileManager() {
     m_tileSets.clear();
 }
 
-void TileManager::setDataSources(const std::vector<std::shared_ptr<DataSource>>& _sources) {
+void TileManager::setDataSources(const std::vector<std::shared_ptr<DataSource>>& _sources,
+                                 const std::vector<std::string>* _rebuildSources) {
 
-    m_tileCache->clear();
+    auto needsRebuild = [&](const std::string& _name) {
+        if (!_rebuildSources) { return true; }
+        return std::find(_rebuildSources->begin(), _rebuildSources->end(),
+                         _name) != _rebuildSources->end();
+    };
+
+    if (!_rebuildSources) {
+        m_tileCache->clear();
+    }
 
     // remove sources that are not in new scene - there must be a better way..
     auto it = std::remove_if(
@@ -51,15 +66,23 @@ void TileManager::setDataSources(const std::vector<std::shared_ptr<DataSource>>&
 
                 if (sIt == _sources.end() || !(*sIt)->generateGeometry()) {
                     DBG("remove source %s", tileSet.source->name().c_str());
+                    m_tileCache->clear(tileSet.source->id());
                     return true;
                 }
             }
-            // Clear cache
-            tileSet.tiles.clear();
+            // Clear tiles, unless the scene update leaves this
+            // source's geometry untouched
+            if (needsRebuild(tileSet.source->name())) {
+                tileSet.tiles.clear();
+                if (_rebuildSources) {
+                    m_tileCache->clear(tileSet.source->id());
+                }
+            }
             return false;
         });
 
     m_tileSets.erase(it, m_tileSets.end());
+    m_tilesDirty = true;
 
     // add new sources
     for (const auto& source : _sources) {
@@ -79,6 +102,7 @@ void TileManager::setDataSources(const std::vector<std::shared_ptr<DataSource>>&
 
 void TileManager::addClientDataSource(std::shared_ptr<DataSource> _dataSource) {
     m_tileSets.push_back({ _dataSource, true });
+    m_tilesDirty = true;
 }
 
 bool TileManager::removeClientDataSource(DataSource& dataSource) {
@@ -90,6 +114,7 @@ bool TileManager::removeClientDataSource(DataSource& dataSource) {
             // Remove the tile set associated with this data source
             it = m_tileSets.erase(it);
             removed = true;
+            m_tilesDirty = true;
         } else {
             ++it;
         }
@@ -103,6 +128,7 @@ void TileManager::clearTileSets() {
     }
 
     m_tileCache->clear();
+    m_tilesDirty = true;
 }
 
 void TileManager::clearTileSet(int32_t _sourceId) {
@@ -111,12 +137,47 @@ void TileManager::clearTileSet(int32_t _sourceId) {
         tileSet.tiles.clear();
     }
 
-    m_tileCache->clear();
+    m_tileCache->clear(_sourceId);
     m_tileSetChanged = true;
+    m_tilesDirty = true;
 }
 
 void TileManager::updateTileSets(const ViewState& _view,
-                                 const std::set<TileID>& _visibleTiles) {
+                                 const std::set<TileID>& _visibleTiles,
+                                 float _budgetMs) {
+
+    m_hasUpdateDeadline = _budgetMs > 0.f;
+    if (m_hasUpdateDeadline) {
+        m_updateDeadline = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(int64_t(_budgetMs * 1000.f));
+    }
+
+    m_zooming = std::abs(_view.zoom - m_lastZoom) > MAX_SETTLED_ZOOM_DELTA;
+    m_lastZoom = _view.zoom;
+
+    // Steady state: every tile settled on the last pass, no source or
+    // cache was touched since and the visible set is unchanged - the
+    // tile list from the last update remains valid, skip the per-tile
+    // bookkeeping entirely.
+    if (m_updateSettled && !m_tilesDirty && _visibleTiles == m_lastVisibleTiles) {
+        bool sourceChanged = false;
+        for (auto& tileSet : m_tileSets) {
+            if (tileSet.sourceGeneration != tileSet.source->generation()) {
+                sourceChanged = true;
+                break;
+            }
+        }
+        if (!sourceChanged) {
+            m_tileSetChanged = false;
+            return;
+        }
+    }
+
+    m_lastVisibleTiles = _visibleTiles;
+    m_tilesDirty = false;
+    m_updateSettled = true;
+    m_updateSerial++;
+
     m_tiles.clear();
     m_loadPending = 0;
     m_tilesInProgress = 0;
@@ -126,8 +187,38 @@ void TileManager::updateTileSets(const ViewState& _view,
         updateTileSet(tileSet, _view, _visibleTiles);
     }
 
+    addPrefetchTasks(_view);
+
     loadTiles();
 
+    // Coordinated eviction: when the whole pipeline exceeds its total
+    // budget, drop raw downloads first - they can be restored from the
+    // disk cache or network - then cached meshes.
+    size_t over = MemoryBudget::overTotalBudget();
+    if (over > 0) {
+        for (auto& tileSet : m_tileSets) {
+            size_t usage = tileSet.source->rawCacheUsage();
+            if (usage == 0) { continue; }
+
+            size_t drop = std::min(usage, over);
+            tileSet.source->trimRawCacheTo(usage - drop);
+            over -= drop;
+            if (over == 0) { break; }
+        }
+
+        if (over > 0) {
+            size_t usage = m_tileCache->getMemoryUsage();
+            if (usage > 0) {
+                auto popped = m_tileCache->trimToSize(usage > over ? usage - over : 0);
+                for (const auto& id : popped) {
+                    for (auto& tileSet : m_tileSets) {
+                        tileSet.source->clearRaster(id);
+                    }
+                }
+            }
+        }
+    }
+
     // Make m_tiles an unique list of tiles for rendering sorted from
     // high to low zoom-levels.
     std::sort(m_tiles.begin(), m_tiles.end(), [](auto& a, auto& b){
@@ -155,17 +246,67 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
     auto& tiles = _tileSet.tiles;
 
     // Check for ready tasks, move Tile to active TileSet and unset Proxies.
+    std::vector<TileEntry*> completed;
+
     for (auto& it : tiles) {
         auto& entry = it.second;
         if (entry.newData()) {
-            clearProxyTiles(_tileSet, it.first, entry, removeTiles);
-            entry.task->complete();
+            completed.push_back(&entry);
 
-            entry.tile = std::move(entry.task->tile());
-            entry.task.reset();
-            newTiles = true;
+        } else if (entry.task && !entry.isReady()) {
+            // The geometry-only tile from the first build phase stands in
+            // while labels and detail are still built on the worker; the
+            // finished tile replaces it once its task completes.
+            if (auto& partial = entry.task->partialTile()) {
+                entry.tile = partial;
+                newTiles = true;
 
-            m_tileSetChanged = true;
+                m_tileSetChanged = true;
+            }
+        }
+    }
+
+    // Finalize finished builds nearest-first, so that when the update
+    // deadline cuts a burst short, the tiles around the view center
+    // land first.
+    if (completed.size() > 1) {
+        std::sort(completed.begin(), completed.end(), [](auto* a, auto* b) {
+                return a->task->getPriority() < b->task->getPriority();
+            });
+    }
+
+    int32_t deferred = 0;
+    for (auto* entry : completed) {
+        if (m_hasUpdateDeadline &&
+            std::chrono::steady_clock::now() > m_updateDeadline) {
+            // Out of time - the task stays ready and is finalized on a
+            // later frame; its proxies keep standing in meanwhile.
+            deferred++;
+            continue;
+        }
+        entry->task->complete();
+
+        entry->tile = std::move(entry->task->tile());
+        entry->task.reset();
+        newTiles = true;
+
+        m_tileSetChanged = true;
+    }
+
+    if (deferred > 0) {
+        m_tilesInProgress += deferred;
+        m_tilesDirty = true;
+        requestRender(RenderDirty::full);
+    }
+
+    for (auto& it : tiles) {
+        auto& entry = it.second;
+
+        // Proxies stand in until the render thread has staged the
+        // tile's meshes; uploads are spread over frames with a byte
+        // budget, so a burst of built tiles fades in without a gap.
+        if (entry.isReady() && entry.m_proxies != 0 && entry.tile->isGlReady()) {
+            clearProxyTiles(_tileSet, it.first, entry, removeTiles);
         }
     }
 
@@ -179,96 +320,101 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
         visibleTiles = &mappedTiles;
     }
 
-    // Loop over visibleTiles and add any needed tiles to tileSet
-    auto curTilesIt = tiles.begin();
-    auto visTilesIt = visibleTiles->begin();
-
     auto generation = _tileSet.source->generation();
 
-    while (visTilesIt != visibleTiles->end() || curTilesIt != tiles.end()) {
-
-        auto& visTileId = visTilesIt == visibleTiles->end()
-            ? NOT_A_TILE : *visTilesIt;
-
-        auto& curTileId = curTilesIt == tiles.end()
-            ? NOT_A_TILE : curTilesIt->first;
-
-        if (visTileId == curTileId) {
-            // tiles in both sets match
-            assert(visTilesIt != visibleTiles->end() &&
-                   curTilesIt != tiles.end());
-
-            auto& entry = curTilesIt->second;
-            entry.setVisible(true);
+    // Loop over visibleTiles and add any needed tiles to tileSet
+    for (const auto& visTileId : *visibleTiles) {
 
-            if (entry.isReady()) {
-                m_tiles.push_back(entry.tile);
+        auto curTilesIt = tiles.find(visTileId);
 
-                if (!entry.isLoading() &&
-                    (entry.tile->sourceGeneration() < generation)) {
-                    // Tile needs update - enqueue for loading
-                    enqueueTask(_tileSet, visTileId, _view);
-                }
-            } else {
+        if (curTilesIt == tiles.end()) {
+            // tileSet is missing an element present in visibleTiles
+            bool cached = addTile(_tileSet, visTileId);
 
-                if (entry.isLoading() && entry.rastersPending() == 0) {
-                    if (newTiles) {
-                        // check again for proxies
-                        updateProxyTiles(_tileSet, visTileId, entry);
-                    }
-                    m_tilesInProgress++;
-                } else if (!bool(entry.task) ||
-                           (entry.rastersPending() > 0 && !entry.isCanceled()) ||
-                           (entry.isCanceled() && (entry.task->sourceGeneration() < generation))) {
-                    // Start loading when:
-                    // no task is set,
-                    // one of the raster for this task has not been loaded yet
-                    // or the task stems from an older tile source generation.
+            auto& entry = tiles.find(visTileId)->second;
+            entry.m_seen = m_updateSerial;
 
-                    // Not yet available - enqueue for loading
+            if (!cached) {
+                if (m_zooming && entry.m_proxies != 0) {
+                    // Covered by a proxy - defer the build until the view
+                    // settles
+                } else {
+                    // Not in cache - enqueue for loading
                     enqueueTask(_tileSet, visTileId, _view);
-
-                    m_tilesInProgress++;
                 }
+                m_tilesInProgress++;
             }
+            continue;
+        }
 
-            ++curTilesIt;
-            ++visTilesIt;
+        auto& entry = curTilesIt->second;
+        entry.m_seen = m_updateSerial;
+        entry.setVisible(true);
+        if (entry.isPrefetch()) {
+            // The prediction came true - from here the tile is
+            // handled like any other visible tile
+            entry.setPrefetch(false);
+        }
 
-        } else if (curTileId > visTileId) {
-            // tileSet is missing an element present in visibleTiles
-            // NB: if (curTileId == NOT_A_TILE) it is always > visTileId
-            //     and if curTileId > visTileId, then visTileId cannot be
-            //     NOT_A_TILE. (for the current implementation of > operator)
-            assert(visTilesIt != visibleTiles->end());
+        if (entry.isReady()) {
+            m_tiles.push_back(entry.tile);
 
-            if (!addTile(_tileSet, visTileId)) {
-                // Not in cache - enqueue for loading
+            if (!entry.isLoading() &&
+                (entry.tile->sourceGeneration() < generation)) {
+                // Tile needs update - enqueue for loading
                 enqueueTask(_tileSet, visTileId, _view);
-                m_tilesInProgress++;
             }
+        } else {
 
-            ++visTilesIt;
+            if (entry.isLoading() && entry.rastersPending() == 0) {
+                if (newTiles) {
+                    // check again for proxies
+                    updateProxyTiles(_tileSet, visTileId, entry);
+                }
+                m_tilesInProgress++;
+            } else if (!bool(entry.task) ||
+                       (entry.rastersPending() > 0 && !entry.isCanceled()) ||
+                       (entry.isCanceled() && (entry.task->sourceGeneration() < generation))) {
+                // Start loading when:
+                // no task is set,
+                // one of the raster for this task has not been loaded yet
+                // or the task stems from an older tile source generation.
+
+                if (m_zooming && !bool(entry.task) && entry.m_proxies != 0) {
+                    // The proxy stands in for this tile as long as the
+                    // zoom keeps moving - defer the build until the
+                    // view settles
+                } else {
+                    // Not yet available - enqueue for loading
+                    enqueueTask(_tileSet, visTileId, _view);
+                }
 
-        } else {
-            // tileSet has a tile not present in visibleTiles
-            assert(curTilesIt != tiles.end());
+                m_tilesInProgress++;
+            }
+        }
+    }
 
-            auto& entry = curTilesIt->second;
+    // Handle tiles that are not part of the visible set anymore
+    for (auto& it : tiles) {
+        auto& entry = it.second;
+        if (entry.m_seen == m_updateSerial) { continue; }
 
-            if (entry.getProxyCounter() > 0) {
-                if (entry.isReady()) {
-                    m_tiles.push_back(entry.tile);
-                } else if (curTileId.z < maxZoom) {
-                    // Cancel loading
-                    removeTiles.push_back(curTileId);
-                }
-            } else {
-                removeTiles.push_back(curTileId);
+        if (entry.getProxyCounter() > 0) {
+            if (entry.isReady()) {
+                m_tiles.push_back(entry.tile);
+            } else if (it.first.z < maxZoom) {
+                // Cancel loading
+                removeTiles.push_back(it.first);
             }
-            entry.setVisible(false);
-            ++curTilesIt;
+        } else if (entry.isPrefetch() && entry.isLoading() &&
+                   m_prefetchTiles.find(it.first) != m_prefetchTiles.end()) {
+            // Still predicted to come into view - keep loading.
+            // Ready prefetched tiles take the removal path below and
+            // wait in the tile cache instead.
+        } else {
+            removeTiles.push_back(it.first);
         }
+        entry.setVisible(false);
     }
 
     while (!removeTiles.empty()) {
@@ -289,6 +435,15 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
     for (auto& it : tiles) {
         auto& entry = it.second;
 
+        if (!entry.isReady() || entry.task ||
+            entry.m_proxies != 0 || entry.getProxyCounter() > 0 ||
+            entry.tile->sourceGeneration() < _tileSet.sourceGeneration) {
+            // Loads, pending builds, proxy stand-ins and stale tiles
+            // need another pass, as do entries whose download was
+            // deferred by the MAX_DOWNLOADS limit
+            m_updateSettled = false;
+        }
+
         size_t rasterLoading = 0;
         size_t rasterDone = 0;
 
@@ -318,7 +473,10 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             auto tileCenter = _view.mapProjection.TileCenter(id);
             double scaleDiv = exp2(id.z - _view.zoom);
             if (scaleDiv < 1) { scaleDiv = 0.1/scaleDiv; } // prefer parent tiles
-            task->setPriority(glm::length2(tileCenter - _view.center) * scaleDiv);
+            double priority = glm::length2(tileCenter - _view.center) * scaleDiv;
+            // Speculative tiles yield to anything visible
+            if (entry.isPrefetch()) { priority *= 4.0; }
+            task->setPriority(priority);
             task->setProxyState(entry.getProxyCounter() > 0);
 
             // Count tiles that are currently being downloaded to
@@ -354,6 +512,51 @@ void TileManager::enqueueTask(TileSet& _tileSet, const TileID& _tileID,
     m_loadTasks.insert(it, std::make_tuple(distance, &_tileSet, _tileID));
 }
 
+void TileManager::addPrefetchTasks(const ViewState& _view) {
+
+    if (m_prefetchTiles.empty()) { return; }
+
+    // Completed prefetches wait in the byte-limited tile cache; stop
+    // fetching when there is no headroom left for them, so speculative
+    // tiles never evict recently used ones.
+    if (m_tileCache->getMemoryUsage() + PREFETCH_CACHE_HEADROOM >
+        m_tileCache->getMaxUsage()) {
+        return;
+    }
+
+    // Count prefetched tiles that are already on their way
+    int pending = 0;
+    for (auto& tileSet : m_tileSets) {
+        for (auto& it : tileSet.tiles) {
+            if (it.second.isPrefetch() && it.second.isLoading()) { pending++; }
+        }
+    }
+
+    for (auto& tileSet : m_tileSets) {
+        auto maxSourceZoom = tileSet.source->maxZoom();
+
+        for (const auto& id : m_prefetchTiles) {
+            if (pending >= MAX_PREFETCH_DOWNLOADS) { return; }
+
+            auto tileId = id;
+            if (tileId.z > maxSourceZoom) {
+                tileId = tileId.withMaxSourceZoom(maxSourceZoom);
+            }
+
+            // Skip tiles that are visible, loading or already built
+            if (tileSet.tiles.find(tileId) != tileSet.tiles.end()) { continue; }
+            if (m_tileCache->contains(tileSet.source->id(), tileId)) { continue; }
+
+            auto entry = tileSet.tiles.emplace(tileId, TileEntry{});
+            if (!entry.second) { continue; }
+
+            entry.first->second.setPrefetch(true);
+            enqueueTask(tileSet, tileId, _view);
+            pending++;
+        }
+    }
+}
+
 // create and download raster references store these
 // rastertasks in this datasource' task
 void TileManager::loadSubTasks(std::vector<std::shared_ptr<DataSource>>& _subSources,
@@ -378,7 +581,7 @@ void TileManager::loadSubTasks(std::vector<std::shared_ptr<DataSource>>& _subSou
         auto subTask = subSource->createTask(subTileID, index);
         if (subTask->isReady()) {
             subTasks.insert(it, subTask);
-            requestRender();
+            requestRender(RenderDirty::full);
 
         } else if (subTask->hasData()) {
             subTasks.insert(it, subTask);
@@ -394,7 +597,7 @@ void TileManager::loadSubTasks(std::vector<std::shared_ptr<DataSource>>& _subSou
                 // dependent raster's loading failed..
                 // this subTask's rasterReady must have been set with black texture
                 assert(subTask->isReady());
-                requestRender();
+                requestRender(RenderDirty::full);
             }
         }
     }
@@ -417,6 +620,7 @@ void TileManager::loadTiles() {
         }
 
         auto task = tileSet.source->createTask(tileId);
+        task->timing().start = std::chrono::steady_clock::now();
 
         if (task->hasData()) {
             // Note: Set implicit 'loading' state
@@ -449,6 +653,26 @@ bool TileManager::addTile(TileSet& _tileSet, const TileID& _tileID) {
 
     auto tile = m_tileCache->get(_tileSet.source->id(), _tileID);
 
+    // Overzoomed tiles tessellate the identical source data at every
+    // styling zoom - only s differs, and the shaders scale widths and
+    // sizes from u_tile_origin. A variant cached at a neighboring zoom
+    // can thus be re-keyed and reused, so a continuous zoom over the
+    // source's max zoom stops rebuilding the same tiles each level.
+    if (!tile && _tileID.s != _tileID.z) {
+        for (int ds : { -1, 1 }) {
+            TileID variantID = _tileID;
+            variantID.s = _tileID.s + ds;
+            if (variantID.s < variantID.z) { continue; }
+
+            if (auto variant = m_tileCache->get(_tileSet.source->id(), variantID)) {
+                variant->setStyleZoom(_tileID.s);
+                // Source generation is checked below with the rest
+                tile = std::move(variant);
+                break;
+            }
+        }
+    }
+
     if (tile) {
         if (tile->sourceGeneration() == _tileSet.source->generation()) {
             m_tiles.push_back(tile);
@@ -491,10 +715,13 @@ void TileManager::removeTile(TileSet& _tileSet, std::map<TileID, TileEntry>::ite
         _tileSet.source->cancelLoadingTile(id);
 
     } else if (entry.isReady()) {
-        // Add to cache
-        auto poppedTiles = m_tileCache->put(_tileSet.source->id(), entry.tile);
-        for (auto& tileID : poppedTiles) {
-            _tileSet.source->clearRaster(tileID);
+        // Add to cache - unless this is the partial tile of a canceled
+        // task, which never got its labels and must not be reused
+        if (!(entry.task && entry.tile == entry.task->partialTile())) {
+            auto poppedTiles = m_tileCache->put(_tileSet.source->id(), entry.tile);
+            for (auto& tileID : poppedTiles) {
+                _tileSet.source->clearRaster(tileID);
+            }
         }
     }
 
@@ -608,7 +835,30 @@ void TileManager::clearProxyTiles(TileSet& _tileSet, const TileID& _tileID, Tile
 }
 
 void TileManager::setCacheSize(size_t _cacheSize) {
+    MemoryBudget::setBudget(MemoryBudget::meshes, _cacheSize);
     m_tileCache->limitCacheSize(_cacheSize);
 }
 
+void TileManager::releaseCachedMemory(size_t _tileCacheBytes, bool _dropRawCaches) {
+    auto popped = m_tileCache->trimToSize(_tileCacheBytes);
+    for (const auto& id : popped) {
+        for (auto& tileSet : m_tileSets) {
+            tileSet.source->clearRaster(id);
+        }
+    }
+
+    for (auto& tileSet : m_tileSets) {
+        tileSet.source->clearDecodedPixels();
+        if (_dropRawCaches) {
+            tileSet.source->trimRawCacheTo(0);
+        }
+    }
+}
+
+void TileManager::setTileCache(std::shared_ptr<TileCache> _cache) {
+    if (!_cache) { return; }
+    m_tileCache = std::move(_cache);
+    m_tilesDirty = true;
+}
+
 }
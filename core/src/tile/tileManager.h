@@ -4,10 +4,12 @@
 #include "tile/tileWorker.h"
 #include "tile/tile.h"
 #include "tile/tileID.h"
+#include "tile/tileHash.h"
 #include "tileTask.h"
 #include "util/fastmap.h"
 
-#include <map>
+#include <chrono>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <mutex>
@@ -35,7 +37,17 @@ struct ViewState {
 class TileManager {
 
     const static size_t DEFAULT_CACHE_SIZE = 32*1024*1024; // 32 MB
+    // Shared budget for raw downloads across all sources and for the
+    // whole pipeline (raw tiles, meshes and textures together)
+    const static size_t DEFAULT_RAW_CACHE_BUDGET = 32*1024*1024;
+    const static size_t DEFAULT_TOTAL_BUDGET = 128*1024*1024;
     const static int MAX_DOWNLOADS = 4;
+    // Byte headroom the tile cache must have left before speculative
+    // tiles are fetched, and the concurrent prefetch load limit.
+    const static size_t PREFETCH_CACHE_HEADROOM = 8*1024*1024; // 8 MB
+    const static int MAX_PREFETCH_DOWNLOADS = 2;
+    // Zoom change per frame below which the view counts as settled
+    constexpr static float MAX_SETTLED_ZOOM_DELTA = 0.02f;
 
 public:
 
@@ -43,11 +55,33 @@ public:
 
     virtual ~TileManager();
 
-    /* Sets the tile DataSources */
-    void setDataSources(const std::vector<std::shared_ptr<DataSource>>& _sources);
-
-    /* Updates visible tile set and load missing tiles */
-    void updateTileSets(const ViewState& _view, const std::set<TileID>& _visibleTiles);
+    /* Sets the tile DataSources. When _rebuildSources is given, only
+     * the tiles and cache entries of the named sources are dropped;
+     * everything else keeps its built tiles, so a scene update scoped
+     * to one layer rebuilds only that layer's source. Without it all
+     * tiles are rebuilt. */
+    void setDataSources(const std::vector<std::shared_ptr<DataSource>>& _sources,
+                        const std::vector<std::string>* _rebuildSources = nullptr);
+
+    /* Updates visible tile set and load missing tiles. With a positive
+     * @_budgetMs, finished tile builds are finalized nearest-first only
+     * until the deadline passes and the remainder carries over to the
+     * next call, so a burst of completed builds cannot blow the frame
+     * budget; proxies keep standing in for the deferred tiles. */
+    void updateTileSets(const ViewState& _view, const std::set<TileID>& _visibleTiles,
+                        float _budgetMs = 0.f);
+
+    /* Sets tiles expected to become visible soon, e.g. extrapolated from
+     * the pan/zoom velocity by View::getPrefetchTiles(). They are loaded
+     * at reduced priority by the next updateTileSets() call and completed
+     * tiles wait in the tile cache, so motion reveals built tiles.
+     */
+    void setPrefetchTiles(std::set<TileID> _prefetchTiles) {
+        if (_prefetchTiles != m_prefetchTiles) {
+            m_prefetchTiles = std::move(_prefetchTiles);
+            m_tilesDirty = true;
+        }
+    }
 
     void clearTileSets();
 
@@ -64,7 +98,13 @@ public:
 
     bool removeClientDataSource(DataSource& dataSource);
 
-    std::unique_ptr<TileCache>& getTileCache() { return m_tileCache; }
+    std::shared_ptr<TileCache>& getTileCache() { return m_tileCache; }
+
+    /* Replace the tile cache with one shared with another TileManager.
+     * Tiles either manager drops from its visible set become available
+     * to the other, so map views with overlapping viewports reuse
+     * built tiles instead of rebuilding them. */
+    void setTileCache(std::shared_ptr<TileCache> _cache);
 
     const auto& getTileSets() { return m_tileSets; }
 
@@ -73,6 +113,13 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* Immediately releases cached memory in response to external memory
+     * pressure: trims the tile cache to at most @_tileCacheBytes and drops
+     * every source's decoded raster pixels; with @_dropRawCaches the raw
+     * download caches are emptied too. The configured cache limits are
+     * unchanged, so the caches refill once the pressure passes. */
+    void releaseCachedMemory(size_t _tileCacheBytes, bool _dropRawCaches);
+
 private:
 
     enum class ProxyID : uint8_t {
@@ -165,6 +212,10 @@ private:
         }
 
         bool m_visible = false;
+        bool m_prefetch = false;
+
+        /* Update pass that last found this entry in the visible set */
+        uint32_t m_seen = 0;
 
         /* Method to check whther this tile is in the current set of visible tiles
          * determined by view::updateTiles().
@@ -176,6 +227,17 @@ private:
         void setVisible(bool _visible) {
             m_visible = _visible;
         }
+
+        /* Whether this tile was requested speculatively ahead of the
+         * viewport and is not (yet) part of the visible set.
+         */
+        bool isPrefetch() const {
+            return m_prefetch;
+        }
+
+        void setPrefetch(bool _prefetch) {
+            m_prefetch = _prefetch;
+        }
     };
 
     struct TileSet {
@@ -183,7 +245,7 @@ private:
             : source(_source), clientDataSource(_clientDataSource) {}
 
         std::shared_ptr<DataSource> source;
-        std::map<TileID, TileEntry> tiles;
+        std::unordered_map<TileID, TileEntry> tiles;
         int64_t sourceGeneration = 0;
         bool clientDataSource;
     };
@@ -192,6 +254,9 @@ private:
 
     void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view);
 
+    // Enqueue load tasks for the current prefetch tile set
+    void addPrefetchTasks(const ViewState& _view);
+
     void loadTiles();
     void loadSubTasks(std::vector<std::shared_ptr<DataSource>>& subSources, std::shared_ptr<TileTask>& tileTask,
                       const TileID& tileID);
@@ -206,7 +271,7 @@ private:
     /*
      * Removes a tile from m_tileSet
      */
-    void removeTile(TileSet& _tileSet, std::map<TileID, TileEntry>::iterator& _tileIter);
+    void removeTile(TileSet& _tileSet, std::unordered_map<TileID, TileEntry>::iterator& _tileIter);
 
     /*
      * Checks and updates m_tileSet with proxy tiles for every new visible tile
@@ -229,7 +294,7 @@ private:
     /* Current tiles ready for rendering */
     std::vector<std::shared_ptr<Tile>> m_tiles;
 
-    std::unique_ptr<TileCache> m_tileCache;
+    std::shared_ptr<TileCache> m_tileCache;
 
     TileTaskQueue& m_workers;
 
@@ -243,6 +308,30 @@ private:
     /* Temporary list of tiles that need to be loaded */
     std::vector<std::tuple<double, TileSet*, TileID>> m_loadTasks;
 
+    /* Tiles predicted to become visible, set before updateTileSets() */
+    std::set<TileID> m_prefetchTiles;
+
+    /* While the zoom moves continuously, builds of tiles that are covered
+     * by a proxy are deferred until the view settles. */
+    float m_lastZoom = 0.f;
+    bool m_zooming = false;
+
+    /* Visible set of the last full update. While it is unchanged, all
+     * tiles are settled and no source or cache was touched from the
+     * outside, per-frame tile bookkeeping is skipped entirely. */
+    std::set<TileID> m_lastVisibleTiles;
+    bool m_updateSettled = false;
+    bool m_tilesDirty = true;
+
+    /* Stamp of the current update pass, marks TileEntries found in the
+     * visible set */
+    uint32_t m_updateSerial = 0;
+
+    /* Deadline of the current update pass; only set while a time
+     * budget was passed to updateTileSets() */
+    std::chrono::steady_clock::time_point m_updateDeadline;
+    bool m_hasUpdateDeadline = false;
+
 
 };
 
@@ -16,22 +16,37 @@ TileTask::TileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _su
 
 void TileTask::process(TileBuilder& _tileBuilder) {
 
-    auto tileData = m_source->parse(*this, *_tileBuilder.scene().mapProjection());
+    auto tileData = m_source->parseCached(*this, *_tileBuilder.scene().mapProjection());
 
     if (tileData) {
-        m_tile = _tileBuilder.build(m_tileId, *tileData, *m_source);
-    } else {
+        m_tile = _tileBuilder.build(*this, *tileData, *m_source);
+    }
+
+    // Either parsing failed or the build was aborted by cancellation.
+    if (!m_tile) {
         cancel();
     }
 }
 
 void TileTask::complete() {
 
+    // Hand the stage stamps to the tile; its first upload() closes
+    // the latency trace
+    m_tile->setLoadStamps(m_timing.start, m_timing.data, m_timing.built);
+
+    // Attach the second-phase meshes to the tile published by the first
+    // build phase. This runs on the update thread, which also renders,
+    // so the tile is safe to modify here.
+    for (auto& pending : m_pendingMeshes) {
+        m_tile->setMesh(*pending.first, std::move(pending.second));
+    }
+    m_pendingMeshes.clear();
+
     for (auto& subTask : m_subTasks) {
         assert(subTask->isReady());
         subTask->complete(*this);
     }
-    
+
 }
 
 }
@@ -2,6 +2,7 @@
 
 #include "tile/tileID.h"
 
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <functional>
@@ -14,6 +15,8 @@ class TileBuilder;
 class DataSource;
 class Tile;
 class MapProjection;
+class Style;
+struct StyledMesh;
 struct TileData;
 
 
@@ -35,11 +38,24 @@ public:
 
     std::shared_ptr<Tile>& tile() { return m_tile; }
 
+    // Geometry-only tile published by the first build phase, renderable
+    // while labels and detail are still being built on the worker.
+    std::shared_ptr<Tile>& partialTile() { return m_partialTile; }
+    void setPartialTile(std::shared_ptr<Tile> _tile) { m_partialTile = _tile; }
+
+    // Defers a second-phase mesh; it is attached to the published tile
+    // in complete(), on the main thread, where the tile is safe to touch.
+    void addPendingMesh(const Style& _style, std::unique_ptr<StyledMesh> _mesh) {
+        m_pendingMeshes.emplace_back(&_style, std::move(_mesh));
+    }
+
     DataSource& source() { return *m_source; }
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
     TileID tileId() const { return m_tileId; }
 
+    // May be called from any thread; a task checks this between
+    // build stages on the worker to abort stale builds early.
     void cancel() { m_canceled = true; }
     bool isCanceled() const { return m_canceled; }
 
@@ -58,6 +74,17 @@ public:
     int subTaskId() const { return m_subTaskId; }
     bool isSubTask() const { return m_subTaskId >= 0; }
 
+    // Stage stamps for the end-to-end latency trace; carried to the
+    // built Tile in complete() and recorded when its meshes are first
+    // staged for drawing, see debug/tileLatency.h
+    struct Timing {
+        std::chrono::steady_clock::time_point start; // load issued
+        std::chrono::steady_clock::time_point data;  // raw bytes available
+        std::chrono::steady_clock::time_point built; // worker build finished
+    };
+
+    Timing& timing() { return m_timing; }
+
     // running on worker thread
     virtual void process(TileBuilder& _tileBuilder);
 
@@ -84,10 +111,43 @@ protected:
     // Tile result, set when tile was  sucessfully created
     std::shared_ptr<Tile> m_tile;
 
-    bool m_canceled = false;
+    // See partialTile() / addPendingMesh()
+    std::shared_ptr<Tile> m_partialTile;
+    std::vector<std::pair<const Style*, std::unique_ptr<StyledMesh>>> m_pendingMeshes;
+
+    std::atomic<bool> m_canceled { false };
 
     std::atomic<double> m_priority;
     bool m_proxyState = false;
+
+    Timing m_timing;
+};
+
+// Shared immutable raw tile bytes. Views either a heap buffer or a
+// memory-mapped cache file; the backing storage is kept alive until
+// the last copy of the view is gone.
+class RawData {
+
+public:
+    RawData() {}
+
+    RawData(std::shared_ptr<std::vector<char>> _buffer)
+        : m_owner(_buffer),
+          m_data(_buffer ? _buffer->data() : nullptr),
+          m_size(_buffer ? _buffer->size() : 0) {}
+
+    RawData(std::shared_ptr<const void> _owner, const char* _data, size_t _size)
+        : m_owner(std::move(_owner)), m_data(_data), m_size(_size) {}
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    explicit operator bool() const { return m_data && m_size > 0; }
+
+private:
+    std::shared_ptr<const void> m_owner;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
 };
 
 class DownloadTileTask : public TileTask {
@@ -96,10 +156,10 @@ public:
         : TileTask(_tileId, _source, _subTask) {}
 
     virtual bool hasData() const override {
-        return rawTileData && !rawTileData->empty();
+        return bool(rawTileData);
     }
     // Raw tile data that will be processed by DataSource.
-    std::shared_ptr<std::vector<char>> rawTileData;
+    RawData rawTileData;
 };
 
 struct TileTaskQueue {
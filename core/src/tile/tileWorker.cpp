@@ -2,6 +2,8 @@
 
 #include "platform.h"
 #include "data/dataSource.h"
+#include "debug/buildTelemetry.h"
+#include "debug/trace.h"
 #include "tile/tileID.h"
 #include "tile/tileTask.h"
 #include "tile/tileBuilder.h"
@@ -11,18 +13,41 @@
 
 #define WORKER_NICENESS 10
 
+// Niceness while the user interacts with the map. Kept above the
+// render thread's priority so builds speed up without starving the
+// frame; on big.LITTLE devices this also steers workers onto the
+// big cores during the interaction.
+#define WORKER_NICENESS_INTERACTIVE 5
+
+// Builds the workers may run ahead of the render thread's upload
+// budget before they pause
+#define MAX_BUILD_AHEAD 4
+
+// Queued builds that justify waking another worker; below this per
+// worker, light loads stay on fewer cores
+#define PENDING_BUILDS_PER_WORKER 2
+
 namespace Tangram {
 
 TileWorker::TileWorker(int _num_worker) {
     m_running = true;
+    m_pendingTasks = 0;
+    m_enqueueIndex = 0;
+    m_niceness = WORKER_NICENESS;
+    m_activeLimit = _num_worker;
 
     m_mainThreadJobQueue.makeCurrentThreadTarget();
 
     for (int i = 0; i < _num_worker; i++) {
         auto worker = std::make_unique<Worker>();
-        worker->thread = std::thread(&TileWorker::run, this, worker.get());
+        worker->index = i;
         m_workers.push_back(std::move(worker));
     }
+    // Start threads only once all workers exist, so stealing never
+    // observes a partially constructed worker list.
+    for (auto& worker : m_workers) {
+        worker->thread = std::thread(&TileWorker::run, this, worker.get());
+    }
 }
 
 TileWorker::~TileWorker(){
@@ -44,27 +69,100 @@ void TileWorker::disposeBuilder(std::unique_ptr<TileBuilder> _builder) {
     }
 }
 
+std::shared_ptr<TileTask> TileWorker::takeBestTask(std::vector<std::shared_ptr<TileTask>>& _queue) {
+
+    // Remove all canceled tasks
+    auto removes = std::remove_if(_queue.begin(), _queue.end(),
+                                  [this](const auto& a) {
+                                      if (a->isCanceled()) {
+                                          m_pendingTasks--;
+                                          return true;
+                                      }
+                                      return false;
+                                  });
+
+    _queue.erase(removes, _queue.end());
+
+    if (_queue.empty()) {
+        return nullptr;
+    }
+
+    // Pop highest priority tile from queue
+    auto it = std::min_element(_queue.begin(), _queue.end(),
+        [](const auto& a, const auto& b) {
+            if (a->isProxy() != b->isProxy()) {
+                return !a->isProxy();
+            }
+            if (a->source().id() == b->source().id() &&
+                a->sourceGeneration() != b->sourceGeneration()) {
+                return a->sourceGeneration() < b->sourceGeneration();
+            }
+            return a->getPriority() < b->getPriority();
+        });
+
+    auto task = std::move(*it);
+    _queue.erase(it);
+    m_pendingTasks--;
+
+    return task;
+}
+
+std::shared_ptr<TileTask> TileWorker::popTask(Worker* _worker) {
+
+    {
+        std::unique_lock<std::mutex> lock(_worker->queueMutex);
+        if (auto task = takeBestTask(_worker->queue)) {
+            return task;
+        }
+    }
+
+    // Own queue is drained - try to steal from a sibling. try_lock
+    // keeps the common path free of cross-worker contention; a busy
+    // sibling is simply skipped.
+    for (auto& other : m_workers) {
+        if (other.get() == _worker) { continue; }
+
+        std::unique_lock<std::mutex> lock(other->queueMutex, std::try_to_lock);
+        if (!lock.owns_lock()) { continue; }
+
+        if (auto task = takeBestTask(other->queue)) {
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
 void TileWorker::run(Worker* instance) {
 
-    setCurrentThreadPriority(WORKER_NICENESS);
+    int niceness = m_niceness.load();
+    setCurrentThreadPriority(niceness);
 
     std::unique_ptr<TileBuilder> builder;
 
     while (true) {
 
-        std::shared_ptr<TileTask> task;
+        // Follow interaction-driven priority changes, see setInteractive()
+        if (m_niceness.load() != niceness) {
+            niceness = m_niceness.load();
+            setCurrentThreadPriority(niceness);
+        }
+
+        std::shared_ptr<Scene> newScene;
+
         {
             std::unique_lock<std::mutex> lock(m_mutex);
 
             m_condition.wait(lock, [&, this]{
-                    return !m_running || !m_queue.empty();
+                    return !m_running ||
+                        bool(instance->pendingScene) ||
+                        (instance->index < size_t(activeWorkers()) &&
+                         m_pendingTasks.load() > 0 &&
+                         m_uploadBacklog.load() < MAX_BUILD_AHEAD);
                 });
 
-            if (instance->tileBuilder) {
-                disposeBuilder(std::move(builder));
-
-                builder = std::move(instance->tileBuilder);
-                LOG("Passed new TileBuilder to TileWorker");
+            if (instance->pendingScene) {
+                newScene = std::move(instance->pendingScene);
             }
 
             // Check if thread should stop
@@ -72,36 +170,30 @@ void TileWorker::run(Worker* instance) {
                 disposeBuilder(std::move(builder));
                 break;
             }
+        }
 
-            if (!builder) {
-                continue;
-            }
-
-            // Remove all canceled tasks
-            auto removes = std::remove_if(m_queue.begin(), m_queue.end(),
-                                          [](const auto& a) { return a->isCanceled(); });
-
-            m_queue.erase(removes, m_queue.end());
-
-            if (m_queue.empty()) {
-                continue;
+        if (newScene) {
+            Trace::Scope trace("workerSetScene");
+            if (builder) {
+                // Refresh the builder in place: the duktape heap and any
+                // functions the new scene shares with the old one survive
+                auto oldScene = builder->setScene(std::move(newScene));
+
+                // The old scene references GL resources, release it on
+                // the main thread
+                m_mainThreadJobQueue.add([s = std::move(oldScene)]{});
+            } else {
+                builder = std::make_unique<TileBuilder>(std::move(newScene));
             }
+        }
 
-            // Pop highest priority tile from queue
-            auto it = std::min_element(m_queue.begin(), m_queue.end(),
-                [](const auto& a, const auto& b) {
-                    if (a->isProxy() != b->isProxy()) {
-                        return !a->isProxy();
-                    }
-                    if (a->source().id() == b->source().id() &&
-                        a->sourceGeneration() != b->sourceGeneration()) {
-                        return a->sourceGeneration() < b->sourceGeneration();
-                    }
-                    return a->getPriority() < b->getPriority();
-                });
+        if (!builder) {
+            continue;
+        }
 
-            task = std::move(*it);
-            m_queue.erase(it);
+        auto task = popTask(instance);
+        if (!task) {
+            continue;
         }
 
         if (task->isCanceled()) {
@@ -110,30 +202,97 @@ void TileWorker::run(Worker* instance) {
 
         // const clock_t begin = clock();
 
-        task->process(*builder);
+        BuildTelemetry::beginTask();
+        {
+            Trace::Scope trace("tileBuild");
+            task->process(*builder);
+        }
+        BuildTelemetry::endTask(task->tileId());
+
+        task->timing().built = std::chrono::steady_clock::now();
 
         // float loadTime = (float(clock() - begin) / CLOCKS_PER_SEC) * 1000;
         // LOG("loadTime %s - %f", task->tileID.toString().c_str(), loadTime);
 
-        requestRender();
+        requestRender(RenderDirty::full);
     }
 }
 
 void TileWorker::setScene(std::shared_ptr<Scene>& _scene) {
-    for (auto& worker : m_workers) {
-        worker->tileBuilder = std::make_unique<TileBuilder>(_scene);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (auto& worker : m_workers) {
+            worker->pendingScene = _scene;
+        }
     }
+    m_condition.notify_all();
 }
 
-void TileWorker::enqueue(std::shared_ptr<TileTask>&& task) {
+void TileWorker::setUploadBacklog(int _count) {
+    int before;
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        if (!m_running) {
-            return;
-        }
-        m_queue.push_back(std::move(task));
+        before = m_uploadBacklog.exchange(_count);
+    }
+    // Wake the workers when uploads caught up enough to build again
+    if (before >= MAX_BUILD_AHEAD && _count < MAX_BUILD_AHEAD) {
+        m_condition.notify_all();
+    }
+}
+
+void TileWorker::setInteractive(bool _on) {
+    m_niceness.store(_on ? WORKER_NICENESS_INTERACTIVE : WORKER_NICENESS);
+}
+
+int TileWorker::activeWorkers() const {
+    int demand = (m_pendingTasks.load() + PENDING_BUILDS_PER_WORKER - 1)
+                     / PENDING_BUILDS_PER_WORKER;
+    return std::min(std::max(demand, 1), m_activeLimit.load());
+}
+
+void TileWorker::setMaxActiveWorkers(int _count) {
+    int poolSize = int(m_workers.size());
+    if (_count <= 0 || _count > poolSize) { _count = poolSize; }
+
+    m_activeLimit.store(_count);
+
+    // Wake parked workers in case the cap was raised
+    m_condition.notify_all();
+}
+
+void TileWorker::enqueue(std::shared_ptr<TileTask>&& task) {
+
+    if (!m_running) {
+        return;
+    }
+
+    // A task arrives here once its data is in hand - from the network,
+    // the disk cache or a raw-cache hit
+    if (task->timing().data == std::chrono::steady_clock::time_point()) {
+        task->timing().data = std::chrono::steady_clock::now();
+    }
+
+    m_pendingTasks++;
+
+    // Distribute tasks round-robin over the currently active workers;
+    // parked queues stay empty so no task waits behind a sleeping
+    // thread, and an idle active worker steals from its siblings.
+    auto& worker = m_workers[m_enqueueIndex++ % activeWorkers()];
+    {
+        std::unique_lock<std::mutex> lock(worker->queueMutex);
+        worker->queue.push_back(std::move(task));
     }
-    m_condition.notify_one();
+
+    // Order the m_pendingTasks increment against the wait predicate:
+    // without passing through m_mutex the enqueue could fall entirely
+    // between a worker's predicate check and its block in wait(), and
+    // the notification below would be lost.
+    { std::lock_guard<std::mutex> lock(m_mutex); }
+
+    // With the demand-based active count, notify_one could pick a
+    // worker that parks again right away; waiters are few, so waking
+    // them all is cheap.
+    m_condition.notify_all();
 }
 
 void TileWorker::stop() {
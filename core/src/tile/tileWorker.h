@@ -31,25 +31,89 @@ public:
 
     void setScene(std::shared_ptr<Scene>& _scene);
 
+    /* Number of built tiles still waiting for their GL upload, set by
+     * the render thread each frame. While it exceeds the build-ahead
+     * limit, workers stop taking tasks - a fast network then queues
+     * downloads instead of piling finished tiles onto the upload
+     * budget, which spreads hitches at connectivity changes. */
+    void setUploadBacklog(int _count);
+
+    /* Raises the worker thread priority while the user interacts
+     * with the map and restores the idle niceness afterwards, so
+     * tile builds during a pan or zoom don't get scheduled onto
+     * whatever core the kernel has spare. Called from the render
+     * thread; workers re-apply their priority when it changes. */
+    void setInteractive(bool _on);
+
+    /* Cap the number of workers allowed to build concurrently; excess
+     * workers park on the wake condition. Platforms pass 1 on battery
+     * saver or idle and 0 to restore the full pool. Within the cap the
+     * pool follows demand - a lone queued tile wakes one worker, a
+     * burst load fans out to all of them. */
+    void setMaxActiveWorkers(int _count);
+
 private:
 
     struct Worker {
         std::thread thread;
-        std::unique_ptr<TileBuilder> tileBuilder;
+
+        // Position in m_workers; workers past the active count park.
+        size_t index = 0;
+
+        // Scene handed over by setScene(); the worker thread picks it up
+        // and refreshes its own TileBuilder, so workers update their JS
+        // state in parallel instead of waiting on the main thread.
+        std::shared_ptr<Scene> pendingScene;
+
+        // Per-worker task queue. Enqueue and dequeue mostly touch
+        // only this worker's own mutex, so workers no longer
+        // serialize on one global lock during tile bursts.
+        std::mutex queueMutex;
+        std::vector<std::shared_ptr<TileTask>> queue;
     };
 
     void run(Worker* instance);
 
+    // Pop the highest priority task from _worker's own queue,
+    // or steal one from a sibling when the own queue is empty.
+    std::shared_ptr<TileTask> popTask(Worker* _worker);
+
+    // Remove canceled tasks and take the best remaining task from
+    // _queue. Must be called with the owning queueMutex held.
+    std::shared_ptr<TileTask> takeBestTask(std::vector<std::shared_ptr<TileTask>>& _queue);
+
     void disposeBuilder(std::unique_ptr<TileBuilder> _builder);
 
+    // Number of workers that should be building right now: grows with
+    // the queued tasks up to the active limit.
+    int activeWorkers() const;
+
     bool m_running;
 
     std::vector<std::unique_ptr<Worker>> m_workers;
 
     std::condition_variable m_condition;
 
+    // Guards only sleeping/waking and m_running; the task queues
+    // live in the workers themselves.
     std::mutex m_mutex;
-    std::vector<std::shared_ptr<TileTask>> m_queue;
+
+    // Total number of queued tasks across all workers, so an idle
+    // worker knows whether there is anything left to steal without
+    // touching every sibling queue.
+    std::atomic<int> m_pendingTasks;
+
+    // Round-robin cursor for distributing incoming tasks.
+    std::atomic<unsigned int> m_enqueueIndex;
+
+    // See setUploadBacklog()
+    std::atomic<int> m_uploadBacklog{0};
+
+    // Niceness the workers should run at, see setInteractive()
+    std::atomic<int> m_niceness;
+
+    // See setMaxActiveWorkers()
+    std::atomic<int> m_activeLimit;
 
     JobQueue m_mainThreadJobQueue;
 
@@ -1,9 +1,11 @@
 #include "builders.h"
 
 #include "geom.h"
-#include "glm/gtx/rotate_vector.hpp"
 #include "glm/gtx/norm.hpp"
 
+#include <array>
+#include <cmath>
+
 namespace mapbox { namespace util {
 template <>
 struct nth<0, Tangram::Point> {
@@ -17,6 +19,26 @@ struct nth<1, Tangram::Point> {
 
 namespace Tangram {
 
+// Upper bound on cached triangulations per builder; the cache is
+// reset wholesale when it fills up.
+#define EARCUT_CACHE_MAX_ENTRIES 512
+
+// FNV-1a over the raw coordinates and ring sizes of a polygon
+static size_t polygonHash(const Tangram::Polygon& _polygon) {
+    size_t hash = 0xcbf29ce484222325;
+    auto mix = [&](const char* _data, size_t _size) {
+        for (size_t i = 0; i < _size; i++) {
+            hash = (hash ^ _data[i]) * 0x100000001b3;
+        }
+    };
+    for (auto& ring : _polygon) {
+        size_t size = ring.size();
+        mix(reinterpret_cast<const char*>(&size), sizeof(size));
+        mix(reinterpret_cast<const char*>(ring.data()), size * sizeof(Point));
+    }
+    return hash;
+}
+
 CapTypes CapTypeFromString(const std::string& str) {
     if (str == "square") { return CapTypes::square; }
     if (str == "round") { return CapTypes::round; }
@@ -31,6 +53,33 @@ JoinTypes JoinTypeFromString(const std::string& str) {
 
 void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuilder& _ctx) {
 
+    // Prune sub-threshold hole rings before triangulation. The copy is
+    // only made when something is actually dropped; the pruned polygon
+    // cannot be pruned again, so the recursion runs at most once.
+    if (_ctx.minHoleArea > 0 && _polygon.size() > 1) {
+        size_t keep = 1;
+        for (size_t i = 1; i < _polygon.size(); i++) {
+            auto& ring = _polygon[i];
+            if (std::abs(signedArea(ring.begin(), ring.end())) >= _ctx.minHoleArea) {
+                keep++;
+            }
+        }
+
+        if (keep < _polygon.size()) {
+            _ctx.prunedPolygon.clear();
+            _ctx.prunedPolygon.push_back(_polygon[0]);
+            for (size_t i = 1; i < _polygon.size(); i++) {
+                auto& ring = _polygon[i];
+                if (std::abs(signedArea(ring.begin(), ring.end())) >= _ctx.minHoleArea) {
+                    _ctx.prunedPolygon.push_back(ring);
+                }
+            }
+
+            buildPolygon(_ctx.prunedPolygon, _height, _ctx);
+            return;
+        }
+    }
+
     glm::vec2 min, max;
     if (_ctx.useTexCoords) {
         min = glm::vec2(std::numeric_limits<float>::max());
@@ -44,18 +93,47 @@ void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuild
         }
     }
 
-    // Run earcut, triangles are stored in _ctx.earcut.indices
-    _ctx.earcut(_polygon);
-
     size_t sumPoints = 0;
     for (auto& line : _polygon) {
         sumPoints += line.size();
     }
 
+    // Look up a cached triangulation; identical geometry recurs when
+    // overzoomed sibling tiles tessellate the same parent feature.
+    size_t key = polygonHash(_polygon);
+    _ctx.cacheLookups++;
+
+    auto cached = _ctx.earcutCache.find(key);
+    if (cached != _ctx.earcutCache.end() &&
+        (cached->second.points != sumPoints ||
+         cached->second.rings != _polygon.size())) {
+        // Hash collision with a different polygon - replaying its
+        // indices would read and mark points past this polygon's end
+        _ctx.earcutCache.erase(cached);
+        cached = _ctx.earcutCache.end();
+    }
+
+    if (cached == _ctx.earcutCache.end()) {
+        // Run earcut, triangles are stored in _ctx.earcut.indices
+        _ctx.earcut(_polygon);
+
+        if (_ctx.earcutCache.size() >= EARCUT_CACHE_MAX_ENTRIES) {
+            _ctx.earcutCache.clear();
+        }
+        cached = _ctx.earcutCache.emplace(key,
+                PolygonBuilder::EarcutEntry{_ctx.earcut.indices,
+                                            uint32_t(sumPoints),
+                                            uint32_t(_polygon.size())}).first;
+    } else {
+        _ctx.cacheHits++;
+    }
+
+    const std::vector<uint16_t>& earcutIndices = cached->second.indices;
+
     // Mark the points that are referenced by indices as used.
     size_t sumVertices = 0;
     _ctx.used.assign(sumPoints, 0);
-    for (auto i : _ctx.earcut.indices) {
+    for (auto i : earcutIndices) {
         if (_ctx.used[i] == 0) {
             _ctx.used[i] = 1;
             sumVertices++;
@@ -97,7 +175,7 @@ void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuild
         }
     }
 
-    for (auto i : _ctx.earcut.indices) {
+    for (auto i : earcutIndices) {
         _ctx.indices.push_back(vertexDataOffset + _ctx.used[i]);
     }
 }
@@ -106,20 +184,39 @@ void Builders::buildPolygonExtrusion(const Polygon& _polygon, float _minHeight,
 
     auto vertexDataOffset = _ctx.numVertices;
 
-    static const glm::vec3 upVector(0.0f, 0.0f, 1.0f);
+    // Pre-size the index buffer; every wall edge adds two triangles
+    size_t numEdges = 0;
+    for (auto& line : _polygon) {
+        if (line.size() < 2) { continue; }
+        numEdges += line.size() - 1;
+    }
+    _ctx.indices.reserve(_ctx.indices.size() + numEdges * 6);
+
     glm::vec3 normalVector;
 
     for (auto& line : _polygon) {
 
         size_t lineSize = line.size();
+        if (lineSize < 2) { continue; }
+
+        // Batch-compute the wall normal of every edge of this ring -
+        // cross(up, b - a) normalized - in one vectorizable pass.
+        auto& normals = _ctx.scratchNormals;
+        normals.resize(lineSize - 1);
+
+        for (size_t i = 0; i < lineSize - 1; i++) {
+            float dx = line[i+1].x - line[i].x;
+            float dy = line[i+1].y - line[i].y;
+            float inv = 1.f / std::sqrt(dx * dx + dy * dy);
+            normals[i] = glm::vec3(-dy * inv, dx * inv, 0.f);
+        }
 
         for (size_t i = 0; i < lineSize - 1; i++) {
 
             glm::vec3 a(line[i]);
             glm::vec3 b(line[i+1]);
 
-            normalVector = glm::cross(upVector, b - a);
-            normalVector = glm::normalize(normalVector);
+            normalVector = normals[i];
 
             if (std::isnan(normalVector.x)
              || std::isnan(normalVector.y)
@@ -188,14 +285,16 @@ void indexPairs( int _nPairs, int _nVertices, std::vector<uint16_t>& _indicesOut
 //  and interpolating their UVs               \ p /
 //                                             \./
 //                                              C
-void addFan(const glm::vec3& _pC,
-            const glm::vec2& _nA, const glm::vec2& _nB, const glm::vec2& _nC,
-            const glm::vec2& _uA, const glm::vec2& _uB, const glm::vec2& _uC,
-            int _numTriangles, PolyLineBuilder& _ctx) {
-
-    // Find angle difference
-    float cross = _nA.x * _nB.y - _nA.y * _nB.x; // z component of cross(_CA, _CB)
-    float angle = atan2f(cross, glm::dot(_nA, _nB));
+//
+// The radial vertices are produced by repeatedly applying the
+// per-step rotation _rotor (cos/sin of the step angle) to the
+// previous radial - a pair of multiply-adds per vertex instead of a
+// sin/cos call per vertex.
+static void addFanRadials(const glm::vec3& _pC,
+                          const glm::vec2& _nA, const glm::vec2& _nC,
+                          const glm::vec2& _uA, const glm::vec2& _uB, const glm::vec2& _uC,
+                          float _angle, const glm::vec2& _rotor,
+                          int _numTriangles, PolyLineBuilder& _ctx) {
 
     int startIndex = _ctx.numVertices;
 
@@ -207,12 +306,14 @@ void addFan(const glm::vec3& _pC,
 
     // Add radial vertices
     glm::vec2 radial = _nA;
+    float invNum = 1.f / _numTriangles;
     for (int i = 0; i < _numTriangles; i++) {
-        float frac = (i + 1)/(float)_numTriangles;
-        radial = glm::rotate(_nA, angle * frac);
+        radial = glm::vec2(radial.x * _rotor.x - radial.y * _rotor.y,
+                           radial.x * _rotor.y + radial.y * _rotor.x);
 
         glm::vec2 uv(0.0);
         if (_ctx.useTexCoords) {
+            float frac = (i + 1) * invNum;
             uv = (1.f - frac) * _uA + frac * _uB;
         }
 
@@ -220,12 +321,49 @@ void addFan(const glm::vec3& _pC,
 
         // Add indices
         _ctx.indices.push_back(startIndex); // center vertex
-        _ctx.indices.push_back(startIndex + i + (angle > 0 ? 1 : 2));
-        _ctx.indices.push_back(startIndex + i + (angle > 0 ? 2 : 1));
+        _ctx.indices.push_back(startIndex + i + (_angle > 0 ? 1 : 2));
+        _ctx.indices.push_back(startIndex + i + (_angle > 0 ? 2 : 1));
     }
 
 }
 
+void addFan(const glm::vec3& _pC,
+            const glm::vec2& _nA, const glm::vec2& _nB, const glm::vec2& _nC,
+            const glm::vec2& _uA, const glm::vec2& _uB, const glm::vec2& _uC,
+            int _numTriangles, PolyLineBuilder& _ctx) {
+
+    // Find angle difference
+    float cross = _nA.x * _nB.y - _nA.y * _nB.x; // z component of cross(_CA, _CB)
+    float angle = atan2f(cross, glm::dot(_nA, _nB));
+
+    float step = angle / _numTriangles;
+    glm::vec2 rotor(cosf(step), sinf(step));
+
+    addFanRadials(_pC, _nA, _nC, _uA, _uB, _uC, angle, rotor, _numTriangles, _ctx);
+
+}
+
+// Rotors for the fixed half-circle cap fans, precomputed per
+// resolution so round caps skip the angle math entirely
+static glm::vec2 halfCircleRotor(int _numTriangles) {
+
+    static const int max_resolution = 16;
+    static const auto rotors = []() {
+        std::array<glm::vec2, max_resolution + 1> r;
+        r[0] = { 1.f, 0.f };
+        for (int i = 1; i <= max_resolution; i++) {
+            float step = float(PI) / i;
+            r[i] = { cosf(step), sinf(step) };
+        }
+        return r;
+    }();
+
+    if (_numTriangles <= max_resolution) { return rotors[_numTriangles]; }
+
+    float step = float(PI) / _numTriangles;
+    return { cosf(step), sinf(step) };
+}
+
 // Function to add the vertices for line caps
 void addCap(const glm::vec3& _coord, const glm::vec2& _normal, int _numCorners, bool _isBeginning, PolyLineBuilder& _ctx) {
 
@@ -246,14 +384,16 @@ void addCap(const glm::vec3& _coord, const glm::vec2& _normal, int _numCorners,
     }
 
     // "Round" cap type needs a fan of vertices
-    glm::vec2 nA(_normal), nB(-_normal), nC(0.f, 0.f), uA(1.f, v), uB(0.f, v), uC(0.5f, v);
+    glm::vec2 nA(_normal), nC(0.f, 0.f), uA(1.f, v), uB(0.f, v), uC(0.5f, v);
     if (_isBeginning) {
         nA *= -1.f; // To flip the direction of the fan, we negate the normal vectors
-        nB *= -1.f;
         uA.x = 0.f; // To keep tex coords consistent, we must reverse these too
         uB.x = 1.f;
     }
-    addFan(_coord, nA, nB, nC, uA, uB, uC, _numCorners, _ctx);
+    // The cap fan always sweeps a half circle, so the per-step rotor
+    // comes from the precomputed table instead of atan2/sincos
+    addFanRadials(_coord, nA, nC, uA, uB, uC, float(PI), halfCircleRotor(_numCorners),
+                  _numCorners, _ctx);
 }
 
 // Tests if a line segment (from point A to B) is outside the edge of a tile
@@ -288,6 +428,33 @@ void buildPolyLineSegment(const Line& _line, PolyLineBuilder& _ctx, size_t _star
                    (origLineSize - _startIndex + _endIndex));
     if (lineSize < 2) { return; }
 
+    // Batch-compute the unit normal of every segment in the span up
+    // front. This plain loop over contiguous floats is data-parallel,
+    // so the compiler can vectorize it, unlike the branchy per-vertex
+    // loop below where the normal math was previously interleaved.
+    auto& normals = _ctx.scratchNormals;
+    normals.resize(lineSize - 1);
+
+    if (_startIndex + lineSize <= origLineSize) {
+        const Point* p = &_line[_startIndex];
+        for (int i = 0; i < lineSize - 1; i++) {
+            float dx = p[i+1].x - p[i].x;
+            float dy = p[i+1].y - p[i].y;
+            float inv = 1.f / std::sqrt(dx * dx + dy * dy);
+            normals[i] = glm::vec2(dy * inv, -dx * inv);
+        }
+    } else {
+        // Wrapped span (closed polygon): fall back to index wrapping
+        for (int i = 0; i < lineSize - 1; i++) {
+            const Point& a = _line[(_startIndex + i) % origLineSize];
+            const Point& b = _line[(_startIndex + i + 1) % origLineSize];
+            float dx = b.x - a.x;
+            float dy = b.y - a.y;
+            float inv = 1.f / std::sqrt(dx * dx + dy * dy);
+            normals[i] = glm::vec2(dy * inv, -dx * inv);
+        }
+    }
+
     glm::vec3 coordCurr(_line[_startIndex]);
     // get the Point using wrapped index in the original line geometry
     glm::vec3 coordNext(_line[(_startIndex + 1) % origLineSize]);
@@ -297,7 +464,7 @@ void buildPolyLineSegment(const Line& _line, PolyLineBuilder& _ctx, size_t _star
     int trianglesOnJoin = (int)_ctx.join;
 
     // Process first point in line with an end cap
-    normNext = glm::normalize(perp2d(coordCurr, coordNext));
+    normNext = normals[0];
 
     if (endCap) {
         addCap(coordCurr, normNext, cornersOnCap, true, _ctx);
@@ -321,7 +488,7 @@ void buildPolyLineSegment(const Line& _line, PolyLineBuilder& _ctx, size_t _star
         }
 
         normPrev = normNext;
-        normNext = glm::normalize(perp2d(coordCurr, coordNext));
+        normNext = normals[i];
 
         // Compute "normal" for miter joint
         miterVec = normPrev + normNext;
@@ -396,7 +563,66 @@ void buildPolyLineSegment(const Line& _line, PolyLineBuilder& _ctx, size_t _star
 
 }
 
-void Builders::buildPolyLine(const Line& _line, PolyLineBuilder& _ctx) {
+// Douglas-Peucker simplification: keeps the endpoints and every
+// point whose distance to the chord of its span exceeds _tolerance.
+// Endpoints are always kept, so closed rings stay closed and tile
+// edge cuts are preserved.
+static void simplifyLine(const Line& _line, float _tolerance, Line& _out) {
+
+    size_t n = _line.size();
+    float sqTolerance = _tolerance * _tolerance;
+
+    std::vector<bool> keep(n, false);
+    keep[0] = true;
+    keep[n-1] = true;
+
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(0, n-1);
+
+    while (!stack.empty()) {
+        size_t first = stack.back().first;
+        size_t last = stack.back().second;
+        stack.pop_back();
+
+        glm::vec2 a(_line[first]);
+        glm::vec2 b(_line[last]);
+
+        float maxSqDist = 0.f;
+        size_t index = first;
+
+        for (size_t i = first + 1; i < last; i++) {
+            float sqDist = sqPointSegmentDistance(glm::vec2(_line[i]), a, b);
+            if (sqDist > maxSqDist) {
+                maxSqDist = sqDist;
+                index = i;
+            }
+        }
+
+        if (maxSqDist > sqTolerance) {
+            keep[index] = true;
+            if (index - first > 1) { stack.emplace_back(first, index); }
+            if (last - index > 1) { stack.emplace_back(index, last); }
+        }
+    }
+
+    _out.clear();
+    _out.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        if (keep[i]) { _out.push_back(_line[i]); }
+    }
+}
+
+void Builders::buildPolyLine(const Line& _rawLine, PolyLineBuilder& _ctx) {
+
+    // Drop sub-tolerance detail before tesselation; every removed
+    // point saves its join triangles too
+    const Line* linePtr = &_rawLine;
+    Line simplified;
+    if (_ctx.simplificationTolerance > 0.f && _rawLine.size() > 2) {
+        simplifyLine(_rawLine, _ctx.simplificationTolerance, simplified);
+        linePtr = &simplified;
+    }
+    const Line& _line = *linePtr;
 
     size_t lineSize = _line.size();
 
@@ -3,6 +3,7 @@
 #include "data/tileData.h"
 
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 #include "earcut.hpp/include/earcut.hpp"
@@ -44,8 +45,37 @@ struct PolygonBuilder {
     size_t numVertices = 0;
     bool useTexCoords;
 
+    // Hole rings with an area below this (in tile units at the built
+    // zoom) are dropped before triangulation; earcut cost grows
+    // superlinearly with ring count and sub-pixel holes do not survive
+    // rasterization anyway. 0 keeps every ring.
+    float minHoleArea = 0.f;
+
+    // Holds the surviving rings while pruning, reused across features
+    Polygon prunedPolygon;
+
     mapbox::detail::Earcut<uint16_t> earcut;
 
+    // Scratch buffer of per-edge extrusion normals, filled in one
+    // batch pass per ring so the compiler can vectorize the math.
+    std::vector<glm::vec3> scratchNormals;
+
+    // Triangulation output cache, keyed by a hash of the polygon
+    // geometry. Overzoomed sibling tiles tessellate the identical
+    // parent geometry, so repeated polygons skip earcut entirely.
+    // The hash is not collision-resistant and geometry is remote
+    // input, so entries carry the point and ring counts of their
+    // polygon and a hit must match them; replayed indices then stay
+    // in bounds. See Builders::buildPolygon().
+    struct EarcutEntry {
+        std::vector<uint16_t> indices;
+        uint32_t points = 0;
+        uint32_t rings = 0;
+    };
+    std::unordered_map<size_t, EarcutEntry> earcutCache;
+    size_t cacheLookups = 0;
+    size_t cacheHits = 0;
+
     PolygonBuilder(PolygonVertexFn _addVertex = [](auto&,auto&,auto&){},
                    bool _useTexCoords = true)
         : addVertex(_addVertex), useTexCoords(_useTexCoords){}
@@ -79,6 +109,15 @@ struct PolyLineBuilder {
     bool closedPolygon;
     bool useTexCoords;
 
+    // When positive, input lines are simplified with this tolerance
+    // (in tile units) before tesselation, so caps and joins are
+    // evaluated on the simplified geometry. 0 disables the pass.
+    float simplificationTolerance = 0.f;
+
+    // Scratch buffer of per-segment unit normals, batch-computed for
+    // a whole line span before tesselation.
+    std::vector<glm::vec2> scratchNormals;
+
     PolyLineBuilder(PolyLineVertexFn _addVertex = [](auto&,auto&,auto&){},
                     CapTypes _cap = CapTypes::butt,
                     JoinTypes _join = JoinTypes::bevel,
@@ -3,6 +3,7 @@
 #include "tangram.h"
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace Tangram {
 
@@ -38,4 +39,66 @@ struct Ease {
 
 };
 
+/* Central scheduler for the active eases.
+ *
+ * Eases occupy fixed slots and are stepped in one pass. Steps are
+ * quantized to a fixed timestep, so on high-rate displays several
+ * small frame deltas batch into one callback invocation per ease
+ * instead of one per frame. active() reports whether any ease is
+ * still running, letting an embedder stop invalidating frames once
+ * nothing animates. */
+class EaseManager {
+
+public:
+
+    // Stepping quantum; callbacks run at most once per elapsed
+    // quantum and always once more on completion
+    static constexpr float s_easeStep = 1.f / 60.f;
+
+    void set(size_t _slot, Ease _ease) {
+        if (_slot >= m_eases.size()) { m_eases.resize(_slot + 1); }
+        m_eases[_slot] = _ease;
+    }
+
+    void clear(size_t _slot) {
+        if (_slot < m_eases.size()) { m_eases[_slot] = {}; }
+    }
+
+    bool active() const {
+        for (const auto& ease : m_eases) {
+            if (!ease.finished()) { return true; }
+        }
+        return false;
+    }
+
+    /* Steps all running eases; returns true when any ease was active
+     * on entry, i.e. this pass may have changed the view */
+    bool update(float _dt) {
+
+        if (!active()) {
+            m_accumulated = 0.f;
+            return false;
+        }
+
+        m_accumulated += _dt;
+        if (m_accumulated < s_easeStep) {
+            // Batch this sub-quantum delta into the next step
+            return true;
+        }
+
+        for (auto& ease : m_eases) {
+            if (!ease.finished()) { ease.update(m_accumulated); }
+        }
+        m_accumulated = 0.f;
+
+        return true;
+    }
+
+private:
+
+    std::vector<Ease> m_eases;
+    float m_accumulated = 0.f;
+
+};
+
 }
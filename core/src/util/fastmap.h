@@ -68,6 +68,130 @@ struct fastmap {
     void clear() { map.clear(); }
 };
 
+// Open-addressing hash map for string keys. The hash is computed once
+// per lookup and slots are probed linearly in a power-of-two table, so
+// a hit usually costs one cache line; full keys are only compared on a
+// hash match. Used for draw- and build-time lookups where the sorted
+// vector of fastmap pays a string comparison per probe step.
+template<typename T>
+struct hashmap {
+
+    struct Entry {
+        size_t hash = 0;
+        bool occupied = false;
+        std::string first;
+        T second{};
+    };
+
+    std::vector<Entry> slots;
+    size_t count = 0;
+
+    struct iterator {
+        Entry* pos;
+        Entry* last;
+
+        iterator& operator++() {
+            do { ++pos; } while (pos != last && !pos->occupied);
+            return *this;
+        }
+        bool operator==(const iterator& _other) const { return pos == _other.pos; }
+        bool operator!=(const iterator& _other) const { return pos != _other.pos; }
+        Entry& operator*() const { return *pos; }
+        Entry* operator->() const { return pos; }
+    };
+
+    struct const_iterator {
+        const Entry* pos;
+        const Entry* last;
+
+        const_iterator& operator++() {
+            do { ++pos; } while (pos != last && !pos->occupied);
+            return *this;
+        }
+        bool operator==(const const_iterator& _other) const { return pos == _other.pos; }
+        bool operator!=(const const_iterator& _other) const { return pos != _other.pos; }
+        const Entry& operator*() const { return *pos; }
+        const Entry* operator->() const { return pos; }
+    };
+
+    T& operator[](const std::string& _key) {
+        if (slots.empty()) { slots.resize(16); }
+
+        // Grow at 3/4 load to keep probe sequences short
+        if (count * 4 >= slots.size() * 3) { grow(); }
+
+        size_t hash = std::hash<std::string>()(_key);
+        Entry& entry = probe(slots, hash, _key);
+        if (!entry.occupied) {
+            entry.hash = hash;
+            entry.occupied = true;
+            entry.first = _key;
+            count++;
+        }
+        return entry.second;
+    }
+
+    iterator find(const std::string& _key) {
+        if (slots.empty()) { return end(); }
+        size_t hash = std::hash<std::string>()(_key);
+        Entry& entry = probe(slots, hash, _key);
+        if (!entry.occupied) { return end(); }
+        return { &entry, slots.data() + slots.size() };
+    }
+
+    const_iterator find(const std::string& _key) const {
+        if (slots.empty()) { return end(); }
+        size_t hash = std::hash<std::string>()(_key);
+        const Entry& entry = slots[probeIndex(slots, hash, _key)];
+        if (!entry.occupied) { return end(); }
+        return { &entry, slots.data() + slots.size() };
+    }
+
+    iterator begin() { return skipEmpty({ slots.data(), slots.data() + slots.size() }); }
+    iterator end() { return { slots.data() + slots.size(), slots.data() + slots.size() }; }
+
+    const_iterator begin() const { return skipEmpty(const_iterator{ slots.data(), slots.data() + slots.size() }); }
+    const_iterator end() const { return { slots.data() + slots.size(), slots.data() + slots.size() }; }
+
+    size_t size() const { return count; }
+
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+private:
+
+    static size_t probeIndex(const std::vector<Entry>& _slots, size_t _hash, const std::string& _key) {
+        size_t mask = _slots.size() - 1;
+        size_t i = _hash & mask;
+        while (_slots[i].occupied &&
+               (_slots[i].hash != _hash || _slots[i].first != _key)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    static Entry& probe(std::vector<Entry>& _slots, size_t _hash, const std::string& _key) {
+        return _slots[probeIndex(_slots, _hash, _key)];
+    }
+
+    void grow() {
+        std::vector<Entry> grown(slots.size() * 2);
+        for (auto& entry : slots) {
+            if (!entry.occupied) { continue; }
+            grown[probeIndex(grown, entry.hash, entry.first)] = std::move(entry);
+        }
+        slots = std::move(grown);
+    }
+
+    template<typename It>
+    static It skipEmpty(It _it) {
+        while (_it.pos != _it.last && !_it.pos->occupied) { ++_it.pos; }
+        return _it;
+    }
+};
+
 template<typename T>
 struct fastmap<std::string, T> {
 
@@ -0,0 +1,70 @@
+#include "frameGovernor.h"
+
+namespace Tangram {
+
+// Smoothing factor for the frame time average
+#define FRAME_TIME_EMA 0.1f
+
+// Headroom before changing levels, as factors of the target frame
+// time; the gap between the two keeps the governor from oscillating
+#define DEGRADE_THRESHOLD 1.2f
+#define RECOVER_THRESHOLD 0.75f
+
+// Frames the average must stay out of budget before a level change;
+// recovery waits longer since stepping quality back up is what users
+// notice
+#define DEGRADE_FRAMES 30
+#define RECOVER_FRAMES 120
+
+#define MAX_QUALITY_LEVEL 2
+
+void FrameGovernor::setTargetFrameTime(float _seconds) {
+
+    m_targetFrameTime = _seconds;
+
+    if (_seconds <= 0.f) {
+        m_level = 0;
+        m_averageFrameTime = 0.f;
+        m_framesOverBudget = 0;
+        m_framesUnderBudget = 0;
+    }
+}
+
+void FrameGovernor::update(float _dt) {
+
+    m_frameCount++;
+
+    if (m_targetFrameTime <= 0.f) { return; }
+
+    if (m_averageFrameTime <= 0.f) { m_averageFrameTime = _dt; }
+    m_averageFrameTime += (_dt - m_averageFrameTime) * FRAME_TIME_EMA;
+
+    if (m_averageFrameTime > m_targetFrameTime * DEGRADE_THRESHOLD) {
+        m_framesUnderBudget = 0;
+
+        if (++m_framesOverBudget >= DEGRADE_FRAMES && m_level < MAX_QUALITY_LEVEL) {
+            m_level++;
+            m_framesOverBudget = 0;
+        }
+    } else if (m_averageFrameTime < m_targetFrameTime * RECOVER_THRESHOLD) {
+        m_framesOverBudget = 0;
+
+        if (++m_framesUnderBudget >= RECOVER_FRAMES && m_level > 0) {
+            m_level--;
+            m_framesUnderBudget = 0;
+        }
+    } else {
+        m_framesOverBudget = 0;
+        m_framesUnderBudget = 0;
+    }
+}
+
+int FrameGovernor::lodBias() const {
+    return (m_level >= 2) ? 1 : 0;
+}
+
+bool FrameGovernor::throttleLabels() const {
+    return (m_level >= 1) && (m_frameCount & 1);
+}
+
+}
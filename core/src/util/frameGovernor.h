@@ -0,0 +1,40 @@
+#pragma once
+
+namespace Tangram {
+
+/* Watches recent frame times against a target and derives a quality
+ * level, so the engine can trade detail for latency on devices that
+ * consistently miss their frame budget. At the first level per-frame
+ * label fade updates run every other frame; at the second the tile
+ * zoom used for tile selection is additionally biased down by one.
+ * Level changes require the smoothed frame time to stay out of budget
+ * for a while, and recovery is slower than degradation, so the
+ * governor does not oscillate around the target. */
+class FrameGovernor {
+
+public:
+
+    /* Sets the target frame time in seconds; a value of 0 or less
+     * disables the governor and restores full quality */
+    void setTargetFrameTime(float _seconds);
+
+    /* Feeds one frame; _dt is the time since the last frame in seconds */
+    void update(float _dt);
+
+    /* Tile zoom reduction to apply while degraded */
+    int lodBias() const;
+
+    /* True when label fade updates should be skipped this frame */
+    bool throttleLabels() const;
+
+private:
+
+    float m_targetFrameTime = 0.f;
+    float m_averageFrameTime = 0.f;
+    int m_level = 0;
+    int m_framesOverBudget = 0;
+    int m_framesUnderBudget = 0;
+    int m_frameCount = 0;
+};
+
+}
@@ -4,8 +4,323 @@
 #include "data/propertyItem.h"
 #include "glm/glm.hpp"
 
+#include "rapidjson/error/en.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+
 namespace Tangram {
 
+namespace {
+
+// SAX handler that assembles Features while the reader walks the input.
+// Coordinate arrays are collected bottom-up: closing a point array appends
+// a projected Point to the current ring, closing a ring promotes it into
+// the current polygon and so on, so the same code handles every geometry
+// type and the type string may precede or follow the coordinates.
+struct FeatureCollectionHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, FeatureCollectionHandler> {
+
+    enum class State : uint8_t {
+        top,        // the root object
+        layer,      // a member object of the root, a potential named collection
+        features,   // a "features" array
+        feature,    // a Feature object
+        properties, // a "properties" object
+        geometry,   // a "geometry" object
+        coords,     // the "coordinates" arrays
+        skip,       // an ignored value
+    };
+
+    FeatureCollectionHandler(const GeoJson::BatchTransform& _proj, int32_t _sourceId, TileData& _data)
+        : m_proj(_proj), m_sourceId(_sourceId), m_data(_data) {}
+
+    const GeoJson::BatchTransform& m_proj;
+    int32_t m_sourceId;
+    TileData& m_data;
+
+    std::vector<State> m_state;
+    std::string m_key;
+
+    // The root object is kept as a single unnamed layer when it turns out
+    // to be a FeatureCollection itself, like the DOM path does
+    Layer m_rootLayer{""};
+    bool m_rootIsCollection = false;
+    bool m_rootHasFeatures = false;
+
+    Layer m_currentLayer{""};
+    bool m_layerIsCollection = false;
+    bool m_layerHasFeatures = false;
+
+    // The layer the open "features" array belongs to
+    Layer* m_featureTarget = nullptr;
+
+    Feature m_feature;
+    std::vector<PropertyItem> m_propItems;
+    std::string m_geometryType;
+
+    double m_coord[2];
+    int m_coordCount = 0;
+    int m_coordDepth = 0;
+    int m_skipDepth = 0;
+
+    // Raw coordinates of the open ring; projected in one batch when
+    // the ring closes, so the per-point path stays trig free
+    std::vector<glm::dvec2> m_rawLine;
+
+    Line m_line;
+    Polygon m_polygon;
+    std::vector<Polygon> m_polygons;
+
+    State current() { return m_state.empty() ? State::skip : m_state.back(); }
+
+    void skipValue() {
+        m_state.push_back(State::skip);
+        m_skipDepth = 1;
+    }
+
+    bool Key(const char* _str, rapidjson::SizeType _length, bool) {
+        m_key.assign(_str, _length);
+        return true;
+    }
+
+    bool StartObject() {
+        if (m_state.empty()) {
+            m_state.push_back(State::top);
+            return true;
+        }
+        switch (current()) {
+        case State::top:
+            m_currentLayer = Layer(m_key);
+            m_layerIsCollection = false;
+            m_layerHasFeatures = false;
+            m_state.push_back(State::layer);
+            break;
+        case State::features:
+            m_feature = Feature();
+            m_propItems.clear();
+            m_geometryType.clear();
+            m_state.push_back(State::feature);
+            break;
+        case State::feature:
+            if (m_key == "properties") {
+                m_state.push_back(State::properties);
+            } else if (m_key == "geometry") {
+                m_state.push_back(State::geometry);
+            } else {
+                skipValue();
+            }
+            break;
+        case State::coords:
+            return false;
+        case State::skip:
+            m_skipDepth++;
+            break;
+        default:
+            skipValue();
+            break;
+        }
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        switch (current()) {
+        case State::skip:
+            if (--m_skipDepth == 0) { m_state.pop_back(); }
+            break;
+        case State::feature:
+            finishFeature();
+            m_state.pop_back();
+            break;
+        case State::layer:
+            if (m_layerIsCollection && m_layerHasFeatures) {
+                m_data.layers.push_back(std::move(m_currentLayer));
+            }
+            m_state.pop_back();
+            break;
+        default:
+            m_state.pop_back();
+            break;
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        // The root value must be an object
+        if (m_state.empty()) { return false; }
+        switch (current()) {
+        case State::top:
+            if (m_key == "features") {
+                m_rootHasFeatures = true;
+                m_featureTarget = &m_rootLayer;
+                m_state.push_back(State::features);
+            } else {
+                skipValue();
+            }
+            break;
+        case State::layer:
+            if (m_key == "features") {
+                m_layerHasFeatures = true;
+                m_featureTarget = &m_currentLayer;
+                m_state.push_back(State::features);
+            } else {
+                skipValue();
+            }
+            break;
+        case State::geometry:
+            if (m_key == "coordinates") {
+                m_line.clear();
+                m_polygon.clear();
+                m_polygons.clear();
+                m_coordCount = 0;
+                m_coordDepth = 1;
+                m_state.push_back(State::coords);
+            } else {
+                skipValue();
+            }
+            break;
+        case State::coords:
+            m_coordDepth++;
+            break;
+        case State::features:
+            return false;
+        case State::skip:
+            m_skipDepth++;
+            break;
+        default:
+            skipValue();
+            break;
+        }
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        switch (current()) {
+        case State::coords:
+            if (m_coordCount >= 2) {
+                // Closed a point array
+                m_rawLine.emplace_back(m_coord[0], m_coord[1]);
+                m_coordCount = 0;
+            } else if (m_coordDepth > 1) {
+                // Closed a ring or a set of rings
+                projectRawLine();
+                if (!m_line.empty()) {
+                    m_polygon.push_back(std::move(m_line));
+                    m_line = Line();
+                } else if (!m_polygon.empty()) {
+                    m_polygons.push_back(std::move(m_polygon));
+                    m_polygon = Polygon();
+                }
+            }
+            if (--m_coordDepth == 0) {
+                projectRawLine();
+                m_state.pop_back();
+            }
+            break;
+        case State::features:
+            m_state.pop_back();
+            break;
+        case State::skip:
+            if (--m_skipDepth == 0) { m_state.pop_back(); }
+            break;
+        default:
+            m_state.pop_back();
+            break;
+        }
+        return true;
+    }
+
+    bool String(const char* _str, rapidjson::SizeType _length, bool) {
+        switch (current()) {
+        case State::top:
+            if (m_key == "type" && _length == 17 && std::strncmp(_str, "FeatureCollection", 17) == 0) {
+                m_rootIsCollection = true;
+            }
+            break;
+        case State::layer:
+            if (m_key == "type" && _length == 17 && std::strncmp(_str, "FeatureCollection", 17) == 0) {
+                m_layerIsCollection = true;
+            }
+            break;
+        case State::properties:
+            m_propItems.emplace_back(m_key, std::string(_str, _length));
+            break;
+        case State::geometry:
+            if (m_key == "type") { m_geometryType.assign(_str, _length); }
+            break;
+        case State::coords:
+            return false;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool number(double _value) {
+        switch (current()) {
+        case State::coords:
+            if (m_coordCount < 2) { m_coord[m_coordCount] = _value; }
+            m_coordCount++;
+            break;
+        case State::properties:
+            m_propItems.emplace_back(m_key, _value);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool Double(double _value) { return number(_value); }
+    bool Int(int _value) { return number(_value); }
+    bool Uint(unsigned _value) { return number(_value); }
+    bool Int64(int64_t _value) { return number(double(_value)); }
+    bool Uint64(uint64_t _value) { return number(double(_value)); }
+
+    void projectRawLine() {
+        if (m_rawLine.empty()) { return; }
+        m_line.resize(m_rawLine.size());
+        m_proj(m_rawLine.data(), m_line.data(), m_rawLine.size());
+        m_rawLine.clear();
+    }
+
+    void finishFeature() {
+
+        Properties properties;
+        properties.sourceId = m_sourceId;
+        properties.setSorted(std::move(m_propItems));
+        properties.sort();
+        m_propItems = std::vector<PropertyItem>();
+        m_feature.props = std::move(properties);
+
+        if (m_geometryType == "Point" || m_geometryType == "MultiPoint") {
+            m_feature.geometryType = GeometryType::points;
+            m_feature.points = std::move(m_line);
+        } else if (m_geometryType == "LineString") {
+            m_feature.geometryType = GeometryType::lines;
+            m_feature.lines.push_back(std::move(m_line));
+        } else if (m_geometryType == "MultiLineString") {
+            m_feature.geometryType = GeometryType::lines;
+            m_feature.lines = std::move(m_polygon);
+        } else if (m_geometryType == "Polygon") {
+            m_feature.geometryType = GeometryType::polygons;
+            m_feature.polygons.push_back(std::move(m_polygon));
+        } else if (m_geometryType == "MultiPolygon") {
+            m_feature.geometryType = GeometryType::polygons;
+            m_feature.polygons = std::move(m_polygons);
+        }
+
+        m_line = Line();
+        m_polygon = Polygon();
+        m_polygons = std::vector<Polygon>();
+
+        if (m_featureTarget) {
+            m_featureTarget->features.push_back(std::move(m_feature));
+        }
+    }
+};
+
+} // namespace
+
 bool GeoJson::isFeatureCollection(const JsonValue& _in) {
 
     // A FeatureCollection must have a "type" of "FeatureCollection"
@@ -153,4 +468,34 @@ Layer GeoJson::getLayer(const JsonValue& _in, const Transform& _proj, int32_t _s
 
 }
 
+bool GeoJson::parseStreaming(const char* _bytes, size_t _length, const BatchTransform& _proj,
+                             int32_t _sourceId, TileData& _out,
+                             const char** _error, size_t* _errorOffset) {
+
+    FeatureCollectionHandler handler(_proj, _sourceId, _out);
+
+    rapidjson::MemoryStream mstream(_bytes, _length);
+    rapidjson::Reader reader;
+    auto result = reader.Parse(mstream, handler);
+
+    *_error = nullptr;
+    *_errorOffset = 0;
+    if (result.IsError()) {
+        *_error = rapidjson::GetParseError_En(result.Code());
+        *_errorOffset = result.Offset();
+        _out.layers.clear();
+        return false;
+    }
+
+    // When the root object is itself a FeatureCollection, its features form
+    // a single unnamed layer and other members are ignored
+    if (handler.m_rootIsCollection && handler.m_rootHasFeatures) {
+        _out.layers.clear();
+        _out.layers.push_back(std::move(handler.m_rootLayer));
+    }
+
+    return true;
+
+}
+
 }
@@ -11,6 +11,10 @@ namespace GeoJson {
 
 using Transform = std::function<Point(glm::dvec2 _lonLat)>;
 
+/* Batch projection: converts _count lon/lat pairs into tile-local points
+ * in one pass; see MapProjection::LonLatToTilePoints */
+using BatchTransform = std::function<void(const glm::dvec2* _lonLat, Point* _out, size_t _count)>;
+
 bool isFeatureCollection(const JsonValue& _in);
 
 Point getPoint(const JsonValue& _in, const Transform& _proj);
@@ -25,6 +29,16 @@ Feature getFeature(const JsonValue& _in, const Transform& _proj, int32_t _source
 
 Layer getLayer(const JsonValue& _in, const Transform& _proj, int32_t _sourceId);
 
+/* Parses GeoJSON bytes with a SAX reader, building Features directly into
+ * _out without the intermediate DOM. Accepts either a FeatureCollection or
+ * an object of named FeatureCollections, like the DOM path. Coordinates are
+ * buffered per ring and projected through _proj in one batch. Returns false
+ * and sets _error/_errorOffset when the input is not valid JSON.
+ */
+bool parseStreaming(const char* _bytes, size_t _length, const BatchTransform& _proj,
+                    int32_t _sourceId, TileData& _out,
+                    const char** _error, size_t* _errorOffset);
+
 }
 
 }
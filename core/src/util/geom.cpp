@@ -101,6 +101,23 @@ glm::vec2 worldToScreenSpace(const glm::mat4& _mvp, const glm::vec4& _worldPosit
     return clipToScreenSpace(clipCoords, _screenSize);
 }
 
+glm::vec2 worldToScreenSpace(const glm::mat4& _mvp, const glm::vec2& _worldPosition,
+                             const glm::vec2& _screenSize, bool& _clipped) {
+
+    // With z = 0 and w = 1 the clip coordinates reduce to two matrix
+    // columns plus the translation
+    glm::vec4 clipCoords = _mvp[0] * _worldPosition.x +
+                           _mvp[1] * _worldPosition.y +
+                           _mvp[3];
+
+    if (clipCoords.w <= 0.0f) {
+        _clipped = true;
+        return {};
+    }
+
+    return clipToScreenSpace(clipCoords, _screenSize);
+}
+
 glm::vec2 centroid(const std::vector<std::vector<glm::vec3>>& _polygon) {
     glm::vec2 centroid;
     int n = 0;
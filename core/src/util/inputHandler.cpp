@@ -29,6 +29,8 @@ InputHandler::InputHandler(View& _view) : m_view(_view) {}
 
 void InputHandler::update(float _dt) {
 
+    m_secondsSinceLastGesture += _dt;
+
     auto velocityPanPixels = m_view.pixelsPerMeter() / m_view.pixelScale() * m_velocityPan;
 
     bool isFlinging = glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
@@ -36,13 +38,16 @@ void InputHandler::update(float _dt) {
 
     if (isFlinging) {
 
+        // The view still moves, keep counting as interaction
+        m_secondsSinceLastGesture = 0.f;
+
         m_velocityPan -= _dt * DAMPING_PAN * m_velocityPan;
         m_view.translate(_dt * m_velocityPan.x, _dt * m_velocityPan.y);
 
         m_velocityZoom -= _dt * DAMPING_ZOOM * m_velocityZoom;
         m_view.zoom(m_velocityZoom * _dt);
 
-        requestRender();
+        requestRender(RenderDirty::full);
     }
 }
 
@@ -160,8 +165,10 @@ void InputHandler::cancelFling() {
 
 void InputHandler::onGesture() {
 
+    m_secondsSinceLastGesture = 0.f;
+
     setVelocity(0.f, { 0.f, 0.f });
-    requestRender();
+    requestRender(RenderDirty::full);
 
 }
 
@@ -25,6 +25,16 @@ public:
 
     void setView(View& _view) { m_view = _view; }
 
+    /* Current fling velocities, for extrapolating the view motion.
+     * Pan is in projected meters per second, zoom in levels per second.
+     */
+    const glm::vec2& velocityPan() const { return m_velocityPan; }
+    float velocityZoom() const { return m_velocityZoom; }
+
+    /* True while the user is interacting or shortly after; used to
+     * boost work that feeds the interaction, like tile builds */
+    bool recentlyActive() const { return m_secondsSinceLastGesture < 1.f; }
+
 private:
 
     void setVelocity(float _zoom, glm::vec2 _pan);
@@ -37,6 +47,9 @@ private:
     glm::vec2 m_velocityPan;
     float m_velocityZoom = 0.f;
 
+    // See recentlyActive()
+    float m_secondsSinceLastGesture = 1.e6f;
+
 };
 
 }
@@ -1,41 +1,156 @@
 #include "jobQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <mutex>
 #include <unordered_map>
 
 namespace Tangram {
 
-std::unordered_map<JobQueue::ThreadId, std::vector<JobQueue::Job>> jobsForThreads;
-std::mutex jobMutex;
+// Bounded lock-free MPSC ring (Vyukov-style sequenced slots): any
+// thread may push, only the target thread pops. If a burst ever
+// exceeds the ring capacity, producers spill into a mutex-guarded
+// overflow list instead of blocking each other on the fast path.
+struct JobQueue::Ring {
+
+    static constexpr size_t capacity = 256; // must be a power of two
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Job job;
+    };
+
+    Ring(ThreadId _threadId) : threadId(_threadId) {
+        for (size_t i = 0; i < capacity; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(Job&& _job) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & (capacity - 1)];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            intptr_t dif = intptr_t(seq) - intptr_t(pos);
+
+            if (dif == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.job = std::move(_job);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                // Ring is full
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Only called from the target thread
+    bool pop(Job& _job) {
+        Slot& slot = slots[head & (capacity - 1)];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (intptr_t(seq) - intptr_t(head + 1) != 0) {
+            return false;
+        }
+
+        _job = std::move(slot.job);
+        slot.job = nullptr;
+        slot.sequence.store(head + capacity, std::memory_order_release);
+        head++;
+        return true;
+    }
+
+    bool empty() const {
+        return head == tail.load(std::memory_order_acquire) && overflow.empty();
+    }
+
+    ThreadId threadId;
+
+    Slot slots[capacity];
+    std::atomic<size_t> tail { 0 };
+    size_t head = 0;
+
+    std::mutex overflowMutex;
+    std::vector<Job> overflow;
+};
+
+namespace {
+
+std::mutex s_registryMutex;
+std::unordered_map<JobQueue::ThreadId, std::vector<std::shared_ptr<JobQueue::Ring>>> s_rings;
+
+}
 
 void JobQueue::makeCurrentThreadTarget() {
-    m_threadId = std::this_thread::get_id();
+    m_ring = std::make_shared<Ring>(std::this_thread::get_id());
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    s_rings[m_ring->threadId].push_back(m_ring);
 }
 
 void JobQueue::add(Job job) const {
-    std::lock_guard<std::mutex> lock(jobMutex);
-    jobsForThreads[m_threadId].push_back(job);
+    if (!m_ring) { return; }
+
+    if (!m_ring->push(std::move(job))) {
+        std::lock_guard<std::mutex> lock(m_ring->overflowMutex);
+        m_ring->overflow.push_back(std::move(job));
+    }
 }
 
-void JobQueue::runJobsForCurrentThread() {
-    auto currentThreadId = std::this_thread::get_id();
+void JobQueue::runJobsForCurrentThread(int _maxJobs) {
+
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+
+        auto entry = s_rings.find(std::this_thread::get_id());
+        if (entry == s_rings.end()) {
+            // Nothing to do here.
+            return;
+        }
+
+        // Drop rings whose last JobQueue is gone once they are drained.
+        auto& list = entry->second;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [](const auto& ring) {
+                                      return ring.use_count() == 1 && ring->empty();
+                                  }),
+                   list.end());
 
-    const auto& entry = jobsForThreads.find(currentThreadId);
-    if (entry == jobsForThreads.end()) {
-        // Nothing to do here.
-        return;
+        rings = list;
     }
 
-    auto& jobs = entry->second;
-    while (!jobs.empty()) {
+    for (auto& ring : rings) {
         Job job;
-        {
-            std::lock_guard<std::mutex> lock(jobMutex);
-            job.swap(jobs.back());
-            jobs.pop_back();
+        while (ring->pop(job)) {
+            job();
+            if (_maxJobs >= 0 && --_maxJobs == 0) { return; }
         }
-        job();
-    }
 
+        if (!ring->overflow.empty()) {
+            std::vector<Job> spilled;
+            {
+                std::lock_guard<std::mutex> lock(ring->overflowMutex);
+                spilled.swap(ring->overflow);
+            }
+            for (size_t i = 0; i < spilled.size(); i++) {
+                spilled[i]();
+                if (_maxJobs >= 0 && --_maxJobs == 0) {
+                    // Requeue what the budget did not cover
+                    std::lock_guard<std::mutex> lock(ring->overflowMutex);
+                    ring->overflow.insert(ring->overflow.begin(),
+                                          std::make_move_iterator(spilled.begin() + i + 1),
+                                          std::make_move_iterator(spilled.end()));
+                    return;
+                }
+            }
+        }
+    }
 }
 
 } //namespace Tangram
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -11,6 +12,11 @@ namespace Tangram {
 //   2. From any thread, call add() with the job you want to run on the target thread.
 //   3. Call JobQueue::runJobsForCurrentThread() on the target thread.
 // This is useful for OpenGL resources that must be created and destroyed on the GL thread.
+//
+// Internally each queue owns a bounded lock-free MPSC ring, so posting
+// a job never makes the consuming (render) thread wait on a producer
+// lock; a mutex is only touched on the rare overflow path and when
+// queues are created or torn down.
 
 class JobQueue {
 
@@ -24,10 +30,17 @@ public:
     void makeCurrentThreadTarget();
     void add(Job job) const;
 
-    static void runJobsForCurrentThread();
+    // Runs jobs queued for the current thread. At most _maxJobs jobs
+    // are run when a non-negative budget is given, so that a burst of
+    // queued disposals can be spread over several frames; remaining
+    // jobs stay queued for the next call.
+    static void runJobsForCurrentThread(int _maxJobs = -1);
 
 private:
-    ThreadId m_threadId;
+
+    struct Ring;
+
+    std::shared_ptr<Ring> m_ring;
 
 };
 
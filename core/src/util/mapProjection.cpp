@@ -8,6 +8,21 @@
 
 namespace Tangram {
 
+void MapProjection::LonLatToTilePoints(const TileID _tileCoord, const glm::dvec2* _lonLat,
+                                       glm::vec3* _out, size_t _count) const {
+
+    BoundingBox bounds(TileBounds(_tileCoord));
+    glm::dvec2 origin = { bounds.min.x, bounds.max.y * -1.0 };
+    double invScale = 1.0 / bounds.width();
+
+    for (size_t i = 0; i < _count; i++) {
+        glm::dvec2 meters = LonLatToMeters(_lonLat[i]);
+        _out[i] = { (meters.x - origin.x) * invScale,
+                    (meters.y - origin.y) * invScale,
+                    0.f };
+    }
+}
+
 MercatorProjection::MercatorProjection(int _tileSize) :
     MapProjection(ProjectionType::mercator),
     m_TileSize(_tileSize) {
@@ -102,6 +117,26 @@ glm::dvec2 MercatorProjection::TileCenter(const TileID _tileCoord) const {
                           _tileCoord.z);
 }
 
+void MercatorProjection::LonLatToTilePoints(const TileID _tileCoord, const glm::dvec2* _lonLat,
+                                            glm::vec3* _out, size_t _count) const {
+
+    BoundingBox bounds(TileBounds(_tileCoord));
+    double invScale = 1.0 / bounds.width();
+
+    // fold the tile origin and scale into per-axis constants so the
+    // loop body is branch-free and vectorizable
+    double mx = HALF_CIRCUMFERENCE * INV_180 * invScale;
+    double ox = bounds.min.x * invScale;
+    double oy = bounds.max.y * -1.0 * invScale;
+    double ry = (double)R_EARTH * invScale;
+
+    for (size_t i = 0; i < _count; i++) {
+        _out[i].x = _lonLat[i].x * mx - ox;
+        _out[i].y = log(tan(PI * 0.25 + _lonLat[i].y * PI * INV_360)) * ry - oy;
+        _out[i].z = 0.f;
+    }
+}
+
 // Reference: https://en.wikipedia.org/wiki/Mercator_projection#Truncation_and_aspect_ratio
 BoundingBox MercatorProjection::MapLonLatBounds() const {
     return { glm::dvec2(-180, -85.05113), glm::dvec2(180, 85.05113) } ;
@@ -132,6 +132,18 @@ public:
      */
     virtual BoundingBox MapLonLatBounds() const = 0;
 
+    /*
+     * Converts an array of lon/lat pairs into the local coordinates of
+     * the given tile (origin at the tile corner, side length 1) in one
+     * pass, hoisting the per-tile constants out of the loop.
+     *  Arguments:
+     *    _tileCoord: tile whose local coordinates to produce
+     *    _lonLat: _count lon/lat pairs
+     *    _out: _count output points
+     */
+    virtual void LonLatToTilePoints(const TileID _tileCoord, const glm::dvec2* _lonLat,
+                                    glm::vec3* _out, size_t _count) const;
+
     /*
      * Returns the projection type of a given projection instance
      *   (example: ProjectionType::Mercator)
@@ -168,6 +180,10 @@ public:
     virtual BoundingBox TileBounds(const TileID _tileCoord) const override;
     virtual BoundingBox TileLonLatBounds(const TileID _tileCoord) const override;
     virtual glm::dvec2 TileCenter(const TileID _tileCoord) const override;
+    /* Batch conversion with the mercator math inlined into one
+     * branch-free loop */
+    virtual void LonLatToTilePoints(const TileID _tileCoord, const glm::dvec2* _lonLat,
+                                    glm::vec3* _out, size_t _count) const override;
     /* Map Bounds for mercator projection */
     virtual BoundingBox MapBounds() const override;
     virtual BoundingBox MapLonLatBounds() const override;
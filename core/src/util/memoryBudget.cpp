@@ -0,0 +1,99 @@
+#include "memoryBudget.h"
+
+#include <atomic>
+
+namespace Tangram {
+
+namespace {
+
+const char* categoryNames[MemoryBudget::count] = {
+    "raw", "meshes", "textures", "decoded",
+};
+
+struct Accounting {
+    std::atomic<size_t> usage[MemoryBudget::count];
+    std::atomic<size_t> budget[MemoryBudget::count];
+    std::atomic<size_t> totalBudget;
+
+    Accounting() {
+        for (int i = 0; i < MemoryBudget::count; i++) {
+            usage[i] = 0;
+            budget[i] = 0;
+        }
+        totalBudget = 0;
+    }
+};
+
+Accounting& accounting() {
+    static Accounting instance;
+    return instance;
+}
+
+}
+
+void MemoryBudget::add(Category _category, size_t _bytes) {
+    accounting().usage[_category] += _bytes;
+}
+
+void MemoryBudget::remove(Category _category, size_t _bytes) {
+    auto& usage = accounting().usage[_category];
+    size_t current = usage.load();
+    // Clamp instead of wrapping when accounting ever gets unbalanced
+    while (!usage.compare_exchange_weak(current, current > _bytes ? current - _bytes : 0)) {}
+}
+
+size_t MemoryBudget::getUsage(Category _category) {
+    return accounting().usage[_category];
+}
+
+size_t MemoryBudget::getTotalUsage() {
+    size_t sum = 0;
+    for (int i = 0; i < count; i++) { sum += accounting().usage[i]; }
+    return sum;
+}
+
+void MemoryBudget::setBudget(Category _category, size_t _bytes) {
+    accounting().budget[_category] = _bytes;
+}
+
+size_t MemoryBudget::getBudget(Category _category) {
+    return accounting().budget[_category];
+}
+
+size_t MemoryBudget::overBudget(Category _category) {
+    size_t budget = accounting().budget[_category];
+    if (budget == 0) { return 0; }
+
+    size_t usage = accounting().usage[_category];
+    return usage > budget ? usage - budget : 0;
+}
+
+void MemoryBudget::setTotalBudget(size_t _bytes) {
+    accounting().totalBudget = _bytes;
+}
+
+size_t MemoryBudget::getTotalBudget() {
+    return accounting().totalBudget;
+}
+
+size_t MemoryBudget::overTotalBudget() {
+    size_t budget = accounting().totalBudget;
+    if (budget == 0) { return 0; }
+
+    size_t usage = getTotalUsage();
+    return usage > budget ? usage - budget : 0;
+}
+
+std::string MemoryBudget::toString() {
+    std::string str;
+    for (int i = 0; i < count; i++) {
+        if (i > 0) { str += " "; }
+        str += categoryNames[i];
+        str += ":";
+        str += std::to_string(accounting().usage[i] / 1024);
+        str += "kb";
+    }
+    return str;
+}
+
+}
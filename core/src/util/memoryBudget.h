@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Tangram {
+
+/*
+ * Central accounting of the memory held by the tile pipeline. The owning
+ * caches report their size changes per category, so eviction decisions can
+ * consider the whole pipeline instead of each cache's local usage, and the
+ * breakdown is queryable for telemetry.
+ */
+struct MemoryBudget {
+
+    enum Category : uint8_t {
+        rawTiles = 0,   // raw downloads cached across all DataSources
+        meshes,         // built tile meshes held by TileCache
+        textures,       // pixel data held by Textures, incl. glyph atlases
+        decodedPixels,  // decoded raster pixels cached by RasterSource
+        count,
+    };
+
+    static void add(Category _category, size_t _bytes);
+    static void remove(Category _category, size_t _bytes);
+
+    static size_t getUsage(Category _category);
+    static size_t getTotalUsage();
+
+    static void setBudget(Category _category, size_t _bytes);
+    static size_t getBudget(Category _category);
+
+    /* Bytes that must be released for @_category to fit its budget,
+     * 0 when within budget. */
+    static size_t overBudget(Category _category);
+
+    static void setTotalBudget(size_t _bytes);
+    static size_t getTotalBudget();
+
+    /* Bytes that must be released for the pipeline to fit the total
+     * budget, 0 when within budget. */
+    static size_t overTotalBudget();
+
+    /* One-line usage breakdown for logs and telemetry */
+    static std::string toString();
+
+    MemoryBudget() = delete;
+
+};
+
+}
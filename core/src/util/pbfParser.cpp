@@ -22,18 +22,69 @@
 
 namespace Tangram {
 
-PbfParser::Geometry PbfParser::getGeometry(ParserContext& _ctx, protobuf::message _geomIn) {
+// Decode one entry of the layer value table on first use; repeated
+// references return the cached Value.
+static const Value& layerValue(PbfParser::ParserContext& _ctx, size_t _valueKey) {
+
+    if (!_ctx.valueDecoded[_valueKey]) {
+        _ctx.valueDecoded[_valueKey] = true;
+
+        protobuf::message valueItr = _ctx.valueMsgs[_valueKey];
+
+        while (valueItr.next()) {
+            switch (valueItr.tag) {
+                case 1: // string value
+                    _ctx.values[_valueKey] = valueItr.string();
+                    break;
+                case 2: // float value
+                    _ctx.values[_valueKey] = valueItr.float32();
+                    break;
+                case 3: // double value
+                    _ctx.values[_valueKey] = valueItr.float64();
+                    break;
+                case 4: // int value
+                    _ctx.values[_valueKey] = valueItr.int64();
+                    break;
+                case 5: // uint value
+                    _ctx.values[_valueKey] = valueItr.varint();
+                    break;
+                case 6: // sint value
+                    _ctx.values[_valueKey] = valueItr.int64();
+                    break;
+                case 7: // bool value
+                    _ctx.values[_valueKey] = valueItr.boolean();
+                    break;
+                default:
+                    valueItr.skip();
+                    break;
+            }
+        }
+    }
 
-    Geometry geometry;
+    return _ctx.values[_valueKey];
+}
+
+void PbfParser::extractGeometry(ParserContext& _ctx, protobuf::message _geomIn) {
+
+    Geometry& geometry = _ctx.geometry;
+    geometry.coordinates.clear();
+    geometry.sizes.clear();
 
     pbfGeomCmd cmd = pbfGeomCmd::moveTo;
     uint32_t cmdRepeat = 0;
 
-    double invTileExtent = (1.0/(_ctx.tileExtent-1.0));
+    // Tile extents are small powers of two, so single precision is
+    // exact for the normalization of the integer tile coordinates
+    float invTileExtent = 1.0f / (_ctx.tileExtent - 1.0f);
 
     int64_t x = 0;
     int64_t y = 0;
 
+    // Raw coordinates of the last emitted point, for exact welding of
+    // repeated points before any float conversion
+    int64_t lastX = 0;
+    int64_t lastY = 0;
+
     size_t numCoordinates = 0;
 
     while(_geomIn.getData() < _geomIn.getEnd()) {
@@ -56,12 +107,15 @@ PbfParser::Geometry PbfParser::getGeometry(ParserContext& _ctx, protobuf::messag
             x += _geomIn.svarint();
             y += _geomIn.svarint();
 
-            // bring the points in 0 to 1 space
-            Point p;
-            p.x = invTileExtent * (double)x;
-            p.y = invTileExtent * (double)(_ctx.tileExtent - y);
+            if (numCoordinates == 0 || x != lastX || y != lastY) {
+                lastX = x;
+                lastY = y;
+
+                // bring the points in 0 to 1 space
+                Point p;
+                p.x = invTileExtent * float(x);
+                p.y = invTileExtent * float(_ctx.tileExtent - y);
 
-            if (numCoordinates == 0 || geometry.coordinates.back() != p) {
                 geometry.coordinates.push_back(p);
                 numCoordinates++;
             }
@@ -79,8 +133,6 @@ PbfParser::Geometry PbfParser::getGeometry(ParserContext& _ctx, protobuf::messag
     if (numCoordinates > 0) {
         geometry.sizes.push_back(numCoordinates);
     }
-
-    return geometry;
 }
 
 Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn) {
@@ -88,7 +140,6 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
     Feature feature(_ctx.sourceId);
 
     _ctx.featureTags.clear();
-    _ctx.featureTags.assign(_ctx.keys.size(), -1);
 
 
     while(_featureIn.next()) {
@@ -116,12 +167,12 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
 
                     auto valueKey = tagsMsg.varint();
 
-                    if( _ctx.values.size() <= valueKey ) {
+                    if( _ctx.valueMsgs.size() <= valueKey ) {
                         LOGE("accessing out of bound values");
                         return feature;
                     }
 
-                    _ctx.featureTags[tagKey] = valueKey;
+                    _ctx.featureTags.emplace_back(tagKey, valueKey);
                 }
                 break;
             }
@@ -130,7 +181,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
                 break;
             // Actual geometry data
             case FEATURE_GEOM:
-                _ctx.geometry = getGeometry(_ctx, _featureIn.getMessage());
+                extractGeometry(_ctx, _featureIn.getMessage());
                 break;
 
             default:
@@ -139,19 +190,29 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
         }
     }
 
+    // Sort the feature's few tags by interned key id instead of
+    // walking the whole layer key table; stable sort plus taking the
+    // last entry of a repeated key matches the former dense table.
+    auto& tags = _ctx.featureTags;
+    std::stable_sort(tags.begin(), tags.end(),
+                     [&](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                         return _ctx.keyIds[a.first] < _ctx.keyIds[b.first];
+                     });
+
     std::vector<Properties::Item> properties;
-    properties.reserve(_ctx.featureTags.size());
+    properties.reserve(tags.size());
 
-    for (int tagKey : _ctx.orderedKeys) {
-        int tagValue = _ctx.featureTags[tagKey];
-        if (tagValue >= 0) {
-            properties.emplace_back(_ctx.keys[tagKey], _ctx.values[tagValue]);
+    for (size_t i = 0, n = tags.size(); i < n; i++) {
+        if (i + 1 < n && _ctx.keyIds[tags[i].first] == _ctx.keyIds[tags[i + 1].first]) {
+            continue;
         }
+        properties.emplace_back(_ctx.keyIds[tags[i].first], layerValue(_ctx, tags[i].second));
     }
     feature.props.setSorted(std::move(properties));
 
     switch(feature.geometryType) {
         case GeometryType::points:
+            feature.points.reserve(_ctx.geometry.coordinates.size());
             feature.points.insert(feature.points.begin(),
                                   _ctx.geometry.coordinates.begin(),
                                   _ctx.geometry.coordinates.end());
@@ -159,6 +220,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
 
         case GeometryType::lines:
         {
+            feature.lines.reserve(_ctx.geometry.sizes.size());
             auto pos = _ctx.geometry.coordinates.begin();
             for (int length : _ctx.geometry.sizes) {
                 if (length == 0) { continue; }
@@ -218,7 +280,7 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
     Layer layer("");
 
     _ctx.keys.clear();
-    _ctx.values.clear();
+    _ctx.valueMsgs.clear();
     _ctx.featureMsgs.clear();
 
     bool lastWasFeature = false;
@@ -247,37 +309,9 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
                 break;
             }
             case LAYER_VALUE: {
-                protobuf::message valueItr = _layerIn.getMessage();
-
-                while (valueItr.next()) {
-                    switch (valueItr.tag) {
-                        case 1: // string value
-                            _ctx.values.push_back(valueItr.string());
-                            break;
-                        case 2: // float value
-                            _ctx.values.push_back(valueItr.float32());
-                            break;
-                        case 3: // double value
-                            _ctx.values.push_back(valueItr.float64());
-                            break;
-                        case 4: // int value
-                            _ctx.values.push_back(valueItr.int64());
-                            break;
-                        case 5: // uint value
-                            _ctx.values.push_back(valueItr.varint());
-                            break;
-                        case 6: // sint value
-                            _ctx.values.push_back(valueItr.int64());
-                            break;
-                        case 7: // bool value
-                            _ctx.values.push_back(valueItr.boolean());
-                            break;
-                        default:
-                            _ctx.values.push_back(none_type{});
-                            valueItr.skip();
-                            break;
-                    }
-                }
+                // Only remember where the value lives in the buffer;
+                // decoding happens on first reference in layerValue().
+                _ctx.valueMsgs.push_back(_layerIn.getMessage());
                 break;
             }
             case LAYER_TILE_EXTENT:
@@ -293,18 +327,16 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
 
     if (_ctx.featureMsgs.empty()) { return layer; }
 
-    //// Assign ordering to keys for faster sorting
-    _ctx.orderedKeys.clear();
-    _ctx.orderedKeys.reserve(_ctx.keys.size());
-    // assign key ids
-    for (int i = 0, n = _ctx.keys.size(); i < n; i++) {
-        _ctx.orderedKeys.push_back(i);
+    _ctx.values.assign(_ctx.valueMsgs.size(), none_type{});
+    _ctx.valueDecoded.assign(_ctx.valueMsgs.size(), false);
+
+    // Intern keys once per layer, so features emit pre-sorted items
+    // without per-feature string handling
+    _ctx.keyIds.clear();
+    _ctx.keyIds.reserve(_ctx.keys.size());
+    for (const auto& key : _ctx.keys) {
+        _ctx.keyIds.push_back(PropertyKey::intern(key));
     }
-    // sort by Property key ordering
-    std::sort(_ctx.orderedKeys.begin(), _ctx.orderedKeys.end(),
-              [&](int a, int b) {
-                  return Properties::keyComparator(_ctx.keys[a], _ctx.keys[b]);
-              });
 
     layer.features.reserve(numFeatures);
     for (auto& featureItr : _ctx.featureMsgs) {
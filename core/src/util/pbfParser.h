@@ -18,24 +18,37 @@ namespace PbfParser {
         std::vector<int> sizes;
     };
 
+    // ParserContext doubles as a per-task allocation arena: all
+    // scratch containers below are cleared but keep their capacity
+    // between features, so parsing a dense tile performs a handful
+    // of allocations instead of one per feature. The context is
+    // torn down wholesale when the task completes.
     struct ParserContext {
         ParserContext(int32_t _sourceId) : sourceId(_sourceId){}
 
         int32_t sourceId;
         std::vector<std::string> keys;
+        // The layer value table is indexed as raw pbf slices into
+        // the tile buffer (kept alive by the task) and an entry is
+        // only decoded into values when a feature references it.
+        std::vector<protobuf::message> valueMsgs;
         std::vector<Value> values;
+        std::vector<bool> valueDecoded;
         std::vector<protobuf::message> featureMsgs;
         Geometry geometry;
-        // Map Key ID -> Tag values
-        std::vector<int> featureTags;
-        // Key IDs sorted by Property key ordering
-        std::vector<int> orderedKeys;
+        // (key id, value id) tag pairs of the current feature, sorted
+        // by interned key for emitting pre-sorted Properties
+        std::vector<std::pair<int, int>> featureTags;
+        // interned PropertyKey ids, parallel to keys
+        std::vector<uint32_t> keyIds;
 
         int tileExtent = 0;
         int winding = 0;
     };
 
-    Geometry getGeometry(ParserContext& _ctx, protobuf::message _geomIn);
+    // Decodes the geometry of one feature into _ctx.geometry,
+    // reusing the buffers of the previous feature.
+    void extractGeometry(ParserContext& _ctx, protobuf::message _geomIn);
 
     Feature getFeature(ParserContext& _ctx, protobuf::message _featureIn);
 
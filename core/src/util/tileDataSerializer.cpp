@@ -0,0 +1,273 @@
+#include "tileDataSerializer.h"
+
+#include "data/propertyItem.h"
+
+#include <cstring>
+
+namespace Tangram {
+
+namespace TileDataSerializer {
+
+static const uint32_t magic = 0x44544754; // 'TGTD'
+static const uint32_t version = 1;
+
+namespace {
+
+enum ValueTag : uint8_t {
+    tagNone = 0,
+    tagDouble = 1,
+    tagString = 2,
+};
+
+struct Writer {
+    std::vector<char>& out;
+
+    template<typename T>
+    void write(const T& _v) {
+        const char* p = reinterpret_cast<const char*>(&_v);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+
+    void writeString(const std::string& _s) {
+        write(uint32_t(_s.size()));
+        out.insert(out.end(), _s.begin(), _s.end());
+    }
+
+    void writePoints(const std::vector<Point>& _points) {
+        write(uint32_t(_points.size()));
+        const char* p = reinterpret_cast<const char*>(_points.data());
+        out.insert(out.end(), p, p + _points.size() * sizeof(Point));
+    }
+};
+
+struct Reader {
+    const char* pos;
+    const char* end;
+
+    bool ok = true;
+
+    template<typename T>
+    bool read(T& _v) {
+        if (!ok || size_t(end - pos) < sizeof(T)) { return (ok = false); }
+        std::memcpy(&_v, pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string& _s) {
+        uint32_t length = 0;
+        if (!read(length)) { return false; }
+        if (size_t(end - pos) < length) { return (ok = false); }
+        _s.assign(pos, length);
+        pos += length;
+        return true;
+    }
+
+    bool readPoints(std::vector<Point>& _points) {
+        uint32_t count = 0;
+        if (!read(count)) { return false; }
+        if (count > size_t(end - pos) / sizeof(Point)) { return (ok = false); }
+        _points.resize(count);
+        std::memcpy(_points.data(), pos, count * sizeof(Point));
+        pos += count * sizeof(Point);
+        return true;
+    }
+
+    // Reads an element count and rejects it when even minimally
+    // encoded elements of _minBytes each cannot fit in the remaining
+    // input. The counts drive reserve() calls, so a corrupt or
+    // truncated blob must not be able to request an absurd
+    // allocation; this mirrors the bound readPoints() applies.
+    bool readCount(uint32_t& _count, size_t _minBytes) {
+        if (!read(_count)) { return false; }
+        if (_count > size_t(end - pos) / _minBytes) { return (ok = false); }
+        return true;
+    }
+};
+
+void writeValue(Writer& _w, const Value& _value) {
+    if (_value.is<double>()) {
+        _w.write(uint8_t(tagDouble));
+        _w.write(_value.get<double>());
+    } else if (_value.is<std::string>()) {
+        _w.write(uint8_t(tagString));
+        _w.writeString(_value.get<std::string>());
+    } else {
+        _w.write(uint8_t(tagNone));
+    }
+}
+
+bool readValue(Reader& _r, Value& _value) {
+    uint8_t tag = tagNone;
+    if (!_r.read(tag)) { return false; }
+
+    switch (tag) {
+        case tagDouble: {
+            double number = 0;
+            if (!_r.read(number)) { return false; }
+            _value = number;
+            return true;
+        }
+        case tagString: {
+            std::string string;
+            if (!_r.readString(string)) { return false; }
+            _value = std::move(string);
+            return true;
+        }
+        case tagNone:
+            _value = none_type{};
+            return true;
+        default:
+            return (_r.ok = false);
+    }
+}
+
+void writeFeature(Writer& _w, const Feature& _feature) {
+    _w.write(uint8_t(_feature.geometryType));
+    _w.write(int32_t(_feature.props.sourceId));
+
+    const auto& items = _feature.props.items();
+    _w.write(uint32_t(items.size()));
+    for (const auto& item : items) {
+        _w.writeString(item.key());
+        writeValue(_w, item.value);
+    }
+
+    _w.writePoints(_feature.points);
+
+    _w.write(uint32_t(_feature.lines.size()));
+    for (const auto& line : _feature.lines) {
+        _w.writePoints(line);
+    }
+
+    _w.write(uint32_t(_feature.polygons.size()));
+    for (const auto& polygon : _feature.polygons) {
+        _w.write(uint32_t(polygon.size()));
+        for (const auto& line : polygon) {
+            _w.writePoints(line);
+        }
+    }
+}
+
+bool readFeature(Reader& _r, Feature& _feature) {
+    uint8_t geometryType = 0;
+    int32_t sourceId = 0;
+    if (!_r.read(geometryType) || !_r.read(sourceId)) { return false; }
+
+    _feature.geometryType = GeometryType(geometryType);
+    _feature.props.sourceId = sourceId;
+
+    // A minimal item is a 4-byte key length plus a 1-byte value tag
+    uint32_t itemCount = 0;
+    if (!_r.readCount(itemCount, 5)) { return false; }
+
+    std::vector<Properties::Item> items;
+    items.reserve(itemCount);
+    for (uint32_t i = 0; i < itemCount; i++) {
+        std::string key;
+        Value value;
+        if (!_r.readString(key) || !readValue(_r, value)) { return false; }
+        items.emplace_back(std::move(key), std::move(value));
+    }
+    _feature.props.setSorted(std::move(items));
+    // Key ids are assigned per process, so the stored order from the
+    // writing run does not carry over
+    _feature.props.sort();
+
+    if (!_r.readPoints(_feature.points)) { return false; }
+
+    // An empty line is its 4-byte point count
+    uint32_t lineCount = 0;
+    if (!_r.readCount(lineCount, sizeof(uint32_t))) { return false; }
+    _feature.lines.reserve(lineCount);
+    for (uint32_t i = 0; i < lineCount; i++) {
+        _feature.lines.emplace_back();
+        if (!_r.readPoints(_feature.lines.back())) { return false; }
+    }
+
+    // An empty polygon is its 4-byte ring count; an empty ring its
+    // 4-byte point count
+    uint32_t polygonCount = 0;
+    if (!_r.readCount(polygonCount, sizeof(uint32_t))) { return false; }
+    _feature.polygons.reserve(polygonCount);
+    for (uint32_t i = 0; i < polygonCount; i++) {
+        uint32_t ringCount = 0;
+        if (!_r.readCount(ringCount, sizeof(uint32_t))) { return false; }
+        _feature.polygons.emplace_back();
+        auto& polygon = _feature.polygons.back();
+        polygon.reserve(ringCount);
+        for (uint32_t j = 0; j < ringCount; j++) {
+            polygon.emplace_back();
+            if (!_r.readPoints(polygon.back())) { return false; }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+std::vector<char> serialize(const TileData& _data) {
+
+    std::vector<char> out;
+    Writer w { out };
+
+    w.write(magic);
+    w.write(version);
+
+    w.write(uint32_t(_data.layers.size()));
+    for (const auto& layer : _data.layers) {
+        w.writeString(layer.name);
+
+        w.write(uint32_t(layer.features.size()));
+        for (const auto& feature : layer.features) {
+            writeFeature(w, feature);
+        }
+    }
+
+    return out;
+}
+
+std::shared_ptr<TileData> deserialize(const char* _data, size_t _size) {
+
+    Reader r { _data, _data + _size };
+
+    uint32_t fileMagic = 0;
+    uint32_t fileVersion = 0;
+    if (!r.read(fileMagic) || !r.read(fileVersion) ||
+        fileMagic != magic || fileVersion != version) {
+        return nullptr;
+    }
+
+    auto tileData = std::make_shared<TileData>();
+
+    // A minimal layer is a 4-byte name length plus its feature count
+    uint32_t layerCount = 0;
+    if (!r.readCount(layerCount, 8)) { return nullptr; }
+
+    tileData->layers.reserve(layerCount);
+    for (uint32_t i = 0; i < layerCount; i++) {
+        std::string name;
+        if (!r.readString(name)) { return nullptr; }
+
+        tileData->layers.emplace_back(name);
+        auto& layer = tileData->layers.back();
+
+        // A minimal feature is its fixed header: geometry type,
+        // source id and the item, point, line and polygon counts
+        uint32_t featureCount = 0;
+        if (!r.readCount(featureCount, 21)) { return nullptr; }
+
+        layer.features.reserve(featureCount);
+        for (uint32_t j = 0; j < featureCount; j++) {
+            layer.features.emplace_back();
+            if (!readFeature(r, layer.features.back())) { return nullptr; }
+        }
+    }
+
+    return tileData;
+}
+
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/* Versioned binary serialization of parsed <TileData>.
+ *
+ * Used by DataSource to persist the parsed stage of a tile, so a
+ * cache hit skips pbf/JSON decoding entirely. Parsed TileData is
+ * scene-independent (layer filtering and styling happen later in
+ * TileBuilder), so entries stay valid across scene changes. The
+ * format version is bumped whenever the TileData structures change;
+ * deserialize rejects blobs with a different version or any
+ * truncation, returning null so callers fall back to a full parse.
+ */
+namespace TileDataSerializer {
+
+    std::vector<char> serialize(const TileData& _data);
+
+    std::shared_ptr<TileData> deserialize(const char* _data, size_t _size);
+
+}
+
+}
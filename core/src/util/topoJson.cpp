@@ -60,7 +60,7 @@ Topology getTopology(const JsonDocument& _document, const Transform& _proj) {
             arc.push_back(getPoint(jsonCoords, topo, q));
         }
 
-        topo.arcs.push_back(arc);
+        topo.arcs.push_back(std::move(arc));
     }
 
     return topo;
@@ -87,6 +87,22 @@ Line getLine(const JsonValue& _arcs, const Topology& _topology) {
         return line;
     }
 
+    // Sum up the referenced arc spans first, so the line is assembled
+    // with a single allocation
+    size_t numPoints = 0;
+    size_t numArcs = 0;
+    for (auto arcIt = _arcs.Begin(); arcIt != _arcs.End(); ++arcIt) {
+        auto index = arcIt->GetInt();
+        if (index < 0) { index = -1 - index; }
+        if ((std::vector<Line>::size_type)index >= _topology.arcs.size()) {
+            continue;
+        }
+        numPoints += _topology.arcs[index].size();
+        numArcs++;
+    }
+    if (numArcs > 1) { numPoints -= numArcs - 1; }
+    line.reserve(numPoints);
+
     for (auto arcIt = _arcs.Begin(); arcIt != _arcs.End(); ++arcIt) {
 
         auto index = arcIt->GetInt();
@@ -102,24 +118,16 @@ Line getLine(const JsonValue& _arcs, const Topology& _topology) {
 
         const auto& arc = _topology.arcs[index];
 
-        auto begin = arc.begin();
-        auto end = arc.end();
-        size_t inc = 1;
-        if (reverse) {
-            begin = arc.end() - 1;
-            end = arc.begin() - 1;
-            inc = -inc;
-        }
-
         // If a line is made from multiple arcs, the first position of an arc must
         // be equal to the last position of the previous arc. So when reconstructing
         // the geometry, the first position of each arc except the first may be dropped
-        if (arcIt != _arcs.Begin()) {
-            begin = begin + inc;
-        }
+        size_t skip = (arcIt == _arcs.Begin()) ? 0 : 1;
+        if (arc.size() <= skip) { continue; }
 
-        for (auto pointIt = begin; pointIt != end; pointIt += inc) {
-            line.push_back(*pointIt);
+        if (reverse) {
+            line.insert(line.end(), arc.rbegin() + skip, arc.rend());
+        } else {
+            line.insert(line.end(), arc.begin() + skip, arc.end());
         }
 
     }
@@ -136,10 +144,12 @@ Polygon getPolygon(const JsonValue& _arcSets, const Topology& _topology) {
         return polygon;
     }
 
+    polygon.reserve(_arcSets.Size());
+
     for (auto arcSetIt = _arcSets.Begin(); arcSetIt != _arcSets.End(); ++arcSetIt) {
 
         auto ring = getLine(*arcSetIt, _topology);
-        polygon.push_back(ring);
+        polygon.push_back(std::move(ring));
 
     }
 
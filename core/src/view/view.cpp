@@ -17,6 +17,12 @@ double invLodFunc(double d) {
     return exp2(d) - 1.0;
 }
 
+// updateTiles change-classification thresholds: position and zoom
+// deltas below these cannot move a tile edge across the frustum
+// boundary, so the previous visible set stays valid.
+const static double s_tileEdgeEpsilon = 1.0 / 64.0;
+const static float s_zoomEpsilon = 0.001f;
+
 View::View(int _width, int _height, ProjectionType _projType) :
     m_obliqueAxis(0, 1),
     m_width(0),
@@ -45,6 +51,7 @@ void View::setMapProjection(ProjectionType _projType) {
     auto bounds = m_projection->MapBounds();
     m_constraint.setLimitsY(bounds.min.y, bounds.max.y);
 
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -53,6 +60,7 @@ void View::setMapProjection(ProjectionType _projType) {
 void View::setPixelScale(float _pixelsPerPoint) {
 
     m_pixelScale = _pixelsPerPoint;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -61,16 +69,30 @@ void View::setPixelScale(float _pixelsPerPoint) {
 void View::setCameraType(CameraType _type) {
 
     m_type = _type;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
 }
 
+void View::setLodBias(int _bias) {
+
+    _bias = glm::clamp(_bias, 0, MAX_LOD);
+
+    if (m_lodBias == _bias) { return; }
+
+    m_lodBias = _bias;
+    m_viewGeneration++;
+    m_dirtyTiles = true;
+
+}
+
 void View::setSize(int _width, int _height) {
 
     m_vpWidth = _width;
     m_vpHeight = _height;
     m_aspect = (float)_width / (float)_height;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -83,6 +105,7 @@ void View::setFieldOfView(float radians) {
 
     m_fov = radians;
     m_fovStops = nullptr;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -91,6 +114,7 @@ void View::setFieldOfView(float radians) {
 void View::setFieldOfViewStops(std::shared_ptr<Stops> stops) {
 
     m_fovStops = stops;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -144,7 +168,12 @@ void View::setZoom(float _z) {
 
 void View::setRoll(float _roll) {
 
-    m_roll = glm::mod(_roll, (float)TWO_PI);
+    _roll = glm::mod(_roll, (float)TWO_PI);
+
+    if (m_roll == _roll) { return; }
+
+    m_roll = _roll;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -157,7 +186,12 @@ void View::setPitch(float _pitch) {
         // Prevent projection plane from intersecting ground plane
         max_pitch = atan2(m_pos.z, m_height * .5f);
     }
-    m_pitch = glm::clamp(_pitch, 0.f, max_pitch);
+    _pitch = glm::clamp(_pitch, 0.f, max_pitch);
+
+    if (m_pitch == _pitch) { return; }
+
+    m_pitch = _pitch;
+    m_viewGeneration++;
     m_dirtyMatrices = true;
     m_dirtyTiles = true;
 
@@ -215,6 +249,22 @@ void View::update(bool _constrainToWorldBounds) {
 
 }
 
+void View::setHorizonClipScale(float _scale) {
+
+    _scale = std::min(1.f, std::max(0.05f, _scale));
+    if (_scale == m_horizonClipScale) { return; }
+
+    m_horizonClipScale = _scale;
+    m_dirtyMatrices = true; // The far plane follows the clip distance
+    m_dirtyTiles = true;
+}
+
+double View::maxTileDistance() const {
+
+    double worldTileSize = 2 * MapProjection::HALF_CIRCUMFERENCE * pow(2, -m_zoom);
+    return worldTileSize * invLodFunc(MAX_LOD + 1) * m_horizonClipScale;
+}
+
 glm::dmat2 View::getBoundsRect() const {
 
     double hw = m_width * 0.5;
@@ -265,10 +315,10 @@ double View::screenToGroundPlane(double& _screenX, double& _screenY) {
     // Determine the maximum distance from the view position at which tiles can be drawn; If the projected point
     // is farther than this maximum or if the point is above the horizon (t < 0) then we set the distance of the
     // point to always be this maximum distance.
-    double maxTileDistance = invLodFunc(MAX_LOD + 1) * 2.0 * MapProjection::HALF_CIRCUMFERENCE * pow(2, -m_zoom);
+    double maxDistance = maxTileDistance();
     double rayDistanceXY = sqrt(ray_world.x * ray_world.x + ray_world.y * ray_world.y);
-    if (rayDistanceXY > maxTileDistance || t < 0) {
-        ray_world *= maxTileDistance / rayDistanceXY;
+    if (rayDistanceXY > maxDistance || t < 0) {
+        ray_world *= maxDistance / rayDistanceXY;
     }
 
     _screenX = ray_world.x + origin_world.x;
@@ -321,7 +371,7 @@ void View::updateMatrices() {
     // Generate view matrix
     m_view = glm::lookAt(m_eye, at, up);
 
-    float maxTileDistance = worldTileSize * invLodFunc(MAX_LOD + 1);
+    float maxTileDistance = worldTileSize * invLodFunc(MAX_LOD + 1) * m_horizonClipScale;
     float near = m_pos.z / 50.f;
     float far = 1;
     float hw = 0.5 * m_width;
@@ -386,11 +436,43 @@ glm::vec2 View::lonLatToScreenPosition(double lon, double lat, bool& clipped) {
 
 void View::updateTiles() {
 
-    m_visibleTiles.clear();
-
-    int zoom = int(m_zoom);
+    int zoom = std::max(int(m_zoom) - m_lodBias, 0);
     int maxTileIndex = 1 << zoom;
 
+    double hc = MapProjection::HALF_CIRCUMFERENCE;
+    double invTileSize = double(maxTileIndex) / (hc * 2);
+
+    // Classify the change since the last full rasterization. Camera
+    // eases tick position and zoom by tiny amounts every frame; those
+    // leave the visible set unchanged, and a pure pan only shifts it.
+    if (m_tilesGeneration == m_viewGeneration && zoom == m_tilesIntZoom &&
+        !m_visibleTiles.empty() &&
+        std::abs(m_zoom - m_tilesZoom) < s_zoomEpsilon) {
+
+        double dx = (m_pos.x - m_tilesPos.x) * invTileSize;
+        // tile y grows southwards while the projected y axis points north
+        double dy = -(m_pos.y - m_tilesPos.y) * invTileSize;
+        int ix = int(lround(dx));
+        int iy = int(lround(dy));
+
+        if (std::abs(dx - ix) < s_tileEdgeEpsilon &&
+            std::abs(dy - iy) < s_tileEdgeEpsilon) {
+
+            if (ix == 0 && iy == 0) {
+                // Sub-epsilon ease tick - nothing to redo
+                m_dirtyTiles = false;
+                return;
+            }
+
+            if (shiftVisibleTiles(ix, iy, zoom, maxTileIndex)) {
+                m_dirtyTiles = false;
+                return;
+            }
+        }
+    }
+
+    m_visibleTiles.clear();
+
     // Bounds of view trapezoid in world space (i.e. view frustum projected onto z = 0 plane)
     glm::dvec2 viewBL = { 0.f,       m_vpHeight }; // bottom left
     glm::dvec2 viewBR = { m_vpWidth, m_vpHeight }; // bottom right
@@ -408,8 +490,6 @@ void View::updateTiles() {
     }
 
     // Transformation from world space to tile space
-    double hc = MapProjection::HALF_CIRCUMFERENCE;
-    double invTileSize = double(maxTileIndex) / (hc * 2);
     glm::dvec2 tileSpaceOrigin(-hc, hc);
     glm::dvec2 tileSpaceAxes(invTileSize, -invTileSize);
 
@@ -450,8 +530,15 @@ void View::updateTiles() {
 
     if (m_type == CameraType::perspective) {
 
-        // Determine zoom reduction for tiles far from the center of view
-        double tilesAtFullZoom = std::max(m_width, m_height) * invTileSize * 0.5;
+        // Determine zoom reduction for tiles far from the center of view.
+        // As the view pitches, rows far from the center cover a growing
+        // ground distance while shrinking to a few pixels on screen, so
+        // the radius kept at full zoom is pulled in with the tilt - the
+        // far rows then resolve to lower-zoom tiles instead of costing
+        // full builds. The floor keeps a sane full-zoom area when the
+        // camera approaches the horizon.
+        double pitchFactor = std::max(0.25, cos(double(m_pitch)));
+        double tilesAtFullZoom = std::max(m_width, m_height) * invTileSize * 0.5 * pitchFactor;
         double viewCenterX = (m_pos.x + hc) * invTileSize;
         double viewCenterY = (m_pos.y - hc) * -invTileSize;
 
@@ -499,8 +586,94 @@ void View::updateTiles() {
     // (which should remain visible, even though the base of the tile is not).
     Rasterize::scanTriangle(a, b, e, 0, maxTileIndex, s);
 
+    m_tilesPos = glm::dvec2(m_pos);
+    m_tilesZoom = m_zoom;
+    m_tilesIntZoom = zoom;
+    m_tilesGeneration = m_viewGeneration;
+
     m_dirtyTiles = false;
 
 }
 
+bool View::shiftVisibleTiles(int _dx, int _dy, int _zoom, int _maxTileIndex) {
+
+    // Tilted views mix zoom levels whose tile units differ; shifting
+    // those exactly would need the LOD bands recomputed, so fall back
+    // to the full pass.
+    for (const auto& id : m_visibleTiles) {
+        if (id.z != _zoom) { return false; }
+    }
+
+    std::set<TileID> shifted;
+    for (const auto& id : m_visibleTiles) {
+        int x = id.x + _dx;
+        int y = id.y + _dy;
+        if (y < 0 || y >= _maxTileIndex) { continue; }
+
+        // Wrap x to the range [0, maxTileIndex)
+        int wrappedX = x & (_maxTileIndex - 1);
+        shifted.emplace(wrappedX, y, _zoom, _zoom, id.wrap + ((x - wrappedX) >> _zoom));
+    }
+
+    m_visibleTiles.swap(shifted);
+
+    // Snap the snapshot forward by the whole-tile part of the pan so
+    // the sub-tile residual does not accumulate over repeated shifts.
+    double tileSize = 2.0 * MapProjection::HALF_CIRCUMFERENCE / double(_maxTileIndex);
+    m_tilesPos.x += _dx * tileSize;
+    m_tilesPos.y -= _dy * tileSize;
+
+    return true;
+}
+
+std::set<TileID> View::getPrefetchTiles(const glm::vec2& _panVelocity, float _zoomVelocity) const {
+
+    // How far ahead of the viewport motion is extrapolated
+    const static float lookAheadTime = 0.5f;
+    // Limit how far the visible set is shifted, in tiles
+    const static int maxTileShift = 2;
+
+    std::set<TileID> tiles;
+
+    int zoom = int(m_zoom);
+    int maxTileIndex = 1 << zoom;
+
+    // Shift the visible tile set along the fling direction. Tile y grows
+    // southwards while the projected y axis points north.
+    double metersPerTile = 2.0 * MapProjection::HALF_CIRCUMFERENCE / double(maxTileIndex);
+    int dx = int(round(_panVelocity.x * lookAheadTime / metersPerTile));
+    int dy = int(round(-_panVelocity.y * lookAheadTime / metersPerTile));
+
+    dx = glm::clamp(dx, -maxTileShift, maxTileShift);
+    dy = glm::clamp(dy, -maxTileShift, maxTileShift);
+
+    if (dx != 0 || dy != 0) {
+        for (const auto& id : m_visibleTiles) {
+            TileID shifted(id.x + dx, id.y + dy, id.z);
+            if (shifted.x < 0 || shifted.x >= maxTileIndex ||
+                shifted.y < 0 || shifted.y >= maxTileIndex) {
+                continue;
+            }
+            if (m_visibleTiles.find(shifted) == m_visibleTiles.end()) {
+                tiles.insert(shifted);
+            }
+        }
+    }
+
+    int predictedZoom = int(m_zoom + _zoomVelocity * lookAheadTime);
+    if (predictedZoom < zoom && zoom > 0) {
+        for (const auto& id : m_visibleTiles) {
+            tiles.insert(id.getParent());
+        }
+    } else if (predictedZoom > zoom && zoom < int(s_maxZoom)) {
+        for (const auto& id : m_visibleTiles) {
+            for (int i = 0; i < 4; i++) {
+                tiles.insert(id.getChild(i));
+            }
+        }
+    }
+
+    return tiles;
+}
+
 }
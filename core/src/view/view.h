@@ -76,6 +76,12 @@ public:
      */
     void setPixelScale(float _pixelsPerPoint);
 
+    /* Sets a reduction of the zoom level used for tile selection,
+     * trading tile detail for build and draw cost (default is 0) */
+    void setLodBias(int _bias);
+
+    int getLodBias() const { return m_lodBias; }
+
     /* Sets the size of the viewable area in pixels */
     void setSize(int _width, int _height);
 
@@ -153,12 +159,27 @@ public:
     double screenToGroundPlane(double& _screenX, double& _screenY);
     double screenToGroundPlane(float& _screenX, float& _screenY);
 
+    /* Sets a scale, in (0, 1], on the maximum ground distance covered by tiles.
+     * Values below 1 pull the far edge of the view trapezoid towards the camera,
+     * bounding the visible-tile count of strongly tilted views; scene fog blends
+     * the resulting edge into the horizon color (see Style::onBeginDrawFrame) */
+    void setHorizonClipScale(float _scale);
+
+    /* Ground distance from the view position beyond which no tiles are drawn */
+    double maxTileDistance() const;
+
     /* Gets the screen position from a latitude/longitude */
     glm::vec2 lonLatToScreenPosition(double lon, double lat, bool& clipped);
 
     /* Returns the set of all tiles visible at the current position and zoom */
     const std::set<TileID>& getVisibleTiles() { return m_visibleTiles; }
 
+    /* Returns tiles expected to become visible soon, extrapolating the
+     * current pan and zoom velocities over a short look-ahead interval.
+     * Pan velocity is in projected meters per second, zoom velocity in
+     * zoom-levels per second. */
+    std::set<TileID> getPrefetchTiles(const glm::vec2& _panVelocity, float _zoomVelocity) const;
+
     /* Returns true if the view properties have changed since the last call to update() */
     bool changedOnLastUpdate() const { return m_changed; }
 
@@ -180,6 +201,11 @@ protected:
     void updateMatrices();
     void updateTiles();
 
+    /* Shifts m_visibleTiles by whole-tile deltas in place of a full
+     * rasterization; returns false when the set mixes zoom levels and
+     * the shift cannot be applied exactly. */
+    bool shiftVisibleTiles(int _dx, int _dy, int _zoom, int _maxTileIndex);
+
     std::shared_ptr<MapProjection> m_projection;
     std::shared_ptr<Stops> m_fovStops;
     std::set<TileID> m_visibleTiles;
@@ -201,6 +227,7 @@ protected:
 
     float m_roll = 0.f;
     float m_pitch = 0.f;
+    float m_horizonClipScale = 1.f;
 
     float m_zoom = 0.f;
 
@@ -211,6 +238,7 @@ protected:
     int m_vpHeight;
     float m_aspect;
     float m_pixelScale = 1.0f;
+    int m_lodBias = 0;
     float m_fov = 0.25 * PI;
 
     CameraType m_type;
@@ -219,6 +247,20 @@ protected:
     bool m_dirtyTiles;
     bool m_changed;
 
+    /* Snapshot of the view state at the last full updateTiles
+     * rasterization, used to classify cheap changes: a pure pan by
+     * whole-tile deltas shifts the previous visible set, sub-epsilon
+     * pan and zoom ticks from camera eases skip the pass entirely. */
+    glm::dvec2 m_tilesPos = { 0.0, 0.0 };
+    float m_tilesZoom = 0.f;
+    int m_tilesIntZoom = -1;
+    uint32_t m_tilesGeneration = 0;
+
+    /* Bumped by every setter that changes the frustum shape (size,
+     * field of view, pitch, roll, camera type, pixel scale, lod
+     * bias); position and zoom are deliberately excluded. */
+    uint32_t m_viewGeneration = 1;
+
 };
 
 }
@@ -16,16 +16,13 @@
 
 #include <regex>
 
-#define NUM_WORKERS 3
-
 PFNGLBINDVERTEXARRAYPROC glBindVertexArrayOESEXT = 0;
 PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArraysOESEXT = 0;
 PFNGLGENVERTEXARRAYSPROC glGenVertexArraysOESEXT = 0;
 
 static bool s_isContinuousRendering = false;
 
-static UrlWorker s_Workers[NUM_WORKERS];
-static std::list<std::unique_ptr<UrlTask>> s_urlTaskQueue;
+static UrlRequestManager s_urlRequestManager;
 
 void logMsg(const char* fmt, ...) {
     va_list args;
@@ -35,17 +32,8 @@ void logMsg(const char* fmt, ...) {
 }
 
 void processNetworkQueue() {
-    // attach workers to NetWorkerData
-    auto taskItr = s_urlTaskQueue.begin();
-    for(auto& worker : s_Workers) {
-        if(taskItr == s_urlTaskQueue.end()) {
-            break;
-        }
-        if(worker.isAvailable()) {
-            worker.perform(std::move(*taskItr));
-            taskItr = s_urlTaskQueue.erase(taskItr);
-        }
-    }
+    // Dispatch happens on the UrlRequestManager network thread; nothing
+    // to do on the main thread anymore
 }
 
 void requestRender() {
@@ -99,6 +87,12 @@ unsigned char* bytesFromFile(const char* _path, size_t& _size) {
     return reinterpret_cast<unsigned char *>(cdata);
 }
 
+// Files are opened relative to the working directory, the path needs
+// no translation
+std::string resolveAssetPath(const char* _path) {
+    return std::string(_path);
+}
+
 // No system fonts implementation (yet!)
 std::string systemFontPath(const std::string& _name, const std::string& _weight,
                            const std::string& _face) {
@@ -113,35 +107,20 @@ std::string systemFontFallbackPath(int _importance, int _weightHint) {
 bool startUrlRequest(const std::string& _url, UrlCallback _callback) {
 
     std::unique_ptr<UrlTask> task(new UrlTask(_url, _callback));
-    for(auto& worker : s_Workers) {
-        if(worker.isAvailable()) {
-            worker.perform(std::move(task));
-            return true;
-        }
-    }
-    s_urlTaskQueue.push_back(std::move(task));
+    s_urlRequestManager.enqueue(std::move(task));
     return true;
 
 }
 
 void cancelUrlRequest(const std::string& _url) {
 
-    // Only clear this request if a worker has not started operating on it!!
-    // otherwise it gets too convoluted with curl!
-    auto itr = s_urlTaskQueue.begin();
-    while(itr != s_urlTaskQueue.end()) {
-        if((*itr)->url == _url) {
-            itr = s_urlTaskQueue.erase(itr);
-        } else {
-            itr++;
-        }
-    }
+    // Pending requests are dropped and in-flight transfers are aborted,
+    // so superseded tiles stop consuming bandwidth
+    s_urlRequestManager.cancel(_url);
 }
 
 void finishUrlRequests() {
-    for(auto& worker : s_Workers) {
-        worker.join();
-    }
+    s_urlRequestManager.join();
 }
 
 void setCurrentThreadPriority(int priority){
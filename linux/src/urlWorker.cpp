@@ -1,85 +1,202 @@
 #include "urlWorker.h"
 
+#include <algorithm>
+
 #include <curl/curl.h>
 
+// Transfers multiplex over few connections, so the cap mainly bounds
+// memory held by in-flight responses - desktop tile servers sustain
+// this many streams comfortably.
+#define MAX_ACTIVE_TRANSFERS 32
+
 static size_t write_data(void *_buffer, size_t _size, size_t _nmemb, void *_dataPtr) {
 
     const size_t realSize = _size * _nmemb;
 
-    std::stringstream* stream = (std::stringstream*)_dataPtr;
+    UrlTask* task = (UrlTask*)_dataPtr;
 
-    stream->write((const char*)_buffer, realSize);
+    task->content.insert(task->content.end(),
+                         (const char*)_buffer,
+                         (const char*)_buffer + realSize);
 
     return realSize;
 }
 
-UrlWorker::UrlWorker() {
-    m_curlHandle = curl_easy_init();
+UrlRequestManager::UrlRequestManager() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    m_multiHandle = curl_multi_init();
+
+#ifdef CURLPIPE_MULTIPLEX
+    // Multiplex concurrent transfers to the same host over one connection
+    // when the server speaks HTTP/2; older libcurl falls back to separate
+    // connections
+    curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, 4L);
+#endif
+
+    m_thread = std::thread(&UrlRequestManager::run, this);
 }
 
-UrlWorker::~UrlWorker() {
-    // wait for thread to finish
-    if (m_future.valid()) { m_future.get(); }
+UrlRequestManager::~UrlRequestManager() {
+    join();
 
-    curl_easy_cleanup(m_curlHandle);
+    curl_multi_cleanup(m_multiHandle);
+    curl_global_cleanup();
 }
 
-void UrlWorker::perform(std::unique_ptr<UrlTask> _task) {
+void UrlRequestManager::enqueue(std::unique_ptr<UrlTask> _task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(std::move(_task));
+    }
+    m_condition.notify_one();
+}
 
-    m_task = std::move(_task);
+void UrlRequestManager::cancel(const std::string& _url) {
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    m_future = std::async(std::launch::async, [&]() {
+    auto itr = m_pending.begin();
+    while (itr != m_pending.end()) {
+        if ((*itr)->url == _url) {
+            itr = m_pending.erase(itr);
+        } else {
+            itr++;
+        }
+    }
 
-        // set up curl to perform fetch
-        curl_easy_setopt(m_curlHandle, CURLOPT_WRITEFUNCTION, write_data);
-        curl_easy_setopt(m_curlHandle, CURLOPT_WRITEDATA, &m_stream);
-        curl_easy_setopt(m_curlHandle, CURLOPT_URL, m_task->url.c_str());
-        curl_easy_setopt(m_curlHandle, CURLOPT_HEADER, 0L);
-        curl_easy_setopt(m_curlHandle, CURLOPT_VERBOSE, 0L);
-        curl_easy_setopt(m_curlHandle, CURLOPT_ACCEPT_ENCODING, "gzip");
+    // In-flight transfers are aborted by the network thread, which owns
+    // the curl handles
+    for (auto& task : m_active) {
+        if (task->url == _url) {
+            task->canceled = true;
+        }
+    }
+    m_condition.notify_one();
+}
 
-        LOGD("Fetching URL: %s", m_task->url.c_str());
+void UrlRequestManager::join() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) { return; }
+        m_stop = true;
+    }
+    m_condition.notify_one();
 
-        // Reset stream
-        m_stream.seekp(0);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
 
-        CURLcode result = curl_easy_perform(m_curlHandle);
+// Moves pending tasks onto the multi handle; m_mutex must be held
+void UrlRequestManager::startPendingTasks() {
 
-        long httpStatusCode = 0;
-        curl_easy_getinfo(m_curlHandle, CURLINFO_RESPONSE_CODE, &httpStatusCode);
+    while (!m_pending.empty() && m_active.size() < MAX_ACTIVE_TRANSFERS) {
+        auto task = std::move(m_pending.front());
+        m_pending.pop_front();
 
-        if (result == CURLE_OK && httpStatusCode == 200) {
-            size_t nBytes = m_stream.tellp();
-            m_stream.seekp(0);
+        CURL* handle = curl_easy_init();
 
-            m_task->content.resize(nBytes);
-            m_stream.seekg(0);
-            m_stream.read(m_task->content.data(), nBytes);
-        } else {
-            LOGE("curl_easy_perform failed: %s - %d",
-                 curl_easy_strerror(result), httpStatusCode);
-        }
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, write_data);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, task.get());
+        curl_easy_setopt(handle, CURLOPT_URL, task->url.c_str());
+        curl_easy_setopt(handle, CURLOPT_HEADER, 0L);
+        curl_easy_setopt(handle, CURLOPT_VERBOSE, 0L);
+        curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "gzip");
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, task.get());
 
-        m_task->callback(std::move(m_task->content));
-        m_task.reset();
+        LOGD("Fetching URL: %s", task->url.c_str());
 
-        // Run processNetworkQueue() for pending tasks
-        requestRender();
+        task->handle = handle;
+        curl_multi_add_handle(m_multiHandle, handle);
 
-        return true;
-    });
+        m_active.push_back(std::move(task));
+    }
 }
 
-void UrlWorker::reset() {
-    m_task.reset();
-}
+// Detaches a completed or canceled transfer and runs its callback; the
+// lock is released around the callback since it may enqueue new requests
+void UrlRequestManager::finishTask(CURL* _handle, bool _success,
+                                   std::unique_lock<std::mutex>& _lock) {
 
-void UrlWorker::join() {
-    if (m_future.valid()) {
-        m_future.get();
+    curl_multi_remove_handle(m_multiHandle, _handle);
+
+    auto itr = std::find_if(m_active.begin(), m_active.end(),
+                            [&](const auto& t) { return t->handle == _handle; });
+
+    std::unique_ptr<UrlTask> task;
+    if (itr != m_active.end()) {
+        task = std::move(*itr);
+        m_active.erase(itr);
+    }
+
+    curl_easy_cleanup(_handle);
+
+    if (task && !task->canceled) {
+        if (!_success) { task->content.clear(); }
+
+        _lock.unlock();
+        task->callback(std::move(task->content));
+        requestRender();
+        _lock.lock();
     }
 }
 
-bool UrlWorker::hasTask(const std::string& _url) {
-    return (m_task && m_task->url == _url);
+void UrlRequestManager::run() {
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+
+        if (m_pending.empty() && m_active.empty()) {
+            if (m_stop) { break; }
+            m_condition.wait(lock, [&]() {
+                    return m_stop || !m_pending.empty();
+                });
+            continue;
+        }
+
+        startPendingTasks();
+
+        // Abort transfers canceled since the last iteration
+        auto itr = m_active.begin();
+        while (itr != m_active.end()) {
+            if ((*itr)->canceled) {
+                CURL* handle = (*itr)->handle;
+                itr++;
+                finishTask(handle, false, lock);
+            } else {
+                itr++;
+            }
+        }
+
+        int running = 0;
+        curl_multi_perform(m_multiHandle, &running);
+
+        int pending = 0;
+        CURLMsg* msg = nullptr;
+        while ((msg = curl_multi_info_read(m_multiHandle, &pending))) {
+            if (msg->msg != CURLMSG_DONE) { continue; }
+
+            CURL* handle = msg->easy_handle;
+            long httpStatusCode = 0;
+            curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &httpStatusCode);
+
+            bool success = (msg->data.result == CURLE_OK && httpStatusCode == 200);
+            if (!success) {
+                LOGE("curl transfer failed: %s - %d",
+                     curl_easy_strerror(msg->data.result), httpStatusCode);
+            }
+            finishTask(handle, success, lock);
+        }
+
+        if (running > 0) {
+            // Release the lock while waiting on the sockets so requests
+            // can be enqueued and canceled meanwhile
+            lock.unlock();
+            int numfds = 0;
+            curl_multi_wait(m_multiHandle, nullptr, 0, 100, &numfds);
+            lock.lock();
+        }
+    }
 }
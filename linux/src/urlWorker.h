@@ -1,47 +1,66 @@
 #pragma once
 
-#include <future>
+#include <condition_variable>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
-#include <sstream>
 
 #include "platform.h"
 
 typedef void CURL;
+typedef void CURLM;
 
 struct UrlTask {
     UrlCallback callback;
     const std::string url;
     std::vector<char> content;
+    CURL* handle = nullptr;
+    bool canceled = false;
 
-    UrlTask(UrlTask&& _other) : 
-        callback(std::move(_other.callback)),
-        url(std::move(_other.url)),
-        content(std::move(_other.content)) {
-    }
-
-    UrlTask(const std::string& _url, const UrlCallback& _callback) : 
+    UrlTask(const std::string& _url, const UrlCallback& _callback) :
         callback(_callback),
         url(_url) {
     }
 };
 
-class UrlWorker {
+/* Runs all url requests through one curl multi handle on a single network
+ * thread, so transfers share connections (and multiplex over HTTP/2 when
+ * libcurl supports it) instead of queuing behind a fixed pool of easy
+ * handles. Transfers are started in the order they were enqueued, which is
+ * the priority order the tile manager issues requests in, and requests can
+ * be canceled while they are in flight.
+ */
+class UrlRequestManager {
     public:
-        void perform(std::unique_ptr<UrlTask> _task);
-        void reset();
-        bool isAvailable() { return !bool(m_task); }
-        bool hasTask(const std::string& _url);
+        void enqueue(std::unique_ptr<UrlTask> _task);
+
+        // Drops a pending request or aborts its transfer; the callback is
+        // not run for canceled requests
+        void cancel(const std::string& _url);
+
+        // Finishes the remaining transfers and stops the network thread
         void join();
 
-        UrlWorker();
-        ~UrlWorker();
+        UrlRequestManager();
+        ~UrlRequestManager();
 
     private:
-        std::unique_ptr<UrlTask> m_task;
-        std::stringstream m_stream;
-        CURL* m_curlHandle = nullptr;
+        void run();
+        void startPendingTasks();
+        void finishTask(CURL* _handle, bool _success,
+                        std::unique_lock<std::mutex>& _lock);
 
-        std::future<bool> m_future;
-};
+        CURLM* m_multiHandle = nullptr;
+
+        std::list<std::unique_ptr<UrlTask>> m_pending;
+        std::list<std::unique_ptr<UrlTask>> m_active;
 
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_thread;
+
+        bool m_stop = false;
+};
@@ -90,6 +90,10 @@ unsigned char* bytesFromFile(const char* _path, size_t& _size) {
     return ptr;
 }
 
+std::string resolveAssetPath(const char* _path) {
+    return std::string([resolvePath(_path) UTF8String]);
+}
+
 // No system fonts implementation (yet!)
 std::string systemFontPath(const std::string& _name, const std::string& _weight, const std::string& _face) {
     return "";
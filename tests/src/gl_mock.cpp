@@ -153,6 +153,22 @@ extern "C" {
     // mapbuffer
     void* glMapBuffer(GLenum target, GLenum access){ return nullptr; }
     GLboolean glUnmapBuffer(GLenum target){ return false; }
+    void* glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access){ return nullptr; }
+
+    // Framebuffers
+    void glGenFramebuffers(GLsizei n, GLuint *framebuffers){}
+    void glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers){}
+    void glBindFramebuffer(GLenum target, GLuint framebuffer){}
+    void glFramebufferTexture2D(GLenum target, GLenum attachment,
+                                GLenum textarget, GLuint texture, GLint level){}
+    void glFramebufferRenderbuffer(GLenum target, GLenum attachment,
+                                   GLenum renderbuffertarget, GLuint renderbuffer){}
+    GLenum glCheckFramebufferStatus(GLenum target){ return GL_FRAMEBUFFER_COMPLETE; }
+    void glGenRenderbuffers(GLsizei n, GLuint *renderbuffers){}
+    void glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers){}
+    void glBindRenderbuffer(GLenum target, GLuint renderbuffer){}
+    void glRenderbufferStorage(GLenum target, GLenum internalformat,
+                               GLsizei width, GLsizei height){}
 
     // VAO
     void glBindVertexArray (GLuint array){}
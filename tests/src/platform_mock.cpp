@@ -62,6 +62,12 @@ unsigned char* bytesFromFile(const char* _path, size_t& _size) {
     return reinterpret_cast<unsigned char *>(cdata);
 }
 
+// Files are opened relative to the working directory, the path needs
+// no translation
+std::string resolveAssetPath(const char* _path) {
+    return std::string(_path);
+}
+
 // No system fonts implementation (yet!)
 std::string systemFontPath(const std::string& _name, const std::string& _weight, const std::string& _face) {
     return "";
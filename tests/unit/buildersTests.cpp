@@ -0,0 +1,89 @@
+#define CATCH_CONFIG_MAIN
+#include "catch/catch.hpp"
+
+#include "util/builders.h"
+
+using namespace Tangram;
+
+static PolyLineBuilder makeBuilder(size_t& _vertexCount) {
+    PolyLineBuilder builder {
+        [&](const glm::vec3& _coord, const glm::vec2& _normal, const glm::vec2& _uv) {
+            _vertexCount++;
+        },
+        CapTypes::butt,
+        JoinTypes::miter
+    };
+    return builder;
+}
+
+TEST_CASE( "Polyline simplification drops sub-tolerance points", "[Core][Builders]" ) {
+
+    // A straight line with tiny zig-zag noise well below tolerance
+    Line noisy;
+    for (int i = 0; i <= 100; i++) {
+        noisy.push_back({ i * 0.01f, (i % 2) * 0.0001f, 0.f });
+    }
+
+    size_t plainVertices = 0;
+    auto plain = makeBuilder(plainVertices);
+    Builders::buildPolyLine(noisy, plain);
+
+    size_t simplifiedVertices = 0;
+    auto simplified = makeBuilder(simplifiedVertices);
+    simplified.simplificationTolerance = 0.001f;
+    Builders::buildPolyLine(noisy, simplified);
+
+    REQUIRE(simplifiedVertices < plainVertices);
+    // The noise collapses to a single segment: two butt-cap ends
+    REQUIRE(simplifiedVertices == 4);
+}
+
+TEST_CASE( "Round cap fan radials stay on the unit circle", "[Core][Builders]" ) {
+
+    std::vector<glm::vec2> normals;
+    PolyLineBuilder builder {
+        [&](const glm::vec3& _coord, const glm::vec2& _normal, const glm::vec2& _uv) {
+            normals.push_back(_normal);
+        },
+        CapTypes::round,
+        JoinTypes::miter
+    };
+
+    Line segment = {
+        { 0.2f, 0.2f, 0.f },
+        { 0.8f, 0.2f, 0.f },
+    };
+    Builders::buildPolyLine(segment, builder);
+
+    // The incremental rotation must not drift off the unit circle,
+    // and the fan must close exactly on the opposite normal
+    size_t fanRadials = 0;
+    for (auto& n : normals) {
+        if (n == glm::vec2(0.f)) { continue; } // fan center
+        REQUIRE(glm::length(n) == Approx(1.f).epsilon(0.001));
+        fanRadials++;
+    }
+    // Two round caps at resolution 6 plus the two segment ends
+    REQUIRE(fanRadials == 2 * 7 + 4);
+}
+
+TEST_CASE( "Polyline simplification keeps above-tolerance corners", "[Core][Builders]" ) {
+
+    Line corner = {
+        { 0.0f, 0.0f, 0.f },
+        { 0.5f, 0.0f, 0.f },
+        { 0.5f, 0.5f, 0.f },
+    };
+
+    size_t plainVertices = 0;
+    auto plain = makeBuilder(plainVertices);
+    Builders::buildPolyLine(corner, plain);
+
+    size_t simplifiedVertices = 0;
+    auto simplified = makeBuilder(simplifiedVertices);
+    simplified.simplificationTolerance = 0.001f;
+    Builders::buildPolyLine(corner, simplified);
+
+    // The corner is far above tolerance, so tesselation is unchanged
+    REQUIRE(simplifiedVertices == plainVertices);
+}
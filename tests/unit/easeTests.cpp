@@ -0,0 +1,58 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "util/ease.h"
+
+using namespace Tangram;
+
+TEST_CASE("EaseManager steps eases and reports activity", "[Ease][EaseManager]") {
+
+    EaseManager manager;
+    float value = -1.f;
+
+    REQUIRE(!manager.active());
+    REQUIRE(!manager.update(0.5f));
+
+    manager.set(0, Ease(1.f, [&](float t) { value = t; }));
+    REQUIRE(manager.active());
+
+    // The first step starts the ease at t = 0
+    REQUIRE(manager.update(0.5f));
+    REQUIRE(value == Approx(0.f));
+
+    REQUIRE(manager.update(0.5f));
+    REQUIRE(value == Approx(0.5f));
+
+    REQUIRE(manager.update(0.5f));
+    REQUIRE(value == Approx(1.f));
+    REQUIRE(!manager.active());
+}
+
+TEST_CASE("EaseManager batches sub-quantum frame deltas", "[Ease][EaseManager]") {
+
+    EaseManager manager;
+    int calls = 0;
+
+    manager.set(0, Ease(1.f, [&](float) { calls++; }));
+    manager.update(0.1f);
+    calls = 0;
+
+    // Two deltas below the stepping quantum batch into the next step
+    manager.update(0.004f);
+    manager.update(0.004f);
+    REQUIRE(calls == 0);
+
+    manager.update(0.01f);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("EaseManager clears slots", "[Ease][EaseManager]") {
+
+    EaseManager manager;
+
+    manager.set(2, Ease(1.f, [](float) {}));
+    REQUIRE(manager.active());
+
+    manager.clear(2);
+    REQUIRE(!manager.active());
+}
@@ -0,0 +1,53 @@
+#define CATCH_CONFIG_MAIN
+#include "catch/catch.hpp"
+
+#include "util/fastmap.h"
+
+#include <set>
+#include <string>
+
+using namespace Tangram;
+
+TEST_CASE( "hashmap finds inserted keys and misses absent ones", "[Core][fastmap]" ) {
+
+    hashmap<int> map;
+    map["polygons"] = 1;
+    map["lines"] = 2;
+    map["text"] = 3;
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.find("polygons")->second == 1);
+    REQUIRE(map.find("lines")->second == 2);
+    REQUIRE(map.find("text")->second == 3);
+    REQUIRE(map.find("points") == map.end());
+    REQUIRE(map.find("") == map.end());
+}
+
+TEST_CASE( "hashmap keeps entries across growth", "[Core][fastmap]" ) {
+
+    hashmap<int> map;
+    for (int i = 0; i < 100; i++) {
+        map["key" + std::to_string(i)] = i;
+    }
+
+    REQUIRE(map.size() == 100);
+    for (int i = 0; i < 100; i++) {
+        auto it = map.find("key" + std::to_string(i));
+        REQUIRE(it != map.end());
+        REQUIRE(it->second == i);
+    }
+}
+
+TEST_CASE( "hashmap iteration visits each entry once", "[Core][fastmap]" ) {
+
+    hashmap<int> map;
+    map["a"] = 1;
+    map["b"] = 2;
+    map["c"] = 3;
+
+    std::set<std::string> seen;
+    for (auto& entry : map) {
+        seen.insert(entry.first);
+    }
+    REQUIRE(seen == std::set<std::string>({ "a", "b", "c" }));
+}
@@ -0,0 +1,63 @@
+#define CATCH_CONFIG_MAIN
+#include "catch/catch.hpp"
+
+#include "util/frameGovernor.h"
+
+using namespace Tangram;
+
+TEST_CASE( "Governor stays at full quality when disabled", "[Core][FrameGovernor]" ) {
+    FrameGovernor governor;
+
+    for (int i = 0; i < 500; i++) {
+        governor.update(0.1f);
+    }
+
+    REQUIRE(governor.lodBias() == 0);
+    REQUIRE(!governor.throttleLabels());
+}
+
+TEST_CASE( "Governor degrades under sustained overload and recovers", "[Core][FrameGovernor]" ) {
+    FrameGovernor governor;
+    // Target 60fps
+    governor.setTargetFrameTime(1.f / 60.f);
+
+    // Frames well over budget: first level throttles label updates
+    bool throttled = false;
+    for (int i = 0; i < 100; i++) {
+        governor.update(0.033f);
+        throttled |= governor.throttleLabels();
+    }
+    REQUIRE(throttled);
+
+    // Staying over budget eventually biases the tile zoom down
+    for (int i = 0; i < 500; i++) {
+        governor.update(0.033f);
+    }
+    REQUIRE(governor.lodBias() == 1);
+
+    // Sustained frames under budget restore full quality
+    for (int i = 0; i < 2000; i++) {
+        governor.update(0.005f);
+    }
+    REQUIRE(governor.lodBias() == 0);
+
+    bool stillThrottled = false;
+    for (int i = 0; i < 100; i++) {
+        governor.update(0.005f);
+        stillThrottled |= governor.throttleLabels();
+    }
+    REQUIRE(!stillThrottled);
+}
+
+TEST_CASE( "Governor resets when the target is cleared", "[Core][FrameGovernor]" ) {
+    FrameGovernor governor;
+    governor.setTargetFrameTime(1.f / 60.f);
+
+    for (int i = 0; i < 500; i++) {
+        governor.update(0.05f);
+    }
+    REQUIRE(governor.lodBias() == 1);
+
+    governor.setTargetFrameTime(0.f);
+    REQUIRE(governor.lodBias() == 0);
+}
@@ -0,0 +1,132 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "util/geoJson.h"
+
+#include <cstring>
+
+using namespace Tangram;
+
+namespace {
+
+const GeoJson::BatchTransform identity = [](const glm::dvec2* _lonLat, Point* _out, size_t _count) {
+    for (size_t i = 0; i < _count; i++) {
+        _out[i] = Point { _lonLat[i].x, _lonLat[i].y, 0 };
+    }
+};
+
+TileData parse(const char* _json) {
+    TileData data;
+    const char* error = nullptr;
+    size_t offset = 0;
+    bool ok = GeoJson::parseStreaming(_json, std::strlen(_json), identity, 0,
+                                      data, &error, &offset);
+    REQUIRE(ok);
+    return data;
+}
+
+}
+
+TEST_CASE( "Stream-parse a FeatureCollection with every geometry type", "[GeoJson]" ) {
+
+    auto data = parse(R"({
+        "type": "FeatureCollection",
+        "features": [
+            { "type": "Feature",
+              "properties": { "name": "pt", "rank": 3 },
+              "geometry": { "type": "Point", "coordinates": [1.0, 2.0] } },
+            { "type": "Feature",
+              "properties": {},
+              "geometry": { "type": "MultiPoint", "coordinates": [[1.0, 2.0], [3.0, 4.0]] } },
+            { "type": "Feature",
+              "properties": {},
+              "geometry": { "type": "LineString", "coordinates": [[0.0, 0.0], [1.0, 1.0]] } },
+            { "type": "Feature",
+              "properties": {},
+              "geometry": { "type": "MultiLineString",
+                            "coordinates": [[[0.0, 0.0], [1.0, 1.0]], [[2.0, 2.0], [3.0, 3.0]]] } },
+            { "type": "Feature",
+              "properties": {},
+              "geometry": { "type": "Polygon",
+                            "coordinates": [[[0.0, 0.0], [1.0, 0.0], [1.0, 1.0], [0.0, 0.0]]] } },
+            { "type": "Feature",
+              "properties": {},
+              "geometry": { "type": "MultiPolygon",
+                            "coordinates": [[[[0.0, 0.0], [1.0, 0.0], [0.0, 1.0]]],
+                                            [[[2.0, 2.0], [3.0, 2.0], [2.0, 3.0]]]] } }
+        ]
+    })");
+
+    REQUIRE(data.layers.size() == 1);
+    REQUIRE(data.layers[0].name == "");
+
+    auto& features = data.layers[0].features;
+    REQUIRE(features.size() == 6);
+
+    REQUIRE(features[0].geometryType == GeometryType::points);
+    REQUIRE(features[0].points.size() == 1);
+    REQUIRE(features[0].points[0] == Point(1.0, 2.0, 0));
+    REQUIRE(features[0].props.getString("name") == "pt");
+    REQUIRE(features[0].props.getNumber("rank") == 3.0);
+
+    REQUIRE(features[1].geometryType == GeometryType::points);
+    REQUIRE(features[1].points.size() == 2);
+
+    REQUIRE(features[2].geometryType == GeometryType::lines);
+    REQUIRE(features[2].lines.size() == 1);
+    REQUIRE(features[2].lines[0].size() == 2);
+
+    REQUIRE(features[3].geometryType == GeometryType::lines);
+    REQUIRE(features[3].lines.size() == 2);
+
+    REQUIRE(features[4].geometryType == GeometryType::polygons);
+    REQUIRE(features[4].polygons.size() == 1);
+    REQUIRE(features[4].polygons[0].size() == 1);
+    REQUIRE(features[4].polygons[0][0].size() == 4);
+
+    REQUIRE(features[5].geometryType == GeometryType::polygons);
+    REQUIRE(features[5].polygons.size() == 2);
+}
+
+TEST_CASE( "Stream-parse an object of named FeatureCollections", "[GeoJson]" ) {
+
+    auto data = parse(R"({
+        "roads": {
+            "type": "FeatureCollection",
+            "features": [
+                { "type": "Feature",
+                  "properties": {},
+                  "geometry": { "type": "LineString", "coordinates": [[0.0, 0.0], [1.0, 1.0]] } }
+            ]
+        },
+        "not_a_layer": 5,
+        "pois": {
+            "type": "FeatureCollection",
+            "features": [
+                { "type": "Feature",
+                  "properties": {},
+                  "geometry": { "type": "Point", "coordinates": [1.0, 2.0] } }
+            ]
+        }
+    })");
+
+    REQUIRE(data.layers.size() == 2);
+    REQUIRE(data.layers[0].name == "roads");
+    REQUIRE(data.layers[0].features.size() == 1);
+    REQUIRE(data.layers[1].name == "pois");
+    REQUIRE(data.layers[1].features.size() == 1);
+}
+
+TEST_CASE( "Stream-parse reports invalid json", "[GeoJson]" ) {
+
+    TileData data;
+    const char* error = nullptr;
+    size_t offset = 0;
+    const char* json = "{ \"type\": \"FeatureCollection\", \"features\": [ }";
+    bool ok = GeoJson::parseStreaming(json, std::strlen(json), identity, 0,
+                                      data, &error, &offset);
+
+    REQUIRE(!ok);
+    REQUIRE(error != nullptr);
+    REQUIRE(data.layers.empty());
+}
@@ -192,6 +192,64 @@ TEST_CASE("SceneLayer matches correct sublayer rules for a feature and context",
 
 }
 
+SceneLayer instance_indexed() {
+
+    // enough string-equality sublayers on the same key to trigger the
+    // sublayer dispatch index
+    auto sub = [](const std::string& _name, const std::string& _kind, int _group) {
+        Filter f = Filter::MatchEquality("kind", { Value(_kind) });
+        DrawRuleData rule = { _name, _group, { { StyleParamKey::order, _name } } };
+        return SceneLayer{ _name, f, { rule }, {} };
+    };
+
+    Filter f = Filter(); // passes everything
+
+    DrawRuleData rule = { "dg0", dg0, {} };
+
+    return { "layer_indexed", f, { rule },
+             { sub("park", "park", group1),
+               sub("wood", "wood", group1),
+               sub("water", "water", group1),
+               sub("beach", "beach", group2) } };
+}
+
+TEST_CASE("SceneLayer dispatches sublayers indexed by equality filters", "[SceneLayer][Filter]") {
+
+    Context ctx;
+    auto layer = instance_indexed();
+
+    {
+        DrawRuleMergeSet ruleSet;
+        Feature feat;
+        feat.props.set("kind", "wood");
+        ruleSet.match(feat, layer, ctx);
+        auto& matches = ruleSet.matchedRules();
+
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[1].findParameter(StyleParamKey::order).value.get<std::string>() == "wood");
+    }
+
+    {
+        DrawRuleMergeSet ruleSet;
+        Feature feat;
+        feat.props.set("kind", "glacier"); // matches only the base layer
+        ruleSet.match(feat, layer, ctx);
+        auto& matches = ruleSet.matchedRules();
+
+        REQUIRE(matches.size() == 1);
+    }
+
+    {
+        DrawRuleMergeSet ruleSet;
+        Feature feat; // no 'kind' property at all
+        ruleSet.match(feat, layer, ctx);
+        auto& matches = ruleSet.matchedRules();
+
+        REQUIRE(matches.size() == 1);
+    }
+
+}
+
 TEST_CASE("SceneLayer correctly merges rules matched from sublayer", "[SceneLayer][Filter]") {
 
     Feature feat;
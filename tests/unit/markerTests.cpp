@@ -0,0 +1,51 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "marker/markerManager.h"
+
+using namespace Tangram;
+
+TEST_CASE( "Marker ids stay valid across removals", "[Markers]" ) {
+
+    MarkerManager markers;
+
+    MarkerID a = markers.add(-74.00, 40.70, 16.f, 0xffff0000);
+    MarkerID b = markers.add(-73.99, 40.71, 16.f, 0xff00ff00);
+
+    REQUIRE(a != 0);
+    REQUIRE(b != 0);
+    REQUIRE(a != b);
+    REQUIRE(markers.size() == 2);
+
+    REQUIRE(markers.remove(a));
+    REQUIRE(markers.size() == 1);
+
+    // a removed id no longer names a marker
+    REQUIRE(!markers.remove(a));
+    REQUIRE(!markers.setPosition(a, 0.0, 0.0));
+
+    // the freed slot is reused, but b keeps working
+    MarkerID c = markers.add(-73.98, 40.72, 16.f, 0xff0000ff);
+    REQUIRE(c != 0);
+    REQUIRE(markers.size() == 2);
+    REQUIRE(markers.setPosition(b, -73.99, 40.72));
+}
+
+TEST_CASE( "Bulk position updates skip dead ids", "[Markers]" ) {
+
+    MarkerManager markers;
+
+    MarkerID a = markers.add(0.0, 0.0, 8.f, 0xffffffff);
+    MarkerID b = markers.add(1.0, 1.0, 8.f, 0xffffffff);
+    markers.remove(b);
+
+    MarkerID ids[] = { a, b, 0 };
+    double coordinates[] = { 10.0, 10.0, 11.0, 11.0, 12.0, 12.0 };
+
+    // only the live marker moves
+    REQUIRE(markers.setPositions(ids, coordinates, 3) == 1);
+
+    markers.removeAll();
+    REQUIRE(markers.size() == 0);
+    REQUIRE(!markers.setPosition(a, 0.0, 0.0));
+}
@@ -30,3 +30,25 @@ TEST_CASE( "Testing some functionality for mercator projection", "[MERCATOR][PRO
     REQUIRE( (testLonLat.x - lonLat.x) < epsilon);
     REQUIRE( (testLonLat.y - lonLat.y) < epsilon);
 }
+
+TEST_CASE( "Batch tile-point conversion matches the per-point path", "[MERCATOR][PROJECTION]" ) {
+    MercatorProjection mercProjection = MercatorProjection();
+    TileID tileId(2, 2, 3);
+
+    glm::dvec2 lonLat[] = { {0.0, 0.0}, {10.0, 45.0}, {-120.0, -30.0}, {45.0, 80.0} };
+    glm::vec3 batch[4];
+
+    mercProjection.LonLatToTilePoints(tileId, lonLat, batch, 4);
+
+    // Reference: project each point through the single-point API and
+    // apply the tile transform by hand
+    BoundingBox bounds(mercProjection.TileBounds(tileId));
+    glm::dvec2 origin = { bounds.min.x, bounds.max.y * -1.0 };
+    double invScale = 1.0 / bounds.width();
+
+    for (int i = 0; i < 4; i++) {
+        glm::dvec2 meters = mercProjection.LonLatToMeters(lonLat[i]);
+        REQUIRE(batch[i].x == Approx((meters.x - origin.x) * invScale));
+        REQUIRE(batch[i].y == Approx((meters.y - origin.y) * invScale));
+    }
+}
@@ -170,3 +170,86 @@ TEST_CASE( "Check overflow", "[Core][TypedMesh]" ) {
 
     checkBounds(mesh);
 }
+
+struct PackedVertex {
+    short x;
+    short y;
+};
+
+TEST_CASE( "Weld duplicate vertices shared between triangles", "[Core][MeshData]" ) {
+    MeshData<PackedVertex> data;
+
+    // Two triangles sharing an edge, with the shared vertices duplicated
+    data.vertices = { {0, 0}, {1, 0}, {0, 1},
+                      {1, 0}, {0, 1}, {1, 1} };
+    data.indices = { 0, 1, 2,  3, 4, 5 };
+    data.offsets.emplace_back(6, 6);
+
+    data.weld();
+
+    REQUIRE(data.vertices.size() == 4);
+    REQUIRE(data.indices.size() == 6);
+    REQUIRE(data.offsets.size() == 1);
+    REQUIRE(data.offsets[0].first == 6);
+    REQUIRE(data.offsets[0].second == 4);
+
+    // The second triangle references the welded vertices of the first
+    REQUIRE(data.indices[3] == data.indices[1]);
+    REQUIRE(data.indices[4] == data.indices[2]);
+}
+
+TEST_CASE( "Weld strips degenerate triangles", "[Core][MeshData]" ) {
+    MeshData<PackedVertex> data;
+
+    data.vertices = { {0, 0}, {1, 0}, {0, 1}, {1, 0} };
+    data.indices = { 0, 1, 2,  0, 1, 3 };
+    data.offsets.emplace_back(6, 4);
+
+    data.weld();
+
+    // Vertex 3 welds onto vertex 1, making the second triangle degenerate
+    REQUIRE(data.vertices.size() == 3);
+    REQUIRE(data.indices.size() == 3);
+    REQUIRE(data.offsets[0].first == 3);
+    REQUIRE(data.offsets[0].second == 3);
+}
+
+TEST_CASE( "Weld keeps geometry batches separate", "[Core][MeshData]" ) {
+    MeshData<PackedVertex> data;
+
+    // Both batches hold the same triangle; indices are batch-relative, so
+    // the second batch must keep its own copy of the vertices
+    data.vertices = { {0, 0}, {1, 0}, {0, 1},
+                      {0, 0}, {1, 0}, {0, 1} };
+    data.indices = { 0, 1, 2,  0, 1, 2 };
+    data.offsets.emplace_back(3, 3);
+    data.offsets.emplace_back(3, 3);
+
+    data.weld();
+
+    REQUIRE(data.vertices.size() == 6);
+    REQUIRE(data.indices.size() == 6);
+    REQUIRE(data.offsets[0].second == 3);
+    REQUIRE(data.offsets[1].second == 3);
+}
+
+TEST_CASE( "Identical mesh data compiles to an identical content hash", "[Core][TypedMesh]" ) {
+    auto a = newMesh(10);
+    auto b = newMesh(10);
+
+    REQUIRE(a->contentHash() != 0);
+    REQUIRE(a->contentHash() == b->contentHash());
+}
+
+TEST_CASE( "Differing mesh data changes the content hash", "[Core][TypedMesh]" ) {
+    auto a = newMesh(10);
+    auto b = newMesh(11);
+
+    REQUIRE(a->contentHash() != b->contentHash());
+
+    // In-place vertex updates are part of the content too
+    auto c = newMesh(10);
+    c->updateVertices({0, 4}, Vertex{1.f, 2.f, 3, 4});
+
+    REQUIRE(a->contentHash() != c->contentHash());
+}
@@ -0,0 +1,69 @@
+#include "catch.hpp"
+
+#include "tile/regionLoader.h"
+
+using namespace Tangram;
+
+TEST_CASE( "Whole world at zoom 0 is one tile", "[REGION]" ) {
+    BoundingBox world{ {-180.0, -85.0}, {180.0, 85.0} };
+
+    auto tiles = RegionLoader::tilesInRegion(world, 0, 0);
+
+    REQUIRE(tiles.size() == 1);
+    REQUIRE(tiles[0] == TileID(0, 0, 0));
+}
+
+TEST_CASE( "Zoom range multiplies tile count by four per level", "[REGION]" ) {
+    BoundingBox world{ {-180.0, -85.0}, {180.0, 85.0} };
+
+    auto tiles = RegionLoader::tilesInRegion(world, 0, 2);
+
+    // 1 + 4 + 16
+    REQUIRE(tiles.size() == 21);
+    // Ordered by ascending zoom
+    REQUIRE(tiles.front().z == 0);
+    REQUIRE(tiles.back().z == 2);
+}
+
+TEST_CASE( "A point region yields one tile per zoom", "[REGION]" ) {
+    // Greenwich observatory
+    BoundingBox point{ {-0.0015, 51.4769}, {-0.0015, 51.4769} };
+
+    auto tiles = RegionLoader::tilesInRegion(point, 10, 14);
+
+    REQUIRE(tiles.size() == 5);
+    for (auto& tile : tiles) {
+        REQUIRE(tile.x >= 0);
+        REQUIRE(tile.x < (1 << tile.z));
+        REQUIRE(tile.y >= 0);
+        REQUIRE(tile.y < (1 << tile.z));
+    }
+}
+
+TEST_CASE( "Northern hemisphere tiles sit in the upper half", "[REGION]" ) {
+    // Tile y runs from north to south
+    BoundingBox helsinki{ {24.93, 60.16}, {24.95, 60.17} };
+
+    auto tiles = RegionLoader::tilesInRegion(helsinki, 5, 5);
+
+    REQUIRE(tiles.size() == 1);
+    REQUIRE(tiles[0].y < (1 << 5) / 2);
+}
+
+TEST_CASE( "Swapped or inverted bounds still enumerate", "[REGION]" ) {
+    BoundingBox swapped{ {13.5, 52.6}, {13.3, 52.4} };
+    BoundingBox ordered{ {13.3, 52.4}, {13.5, 52.6} };
+
+    auto a = RegionLoader::tilesInRegion(swapped, 8, 10);
+    auto b = RegionLoader::tilesInRegion(ordered, 8, 10);
+
+    REQUIRE(a.size() == b.size());
+    REQUIRE(!a.empty());
+}
+
+TEST_CASE( "Invalid zoom range yields no tiles", "[REGION]" ) {
+    BoundingBox world{ {-180.0, -85.0}, {180.0, 85.0} };
+
+    REQUIRE(RegionLoader::tilesInRegion(world, 4, 2).empty());
+    REQUIRE(RegionLoader::tilesInRegion(world, -1, 2).empty());
+}
@@ -170,3 +170,20 @@ TEST_CASE( "Texture path tests after importing process", "[scene-import][core]")
     REQUIRE(uniformsNode["u_tex3"].Scalar() == "import/importResources/tex.png");
     REQUIRE(uniformsNode["u_tex4"].Scalar() == "tex1");
 }
+
+TEST_CASE( "Cached fragments are isolated between imports", "[scene-import][core]") {
+
+    Importer::clearFragmentCache();
+
+    TestImporter importer;
+    auto root = importer.applySceneImports("car.yaml");
+    REQUIRE(root["type"].Scalar() == "car");
+
+    // Mutating the resolved document must not leak into the fragment cache
+    root["type"] = "mutated";
+
+    TestImporter reimporter;
+    auto root2 = reimporter.applySceneImports("car.yaml");
+    REQUIRE(root2["type"].Scalar() == "car");
+    REQUIRE(root2["category"].Scalar() == "vehicle");
+}
@@ -8,6 +8,8 @@
 #include "style/polylineStyle.h"
 #include "style/polygonStyle.h"
 #include "scene/pointLight.h"
+#include "scene/ambientLight.h"
+#include "gl/shaderProgram.h"
 
 #include "platform.h"
 
@@ -70,3 +72,35 @@ TEST_CASE("Test light parameter parsing") {
     REQUIRE(pos.units[1] == Unit::meter);
     REQUIRE(pos.units[2] == Unit::meter);
 }
+
+TEST_CASE("Identity lighting is pruned from style shaders") {
+
+    // The default setup - one full-white ambient light and a plain
+    // white material - compiles to an identity, so the style builds
+    // without any lighting code
+    Scene scene;
+    auto amb = std::make_unique<AmbientLight>("defaultLight");
+    amb->setAmbientColor({ 1.f, 1.f, 1.f, 1.f });
+    scene.lights().push_back(std::move(amb));
+
+    PolygonStyle style("polygons");
+    style.build(scene);
+
+    auto blocks = style.getShaderProgram()->getSourceBlocks();
+    for (auto& define : blocks["defines"]) {
+        REQUIRE(define.find("TANGRAM_LIGHTING") == std::string::npos);
+    }
+    REQUIRE(blocks.find("__lighting") == blocks.end());
+
+    // A tinted light keeps the lighting path
+    Scene litScene;
+    auto tinted = std::make_unique<AmbientLight>("tinted");
+    tinted->setAmbientColor({ 0.5f, 0.5f, 0.5f, 1.f });
+    litScene.lights().push_back(std::move(tinted));
+
+    PolygonStyle litStyle("polygons");
+    litStyle.build(litScene);
+
+    blocks = litStyle.getShaderProgram()->getSourceBlocks();
+    REQUIRE(blocks.find("__lighting") != blocks.end());
+}
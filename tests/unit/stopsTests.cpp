@@ -94,6 +94,25 @@ TEST_CASE("Stops evaluate color values correctly at and between key frames", "[S
 
 }
 
+TEST_CASE("Stops evaluate correctly with fractional frame keys", "[Stops]") {
+
+    // frames between integer zooms must not be skipped by the
+    // per-integer-zoom frame index
+    Stops stops({
+            Stops::Frame(0, 0.f),
+            Stops::Frame(2.5, 10.f),
+            Stops::Frame(4.5, 30.f)
+    });
+
+    REQUIRE(stops.evalFloat(0) == 0.f);
+    REQUIRE(stops.evalFloat(1.25) == 5.f);
+    REQUIRE(stops.evalFloat(2.5) == 10.f);
+    REQUIRE(stops.evalFloat(3.5) == 20.f);
+    REQUIRE(stops.evalFloat(4.5) == 30.f);
+    REQUIRE(stops.evalFloat(30) == 30.f);
+
+}
+
 TEST_CASE("Stops parses correctly from YAML distance values", "[Stops][YAML]") {
 
     YAML::Node node = YAML::Load("[ [10, 0], [16, .04], [18, .2], [19, .2] ]");
@@ -8,6 +8,7 @@
 #include "scene/filters.h"
 #include "scene/sceneLoader.h"
 #include "scene/scene.h"
+#include "style/polygonStyle.h"
 #include "util/variant.h"
 
 using namespace Tangram;
@@ -132,3 +133,23 @@ TEST_CASE( "Style Uniforms Parsing failure Tests: textures uniform value", "[Sty
     REQUIRE(!SceneLoader::parseStyleUniforms(node["u_uniform_float1"], scene, uniformValues));
 }
 
+
+TEST_CASE( "Live uniform updates apply without a config rebuild", "[StyleUniforms][core][yaml]") {
+    std::shared_ptr<Scene> scene = std::make_shared<Scene>();
+
+    auto style = std::make_unique<PolygonStyle>("heightglow");
+    style->styleUniforms().emplace_back("u_brightness", 0.5f);
+    scene->styles().push_back(std::move(style));
+
+    // An existing uniform of matching type updates in place
+    REQUIRE(SceneLoader::applyUniformUpdate({"styles.heightglow.shaders.uniforms.u_brightness", "0.9"}, scene));
+    REQUIRE(scene->styles()[0]->styleUniforms()[0].second.get<float>() == 0.9f);
+
+    // A type change needs a shader rebuild
+    REQUIRE(!SceneLoader::applyUniformUpdate({"styles.heightglow.shaders.uniforms.u_brightness", "[1, 0, 0]"}, scene));
+
+    // Unknown uniforms, styles and non-uniform paths take the full path
+    REQUIRE(!SceneLoader::applyUniformUpdate({"styles.heightglow.shaders.uniforms.u_missing", "1.0"}, scene));
+    REQUIRE(!SceneLoader::applyUniformUpdate({"styles.missing.shaders.uniforms.u_brightness", "1.0"}, scene));
+    REQUIRE(!SceneLoader::applyUniformUpdate({"layers.poi_icons.draw.icons.interactive", "false"}, scene));
+}
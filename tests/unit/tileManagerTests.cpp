@@ -272,3 +272,40 @@ TEST_CASE( "Use proxy Tile - circular proxies", "[TileManager][updateTileSets]"
     REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
 
 }
+
+TEST_CASE( "Share one tile cache between managers", "[TileManager][TileCache]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(worker);
+    ViewState viewState { s_projection, true, glm::vec2(0), 1 };
+
+    auto source = std::make_shared<TestDataSource>();
+    std::vector<std::shared_ptr<DataSource>> sources = { source };
+    tileManager.setDataSources(sources);
+
+    /// Build tile 0/0/1 in the first manager
+    std::set<TileID> visibleTiles_1 = { TileID{0,0,1} };
+    tileManager.updateTileSets(viewState, visibleTiles_1);
+    worker.processTask(0);
+    tileManager.updateTileSets(viewState, visibleTiles_1);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(source->tileTaskCount == 1);
+
+    /// Move to the sibling tile - 0/0/1 is no proxy for it, so it is
+    /// dropped into the cache
+    std::set<TileID> visibleTiles_2 = { TileID{1,1,1} };
+    tileManager.updateTileSets(viewState, visibleTiles_2);
+
+    /// A second manager adopting the cache reuses the built tile
+    /// without raising a new tile task
+    TileManager otherManager(worker);
+    otherManager.setDataSources(sources);
+    otherManager.setTileCache(tileManager.getTileCache());
+    REQUIRE(otherManager.getTileCache() == tileManager.getTileCache());
+
+    otherManager.updateTileSets(viewState, visibleTiles_1);
+
+    REQUIRE(otherManager.getVisibleTiles().size() == 1);
+    REQUIRE(otherManager.getVisibleTiles()[0]->getID() == TileID(0,0,1));
+    REQUIRE(source->tileTaskCount == 2);
+}
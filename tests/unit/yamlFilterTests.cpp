@@ -238,3 +238,73 @@ TEST_CASE("Filters specified as a javascript function evaluate correctly", "[fil
     REQUIRE(!filter.eval(bmw1, ctx));
     REQUIRE(!filter.eval(bike, ctx));
 }
+
+TEST_CASE("Simple javascript equality compiles to a native filter", "[filters][core][yaml]") {
+    init();
+    Filter filter = load("filter: 'function() { return feature.brand == \"honda\"; }'");
+
+    REQUIRE(!filter.data.is<Filter::Function>());
+    REQUIRE(filter.eval(civic, ctx));
+    REQUIRE(!filter.eval(bmw1, ctx));
+    REQUIRE(filter.eval(bike, ctx));
+}
+
+TEST_CASE("Simple javascript inequality compiles to a native filter", "[filters][core][yaml]") {
+    init();
+    Filter filter = load("filter: 'function() { return feature.type !== \"car\"; }'");
+
+    REQUIRE(!filter.data.is<Filter::Function>());
+    REQUIRE(!filter.eval(civic, ctx));
+    REQUIRE(!filter.eval(bmw1, ctx));
+    REQUIRE(filter.eval(bike, ctx));
+}
+
+TEST_CASE("Simple javascript comparison compiles to a native filter", "[filters][core][yaml]") {
+    init();
+    Filter filter = load("filter: 'function() { return feature.wheel >= 3; }'");
+
+    REQUIRE(filter.data.is<Filter::Range>());
+    REQUIRE(filter.eval(civic, ctx));
+    REQUIRE(filter.eval(bmw1, ctx));
+    REQUIRE(!filter.eval(bike, ctx));
+}
+
+TEST_CASE("Javascript functions with arithmetic stay with the JS context", "[filters][core][yaml]") {
+    init();
+    Filter filter = load("filter: 'function() { return feature.wheel * 2 === 8; }'");
+
+    REQUIRE(filter.data.is<Filter::Function>());
+    REQUIRE(filter.eval(civic, ctx));
+    REQUIRE(filter.eval(bmw1, ctx));
+    REQUIRE(!filter.eval(bike, ctx));
+}
+
+TEST_CASE("Operands are ordered by cost and selectivity", "[filters][core][yaml]") {
+    std::vector<Filter> all;
+    all.push_back(Filter::MatchFunction(0));
+    all.push_back(Filter::MatchExistence("name", true));
+    all.push_back(Filter::MatchEquality("kind", { Value{std::string("park")} }));
+
+    Filter filter = Filter::MatchAll(std::move(all));
+
+    // Cheap discriminating equality first, function filter last
+    auto& operands = filter.operands();
+    REQUIRE(operands.size() == 3);
+    REQUIRE(operands[0].data.is<Filter::Equality>());
+    REQUIRE(operands[1].data.is<Filter::Existence>());
+    REQUIRE(operands[2].data.is<Filter::Function>());
+
+    // At equal cost the ordering flips between 'all' and 'any': 'all'
+    // wants the most selective operand first, 'any' the least selective
+    std::vector<Filter> pair;
+    pair.push_back(Filter::MatchEquality("$geometry", { Value{std::string("point")} }));
+    pair.push_back(Filter::MatchRange("$zoom", 14, 16));
+
+    std::vector<Filter> pairCopy = pair;
+
+    Filter allFilter = Filter::MatchAll(std::move(pair));
+    REQUIRE(allFilter.operands()[0].data.is<Filter::Range>());
+
+    Filter anyFilter = Filter::MatchAny(std::move(pairCopy));
+    REQUIRE(anyFilter.operands()[0].data.is<Filter::Equality>());
+}
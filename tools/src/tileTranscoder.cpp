@@ -0,0 +1,208 @@
+#include "data/dataSource.h"
+#include "data/geoJsonSource.h"
+#include "data/mvtSource.h"
+#include "data/topoJsonSource.h"
+#include "data/tileData.h"
+#include "tile/tileID.h"
+#include "tile/tileTask.h"
+#include "util/mapProjection.h"
+#include "platform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+/*
+ * Batch-converts an MVT/GeoJSON/TopoJSON tileset into the binary
+ * parsed-tile format, using the same parser and serializer code paths
+ * the engine runs on device. The output directory is laid out exactly
+ * like a DataSource disk cache, so a preprocessed bundle can be handed
+ * to DataSource::setDiskCache as-is and tiles load without any pbf or
+ * JSON decoding.
+ *
+ * Input tiles are found under the input directory either nested as
+ * {z}/{x}/{y}.<ext> or flat as {z}-{x}-{y}.<ext>, with the format
+ * picked per file from its extension.
+ */
+
+using namespace Tangram;
+
+namespace {
+
+struct InputTile {
+    TileID id = NOT_A_TILE;
+    std::string path;
+    // Index into the sources array, chosen from the file extension
+    int format = -1;
+};
+
+// Effectively unlimited: bundles are trimmed by hand, not by LRU
+const size_t cacheBudget = size_t(1) << 40;
+
+int formatFromExtension(const std::string& _name) {
+    auto dot = _name.rfind('.');
+    if (dot == std::string::npos) { return -1; }
+    auto ext = _name.substr(dot + 1);
+
+    if (ext == "mvt" || ext == "pbf") { return 0; }
+    if (ext == "json" || ext == "geojson") { return 1; }
+    if (ext == "topojson") { return 2; }
+    return -1;
+}
+
+void collectTiles(const std::string& _root, std::vector<InputTile>& _tiles) {
+
+    DIR* dir = opendir(_root.c_str());
+    if (!dir) { return; }
+
+    while (struct dirent* item = readdir(dir)) {
+        std::string name = item->d_name;
+        if (name == "." || name == "..") { continue; }
+
+        std::string path = _root + "/" + name;
+
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) { continue; }
+
+        if (S_ISDIR(st.st_mode)) {
+            collectTiles(path, _tiles);
+            continue;
+        }
+
+        int format = formatFromExtension(name);
+        if (format < 0) { continue; }
+
+        InputTile tile;
+        tile.path = path;
+        tile.format = format;
+
+        // Flat {z}-{x}-{y}.<ext> first, then {z}/{x}/{y}.<ext> from
+        // the trailing path components
+        int x = 0, y = 0, z = 0;
+        if (sscanf(name.c_str(), "%d-%d-%d.", &z, &x, &y) == 3) {
+            tile.id = TileID(x, y, z);
+        } else if (sscanf(path.c_str() + _root.size(), "/%d.", &y) == 1) {
+            auto xPos = _root.rfind('/');
+            if (xPos == std::string::npos) { continue; }
+            auto zPos = _root.rfind('/', xPos - 1);
+            if (zPos == std::string::npos) { continue; }
+            if (sscanf(_root.c_str() + zPos, "/%d/%d", &z, &x) != 2) { continue; }
+            tile.id = TileID(x, y, z);
+        } else {
+            continue;
+        }
+
+        _tiles.push_back(std::move(tile));
+    }
+
+    closedir(dir);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 3) {
+        printf("usage: %s <input-dir> <output-dir> [threads]\n", argv[0]);
+        printf("  Transcodes a {z}/{x}/{y}.mvt (or .pbf/.json/.geojson/.topojson)\n");
+        printf("  tileset into the engine's binary parsed-tile cache format.\n");
+        return 1;
+    }
+
+    std::string inputRoot = argv[1];
+    std::string outputRoot = argv[2];
+
+    unsigned numThreads = std::thread::hardware_concurrency();
+    if (argc > 3) { numThreads = std::max(1, atoi(argv[3])); }
+
+    std::vector<InputTile> tiles;
+    collectTiles(inputRoot, tiles);
+
+    if (tiles.empty()) {
+        printf("No tiles found under %s\n", inputRoot.c_str());
+        return 1;
+    }
+
+    // The maxZoom only affects overzooming at runtime, it plays no
+    // role in parsing; the url templates are never fetched.
+    std::vector<std::shared_ptr<DataSource>> sources = {
+        std::make_shared<MVTSource>("transcode", "{z}/{x}/{y}", 18),
+        std::make_shared<GeoJsonSource>("transcode", "{z}/{x}/{y}", 18),
+        std::make_shared<TopoJsonSource>("transcode", "{z}/{x}/{y}", 18),
+    };
+    for (auto& source : sources) {
+        // parseCached stores each parsed tile into <output>/parsed
+        source->setDiskCache(outputRoot, cacheBudget);
+    }
+
+    MercatorProjection projection;
+
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> done(0);
+    std::atomic<size_t> failed(0);
+    std::atomic<size_t> bytesIn(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto work = [&]() {
+        while (true) {
+            size_t i = next++;
+            if (i >= tiles.size()) { break; }
+
+            auto& input = tiles[i];
+
+            std::ifstream resource(input.path, std::ifstream::ate | std::ifstream::binary);
+            if (!resource.is_open()) {
+                failed++;
+                continue;
+            }
+            auto buffer = std::make_shared<std::vector<char>>(resource.tellg());
+            resource.seekg(std::ifstream::beg);
+            resource.read(buffer->data(), buffer->size());
+            resource.close();
+
+            bytesIn += buffer->size();
+
+            auto task = sources[input.format]->createTask(input.id);
+            static_cast<DownloadTileTask&>(*task).rawTileData = RawData(buffer);
+
+            auto tileData = sources[input.format]->parseCached(*task, projection);
+
+            if (tileData && !tileData->layers.empty()) {
+                done++;
+            } else {
+                failed++;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < numThreads; i++) {
+        workers.emplace_back(work);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    printf("Transcoded %zu of %zu tiles (%zu failed/empty) on %u threads\n",
+           done.load(), tiles.size(), failed.load(), numThreads);
+    printf("%.1f MB in, %.2fs, %.0f tiles/s\n",
+           bytesIn.load() / (1024.0 * 1024.0), elapsed,
+           elapsed > 0 ? tiles.size() / elapsed : 0.0);
+    printf("Parsed-tile bundle written to %s/parsed\n", outputRoot.c_str());
+
+    return failed.load() > 0 ? 2 : 0;
+}